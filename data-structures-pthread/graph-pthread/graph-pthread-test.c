@@ -0,0 +1,923 @@
+/**
+   graph-pthread-test.c
+
+   Tests of constructing and transforming graphs with generic integer
+   vertices and generic contiguous weights with multiple threads.
+
+   The following command line arguments can be used to customize tests:
+   graph-pthread-test
+      [0, size_t width / 2] : n for 2**n vertices in smallest graph
+      [0, size_t width / 2] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : random graph generation test on/off
+      [0, 1] : R-MAT and grid graph generation test on/off
+      [0, 1] : relabeling test on/off
+      [0, 1] : batched insertion and deletion test on/off
+      [0, 1] : transpose test on/off
+      [0, 1] : sort and dedup test on/off
+
+   usage examples:
+   ./graph-pthread-test
+   ./graph-pthread-test 10 14
+   ./graph-pthread-test 14 20 8 1
+   ./graph-pthread-test 14 20 8 0 1
+   ./graph-pthread-test 14 20 8 0 0 1
+   ./graph-pthread-test 14 20 8 0 0 0 1
+   ./graph-pthread-test 14 20 8 0 0 0 0 1
+   ./graph-pthread-test 14 20 8 0 0 0 0 0 1
+
+   graph-pthread-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the width of size_t is even
+   and less than 2040, ii) size_t and clock_t are convertible to double,
+   and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include "graph-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems. RANDOM() is only called by the
+   main thread. Each thread uses its own linear congruential generator
+   state in its argument, seeded with RANDOM().
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "graph-pthread-test \n"
+  "[0, size_t width / 2] : n for 2**n vertices in smallest graph \n"
+  "[0, size_t width / 2] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : random graph generation test on/off \n"
+  "[0, 1] : R-MAT and grid graph generation test on/off \n"
+  "[0, 1] : relabeling test on/off \n"
+  "[0, 1] : batched insertion and deletion test on/off \n"
+  "[0, 1] : transpose test on/off \n"
+  "[0, 1] : sort and dedup test on/off \n";
+const int C_ARGC_ULIMIT = 10;
+const size_t C_ARGS_DEF[9] = {0u, 10u, 4u, 1u, 1u, 1u, 1u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_FULL_BIT = PRECISION_FROM_ULIMIT((size_t)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const double C_PROB_ONE = 1.0;
+const double C_PROB_HALF = 0.5;
+const double C_PROB_ZERO = 0.0;
+const unsigned long C_LCG_MUL = 1103515245ul;
+const unsigned long C_LCG_ADD = 12345ul;
+const unsigned long C_LCG_MASK = 0xfffffffful;
+const double C_LCG_RANGE = 4294967296.0;
+const size_t C_RMAT_EDGE_FACTOR = 16u;
+const double C_RMAT_A = 0.57;
+const double C_RMAT_B = 0.19;
+const double C_RMAT_C = 0.19;
+
+int cmp_adj_lst(const struct adj_lst *a,
+                const struct adj_lst *b,
+                size_t (*read_vt)(const void *));
+int is_simple(const struct adj_lst *a, size_t (*read_vt)(const void *));
+int is_sym(const struct adj_lst *a, size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Test adj_lst_rand_dir_geo_pthread and adj_lst_rand_undir_geo_pthread.
+*/
+
+struct geo_arg{
+  double p;
+  unsigned long x;
+};
+
+size_t geo(void *arg){
+  double k;
+  struct geo_arg *g = arg;
+  if (g->p >= C_PROB_ONE) return 0;
+  if (g->p <= C_PROB_ZERO) return (size_t)-1;
+  g->x = (g->x * C_LCG_MUL + C_LCG_ADD) & C_LCG_MASK;
+  k = floor(log((g->x + 1.0) / C_LCG_RANGE) / log(1.0 - g->p));
+  if (k >= (double)((size_t)-1)) return (size_t)-1;
+  return k;
+}
+
+void geo_args_init(struct geo_arg *gas,
+                   size_t num_threads,
+                   double p,
+                   unsigned long seed){
+  size_t i;
+  for (i = 0; i < num_threads; i++){
+    gas[i].p = p;
+    gas[i].x = (seed + i * C_LCG_ADD) & C_LCG_MASK;
+  }
+}
+
+void rand_geo_pthread_helper(size_t log_start,
+                             size_t log_end,
+                             size_t num_threads,
+                             int is_dir,
+                             void (*rand_build)(struct adj_lst *,
+                                                void (*)(void *, size_t),
+                                                size_t (*)(void *),
+                                                void *),
+                             void (*rand_build_pthread)(
+                               struct adj_lst *,
+                               void (*)(void *, size_t),
+                               size_t (*)(void *),
+                               void *,
+                               size_t,
+                               size_t));
+
+void run_rand_dir_geo_pthread_test(size_t log_start,
+                                   size_t log_end,
+                                   size_t num_threads){
+  printf("Test adj_lst_rand_dir_geo_pthread\n");
+  printf("\tn vertices, E[# of directed edges] = n(n - 1) * (%.1f * 1)\n",
+         C_PROB_HALF);
+  rand_geo_pthread_helper(log_start, log_end, num_threads, 1,
+                          adj_lst_rand_dir_geo,
+                          adj_lst_rand_dir_geo_pthread);
+}
+
+void run_rand_undir_geo_pthread_test(size_t log_start,
+                                     size_t log_end,
+                                     size_t num_threads){
+  printf("Test adj_lst_rand_undir_geo_pthread\n");
+  printf("\tn vertices, E[# of directed edges] = n(n - 1)/2 * (%.1f * 2)\n",
+         C_PROB_HALF);
+  rand_geo_pthread_helper(log_start, log_end, num_threads, 0,
+                          adj_lst_rand_undir_geo,
+                          adj_lst_rand_undir_geo_pthread);
+}
+
+void rand_geo_pthread_helper(size_t log_start,
+                             size_t log_end,
+                             size_t num_threads,
+                             int is_dir,
+                             void (*rand_build)(struct adj_lst *,
+                                                void (*)(void *, size_t),
+                                                size_t (*)(void *),
+                                                void *),
+                             void (*rand_build_pthread)(
+                               struct adj_lst *,
+                               void (*)(void *, size_t),
+                               size_t (*)(void *),
+                               void *,
+                               size_t,
+                               size_t)){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  unsigned long seed;
+  struct graph g;
+  struct adj_lst a, b;
+  struct geo_arg *gas = NULL;
+  clock_t t;
+  gas = malloc_perror(num_threads, sizeof(struct geo_arg));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, expected directed edges: %.1f, "
+           "threads: %lu\n",
+           TOLU(num_vts), C_PROB_HALF * num_vts * (num_vts - 1),
+           TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      /* probability 1/2, serial and multithreaded */
+      geo_args_init(gas, 1, C_PROB_HALF, RANDOM());
+      adj_lst_base_init(&a, &g);
+      t = clock();
+      rand_build(&a, C_WRITE[j], geo, gas);
+      t = clock() - t;
+      printf("\t\t\t%s serial directed edges:        %lu\n",
+             C_VT_TYPES[j], TOLU(a.num_es));
+      printf("\t\t\t%s serial build time:            %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      adj_lst_free(&a);
+      seed = RANDOM();
+      geo_args_init(gas, num_threads, C_PROB_HALF, seed);
+      adj_lst_base_init(&a, &g);
+      t = clock();
+      rand_build_pthread(&a, C_WRITE[j], geo, gas, sizeof(struct geo_arg),
+                         num_threads);
+      t = clock() - t;
+      printf("\t\t\t%s multithreaded directed edges: %lu\n",
+             C_VT_TYPES[j], TOLU(a.num_es));
+      printf("\t\t\t%s multithreaded build time:     %.6f seconds "
+             "(cpu)\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= is_simple(&a, C_READ[j]);
+      if (!is_dir) res *= is_sym(&a, C_READ[j]);
+      /* reproducibility given the seeds and number of threads */
+      geo_args_init(gas, num_threads, C_PROB_HALF, seed);
+      adj_lst_base_init(&b, &g);
+      rand_build_pthread(&b, C_WRITE[j], geo, gas, sizeof(struct geo_arg),
+                         num_threads);
+      res *= cmp_adj_lst(&a, &b, C_READ[j]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      /* probability 1, each vertex is adjacent to all other vertices */
+      geo_args_init(gas, num_threads, C_PROB_ONE, RANDOM());
+      adj_lst_base_init(&a, &g);
+      rand_build_pthread(&a, C_WRITE[j], geo, gas, sizeof(struct geo_arg),
+                         num_threads);
+      res *= (a.num_es == num_vts * (num_vts - 1));
+      res *= is_simple(&a, C_READ[j]);
+      adj_lst_free(&a);
+      /* probability 0 */
+      geo_args_init(gas, num_threads, C_PROB_ZERO, RANDOM());
+      adj_lst_base_init(&a, &g);
+      rand_build_pthread(&a, C_WRITE[j], geo, gas, sizeof(struct geo_arg),
+                         num_threads);
+      res *= (a.num_es == 0);
+      adj_lst_free(&a);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+  free(gas);
+  gas = NULL;
+}
+
+/**
+   Test graph_rmat_pthread and graph_grid_pthread.
+*/
+
+struct quad_arg{
+  unsigned long x;
+};
+
+unsigned long lcg_next(unsigned long *x){
+  *x = (*x * C_LCG_MUL + C_LCG_ADD) & C_LCG_MASK;
+  return *x;
+}
+
+size_t rand_quad(void *arg){
+  double r;
+  struct quad_arg *qa = arg;
+  r = lcg_next(&qa->x) / C_LCG_RANGE;
+  if (r < C_RMAT_A) return 0;
+  if (r < C_RMAT_A + C_RMAT_B) return 1;
+  if (r < C_RMAT_A + C_RMAT_B + C_RMAT_C) return 2;
+  return 3;
+}
+
+void gen_wt_ulong(void *wt, void *arg){
+  struct quad_arg *qa = arg;
+  *(unsigned long *)wt = lcg_next(&qa->x);
+}
+
+void quad_args_init(struct quad_arg *qas,
+                    size_t num_threads,
+                    unsigned long seed){
+  size_t i;
+  for (i = 0; i < num_threads; i++){
+    qas[i].x = (seed + i * C_LCG_ADD) & C_LCG_MASK;
+  }
+}
+
+int cmp_graph(const struct graph *g, const struct graph *h);
+
+void run_rmat_pthread_test(size_t log_start,
+                           size_t log_end,
+                           size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_es;
+  unsigned long seed;
+  struct graph g, h;
+  struct quad_arg *qas = NULL;
+  clock_t t;
+  qas = malloc_perror(num_threads, sizeof(struct quad_arg));
+  printf("Test graph_rmat_pthread\n");
+  printf("\tn vertices, %lu * n directed edges, "
+         "quadrant probabilities %.2f, %.2f, %.2f, %.2f\n",
+         TOLU(C_RMAT_EDGE_FACTOR), C_RMAT_A, C_RMAT_B, C_RMAT_C,
+         1.0 - C_RMAT_A - C_RMAT_B - C_RMAT_C);
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_es = mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts);
+    printf("\t\tvertices: %lu, directed edges: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_es), TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      /* serial and single-threaded generation are equal */
+      seed = RANDOM();
+      quad_args_init(qas, 1, seed);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      t = clock();
+      graph_rmat(&g, num_es, C_WRITE[j], rand_quad, gen_wt_ulong, qas);
+      t = clock() - t;
+      printf("\t\t\t%s serial build time:         %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      quad_args_init(qas, 1, seed);
+      graph_base_init(&h, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_rmat_pthread(&h, num_es, C_WRITE[j], rand_quad, gen_wt_ulong,
+                         qas, sizeof(struct quad_arg), 1);
+      res *= cmp_graph(&g, &h);
+      graph_free(&g);
+      graph_free(&h);
+      /* range of vertices and reproducibility given the number of threads */
+      seed = RANDOM();
+      quad_args_init(qas, num_threads, seed);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      t = clock();
+      graph_rmat_pthread(&g, num_es, C_WRITE[j], rand_quad, gen_wt_ulong,
+                         qas, sizeof(struct quad_arg), num_threads);
+      t = clock() - t;
+      printf("\t\t\t%s multithreaded build time:  %.6f seconds (cpu)\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (g.num_es == num_es);
+      for (k = 0; k < g.num_es; k++){
+        res *= (C_READ[j]((char *)g.u + k * g.vt_size) < num_vts);
+        res *= (C_READ[j]((char *)g.v + k * g.vt_size) < num_vts);
+      }
+      quad_args_init(qas, num_threads, seed);
+      graph_base_init(&h, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_rmat_pthread(&h, num_es, C_WRITE[j], rand_quad, gen_wt_ulong,
+                         qas, sizeof(struct quad_arg), num_threads);
+      res *= cmp_graph(&g, &h);
+      graph_free(&g);
+      graph_free(&h);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+  free(qas);
+  qas = NULL;
+}
+
+void grid_dims(size_t log_num_vts, size_t num_dims, size_t *dims){
+  size_t i;
+  size_t log_rem = log_num_vts;
+  for (i = 0; i < 3; i++){
+    if (i < num_dims){
+      dims[i] = pow_two_perror(log_rem / (num_dims - i));
+      log_rem -= log_rem / (num_dims - i);
+    }else{
+      dims[i] = 1;
+    }
+  }
+}
+
+void run_grid_pthread_test(size_t log_start,
+                           size_t log_end,
+                           size_t num_threads){
+  int res = 1;
+  size_t i, j, d;
+  size_t num_vts;
+  size_t dims[3];
+  unsigned long seed;
+  struct graph g, h;
+  struct quad_arg *qas = NULL;
+  clock_t t;
+  qas = malloc_perror(num_threads, sizeof(struct quad_arg));
+  printf("Test graph_grid_pthread\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    for (d = 2; d <= 3; d++){
+      grid_dims(i, d, dims);
+      printf("\t\t%luD grid %lu x %lu x %lu, threads: %lu\n",
+             TOLU(d), TOLU(dims[0]), TOLU(dims[1]), TOLU(dims[2]),
+             TOLU(num_threads));
+      for (j = 0; j < C_FN_COUNT; j++){
+        /* serial and single-threaded generation are equal */
+        seed = RANDOM();
+        quad_args_init(qas, 1, seed);
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+        t = clock();
+        graph_grid(&g, dims[0], dims[1], dims[2], C_WRITE[j],
+                   gen_wt_ulong, qas);
+        t = clock() - t;
+        printf("\t\t\t%s serial build time:         %.6f seconds\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        quad_args_init(qas, 1, seed);
+        graph_base_init(&h, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+        graph_grid_pthread(&h, dims[0], dims[1], dims[2], C_WRITE[j],
+                           gen_wt_ulong, qas, sizeof(struct quad_arg), 1);
+        res *= cmp_graph(&g, &h);
+        graph_free(&h);
+        /* same edges in the same order across the numbers of threads */
+        quad_args_init(qas, num_threads, seed);
+        graph_base_init(&h, num_vts, C_VT_SIZES[j], 0);
+        t = clock();
+        graph_grid_pthread(&h, dims[0], dims[1], dims[2], C_WRITE[j],
+                           NULL, qas, sizeof(struct quad_arg), num_threads);
+        t = clock() - t;
+        printf("\t\t\t%s multithreaded build time:  %.6f seconds (cpu)\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        g.wt_size = 0;
+        res *= cmp_graph(&g, &h);
+        g.wt_size = sizeof(unsigned long);
+        graph_free(&g);
+        graph_free(&h);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+  free(qas);
+  qas = NULL;
+}
+
+/**
+   Test adj_lst_relabel_pthread on R-MAT graphs with random permutations.
+*/
+
+void run_relabel_pthread_test(size_t log_start,
+                              size_t log_end,
+                              size_t num_threads){
+  int res = 1;
+  size_t i, j, k, tmp;
+  size_t num_vts;
+  size_t *perm = NULL;
+  struct graph g;
+  struct adj_lst a, b, c;
+  struct quad_arg qa;
+  clock_t t;
+  printf("Test adj_lst_relabel_pthread\n");
+  printf("\tn vertices, %lu * n directed edges\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_threads));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    for (k = 0; k < num_vts; k++){
+      perm[k] = k;
+    }
+    for (k = num_vts; k > 1; k--){
+      j = RANDOM() % k;
+      tmp = perm[k - 1];
+      perm[k - 1] = perm[j];
+      perm[j] = tmp;
+    }
+    for (j = 0; j < C_FN_COUNT; j++){
+      quad_args_init(&qa, 1, RANDOM());
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, NULL, &qa);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      adj_lst_base_init(&b, &g);
+      adj_lst_unbound(&b);
+      t = clock();
+      adj_lst_relabel(&b, &a, perm, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s serial relabel time:         %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      adj_lst_base_init(&c, &g);
+      adj_lst_unbound(&c);
+      t = clock();
+      adj_lst_relabel_pthread(&c, &a, perm, C_READ[j], C_WRITE[j],
+                              num_threads);
+      t = clock() - t;
+      printf("\t\t\t%s multithreaded relabel time:  %.6f seconds (cpu)\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= cmp_adj_lst(&b, &c, C_READ[j]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      adj_lst_free(&c);
+      graph_free(&g);
+    }
+    free(perm);
+    perm = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_{dir, undir}_insert_pthread and
+   adj_lst_{dir, undir}_del_pthread on R-MAT and 2D grid graphs. The first
+   half of the edges of a graph is built serially and the second half is
+   inserted with threads, which is tested to result in the adjacency list
+   of the graph. The first half is then deleted serially and with threads,
+   which is tested to result in the same adjacency lists.
+*/
+
+void update_helper(const struct graph *g,
+                   size_t j,
+                   int is_undir,
+                   size_t num_threads,
+                   int *res){
+  struct graph h, k;
+  struct adj_lst a, b, c;
+  clock_t t;
+  void (*build)(struct adj_lst *,
+                const struct graph *,
+                size_t (*)(const void *)) =
+    is_undir ? adj_lst_undir_build : adj_lst_dir_build;
+  void (*del)(struct adj_lst *,
+              const struct graph *,
+              size_t (*)(const void *)) =
+    is_undir ? adj_lst_undir_del : adj_lst_dir_del;
+  /* h and k share the arrays of g */
+  h = *g;
+  k = *g;
+  h.num_es = g->num_es / 2;
+  k.num_es = g->num_es - h.num_es;
+  k.u = (char *)g->u + h.num_es * g->vt_size;
+  k.v = (char *)g->v + h.num_es * g->vt_size;
+  adj_lst_base_init(&a, g);
+  adj_lst_base_init(&b, g);
+  adj_lst_base_init(&c, g);
+  adj_lst_unbound(&a);
+  adj_lst_unbound(&b);
+  adj_lst_unbound(&c);
+  build(&a, g, C_READ[j]);
+  build(&b, &h, C_READ[j]);
+  t = clock();
+  if (is_undir){
+    adj_lst_undir_insert_pthread(&b, &k, C_READ[j], num_threads);
+  }else{
+    adj_lst_dir_insert_pthread(&b, &k, C_READ[j], num_threads);
+  }
+  t = clock() - t;
+  *res *= cmp_adj_lst(&a, &b, C_READ[j]);
+  printf("\t\t\t%s %s insert time:  %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], is_undir ? "undir" : "dir  ",
+         (double)t / CLOCKS_PER_SEC);
+  build(&c, g, C_READ[j]);
+  t = clock();
+  del(&c, &h, C_READ[j]);
+  t = clock() - t;
+  printf("\t\t\t%s %s serial del time:        %.6f seconds\n",
+         C_VT_TYPES[j], is_undir ? "undir" : "dir  ",
+         (double)t / CLOCKS_PER_SEC);
+  t = clock();
+  if (is_undir){
+    adj_lst_undir_del_pthread(&b, &h, C_READ[j], num_threads);
+  }else{
+    adj_lst_dir_del_pthread(&b, &h, C_READ[j], num_threads);
+  }
+  t = clock() - t;
+  printf("\t\t\t%s %s multithreaded del time: %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], is_undir ? "undir" : "dir  ",
+         (double)t / CLOCKS_PER_SEC);
+  *res *= cmp_adj_lst(&b, &c, C_READ[j]);
+  *res *= (b.num_es == a.num_es - h.num_es * (1 + is_undir));
+  adj_lst_free(&a);
+  adj_lst_free(&b);
+  adj_lst_free(&c);
+}
+
+void run_update_pthread_test(size_t log_start,
+                             size_t log_end,
+                             size_t num_threads){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct quad_arg qa;
+  printf("Test batched insertion and deletion with threads\n");
+  printf("\tn vertices, %lu * n directed R-MAT edges, 2D grid\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      quad_args_init(&qa, 1, RANDOM());
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, NULL, &qa);
+      update_helper(&g, j, 0, num_threads, &res);
+      graph_free(&g);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, pow_two_perror(i / 2), pow_two_perror(i - i / 2), 1,
+                 C_WRITE[j], NULL, NULL);
+      update_helper(&g, j, 1, num_threads, &res);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_transpose_pthread on weighted R-MAT graphs by comparing
+   the pairs, including the wt_size blocks, with the result of
+   adj_lst_transpose.
+*/
+
+void run_transpose_pthread_test(size_t log_start,
+                                size_t log_end,
+                                size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a, b, c;
+  struct quad_arg qa;
+  clock_t t;
+  printf("Test adj_lst_transpose_pthread\n");
+  printf("\tn vertices, %lu * n directed edges\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      quad_args_init(&qa, 1, RANDOM());
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, gen_wt_ulong, &qa);
+      adj_lst_base_init(&a, &g);
+      adj_lst_base_init(&b, &g);
+      adj_lst_base_init(&c, &g);
+      adj_lst_unbound(&a);
+      adj_lst_unbound(&b);
+      adj_lst_unbound(&c);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      t = clock();
+      adj_lst_transpose(&b, &a, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s serial transpose time:         %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      t = clock();
+      adj_lst_transpose_pthread(&c, &a, C_READ[j], C_WRITE[j],
+                                num_threads);
+      t = clock() - t;
+      printf("\t\t\t%s multithreaded transpose time:  %.6f seconds "
+             "(cpu)\n", C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (b.num_es == c.num_es);
+      for (k = 0; k < num_vts; k++){
+        res *= (b.vt_wts[k]->num_elts == c.vt_wts[k]->num_elts &&
+                memcmp(b.vt_wts[k]->elts,
+                       c.vt_wts[k]->elts,
+                       b.vt_wts[k]->num_elts * b.pair_size) == 0);
+      }
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      adj_lst_free(&c);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_sort_pthread and adj_lst_dedup_pthread.
+*/
+
+int cmp_vts(const struct adj_lst *a,
+            const struct adj_lst *b,
+            size_t (*read_vt)(const void *)){
+  size_t i, k;
+  const char *p = NULL, *q = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    if (a->vt_wts[i]->num_elts != b->vt_wts[i]->num_elts) return 0;
+    p = a->vt_wts[i]->elts;
+    q = b->vt_wts[i]->elts;
+    for (k = 0; k < a->vt_wts[i]->num_elts; k++){
+      if (read_vt(p) != read_vt(q)) return 0;
+      p += a->pair_size;
+      q += b->pair_size;
+    }
+  }
+  return 1;
+}
+
+void run_sort_dedup_pthread_test(size_t log_start,
+                                 size_t log_end,
+                                 size_t num_threads){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a, b;
+  struct quad_arg qa;
+  clock_t t;
+  printf("Test adj_lst_sort_pthread and adj_lst_dedup_pthread\n");
+  printf("\tn vertices, %lu * n directed edges\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      quad_args_init(&qa, 1, RANDOM());
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, gen_wt_ulong, &qa);
+      adj_lst_base_init(&a, &g);
+      adj_lst_base_init(&b, &g);
+      adj_lst_unbound(&a);
+      adj_lst_unbound(&b);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      adj_lst_dir_build(&b, &g, C_READ[j]);
+      t = clock();
+      adj_lst_sort(&a, C_CMP[j]);
+      adj_lst_dedup(&a, C_CMP[j]);
+      t = clock() - t;
+      printf("\t\t\t%s serial sort and dedup time:         %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      t = clock();
+      adj_lst_sort_pthread(&b, C_CMP[j], num_threads);
+      adj_lst_dedup_pthread(&b, C_CMP[j], num_threads);
+      t = clock() - t;
+      printf("\t\t\t%s multithreaded sort and dedup time:  %.6f seconds "
+             "(cpu)\n", C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (a.num_es == b.num_es);
+      res *= cmp_vts(&a, &b, C_READ[j]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Compares the number of edges and the u, v, and, if wt_size is not 0,
+   wts arrays of two graphs with the same vt_size and wt_size. Returns 1
+   if the graphs are equal, otherwise returns 0.
+*/
+int cmp_graph(const struct graph *g, const struct graph *h){
+  if (g->num_es != h->num_es) return 0;
+  if (g->num_es == 0) return 1;
+  if (memcmp(g->u, h->u, g->num_es * g->vt_size) ||
+      memcmp(g->v, h->v, g->num_es * g->vt_size)) return 0;
+  if (g->wt_size > 0 &&
+      memcmp(g->wts, h->wts, g->num_es * g->wt_size)) return 0;
+  return 1;
+}
+
+/**
+   Compares two unweighted adjacency lists, with the same order of vertices
+   in each list. Returns 1 if the lists are equal, otherwise returns 0.
+*/
+int cmp_adj_lst(const struct adj_lst *a,
+                const struct adj_lst *b,
+                size_t (*read_vt)(const void *)){
+  int res = 1;
+  size_t i, j;
+  const char *p = NULL, *q = NULL;
+  res *= (a->num_vts == b->num_vts);
+  res *= (a->num_es == b->num_es);
+  for (i = 0; res && i < a->num_vts; i++){
+    res *= (a->vt_wts[i]->num_elts == b->vt_wts[i]->num_elts);
+    p = a->vt_wts[i]->elts;
+    q = b->vt_wts[i]->elts;
+    for (j = 0; res && j < a->vt_wts[i]->num_elts; j++){
+      res *= (read_vt(p) == read_vt(q));
+      p += a->pair_size;
+      q += b->pair_size;
+    }
+  }
+  return res;
+}
+
+/**
+   Returns 1 if an adjacency list has no loops and no parallel edges and
+   the number of edges equals the sum of the counts of the lists,
+   otherwise returns 0.
+*/
+int is_simple(const struct adj_lst *a, size_t (*read_vt)(const void *)){
+  int res = 1;
+  size_t i, j, v;
+  size_t num_es = 0;
+  size_t *marks = NULL;
+  const char *p = NULL;
+  marks = calloc_perror(a->num_vts + 1, sizeof(size_t));
+  for (i = 0; res && i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; res && j < a->vt_wts[i]->num_elts; j++){
+      v = read_vt(p);
+      res *= (v != i && v < a->num_vts && marks[v] != i + 1);
+      if (res) marks[v] = i + 1;
+      p += a->pair_size;
+    }
+    num_es += a->vt_wts[i]->num_elts;
+  }
+  res *= (num_es == a->num_es);
+  free(marks);
+  marks = NULL;
+  return res;
+}
+
+/**
+   Returns 1 if the in-degree of each vertex equals its out-degree in an
+   adjacency list, which holds if the list represents an undirected
+   graph, otherwise returns 0.
+*/
+int is_sym(const struct adj_lst *a, size_t (*read_vt)(const void *)){
+  int res = 1;
+  size_t i, j;
+  size_t *in_degs = NULL;
+  const char *p = NULL;
+  in_degs = calloc_perror(a->num_vts + 1, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; j < a->vt_wts[i]->num_elts; j++){
+      in_degs[read_vt(p)]++;
+      p += a->pair_size;
+    }
+  }
+  for (i = 0; i < a->num_vts; i++){
+    res *= (in_degs[i] == a->vt_wts[i]->num_elts);
+  }
+  free(in_degs);
+  in_degs = NULL;
+  return res;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_FULL_BIT / 2 ||
+      args[1] > C_FULL_BIT / 2 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1 ||
+      args[5] > 1 ||
+      args[6] > 1 ||
+      args[7] > 1 ||
+      args[8] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]){
+    run_rand_dir_geo_pthread_test(args[0], args[1], args[2]);
+    run_rand_undir_geo_pthread_test(args[0], args[1], args[2]);
+  }
+  if (args[4]){
+    run_rmat_pthread_test(args[0], args[1], args[2]);
+    run_grid_pthread_test(args[0], args[1], args[2]);
+  }
+  if (args[5]) run_relabel_pthread_test(args[0], args[1], args[2]);
+  if (args[6]) run_update_pthread_test(args[0], args[1], args[2]);
+  if (args[7]) run_transpose_pthread_test(args[0], args[1], args[2]);
+  if (args[8]) run_sort_dedup_pthread_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
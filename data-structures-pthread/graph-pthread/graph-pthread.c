@@ -0,0 +1,1163 @@
+/**
+   graph-pthread.c
+
+   Functions for constructing and transforming graphs with generic integer
+   vertices and generic contiguous weights with multiple threads.
+
+   The functions operate on the graph and adj_lst structs of graph.h. The
+   adjacency list of a vertex is modified only by a single thread at any
+   given time, which is achieved by partitioning the vertices across
+   threads and, where an operation generates pairs for vertices owned
+   by other threads, by buffering the pairs per owner thread and adding
+   them in a subsequent phase after all threads of the first phase are
+   joined. As a result, no locks are acquired on adjacency lists.
+
+   Random generation is reproducible given the random number generator
+   state in the argument of each thread and the number of threads. The
+   user-defined random operations are called by a thread only with the
+   argument of the thread.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "graph-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+/* count of consecutive vertices assigned to a thread in round-robin */
+static const size_t C_VT_BLOCK_COUNT = 64u;
+
+static const size_t C_STACK_INIT_COUNT = 1u;
+static const size_t C_STACK_MAX_COUNT = 0u; /* < init count, unbounded */
+
+static size_t rr_owner(size_t u, size_t num_threads);
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count);
+static size_t grid_prefix(size_t n,
+                          size_t num_x,
+                          size_t num_y,
+                          size_t num_z);
+static size_t last_count(size_t n, size_t m, size_t k);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Builds the adjacency list of a directed graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1) possible edges is added according
+   to a Bernoulli distribution in O(num_vts + num_es) work by geometric
+   skipping, as in adj_lst_rand_dir_geo, with num_threads threads. Each
+   thread builds the adjacency lists of a contiguous range of vertices and
+   calls geo with its own argument in the args array. The effective type
+   of the wt_size blocks is not set, as in adj_lst_rand_dir_geo.
+   a            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init and optionally with adj_lst_align
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   geo          : takes the argument of a thread as the value of its
+                  parameter and returns the number of failures before the
+                  first success in a sequence of independent Bernoulli
+                  trials; please see adj_lst_rand_dir_geo; is called
+                  concurrently by threads with different arguments
+   args         : pointer to an array of num_threads arg_size blocks, where
+                  the ith block is the argument of the ith thread, e.g. the
+                  state of an independent random number generator stream
+   arg_size     : non-zero size of an argument block in the args array
+   num_threads  : > 0 number of threads
+*/
+
+struct rand_dir_arg{
+  size_t start;
+  size_t count;
+  size_t num_es;
+  void *arg;
+  struct adj_lst *a;
+  void (*write_vt)(void *, size_t);
+  size_t (*geo)(void *);
+};
+
+static void *rand_dir_thread(void *arg){
+  size_t i, j, k;
+  void *buf = NULL;
+  struct rand_dir_arg *ra = arg;
+  struct adj_lst *a = ra->a;
+  buf = calloc_perror(1, a->pair_size);
+  for (i = ra->start; i < ra->start + ra->count; i++){
+    /* j is the index of the next possible edge (i, j + (j >= i)) */
+    j = 0;
+    while ((k = ra->geo(ra->arg)) < a->num_vts - 1 - j){
+      j += k;
+      ra->write_vt(buf, j + (j >= i));
+      stack_push(a->vt_wts[i], buf);
+      ra->num_es++;
+      j++;
+    }
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+void adj_lst_rand_dir_geo_pthread(struct adj_lst *a,
+                                  void (*write_vt)(void *, size_t),
+                                  size_t (*geo)(void *),
+                                  void *args,
+                                  size_t arg_size,
+                                  size_t num_threads){
+  size_t i;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  pthread_t *tids = NULL;
+  struct rand_dir_arg *ras = NULL;
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  ras = malloc_perror(num_threads, sizeof(struct rand_dir_arg));
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    ras[i].start = start;
+    ras[i].count = seg_count;
+    ras[i].count += (rem_count > 0 && rem_count--);
+    ras[i].num_es = 0;
+    ras[i].arg = ptr(args, i, arg_size);
+    ras[i].a = a;
+    ras[i].write_vt = write_vt;
+    ras[i].geo = geo;
+    thread_create_perror(&tids[i], rand_dir_thread, &ras[i]);
+    start += ras[i].count;
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    a->num_es += ras[i].num_es;
+  }
+  free(tids);
+  free(ras);
+  tids = NULL;
+  ras = NULL;
+}
+
+/**
+   Builds the adjacency list of an undirected graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1)/2 possible edges is added
+   according to a Bernoulli distribution in O(num_vts + num_es) work by
+   geometric skipping, as in adj_lst_rand_undir_geo, with num_threads
+   threads. The vertices are assigned to threads in blocks of consecutive
+   vertices in a round-robin order, which balances the triangular set of
+   possible (u, v) edges with u < v across threads. A thread generates the
+   edges of its vertices and buffers the (v, u) pairs for the owner
+   threads of v, which add the buffered pairs after all threads completed
+   generation. Please see the parameter specification in
+   adj_lst_rand_dir_geo_pthread.
+*/
+
+struct rand_undir_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t num_es;
+  void *arg;
+  struct stack *bufs; /* num_threads x num_threads (v, u) pair buffers */
+  struct adj_lst *a;
+  void (*write_vt)(void *, size_t);
+  size_t (*geo)(void *);
+};
+
+static void *rand_undir_gen_thread(void *arg){
+  size_t b, i, j, k;
+  size_t end;
+  size_t num_blocks;
+  size_t vu[2];
+  void *buf = NULL;
+  struct rand_undir_arg *ra = arg;
+  struct adj_lst *a = ra->a;
+  struct stack *bufs = &ra->bufs[ra->ix * ra->num_threads];
+  buf = calloc_perror(1, a->pair_size);
+  num_blocks = a->num_vts / C_VT_BLOCK_COUNT +
+    (a->num_vts % C_VT_BLOCK_COUNT > 0);
+  for (b = ra->ix; b < num_blocks; b += ra->num_threads){
+    i = b * C_VT_BLOCK_COUNT;
+    end = i + C_VT_BLOCK_COUNT;
+    if (end > a->num_vts) end = a->num_vts;
+    for (; i < end && i + 1 < a->num_vts; i++){
+      /* j is the next possible end vertex of an (i, j) edge with i < j */
+      j = i + 1;
+      while ((k = ra->geo(ra->arg)) < a->num_vts - j){
+        j += k;
+        ra->write_vt(buf, j);
+        stack_push(a->vt_wts[i], buf);
+        vu[0] = j;
+        vu[1] = i;
+        stack_push(&bufs[rr_owner(j, ra->num_threads)], vu);
+        ra->num_es++;
+        j++;
+      }
+    }
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+static void *rand_undir_add_thread(void *arg){
+  size_t i, j;
+  const size_t *vu = NULL;
+  void *buf = NULL;
+  struct rand_undir_arg *ra = arg;
+  struct adj_lst *a = ra->a;
+  struct stack *s = NULL;
+  buf = calloc_perror(1, a->pair_size);
+  for (i = 0; i < ra->num_threads; i++){
+    s = &ra->bufs[i * ra->num_threads + ra->ix];
+    vu = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      ra->write_vt(buf, vu[1]);
+      stack_push(a->vt_wts[vu[0]], buf);
+      ra->num_es++;
+      vu += 2;
+    }
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+void adj_lst_rand_undir_geo_pthread(struct adj_lst *a,
+                                    void (*write_vt)(void *, size_t),
+                                    size_t (*geo)(void *),
+                                    void *args,
+                                    size_t arg_size,
+                                    size_t num_threads){
+  size_t i;
+  size_t num_bufs = mul_sz_perror(num_threads, num_threads);
+  pthread_t *tids = NULL;
+  struct stack *bufs = NULL;
+  struct rand_undir_arg *ras = NULL;
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  ras = malloc_perror(num_threads, sizeof(struct rand_undir_arg));
+  bufs = malloc_perror(num_bufs, sizeof(struct stack));
+  for (i = 0; i < num_bufs; i++){
+    stack_init(&bufs[i], 2 * sizeof(size_t), NULL);
+    stack_bound(&bufs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  for (i = 0; i < num_threads; i++){
+    ras[i].ix = i;
+    ras[i].num_threads = num_threads;
+    ras[i].num_es = 0;
+    ras[i].arg = ptr(args, i, arg_size);
+    ras[i].bufs = bufs;
+    ras[i].a = a;
+    ras[i].write_vt = write_vt;
+    ras[i].geo = geo;
+    thread_create_perror(&tids[i], rand_undir_gen_thread, &ras[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], rand_undir_add_thread, &ras[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    a->num_es += ras[i].num_es;
+  }
+  for (i = 0; i < num_bufs; i++){
+    stack_free(&bufs[i]);
+  }
+  free(tids);
+  free(ras);
+  free(bufs);
+  tids = NULL;
+  ras = NULL;
+  bufs = NULL;
+}
+
+/**
+   Generates the edges of a graph with num_vts vertices according to the
+   recursive matrix (R-MAT) model, as in graph_rmat, with num_threads
+   threads. Each thread generates a contiguous range of edges and calls
+   rand_quad and gen_wt with its own argument in the args array. The u, v,
+   and wts arrays are allocated by the call and are freed with graph_free.
+   g            : pointer to a graph struct initialized with
+                  graph_base_init
+   num_es       : number of edges
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   rand_quad    : takes the argument of a thread as the value of its
+                  parameter and returns the index of the selected quadrant
+                  in [0, 3]; please see graph_rmat; is called concurrently
+                  by threads with different arguments
+   gen_wt       : - NULL if the graph is not weighted
+                  - otherwise writes a weight value to the wt_size block
+                  pointed to by the first argument and takes the argument
+                  of a thread as the value of its second parameter; is
+                  called concurrently by threads with different arguments
+   args         : pointer to an array of num_threads arg_size blocks, where
+                  the ith block is the argument of the ith thread
+   arg_size     : non-zero size of an argument block in the args array
+   num_threads  : > 0 number of threads
+*/
+
+struct rmat_arg{
+  size_t start;
+  size_t count;
+  void *arg;
+  struct graph *g;
+  void (*write_vt)(void *, size_t);
+  size_t (*rand_quad)(void *);
+  void (*gen_wt)(void *, void *);
+};
+
+static void *rmat_thread(void *arg){
+  size_t i;
+  size_t u, v;
+  struct rmat_arg *ra = arg;
+  for (i = ra->start; i < ra->start + ra->count; i++){
+    graph_rmat_edge(&u, &v, ra->g->num_vts, ra->rand_quad, ra->arg);
+    graph_set_edge(ra->g, i, u, v, ra->write_vt, ra->gen_wt, ra->arg);
+  }
+  return NULL;
+}
+
+void graph_rmat_pthread(struct graph *g,
+                        size_t num_es,
+                        void (*write_vt)(void *, size_t),
+                        size_t (*rand_quad)(void *),
+                        void (*gen_wt)(void *, void *),
+                        void *args,
+                        size_t arg_size,
+                        size_t num_threads){
+  size_t i;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  pthread_t *tids = NULL;
+  struct rmat_arg *ras = NULL;
+  g->num_es = num_es;
+  if (num_es == 0) return;
+  g->u = malloc_perror(num_es, g->vt_size);
+  g->v = malloc_perror(num_es, g->vt_size);
+  if (g->wt_size > 0) g->wts = malloc_perror(num_es, g->wt_size);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  ras = malloc_perror(num_threads, sizeof(struct rmat_arg));
+  seg_count = num_es / num_threads;
+  rem_count = num_es - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    ras[i].start = start;
+    ras[i].count = seg_count;
+    ras[i].count += (rem_count > 0 && rem_count--);
+    ras[i].arg = ptr(args, i, arg_size);
+    ras[i].g = g;
+    ras[i].write_vt = write_vt;
+    ras[i].rand_quad = rand_quad;
+    ras[i].gen_wt = gen_wt;
+    thread_create_perror(&tids[i], rmat_thread, &ras[i]);
+    start += ras[i].count;
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  free(tids);
+  free(ras);
+  tids = NULL;
+  ras = NULL;
+}
+
+/**
+   Generates the edges of a 2D or 3D grid graph with num_x * num_y * num_z
+   vertices, as in graph_grid, with num_threads threads. Each thread
+   generates the edges of a contiguous range of vertices, in the same order
+   as graph_grid, and calls gen_wt with its own argument in the args array.
+   The u, v, and wts arrays are allocated by the call and are freed with
+   graph_free. Please see the parameter specification in graph_grid and
+   graph_rmat_pthread.
+*/
+
+struct grid_arg{
+  size_t start;
+  size_t count;
+  size_t num_x;
+  size_t num_y;
+  size_t num_z;
+  void *arg;
+  struct graph *g;
+  void (*write_vt)(void *, size_t);
+  void (*gen_wt)(void *, void *);
+};
+
+static void *grid_thread(void *arg){
+  size_t i, j;
+  size_t x, y, z;
+  struct grid_arg *ga = arg;
+  size_t xy = ga->num_x * ga->num_y;
+  j = grid_prefix(ga->start, ga->num_x, ga->num_y, ga->num_z);
+  for (i = ga->start; i < ga->start + ga->count; i++){
+    x = i % ga->num_x;
+    y = (i / ga->num_x) % ga->num_y;
+    z = i / xy;
+    if (x + 1 < ga->num_x){
+      graph_set_edge(ga->g, j++, i, i + 1, ga->write_vt, ga->gen_wt,
+                     ga->arg);
+    }
+    if (y + 1 < ga->num_y){
+      graph_set_edge(ga->g, j++, i, i + ga->num_x, ga->write_vt, ga->gen_wt,
+                     ga->arg);
+    }
+    if (z + 1 < ga->num_z){
+      graph_set_edge(ga->g, j++, i, i + xy, ga->write_vt, ga->gen_wt,
+                     ga->arg);
+    }
+  }
+  return NULL;
+}
+
+void graph_grid_pthread(struct graph *g,
+                        size_t num_x,
+                        size_t num_y,
+                        size_t num_z,
+                        void (*write_vt)(void *, size_t),
+                        void (*gen_wt)(void *, void *),
+                        void *args,
+                        size_t arg_size,
+                        size_t num_threads){
+  size_t i;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  pthread_t *tids = NULL;
+  struct grid_arg *gas = NULL;
+  if (g->num_vts != mul_sz_perror(mul_sz_perror(num_x, num_y), num_z)){
+    perror("graph_grid_pthread number of vertices");
+    exit(EXIT_FAILURE);
+  }
+  g->num_es = grid_prefix(g->num_vts, num_x, num_y, num_z);
+  if (g->num_es == 0) return;
+  g->u = malloc_perror(g->num_es, g->vt_size);
+  g->v = malloc_perror(g->num_es, g->vt_size);
+  if (g->wt_size > 0) g->wts = malloc_perror(g->num_es, g->wt_size);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  gas = malloc_perror(num_threads, sizeof(struct grid_arg));
+  seg_count = g->num_vts / num_threads;
+  rem_count = g->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    gas[i].start = start;
+    gas[i].count = seg_count;
+    gas[i].count += (rem_count > 0 && rem_count--);
+    gas[i].num_x = num_x;
+    gas[i].num_y = num_y;
+    gas[i].num_z = num_z;
+    gas[i].arg = ptr(args, i, arg_size);
+    gas[i].g = g;
+    gas[i].write_vt = write_vt;
+    gas[i].gen_wt = gen_wt;
+    thread_create_perror(&tids[i], grid_thread, &gas[i]);
+    start += gas[i].count;
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  free(tids);
+  free(gas);
+  tids = NULL;
+  gas = NULL;
+}
+
+/**
+   Builds the adjacency list b as a copy of the adjacency list a with the
+   vertices relabeled according to a permutation, as in adj_lst_relabel,
+   with num_threads threads. Each thread builds the lists of a contiguous
+   range of new vertex labels by relabeling the lists of the corresponding
+   vertices in a, which are found with the inverse permutation.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges
+   a            : pointer to an adjacency list
+   perm         : pointer to an array of num_vts size_t elements, where
+                  perm[u] is the new label of the vertex u and each value in
+                  [0, num_vts) appears once
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   num_threads  : > 0 number of threads
+*/
+
+struct relabel_arg{
+  size_t start;
+  size_t count;
+  const size_t *perm;
+  const size_t *inv;
+  struct adj_lst *b;
+  const struct adj_lst *a;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+};
+
+static void *relabel_thread(void *arg){
+  size_t i;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  void *buf = NULL;
+  struct relabel_arg *ra = arg;
+  const struct adj_lst *a = ra->a;
+  struct adj_lst *b = ra->b;
+  buf = calloc_perror(1, b->pair_size);
+  for (i = ra->start; i < ra->start + ra->count; i++){
+    p_start = a->vt_wts[ra->inv[i]]->elts;
+    p_end = (char *)p_start +
+      a->vt_wts[ra->inv[i]]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      ra->write_vt(buf, ra->perm[ra->read_vt(p)]);
+      if (a->wt_size > 0){
+        memcpy((char *)buf + b->wt_offset,
+               (char *)p + a->wt_offset,
+               a->wt_size);
+      }
+      stack_push(b->vt_wts[i], buf);
+    }
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+void adj_lst_relabel_pthread(struct adj_lst *b,
+                             const struct adj_lst *a,
+                             const size_t *perm,
+                             size_t (*read_vt)(const void *),
+                             void (*write_vt)(void *, size_t),
+                             size_t num_threads){
+  size_t i;
+  size_t start = 0;
+  size_t seg_count, rem_count;
+  size_t *inv = NULL;
+  pthread_t *tids = NULL;
+  struct relabel_arg *ras = NULL;
+  inv = malloc_perror(a->num_vts, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    inv[perm[i]] = i;
+  }
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  ras = malloc_perror(num_threads, sizeof(struct relabel_arg));
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    ras[i].start = start;
+    ras[i].count = seg_count;
+    ras[i].count += (rem_count > 0 && rem_count--);
+    ras[i].perm = perm;
+    ras[i].inv = inv;
+    ras[i].b = b;
+    ras[i].a = a;
+    ras[i].read_vt = read_vt;
+    ras[i].write_vt = write_vt;
+    thread_create_perror(&tids[i], relabel_thread, &ras[i]);
+    start += ras[i].count;
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  b->num_es = a->num_es;
+  free(inv);
+  free(tids);
+  free(ras);
+  inv = NULL;
+  tids = NULL;
+  ras = NULL;
+}
+
+/**
+   Builds the adjacency list b of the transpose of the graph of the
+   adjacency list a, as in adj_lst_transpose, with num_threads threads.
+   The vertices are split into num_threads contiguous ranges. In the first
+   phase each thread counts the pairs of the lists of its range by the
+   range of their end vertices, the counts are prefix-summed, and in the
+   second phase each thread scatters its pairs into a single array, where
+   the pairs of each range of end vertices are contiguous and in the order
+   of their start vertices. In the third phase each thread pushes the pairs
+   of its range of end vertices onto the lists of b. The result is equal to
+   the result of adj_lst_transpose.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges;
+                  unbounded if an in-degree may exceed num_vts
+   a            : pointer to an adjacency list
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   num_threads  : > 0 number of threads
+*/
+
+struct tr_pair{
+  size_t u;
+  const void *p; /* pair in the list of u in a */
+};
+
+struct transpose_arg{
+  size_t start;
+  size_t count;
+  size_t id;
+  size_t num_threads;
+  size_t seg_count;
+  size_t rem_count;
+  size_t *offsets; /* num_threads * num_threads counts or offsets */
+  struct tr_pair *trs;
+  struct adj_lst *b;
+  const struct adj_lst *a;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+};
+
+static void *transpose_count_thread(void *arg){
+  size_t i;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct transpose_arg *ta = arg;
+  const struct adj_lst *a = ta->a;
+  size_t *counts = &ta->offsets[ta->id * ta->num_threads];
+  for (i = ta->start; i < ta->start + ta->count; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      counts[range_owner(ta->read_vt(p), ta->seg_count, ta->rem_count)]++;
+    }
+  }
+  return NULL;
+}
+
+static void *transpose_scatter_thread(void *arg){
+  size_t i, o;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct transpose_arg *ta = arg;
+  const struct adj_lst *a = ta->a;
+  size_t *offsets = &ta->offsets[ta->id * ta->num_threads];
+  for (i = ta->start; i < ta->start + ta->count; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      o = range_owner(ta->read_vt(p), ta->seg_count, ta->rem_count);
+      ta->trs[offsets[o]].u = i;
+      ta->trs[offsets[o]].p = p;
+      offsets[o]++;
+    }
+  }
+  return NULL;
+}
+
+static void *transpose_push_thread(void *arg){
+  size_t i, start, end;
+  void *buf = NULL;
+  const struct tr_pair *tr = NULL;
+  struct transpose_arg *ta = arg;
+  const struct adj_lst *a = ta->a;
+  struct adj_lst *b = ta->b;
+  /* after scattering, the pairs of the range end at the offsets of the
+     last thread and start at the offsets of the previous range */
+  start = (ta->id == 0) ?
+    0 :
+    ta->offsets[(ta->num_threads - 1) * ta->num_threads + ta->id - 1];
+  end = ta->offsets[(ta->num_threads - 1) * ta->num_threads + ta->id];
+  buf = calloc_perror(1, b->pair_size);
+  for (i = start; i < end; i++){
+    tr = &ta->trs[i];
+    ta->write_vt(buf, tr->u);
+    if (a->wt_size > 0){
+      memcpy((char *)buf + b->wt_offset,
+             (char *)tr->p + a->wt_offset,
+             a->wt_size);
+    }
+    stack_push(b->vt_wts[ta->read_vt(tr->p)], buf);
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+void adj_lst_transpose_pthread(struct adj_lst *b,
+                               const struct adj_lst *a,
+                               size_t (*read_vt)(const void *),
+                               void (*write_vt)(void *, size_t),
+                               size_t num_threads){
+  size_t i, o, t;
+  size_t start = 0, offset = 0, count;
+  size_t seg_count, rem_count, rem;
+  size_t *offsets = NULL;
+  struct tr_pair *trs = NULL;
+  pthread_t *tids = NULL;
+  struct transpose_arg *tas = NULL;
+  if (a->num_es == 0) return;
+  offsets = calloc_perror(mul_sz_perror(num_threads, num_threads),
+                          sizeof(size_t));
+  trs = malloc_perror(a->num_es, sizeof(struct tr_pair));
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  tas = malloc_perror(num_threads, sizeof(struct transpose_arg));
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  rem = rem_count;
+  for (i = 0; i < num_threads; i++){
+    tas[i].start = start;
+    tas[i].count = seg_count;
+    tas[i].count += (rem > 0 && rem--);
+    tas[i].id = i;
+    tas[i].num_threads = num_threads;
+    tas[i].seg_count = seg_count;
+    tas[i].rem_count = rem_count;
+    tas[i].offsets = offsets;
+    tas[i].trs = trs;
+    tas[i].b = b;
+    tas[i].a = a;
+    tas[i].read_vt = read_vt;
+    tas[i].write_vt = write_vt;
+    thread_create_perror(&tids[i], transpose_count_thread, &tas[i]);
+    start += tas[i].count;
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  /* pairs of each range of end vertices are contiguous, by thread */
+  for (o = 0; o < num_threads; o++){
+    for (t = 0; t < num_threads; t++){
+      count = offsets[t * num_threads + o];
+      offsets[t * num_threads + o] = offset;
+      offset += count;
+    }
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], transpose_scatter_thread, &tas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], transpose_push_thread, &tas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+  b->num_es = a->num_es;
+  free(offsets);
+  free(trs);
+  free(tids);
+  free(tas);
+  offsets = NULL;
+  trs = NULL;
+  tids = NULL;
+  tas = NULL;
+}
+
+/**
+   Inserts or deletes a batch of directed edges, or of undirected edges if
+   is_undir is nonzero, with num_threads threads. The ith edge of the batch
+   is represented in the groups by the index i, or by the indices 2i and
+   2i + 1 of its (u, v) and (v, u) directions if is_undir is nonzero. The
+   stable counting sort preserves the order of the edges in each group.
+*/
+
+struct update_arg{
+  size_t start;
+  size_t count;
+  size_t num_es; /* number of inserted or deleted pairs */
+  int is_undir;
+  int is_del;
+  const size_t *offsets;
+  const size_t *ixs;
+  struct adj_lst *a;
+  const struct graph *g;
+  size_t (*read_vt)(const void *);
+};
+
+static void *update_thread(void *arg){
+  size_t i, j, e, start;
+  size_t max_num = 0;
+  size_t *vs = NULL, *cnts = NULL;
+  void *buf = NULL;
+  const void *v = NULL;
+  struct update_arg *ua = arg;
+  struct adj_lst *a = ua->a;
+  const struct graph *g = ua->g;
+  buf = calloc_perror(1, a->pair_size);
+  if (ua->is_del){
+    for (i = ua->start; i < ua->start + ua->count; i++){
+      start = (i == 0) ? 0 : ua->offsets[i - 1];
+      if (ua->offsets[i] - start > max_num) max_num = ua->offsets[i] - start;
+    }
+  }
+  if (max_num > 0){
+    vs = malloc_perror(max_num, sizeof(size_t));
+    cnts = malloc_perror(max_num, sizeof(size_t));
+  }
+  for (i = ua->start; i < ua->start + ua->count; i++){
+    start = (i == 0) ? 0 : ua->offsets[i - 1];
+    for (j = start; j < ua->offsets[i]; j++){
+      e = ua->is_undir ? ua->ixs[j] / 2 : ua->ixs[j];
+      v = (ua->is_undir && ua->ixs[j] % 2) ?
+        ptr(g->u, e, g->vt_size) :
+        ptr(g->v, e, g->vt_size);
+      if (ua->is_del){
+        vs[j - start] = ua->read_vt(v);
+      }else{
+        memcpy(buf, v, a->vt_size);
+        if (a->wt_size > 0 && g->wts != NULL){
+          memcpy((char *)buf + a->wt_offset,
+                 ptr(g->wts, e, g->wt_size),
+                 a->wt_size);
+        }
+        stack_push(a->vt_wts[i], buf);
+      }
+    }
+    if (ua->offsets[i] > start){
+      if (ua->is_del){
+        ua->num_es += adj_lst_vt_del(a,
+                                     i,
+                                     vs,
+                                     ua->offsets[i] - start,
+                                     cnts,
+                                     buf,
+                                     ua->read_vt);
+      }else{
+        ua->num_es += ua->offsets[i] - start;
+      }
+    }
+  }
+  free(buf);
+  free(vs);
+  free(cnts);
+  buf = NULL;
+  vs = NULL;
+  cnts = NULL;
+  return NULL;
+}
+
+static void update_edges(struct adj_lst *a,
+                         const struct graph *g,
+                         size_t (*read_vt)(const void *),
+                         int is_undir,
+                         int is_del,
+                         size_t num_threads){
+  size_t i, u;
+  size_t num, seg_count, rem_count, target;
+  size_t *offsets = NULL, *ixs = NULL;
+  pthread_t *tids = NULL;
+  struct update_arg *uas = NULL;
+  if (g->num_es == 0) return;
+  num = mul_sz_perror(g->num_es, 1 + (is_undir != 0));
+  offsets = calloc_perror(add_sz_perror(a->num_vts, 1), sizeof(size_t));
+  ixs = malloc_perror(num, sizeof(size_t));
+  for (i = 0; i < g->num_es; i++){
+    offsets[read_vt(ptr(g->u, i, g->vt_size)) + 1]++;
+    if (is_undir) offsets[read_vt(ptr(g->v, i, g->vt_size)) + 1]++;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    offsets[i + 1] += offsets[i];
+  }
+  /* after scattering, offsets[u] is the end of the group of u */
+  for (i = 0; i < g->num_es; i++){
+    if (is_undir){
+      ixs[offsets[read_vt(ptr(g->u, i, g->vt_size))]++] = 2 * i;
+      ixs[offsets[read_vt(ptr(g->v, i, g->vt_size))]++] = 2 * i + 1;
+    }else{
+      ixs[offsets[read_vt(ptr(g->u, i, g->vt_size))]++] = i;
+    }
+  }
+  /* contiguous ranges of vertices with about num / num_threads pairs */
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  uas = malloc_perror(num_threads, sizeof(struct update_arg));
+  seg_count = num / num_threads;
+  rem_count = num - seg_count * num_threads;
+  target = 0;
+  u = 0;
+  for (i = 0; i < num_threads; i++){
+    target += seg_count;
+    target += (rem_count > 0 && rem_count--);
+    uas[i].start = u;
+    while (u < a->num_vts && (offsets[u] <= target || i == num_threads - 1)){
+      u++;
+    }
+    uas[i].count = u - uas[i].start;
+    uas[i].num_es = 0;
+    uas[i].is_undir = is_undir;
+    uas[i].is_del = is_del;
+    uas[i].offsets = offsets;
+    uas[i].ixs = ixs;
+    uas[i].a = a;
+    uas[i].g = g;
+    uas[i].read_vt = read_vt;
+    thread_create_perror(&tids[i], update_thread, &uas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    if (is_del){
+      a->num_es -= uas[i].num_es;
+    }else{
+      a->num_es += uas[i].num_es;
+    }
+  }
+  free(offsets);
+  free(ixs);
+  free(tids);
+  free(uas);
+  offsets = NULL;
+  ixs = NULL;
+  tids = NULL;
+  uas = NULL;
+}
+
+/**
+   Inserts a batch of directed edges into the adjacency list of a directed
+   graph with num_threads threads. The edges of the graph g are grouped by
+   u with a counting sort in O(num_vts + num_es) time, and each thread
+   pushes the pairs of the groups of a contiguous range of vertices with
+   about the same number of edges. The order of the pushed pairs in each
+   list is the order of the edges in g, and the result is equal to the
+   result of adj_lst_dir_build. If the graph is weighted, the effective
+   type of the copied wt_size blocks is kept as in adj_lst_dir_build.
+   a            : pointer to an adjacency list; unbounded with
+                  adj_lst_unbound if a list may exceed num_vts pairs
+   g            : pointer to the graph struct of a graph with the same
+                  num_vts, vt_size, and wt_size as the adjacency list, with
+                  the edges to be inserted
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dir_insert_pthread(struct adj_lst *a,
+                                const struct graph *g,
+                                size_t (*read_vt)(const void *),
+                                size_t num_threads){
+  update_edges(a, g, read_vt, 0, 0, num_threads);
+}
+
+/**
+   Inserts a batch of undirected edges into the adjacency list of an
+   undirected graph with num_threads threads, where the pairs of each (u, v)
+   edge in g are pushed onto the lists of u and v. The result is equal to
+   the result of adj_lst_undir_build. Please see the specification of
+   adj_lst_dir_insert_pthread.
+*/
+void adj_lst_undir_insert_pthread(struct adj_lst *a,
+                                  const struct graph *g,
+                                  size_t (*read_vt)(const void *),
+                                  size_t num_threads){
+  update_edges(a, g, read_vt, 1, 0, num_threads);
+}
+
+/**
+   Deletes a batch of directed edges from the adjacency list of a directed
+   graph with num_threads threads, as in adj_lst_dir_del. The edges of the
+   graph g are grouped by u with a counting sort, and each thread sorts the
+   end vertices of the groups of a contiguous range of vertices with about
+   the same number of edges and scans each list in the range once, where
+   a pair is removed by moving the last pair of the list into its place.
+   The result is equal to the result of adj_lst_dir_del.
+   a            : pointer to an adjacency list
+   g            : pointer to the graph struct of a graph with the same
+                  num_vts and vt_size as the adjacency list, with the edges
+                  to be deleted
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dir_del_pthread(struct adj_lst *a,
+                             const struct graph *g,
+                             size_t (*read_vt)(const void *),
+                             size_t num_threads){
+  update_edges(a, g, read_vt, 0, 1, num_threads);
+}
+
+/**
+   Deletes a batch of undirected edges from the adjacency list of an
+   undirected graph with num_threads threads, as in adj_lst_undir_del. The
+   result is equal to the result of adj_lst_undir_del. Please see the
+   specification of adj_lst_dir_del_pthread.
+*/
+void adj_lst_undir_del_pthread(struct adj_lst *a,
+                               const struct graph *g,
+                               size_t (*read_vt)(const void *),
+                               size_t num_threads){
+  update_edges(a, g, read_vt, 1, 1, num_threads);
+}
+
+/**
+   Sorts or, if is_dedup is nonzero, deduplicates the lists of an
+   adjacency list with num_threads threads, where each thread processes a
+   contiguous range of vertices with about the same number of pairs.
+*/
+
+struct sort_arg{
+  size_t start;
+  size_t count;
+  size_t num_es; /* number of removed pairs */
+  int is_dedup;
+  struct adj_lst *a;
+  int (*cmp_vt)(const void *, const void *);
+};
+
+static void *sort_thread(void *arg){
+  size_t i;
+  void *buf = NULL;
+  struct sort_arg *sa = arg;
+  struct adj_lst *a = sa->a;
+  buf = calloc_perror(1, a->pair_size);
+  for (i = sa->start; i < sa->start + sa->count; i++){
+    if (sa->is_dedup){
+      sa->num_es += adj_lst_vt_dedup(a, i, buf, sa->cmp_vt);
+    }else{
+      adj_lst_vt_sort(a, i, sa->cmp_vt);
+    }
+  }
+  free(buf);
+  buf = NULL;
+  return NULL;
+}
+
+static void sort_lsts(struct adj_lst *a,
+                      int (*cmp_vt)(const void *, const void *),
+                      int is_dedup,
+                      size_t num_threads){
+  size_t i, u;
+  size_t num = 0, seg_count, rem_count, target, cum;
+  pthread_t *tids = NULL;
+  struct sort_arg *sas = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    num += a->vt_wts[i]->num_elts;
+  }
+  /* contiguous ranges of vertices with about num / num_threads pairs */
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(struct sort_arg));
+  seg_count = num / num_threads;
+  rem_count = num - seg_count * num_threads;
+  target = 0;
+  cum = 0;
+  u = 0;
+  for (i = 0; i < num_threads; i++){
+    target += seg_count;
+    target += (rem_count > 0 && rem_count--);
+    sas[i].start = u;
+    while (u < a->num_vts &&
+           (cum + a->vt_wts[u]->num_elts <= target ||
+            i == num_threads - 1)){
+      cum += a->vt_wts[u]->num_elts;
+      u++;
+    }
+    sas[i].count = u - sas[i].start;
+    sas[i].num_es = 0;
+    sas[i].is_dedup = is_dedup;
+    sas[i].a = a;
+    sas[i].cmp_vt = cmp_vt;
+    thread_create_perror(&tids[i], sort_thread, &sas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    a->num_es -= sas[i].num_es;
+  }
+  free(tids);
+  free(sas);
+  tids = NULL;
+  sas = NULL;
+}
+
+/**
+   Sorts the pairs of each list of an adjacency list in the non-decreasing
+   order of vertices according to cmp_vt, as in adj_lst_sort, with
+   num_threads threads. Each thread sorts the lists of a contiguous range
+   of vertices with about the same number of pairs. The order of the pairs
+   with the same vertex is unspecified.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns a negative integer
+                  value if the value in the vt_size block pointed to by the
+                  first argument is less than the value in the vt_size
+                  block pointed to by the second argument, a positive
+                  integer value if the former is greater than the latter,
+                  and zero otherwise
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_sort_pthread(struct adj_lst *a,
+                          int (*cmp_vt)(const void *, const void *),
+                          size_t num_threads){
+  sort_lsts(a, cmp_vt, 0, num_threads);
+}
+
+/**
+   Removes the duplicate pairs from each list of an adjacency list, where
+   the pairs with the same vertex are consecutive in each list, e.g. after
+   adj_lst_sort_pthread, as in adj_lst_dedup, with num_threads threads.
+   Each thread processes the lists of a contiguous range of vertices with
+   about the same number of pairs, and num_es is decreased by the total
+   number of removed pairs after the threads are joined. The result is
+   equal to the result of adj_lst_dedup.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns zero if and only if
+                  the values in the vt_size blocks pointed to by the two
+                  arguments are equal
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dedup_pthread(struct adj_lst *a,
+                           int (*cmp_vt)(const void *, const void *),
+                           size_t num_threads){
+  sort_lsts(a, cmp_vt, 1, num_threads);
+}
+
+/**
+   Returns the thread that owns a vertex if blocks of C_VT_BLOCK_COUNT
+   consecutive vertices are assigned to threads in a round-robin order.
+*/
+static size_t rr_owner(size_t u, size_t num_threads){
+  return (u / C_VT_BLOCK_COUNT) % num_threads;
+}
+
+/**
+   Returns the thread that owns a vertex if the vertices are split into
+   contiguous ranges, where the first rem_count threads own seg_count + 1
+   vertices and the other threads own seg_count vertices.
+*/
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count){
+  if (u < rem_count * (seg_count + 1)) return u / (seg_count + 1);
+  return rem_count + (u - rem_count * (seg_count + 1)) / seg_count;
+}
+
+/**
+   Returns the number of grid edges of the vertices in [0, n). A vertex
+   i has an edge along an axis unless it is on the last plane of the axis,
+   i.e. unless i mod m >= m - k, where m and k are the numbers of vertices
+   in a block and in its last plane along the axis.
+*/
+static size_t grid_prefix(size_t n,
+                          size_t num_x,
+                          size_t num_y,
+                          size_t num_z){
+  size_t xy = num_x * num_y;
+  return (mul_sz_perror(3, n) -
+          last_count(n, num_x, 1) -
+          last_count(n, xy, num_x) -
+          last_count(n, xy * num_z, xy));
+}
+
+/**
+   Returns the number of i in [0, n) with i mod m >= m - k, where
+   0 < k <= m.
+*/
+static size_t last_count(size_t n, size_t m, size_t k){
+  size_t rem = n % m;
+  return (n / m) * k + (rem > m - k ? rem - (m - k) : 0);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
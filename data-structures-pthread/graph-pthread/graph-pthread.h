@@ -0,0 +1,308 @@
+/**
+   graph-pthread.h
+
+   Declarations of accessible functions for constructing and transforming
+   graphs with generic integer vertices and generic contiguous weights
+   with multiple threads.
+
+   The functions operate on the graph and adj_lst structs of graph.h. The
+   adjacency list of a vertex is modified only by a single thread at any
+   given time, which is achieved by partitioning the vertices across
+   threads and, where an operation generates pairs for vertices owned
+   by other threads, by buffering the pairs per owner thread and adding
+   them in a subsequent phase after all threads of the first phase are
+   joined. As a result, no locks are acquired on adjacency lists.
+
+   Random generation is reproducible given the random number generator
+   state in the argument of each thread and the number of threads. The
+   user-defined random operations are called by a thread only with the
+   argument of the thread.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef GRAPH_PTHREAD_H
+#define GRAPH_PTHREAD_H
+
+#define _XOPEN_SOURCE 600
+
+#include <stddef.h>
+#include <pthread.h>
+#include "graph.h"
+
+/**
+   Builds the adjacency list of a directed graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1) possible edges is added according
+   to a Bernoulli distribution in O(num_vts + num_es) work by geometric
+   skipping, as in adj_lst_rand_dir_geo, with num_threads threads. Each
+   thread builds the adjacency lists of a contiguous range of vertices and
+   calls geo with its own argument in the args array. The effective type
+   of the wt_size blocks is not set, as in adj_lst_rand_dir_geo.
+   a            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init and optionally with adj_lst_align
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   geo          : takes the argument of a thread as the value of its
+                  parameter and returns the number of failures before the
+                  first success in a sequence of independent Bernoulli
+                  trials; please see adj_lst_rand_dir_geo; is called
+                  concurrently by threads with different arguments
+   args         : pointer to an array of num_threads arg_size blocks, where
+                  the ith block is the argument of the ith thread, e.g. the
+                  state of an independent random number generator stream
+   arg_size     : non-zero size of an argument block in the args array
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_rand_dir_geo_pthread(struct adj_lst *a,
+                                  void (*write_vt)(void *, size_t),
+                                  size_t (*geo)(void *),
+                                  void *args,
+                                  size_t arg_size,
+                                  size_t num_threads);
+
+/**
+   Builds the adjacency list of an undirected graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1)/2 possible edges is added
+   according to a Bernoulli distribution in O(num_vts + num_es) work by
+   geometric skipping, as in adj_lst_rand_undir_geo, with num_threads
+   threads. The vertices are assigned to threads in blocks of consecutive
+   vertices in a round-robin order, which balances the triangular set of
+   possible (u, v) edges with u < v across threads. A thread generates the
+   edges of its vertices and buffers the (v, u) pairs for the owner
+   threads of v, which add the buffered pairs after all threads completed
+   generation. Please see the parameter specification in
+   adj_lst_rand_dir_geo_pthread.
+*/
+void adj_lst_rand_undir_geo_pthread(struct adj_lst *a,
+                                    void (*write_vt)(void *, size_t),
+                                    size_t (*geo)(void *),
+                                    void *args,
+                                    size_t arg_size,
+                                    size_t num_threads);
+
+/**
+   Generates the edges of a graph with num_vts vertices according to the
+   recursive matrix (R-MAT) model, as in graph_rmat, with num_threads
+   threads. Each thread generates a contiguous range of edges and calls
+   rand_quad and gen_wt with its own argument in the args array. The u, v,
+   and wts arrays are allocated by the call and are freed with graph_free.
+   g            : pointer to a graph struct initialized with
+                  graph_base_init
+   num_es       : number of edges
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   rand_quad    : takes the argument of a thread as the value of its
+                  parameter and returns the index of the selected quadrant
+                  in [0, 3]; please see graph_rmat; is called concurrently
+                  by threads with different arguments
+   gen_wt       : - NULL if the graph is not weighted
+                  - otherwise writes a weight value to the wt_size block
+                  pointed to by the first argument and takes the argument
+                  of a thread as the value of its second parameter; is
+                  called concurrently by threads with different arguments
+   args         : pointer to an array of num_threads arg_size blocks, where
+                  the ith block is the argument of the ith thread
+   arg_size     : non-zero size of an argument block in the args array
+   num_threads  : > 0 number of threads
+*/
+void graph_rmat_pthread(struct graph *g,
+                        size_t num_es,
+                        void (*write_vt)(void *, size_t),
+                        size_t (*rand_quad)(void *),
+                        void (*gen_wt)(void *, void *),
+                        void *args,
+                        size_t arg_size,
+                        size_t num_threads);
+
+/**
+   Generates the edges of a 2D or 3D grid graph with num_x * num_y * num_z
+   vertices, as in graph_grid, with num_threads threads. Each thread
+   generates the edges of a contiguous range of vertices, in the same order
+   as graph_grid, and calls gen_wt with its own argument in the args array.
+   The u, v, and wts arrays are allocated by the call and are freed with
+   graph_free. Please see the parameter specification in graph_grid and
+   graph_rmat_pthread.
+*/
+void graph_grid_pthread(struct graph *g,
+                        size_t num_x,
+                        size_t num_y,
+                        size_t num_z,
+                        void (*write_vt)(void *, size_t),
+                        void (*gen_wt)(void *, void *),
+                        void *args,
+                        size_t arg_size,
+                        size_t num_threads);
+
+/**
+   Builds the adjacency list b as a copy of the adjacency list a with the
+   vertices relabeled according to a permutation, as in adj_lst_relabel,
+   with num_threads threads. Each thread builds the lists of a contiguous
+   range of new vertex labels by relabeling the lists of the corresponding
+   vertices in a, which are found with the inverse permutation.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges
+   a            : pointer to an adjacency list
+   perm         : pointer to an array of num_vts size_t elements, where
+                  perm[u] is the new label of the vertex u and each value in
+                  [0, num_vts) appears once
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_relabel_pthread(struct adj_lst *b,
+                             const struct adj_lst *a,
+                             const size_t *perm,
+                             size_t (*read_vt)(const void *),
+                             void (*write_vt)(void *, size_t),
+                             size_t num_threads);
+
+/**
+   Inserts a batch of directed edges into the adjacency list of a directed
+   graph with num_threads threads. The edges of the graph g are grouped by
+   u with a counting sort in O(num_vts + num_es) time, and each thread
+   pushes the pairs of the groups of a contiguous range of vertices with
+   about the same number of edges. The order of the pushed pairs in each
+   list is the order of the edges in g, and the result is equal to the
+   result of adj_lst_dir_build. If the graph is weighted, the effective
+   type of the copied wt_size blocks is kept as in adj_lst_dir_build.
+   a            : pointer to an adjacency list; unbounded with
+                  adj_lst_unbound if a list may exceed num_vts pairs
+   g            : pointer to the graph struct of a graph with the same
+                  num_vts, vt_size, and wt_size as the adjacency list, with
+                  the edges to be inserted
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dir_insert_pthread(struct adj_lst *a,
+                                const struct graph *g,
+                                size_t (*read_vt)(const void *),
+                                size_t num_threads);
+
+/**
+   Inserts a batch of undirected edges into the adjacency list of an
+   undirected graph with num_threads threads, where the pairs of each (u, v)
+   edge in g are pushed onto the lists of u and v. The result is equal to
+   the result of adj_lst_undir_build. Please see the specification of
+   adj_lst_dir_insert_pthread.
+*/
+void adj_lst_undir_insert_pthread(struct adj_lst *a,
+                                  const struct graph *g,
+                                  size_t (*read_vt)(const void *),
+                                  size_t num_threads);
+
+/**
+   Deletes a batch of directed edges from the adjacency list of a directed
+   graph with num_threads threads, as in adj_lst_dir_del. The edges of the
+   graph g are grouped by u with a counting sort, and each thread sorts the
+   end vertices of the groups of a contiguous range of vertices with about
+   the same number of edges and scans each list in the range once, where
+   a pair is removed by moving the last pair of the list into its place.
+   The result is equal to the result of adj_lst_dir_del.
+   a            : pointer to an adjacency list
+   g            : pointer to the graph struct of a graph with the same
+                  num_vts and vt_size as the adjacency list, with the edges
+                  to be deleted
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dir_del_pthread(struct adj_lst *a,
+                             const struct graph *g,
+                             size_t (*read_vt)(const void *),
+                             size_t num_threads);
+
+/**
+   Deletes a batch of undirected edges from the adjacency list of an
+   undirected graph with num_threads threads, as in adj_lst_undir_del. The
+   result is equal to the result of adj_lst_undir_del. Please see the
+   specification of adj_lst_dir_del_pthread.
+*/
+void adj_lst_undir_del_pthread(struct adj_lst *a,
+                               const struct graph *g,
+                               size_t (*read_vt)(const void *),
+                               size_t num_threads);
+
+/**
+   Builds the adjacency list b of the transpose of the graph of the
+   adjacency list a, as in adj_lst_transpose, with num_threads threads.
+   The vertices are split into num_threads contiguous ranges. In the first
+   phase each thread counts the pairs of the lists of its range by the
+   range of their end vertices, the counts are prefix-summed, and in the
+   second phase each thread scatters its pairs into a single array, where
+   the pairs of each range of end vertices are contiguous and in the order
+   of their start vertices. In the third phase each thread pushes the pairs
+   of its range of end vertices onto the lists of b. The result is equal to
+   the result of adj_lst_transpose.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges;
+                  unbounded if an in-degree may exceed num_vts
+   a            : pointer to an adjacency list
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_transpose_pthread(struct adj_lst *b,
+                               const struct adj_lst *a,
+                               size_t (*read_vt)(const void *),
+                               void (*write_vt)(void *, size_t),
+                               size_t num_threads);
+
+/**
+   Sorts the pairs of each list of an adjacency list in the non-decreasing
+   order of vertices according to cmp_vt, as in adj_lst_sort, with
+   num_threads threads. Each thread sorts the lists of a contiguous range
+   of vertices with about the same number of pairs. The order of the pairs
+   with the same vertex is unspecified.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns a negative integer
+                  value if the value in the vt_size block pointed to by the
+                  first argument is less than the value in the vt_size
+                  block pointed to by the second argument, a positive
+                  integer value if the former is greater than the latter,
+                  and zero otherwise
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_sort_pthread(struct adj_lst *a,
+                          int (*cmp_vt)(const void *, const void *),
+                          size_t num_threads);
+
+/**
+   Removes the duplicate pairs from each list of an adjacency list, where
+   the pairs with the same vertex are consecutive in each list, e.g. after
+   adj_lst_sort_pthread, as in adj_lst_dedup, with num_threads threads.
+   Each thread processes the lists of a contiguous range of vertices with
+   about the same number of pairs, and num_es is decreased by the total
+   number of removed pairs after the threads are joined. The result is
+   equal to the result of adj_lst_dedup.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns zero if and only if
+                  the values in the vt_size blocks pointed to by the two
+                  arguments are equal
+   num_threads  : > 0 number of threads
+*/
+void adj_lst_dedup_pthread(struct adj_lst *a,
+                           int (*cmp_vt)(const void *, const void *),
+                           size_t num_threads);
+
+#endif
@@ -0,0 +1,256 @@
+/**
+   graph-cmpr-test.c
+
+   Tests of compressed adjacency lists across graphs with different
+   integer types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   graph-cmpr-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./graph-cmpr-test
+   ./graph-cmpr-test 10 14
+   ./graph-cmpr-test 14 18 0 1
+
+   graph-cmpr-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "graph-cmpr.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "graph-cmpr-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 14u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTOR = 16u;
+
+int cmp_sz(const void *a, const void *b);
+void print_test_result(int res);
+
+/**
+   Test helper shared by grid and R-MAT graph tests. The vertices decoded
+   from each list of a compressed adjacency list are tested to be equal to
+   the sorted vertices of the list of the adjacency list, and the sizes
+   of both representations are printed.
+*/
+
+void cmpr_helper(const struct adj_lst *a, size_t j, int *res){
+  size_t i, k, v;
+  size_t num, max_num = 0;
+  size_t lst_size, cmpr_size;
+  size_t *vts = NULL;
+  struct adj_cmpr c;
+  struct adj_cmpr_iter it;
+  clock_t t;
+  for (i = 0; i < a->num_vts; i++){
+    if (a->vt_wts[i]->num_elts > max_num) max_num = a->vt_wts[i]->num_elts;
+  }
+  vts = malloc_perror(add_sz_perror(max_num, 1), sizeof(size_t));
+  t = clock();
+  adj_cmpr_init(&c, a, C_READ[j]);
+  t = clock() - t;
+  *res *= (c.num_vts == a->num_vts &&
+           c.num_es == a->num_es &&
+           c.vt_size == a->vt_size);
+  for (i = 0; i < a->num_vts; i++){
+    num = a->vt_wts[i]->num_elts;
+    for (k = 0; k < num; k++){
+      vts[k] = C_READ[j]((char *)a->vt_wts[i]->elts + k * a->pair_size);
+    }
+    qsort(vts, num, sizeof(size_t), cmp_sz);
+    adj_cmpr_iter_init(&it, &c, i);
+    k = 0;
+    while (adj_cmpr_iter_next(&it, &v)){
+      *res *= (k < num && vts[k] == v);
+      k++;
+    }
+    *res *= (k == num);
+    v = a->num_vts;
+    *res *= (!adj_cmpr_iter_next(&it, &v) && v == a->num_vts);
+  }
+  lst_size = a->num_es * a->pair_size;
+  cmpr_size = c.offsets[c.num_vts];
+  printf("\t\t\t%s init time:       %.6f seconds\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  printf("\t\t\t%s pairs:           %lu bytes, encoded: %lu bytes, "
+         "ratio: %.3f\n",
+         C_VT_TYPES[j], TOLU(lst_size), TOLU(cmpr_size),
+         (cmpr_size == 0) ? 0.0 : (double)lst_size / cmpr_size);
+  adj_cmpr_free(&c);
+  free(vts);
+  vts = NULL;
+}
+
+/**
+   Run tests on unweighted 2D grid graphs, where the gaps are small.
+*/
+
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_x, num_y;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test adj_cmpr_ operations on unweighted 2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_x * num_y, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      cmpr_helper(&a, j, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on directed R-MAT multigraphs with size_t weights, where the
+   gaps are large and the weights are ignored by the encoding.
+*/
+
+void gen_wt(void *wt, void *arg){
+  (void)arg;
+  *(size_t *)wt = RANDOM();
+}
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test adj_cmpr_ operations on weighted R-MAT graphs\n");
+  printf("\tn vertices, %lu * n directed edges\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(size_t));
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, gen_wt, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      cmpr_helper(&a, j, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+int cmp_sz(const void *a, const void *b){
+  if (*(const size_t *)a > *(const size_t *)b){
+    return 1;
+  }else if (*(const size_t *)a < *(const size_t *)b){
+    return -1;
+  }else{
+    return 0;
+  }
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
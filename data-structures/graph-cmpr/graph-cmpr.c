@@ -0,0 +1,196 @@
+/**
+   graph-cmpr.c
+
+   Functions for a read-only compressed representation of the adjacency
+   list of a graph with generic integer vertices indexed from 0.
+
+   The list of each vertex is sorted in the non-decreasing order of
+   vertices and is stored as a sequence of gaps between consecutive
+   vertices, where the first gap is the first vertex. Each gap is encoded
+   as a variable-length integer in a sequence of bytes, with the seven low
+   order bits of a byte representing the next seven bits of the gap in the
+   little-endian order and the high order bit set if the gap continues in
+   the next byte. The encoded lists are stored contiguously in a single
+   block of bytes, and the list of a vertex is located by an array of
+   offsets. As a result, a gap below 128 is stored in a single byte,
+   independently of the integer type used to represent vertices.
+
+   The weights of a graph are not represented. The vertices in a list are
+   read in the non-decreasing order with an iterator, and the compressed
+   representation can be used by graph algorithms that do not depend on the
+   order of vertices in a list, such as bfs_cmpr and dfs_cmpr in
+   graph-algorithms/search-cmpr.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph-cmpr.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static const size_t C_BYTES_INIT_COUNT = 64;
+static const unsigned char C_LOW_MASK = 0x7f;
+static const unsigned char C_CONT_BIT = 0x80;
+static const size_t C_LOW_BIT = 7;
+
+static void encode(unsigned char **bytes,
+                   size_t *count,
+                   size_t *alloc_count,
+                   size_t x);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Initializes a compressed adjacency list according to an adjacency list.
+   The adjacency list is not modified and can be freed after the call is
+   completed. The number of bytes in the encoded lists can be read as
+   offsets[num_vts] after the call.
+   c           : pointer to a preallocated block of size
+                 sizeof(struct adj_cmpr)
+   a           : pointer to an adjacency list
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void adj_cmpr_init(struct adj_cmpr *c,
+                   const struct adj_lst *a,
+                   size_t (*read_vt)(const void *)){
+  size_t i, j;
+  size_t max_num = 0;
+  size_t count = 0;
+  size_t alloc_count = 0;
+  size_t *vts = NULL;
+  const struct stack *s = NULL;
+  c->num_vts = a->num_vts;
+  c->num_es = a->num_es;
+  c->vt_size = a->vt_size;
+  c->offsets = malloc_perror(add_sz_perror(a->num_vts, 1), sizeof(size_t));
+  c->bytes = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    if (a->vt_wts[i]->num_elts > max_num) max_num = a->vt_wts[i]->num_elts;
+  }
+  if (max_num > 0){
+    vts = malloc_perror(max_num, sizeof(size_t));
+    c->bytes = malloc_perror(C_BYTES_INIT_COUNT, 1);
+    alloc_count = C_BYTES_INIT_COUNT;
+  }
+  c->offsets[0] = 0;
+  for (i = 0; i < a->num_vts; i++){
+    s = a->vt_wts[i];
+    for (j = 0; j < s->num_elts; j++){
+      vts[j] = read_vt(ptr(s->elts, j, a->pair_size));
+    }
+    if (s->num_elts > 1){
+      qsort(vts, s->num_elts, sizeof(size_t), graph_cmp_sz);
+    }
+    for (j = 0; j < s->num_elts; j++){
+      encode(&c->bytes, &count, &alloc_count,
+             (j == 0) ? vts[j] : vts[j] - vts[j - 1]);
+    }
+    c->offsets[i + 1] = count;
+  }
+  if (count > 0){
+    c->bytes = realloc_perror(c->bytes, count, 1);
+  }else if (c->bytes != NULL){
+    free(c->bytes);
+    c->bytes = NULL;
+  }
+  free(vts);
+  vts = NULL;
+}
+
+/**
+   Initializes an iterator across the list of a vertex. The iterator is
+   valid until the compressed adjacency list is freed.
+   it          : pointer to a preallocated block of size
+                 sizeof(struct adj_cmpr_iter)
+   c           : pointer to an initialized compressed adjacency list
+   u           : vertex in [0, num_vts)
+*/
+void adj_cmpr_iter_init(struct adj_cmpr_iter *it,
+                        const struct adj_cmpr *c,
+                        size_t u){
+  /* no pointer arithmetic on a NULL block of a graph with no edges */
+  if (c->bytes == NULL){
+    it->p = NULL;
+    it->end = NULL;
+  }else{
+    it->p = c->bytes + c->offsets[u];
+    it->end = c->bytes + c->offsets[u + 1];
+  }
+  it->v = 0;
+}
+
+/**
+   Reads the next vertex in a list into the size_t object pointed to by
+   v and returns 1, or returns 0 if all vertices in the list were read, in
+   which case the object pointed to by v remains unchanged.
+   it          : pointer to an iterator initialized with adj_cmpr_iter_init
+   v           : pointer to a preallocated size_t object
+*/
+int adj_cmpr_iter_next(struct adj_cmpr_iter *it, size_t *v){
+  size_t x = 0;
+  size_t shift = 0;
+  const unsigned char *p = it->p;
+  if (p == it->end) return 0;
+  while (*p & C_CONT_BIT){
+    x |= (size_t)(*p & C_LOW_MASK) << shift;
+    shift += C_LOW_BIT;
+    p++;
+  }
+  x |= (size_t)*p << shift;
+  it->p = p + 1;
+  it->v += x;
+  *v = it->v;
+  return 1;
+}
+
+/**
+   Frees the memory allocated by adj_cmpr_init and leaves a block of size
+   sizeof(struct adj_cmpr) pointed to by the c parameter.
+*/
+void adj_cmpr_free(struct adj_cmpr *c){
+  free(c->offsets);
+  free(c->bytes);
+  c->offsets = NULL;
+  c->bytes = NULL;
+}
+
+/**
+   Appends the variable-length encoding of a size_t value to a block of
+   bytes, where count is the number of used bytes and alloc_count is the
+   number of allocated bytes, and doubles the block if necessary.
+*/
+static void encode(unsigned char **bytes,
+                   size_t *count,
+                   size_t *alloc_count,
+                   size_t x){
+  do{
+    if (*count == *alloc_count){
+      *alloc_count = mul_sz_perror(*alloc_count, 2);
+      *bytes = realloc_perror(*bytes, *alloc_count, 1);
+    }
+    (*bytes)[*count] = (unsigned char)(x & C_LOW_MASK);
+    x >>= C_LOW_BIT;
+    if (x > 0) (*bytes)[*count] |= C_CONT_BIT;
+    (*count)++;
+  }while (x > 0);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
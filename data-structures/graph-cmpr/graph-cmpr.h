@@ -0,0 +1,99 @@
+/**
+   graph-cmpr.h
+
+   Struct declarations and declarations of accessible functions for a
+   read-only compressed representation of the adjacency list of a graph
+   with generic integer vertices indexed from 0.
+
+   The list of each vertex is sorted in the non-decreasing order of
+   vertices and is stored as a sequence of gaps between consecutive
+   vertices, where the first gap is the first vertex. Each gap is encoded
+   as a variable-length integer in a sequence of bytes, with the seven low
+   order bits of a byte representing the next seven bits of the gap in the
+   little-endian order and the high order bit set if the gap continues in
+   the next byte. The encoded lists are stored contiguously in a single
+   block of bytes, and the list of a vertex is located by an array of
+   offsets. As a result, a gap below 128 is stored in a single byte,
+   independently of the integer type used to represent vertices.
+
+   The weights of a graph are not represented. The vertices in a list are
+   read in the non-decreasing order with an iterator, and the compressed
+   representation can be used by graph algorithms that do not depend on the
+   order of vertices in a list, such as bfs_cmpr and dfs_cmpr in
+   graph-algorithms/search-cmpr.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef GRAPH_CMPR_H
+#define GRAPH_CMPR_H
+
+#include <stddef.h>
+#include "graph.h"
+
+struct adj_cmpr{
+  size_t num_vts;
+  size_t num_es;
+  size_t vt_size;        /* size of the integer type of vertices */
+  size_t *offsets;       /* num_vts + 1 offsets of lists in bytes */
+  unsigned char *bytes;  /* encoded gaps, NULL if no edges */
+};
+
+struct adj_cmpr_iter{
+  const unsigned char *p;
+  const unsigned char *end;
+  size_t v;              /* last read vertex */
+};
+
+/**
+   Initializes a compressed adjacency list according to an adjacency list.
+   The adjacency list is not modified and can be freed after the call is
+   completed. The number of bytes in the encoded lists can be read as
+   offsets[num_vts] after the call.
+   c           : pointer to a preallocated block of size
+                 sizeof(struct adj_cmpr)
+   a           : pointer to an adjacency list
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void adj_cmpr_init(struct adj_cmpr *c,
+                   const struct adj_lst *a,
+                   size_t (*read_vt)(const void *));
+
+/**
+   Initializes an iterator across the list of a vertex. The iterator is
+   valid until the compressed adjacency list is freed.
+   it          : pointer to a preallocated block of size
+                 sizeof(struct adj_cmpr_iter)
+   c           : pointer to an initialized compressed adjacency list
+   u           : vertex in [0, num_vts)
+*/
+void adj_cmpr_iter_init(struct adj_cmpr_iter *it,
+                        const struct adj_cmpr *c,
+                        size_t u);
+
+/**
+   Reads the next vertex in a list into the size_t object pointed to by
+   v and returns 1, or returns 0 if all vertices in the list were read, in
+   which case the object pointed to by v remains unchanged.
+   it          : pointer to an iterator initialized with adj_cmpr_iter_init
+   v           : pointer to a preallocated size_t object
+*/
+int adj_cmpr_iter_next(struct adj_cmpr_iter *it, size_t *v);
+
+/**
+   Frees the memory allocated by adj_cmpr_init and leaves a block of size
+   sizeof(struct adj_cmpr) pointed to by the c parameter.
+*/
+void adj_cmpr_free(struct adj_cmpr *c);
+
+#endif
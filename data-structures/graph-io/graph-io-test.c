@@ -0,0 +1,500 @@
+/**
+   graph-io-test.c
+
+   Tests of reading graphs in the DIMACS shortest path, METIS, and Matrix
+   Market coordinate formats into adjacency lists with generic integer
+   vertices and generic contiguous weights.
+
+   The tests write files into the current directory and remove them after
+   reading.
+
+   The following command line arguments can be used to customize tests:
+   graph-io-test
+      [0, size_t width / 2] : n for 2**n vertices in smallest graph
+      [0, size_t width / 2] : n for 2**n vertices in largest graph
+      [0, 1] : small graph test on/off
+      [0, 1] : random graph test on/off
+
+   usage examples:
+   ./graph-io-test
+   ./graph-io-test 10 12
+   ./graph-io-test 0 10 0 1
+
+   graph-io-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99 with the only requirement that width of size_t is even
+   and less than 2040.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "graph-io.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "graph-io-test \n"
+  "[0, size_t width / 2] : n for 2**n vertices in smallest graph \n"
+  "[0, size_t width / 2] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : small graph test on/off \n"
+  "[0, 1] : random graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 8u, 1u, 1u};
+const size_t C_FULL_BIT = PRECISION_FROM_ULIMIT((size_t)-1);
+
+/* files */
+const char *C_GR_PATH = "graph-io-test-tmp.gr";
+const char *C_CO_PATH = "graph-io-test-tmp.co";
+const char *C_METIS_PATH = "graph-io-test-tmp.graph";
+const char *C_MTX_PATH = "graph-io-test-tmp.mtx";
+
+/* small graph tests */
+const size_t C_NUM_VTS = 5u;
+const size_t C_NUM_ES = 4u;
+const unsigned long C_ULONG_U[4] = {0u, 0u, 0u, 1u};
+const unsigned long C_ULONG_V[4] = {1u, 2u, 3u, 3u};
+const unsigned long C_ULONG_WTS[4] = {4u, 3u, 2u, 1u};
+const long C_LONG_COORDS[10] = {-1, 1, 2, -2, 3, 3, -4, -4, 0, 5};
+
+const char *C_GR_FILE =
+  "c small graph\n"
+  "p sp 5 4\n"
+  "c arcs\n"
+  "a 1 2 4\n"
+  "a 1 3 3\n"
+  "a 1 4 2\n"
+  "a 2 4 1\n";
+const char *C_CO_FILE =
+  "c coordinates\n"
+  "p aux sp co 5\n"
+  "v 1 -1 1\n"
+  "v 2 2 -2\n"
+  "v 3 3 3\n"
+  "v 4 -4 -4\n"
+  "v 5 0 5\n";
+const char *C_METIS_FILE =
+  "% small graph\n"
+  "5 4 001\n"
+  "2 4 3 3 4 2\n"
+  "1 4 4 1\n"
+  "% comment between vertex lines\n"
+  "1 3\n"
+  "1 2 2 1\n"
+  "\n";
+const char *C_MTX_FILE =
+  "%%MatrixMarket matrix coordinate integer symmetric\n"
+  "% small graph\n"
+  "5 5 4\n"
+  "2 1 4\n"
+  "3 1 3\n"
+  "4 1 2\n"
+  "4 2 1\n";
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const double C_PROB_ONE = 1.0;
+const double C_PROB_HALF = 0.5;
+const double C_PROB_ZERO = 0.0;
+
+void write_file(const char *path, const char *s);
+int cmp_adj_lst(const struct adj_lst *a,
+                const struct adj_lst *b,
+                size_t (*read_vt)(const void *));
+int cmp_sorted_adj_lst(const struct adj_lst *a,
+                       const struct adj_lst *b,
+                       size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Test on small graphs. The adjacency lists built from files are compared
+   with the adjacency lists built from the corresponding graphs.
+*/
+
+void small_graph_init(struct graph *g,
+                      size_t vt_size,
+                      size_t wt_size,
+                      void (*write_vt)(void *, size_t)){
+  size_t i;
+  graph_base_init(g, C_NUM_VTS, vt_size, wt_size);
+  g->num_es = C_NUM_ES;
+  g->u = malloc_perror(C_NUM_ES, vt_size);
+  g->v = malloc_perror(C_NUM_ES, vt_size);
+  g->wts = NULL;
+  for (i = 0; i < C_NUM_ES; i++){
+    write_vt((char *)g->u + i * vt_size, C_ULONG_U[i]);
+    write_vt((char *)g->v + i * vt_size, C_ULONG_V[i]);
+  }
+  if (wt_size > 0){
+    g->wts = malloc_perror(C_NUM_ES, wt_size);
+    memcpy(g->wts, C_ULONG_WTS, C_NUM_ES * wt_size);
+  }
+}
+
+void small_graph_free(struct graph *g){
+  free(g->u);
+  free(g->v);
+  free(g->wts);
+  g->u = NULL;
+  g->v = NULL;
+  g->wts = NULL;
+}
+
+void run_small_graph_test(){
+  int res = 1;
+  size_t i, j;
+  long coords[10];
+  struct graph g;
+  struct adj_lst a, b;
+  write_file(C_GR_PATH, C_GR_FILE);
+  write_file(C_METIS_PATH, C_METIS_FILE);
+  write_file(C_MTX_PATH, C_MTX_FILE);
+  write_file(C_CO_PATH, C_CO_FILE);
+  for (i = 0; i < C_FN_COUNT; i++){
+    printf("Run small graph tests, %s vertices, ulong weights\n",
+           C_VT_TYPES[i]);
+    for (j = 0; j < 2; j++){
+      /* j = 0: unweighted, j = 1: weighted */
+      small_graph_init(&g, C_VT_SIZES[i], j * sizeof(unsigned long),
+                       C_WRITE[i]);
+      adj_lst_base_init(&a, &g);
+      adj_lst_dir_build(&a, &g, C_READ[i]);
+      adj_lst_dimacs_build(&b, C_GR_PATH, C_VT_SIZES[i],
+                           j * sizeof(unsigned long), C_WRITE[i],
+                           graph_io_scan_ulong);
+      res *= cmp_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&b);
+      adj_lst_file_build(&b, C_GR_PATH, C_VT_SIZES[i],
+                         j * sizeof(unsigned long), C_WRITE[i],
+                         graph_io_scan_ulong);
+      res *= cmp_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[i]);
+      adj_lst_metis_build(&b, C_METIS_PATH, C_VT_SIZES[i],
+                          j * sizeof(unsigned long), C_WRITE[i],
+                          graph_io_scan_ulong);
+      res *= cmp_sorted_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&b);
+      adj_lst_mtx_build(&b, C_MTX_PATH, C_VT_SIZES[i],
+                        j * sizeof(unsigned long), C_WRITE[i],
+                        graph_io_scan_ulong);
+      res *= cmp_sorted_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      small_graph_free(&g);
+    }
+    printf("\tdimacs, metis, mtx build correctness:      ");
+    print_test_result(res);
+    res = 1;
+  }
+  printf("Run small coordinate test, long coordinates\n");
+  graph_io_dimacs_co_read(C_CO_PATH, C_NUM_VTS, coords, sizeof(long),
+                          graph_io_scan_long);
+  res *= (memcmp(coords, C_LONG_COORDS, sizeof(coords)) == 0);
+  printf("\tdimacs coordinate read correctness:        ");
+  print_test_result(res);
+  res = 1;
+  printf("Run small header test\n");
+  res *= (graph_io_file_num_vts(C_GR_PATH) == C_NUM_VTS);
+  res *= (graph_io_file_num_vts(C_METIS_PATH) == C_NUM_VTS);
+  res *= (graph_io_file_num_vts(C_MTX_PATH) == C_NUM_VTS);
+  printf("\tnumber of vertices in header correctness:  ");
+  print_test_result(res);
+  remove(C_GR_PATH);
+  remove(C_METIS_PATH);
+  remove(C_MTX_PATH);
+  remove(C_CO_PATH);
+}
+
+/**
+   Test on random graphs. A random graph is written into a file in each
+   format and read back, and the adjacency lists are compared. The
+   vertices of each list are written in the order of the list, so that
+   the order is preserved by the readers.
+*/
+
+struct bern_arg{
+  double p;
+};
+
+int bern(void *arg){
+  struct bern_arg *b = arg;
+  if (b->p >= C_PROB_ONE) return 1;
+  if (b->p <= C_PROB_ZERO) return 0;
+  if (b->p > DRAND()) return 1;
+  return 0;
+}
+
+void set_rand_wts(struct adj_lst *a){
+  size_t i, j;
+  unsigned long wt;
+  char *p = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; j < a->vt_wts[i]->num_elts; j++){
+      wt = RANDOM();
+      memcpy(p + a->wt_offset, &wt, sizeof(unsigned long));
+      p += a->pair_size;
+    }
+  }
+}
+
+void write_dimacs(const struct adj_lst *a,
+                  size_t (*read_vt)(const void *)){
+  size_t i, j;
+  const char *p = NULL;
+  FILE *f = fopen(C_GR_PATH, "w");
+  fprintf(f, "p sp %lu %lu\n", TOLU(a->num_vts), TOLU(a->num_es));
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; j < a->vt_wts[i]->num_elts; j++){
+      fprintf(f, "a %lu %lu %lu\n", TOLU(i + 1), TOLU(read_vt(p) + 1),
+              *(const unsigned long *)(p + a->wt_offset));
+      p += a->pair_size;
+    }
+  }
+  fclose(f);
+}
+
+void write_metis(const struct adj_lst *a,
+                 size_t (*read_vt)(const void *)){
+  size_t i, j;
+  const char *p = NULL;
+  FILE *f = fopen(C_METIS_PATH, "w");
+  fprintf(f, "%lu %lu 1\n", TOLU(a->num_vts), TOLU(a->num_es / 2));
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; j < a->vt_wts[i]->num_elts; j++){
+      fprintf(f, " %lu %lu", TOLU(read_vt(p) + 1),
+              *(const unsigned long *)(p + a->wt_offset));
+      p += a->pair_size;
+    }
+    fprintf(f, "\n");
+  }
+  fclose(f);
+}
+
+void write_mtx(const struct adj_lst *a,
+               size_t (*read_vt)(const void *)){
+  size_t i, j;
+  const char *p = NULL;
+  FILE *f = fopen(C_MTX_PATH, "w");
+  fprintf(f, "%%%%MatrixMarket matrix coordinate integer general\n");
+  fprintf(f, "%lu %lu %lu\n",
+          TOLU(a->num_vts), TOLU(a->num_vts), TOLU(a->num_es));
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    for (j = 0; j < a->vt_wts[i]->num_elts; j++){
+      fprintf(f, "%lu %lu %lu\n", TOLU(i + 1), TOLU(read_vt(p) + 1),
+              *(const unsigned long *)(p + a->wt_offset));
+      p += a->pair_size;
+    }
+  }
+  fclose(f);
+}
+
+void run_rand_graph_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a, b;
+  struct bern_arg arg;
+  arg.p = C_PROB_HALF;
+  for (i = 0; i < C_FN_COUNT; i++){
+    printf("Run random graph tests, %s vertices, ulong weights\n",
+           C_VT_TYPES[i]);
+    for (j = log_start; j <= log_end; j++){
+      num_vts = pow_two_perror(j);
+      graph_base_init(&g, num_vts, C_VT_SIZES[i], sizeof(unsigned long));
+      adj_lst_base_init(&a, &g);
+      adj_lst_rand_dir(&a, C_WRITE[i], bern, &arg);
+      set_rand_wts(&a);
+      write_dimacs(&a, C_READ[i]);
+      adj_lst_dimacs_build(&b, C_GR_PATH, C_VT_SIZES[i],
+                           sizeof(unsigned long), C_WRITE[i],
+                           graph_io_scan_ulong);
+      res *= cmp_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&b);
+      write_mtx(&a, C_READ[i]);
+      adj_lst_mtx_build(&b, C_MTX_PATH, C_VT_SIZES[i],
+                        sizeof(unsigned long), C_WRITE[i],
+                        graph_io_scan_ulong);
+      res *= cmp_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      adj_lst_base_init(&a, &g);
+      adj_lst_rand_undir(&a, C_WRITE[i], bern, &arg);
+      set_rand_wts(&a);
+      write_metis(&a, C_READ[i]);
+      adj_lst_metis_build(&b, C_METIS_PATH, C_VT_SIZES[i],
+                          sizeof(unsigned long), C_WRITE[i],
+                          graph_io_scan_ulong);
+      res *= cmp_adj_lst(&a, &b, C_READ[i]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+    }
+    printf("\tvertices: 2**%lu - 2**%lu\n", TOLU(log_start), TOLU(log_end));
+    printf("\tdimacs, metis, mtx build correctness:      ");
+    print_test_result(res);
+    res = 1;
+  }
+  remove(C_GR_PATH);
+  remove(C_METIS_PATH);
+  remove(C_MTX_PATH);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+void write_file(const char *path, const char *s){
+  FILE *f = fopen(path, "w");
+  if (f == NULL){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+  fputs(s, f);
+  fclose(f);
+}
+
+/**
+   Compares two adjacency lists with unsigned long weights or without
+   weights, with the same order of vertices in each list. Returns 1 if
+   the lists are equal, otherwise returns 0.
+*/
+int cmp_adj_lst(const struct adj_lst *a,
+                const struct adj_lst *b,
+                size_t (*read_vt)(const void *)){
+  int res = 1;
+  size_t i, j;
+  const char *p = NULL, *q = NULL;
+  res *= (a->num_vts == b->num_vts);
+  res *= (a->num_es == b->num_es);
+  res *= (a->pair_size == b->pair_size);
+  res *= (a->wt_offset == b->wt_offset);
+  for (i = 0; res && i < a->num_vts; i++){
+    res *= (a->vt_wts[i]->num_elts == b->vt_wts[i]->num_elts);
+    p = a->vt_wts[i]->elts;
+    q = b->vt_wts[i]->elts;
+    for (j = 0; res && j < a->vt_wts[i]->num_elts; j++){
+      res *= (read_vt(p) == read_vt(q));
+      if (a->wt_size > 0){
+        res *= (*(const unsigned long *)(p + a->wt_offset) ==
+                *(const unsigned long *)(q + b->wt_offset));
+      }
+      p += a->pair_size;
+      q += b->pair_size;
+    }
+  }
+  return res;
+}
+
+/**
+   Compares two adjacency lists with unsigned long weights or without
+   weights, without regard to the order of vertices in each list. Assumes
+   that there are no parallel edges. Returns 1 if the lists are equal,
+   otherwise returns 0.
+*/
+int cmp_sorted_adj_lst(const struct adj_lst *a,
+                       const struct adj_lst *b,
+                       size_t (*read_vt)(const void *)){
+  int res = 1, found;
+  size_t i, j, k;
+  const char *p = NULL, *q = NULL;
+  res *= (a->num_vts == b->num_vts);
+  res *= (a->num_es == b->num_es);
+  for (i = 0; res && i < a->num_vts; i++){
+    res *= (a->vt_wts[i]->num_elts == b->vt_wts[i]->num_elts);
+    p = a->vt_wts[i]->elts;
+    for (j = 0; res && j < a->vt_wts[i]->num_elts; j++){
+      found = 0;
+      q = b->vt_wts[i]->elts;
+      for (k = 0; !found && k < b->vt_wts[i]->num_elts; k++){
+        found = (read_vt(p) == read_vt(q) &&
+                 (a->wt_size == 0 ||
+                  *(const unsigned long *)(p + a->wt_offset) ==
+                  *(const unsigned long *)(q + b->wt_offset)));
+        q += b->pair_size;
+      }
+      res *= found;
+      p += a->pair_size;
+    }
+  }
+  return res;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_FULL_BIT / 2 ||
+      args[1] > C_FULL_BIT / 2 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_small_graph_test();
+  if (args[3]) run_rand_graph_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,703 @@
+/**
+   graph-io.c
+
+   Functions for reading graphs in the DIMACS shortest path (.gr, .co),
+   METIS (.graph), and Matrix Market coordinate (.mtx) formats into
+   adjacency lists with generic integer vertices and generic contiguous
+   weights.
+
+   The vertices in a file are indexed from 1 and are copied into an
+   adjacency list as vt_size blocks with values decreased by 1, so that the
+   vertex values in the adjacency list start from 0. The arcs and edges of
+   a file are pushed directly onto the stacks of an adjacency list while
+   the file is read, without building an intermediate edge array.
+
+   A file is read line by line into a dynamically growing buffer. The
+   stacks of an adjacency list built by a reader are not bounded by the
+   number of vertices, so that files with parallel edges are accepted.
+
+   The weight values in a file are read with a user-defined or predefined
+   scanning operation that reads a weight value from a character string and
+   writes it into a wt_size block. If wt_size is 0, the weight values in a
+   file are skipped and an unweighted adjacency list is built. The predefined
+   scanning operations are provided for integer weights. Non-integer weight
+   operations on suitable systems are defined by the user.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted, an allocation is not completed due to
+   insufficient resources, a file cannot be opened, or a file does not
+   follow its format. The behavior outside the specified parameter ranges
+   is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include "graph-io.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+static const unsigned short C_USHORT_ULIMIT = USHRT_MAX;
+static const unsigned int C_UINT_ULIMIT = UINT_MAX;
+static const unsigned long C_ULONG_ULIMIT = ULONG_MAX;
+static const size_t C_SZ_ULIMIT = (size_t)-1;
+
+static const short C_SHORT_LLIMIT = SHRT_MIN;
+static const short C_SHORT_ULIMIT = SHRT_MAX;
+static const int C_INT_LLIMIT = INT_MIN;
+static const int C_INT_ULIMIT = INT_MAX;
+static const long C_LONG_LLIMIT = LONG_MIN;
+static const long C_LONG_ULIMIT = LONG_MAX;
+
+static const size_t C_LINE_INIT_COUNT = 256;
+
+struct reader{
+  FILE *f;
+  const char *path;
+  char *s;      /* buffer of the current line */
+  size_t count; /* count of chars in the buffer */
+  size_t num;   /* number of the current line, starting from 1 */
+};
+
+static void reader_init(struct reader *r, const char *path);
+static int reader_next(struct reader *r);
+static int reader_next_data(struct reader *r, char comment);
+static void reader_free(struct reader *r);
+static void reader_error(const struct reader *r, const char *s);
+static const char *skip_space(const char *s);
+static const char *skip_token(const char *s);
+static const char *scan_size(const char *s, size_t *val);
+static const char *scan_vt(const struct reader *r,
+                           const char *s,
+                           size_t num_vts,
+                           size_t *val);
+static int token_eq(const char *s, size_t len, const char *t);
+static const char *scan_unsigned(const char *s,
+                                 unsigned long *val,
+                                 unsigned long ulimit);
+static const char *scan_signed(const char *s,
+                               long *val,
+                               long llimit,
+                               long ulimit);
+static void fprintf_stderr_exit(const char *s, int line);
+
+/**
+   Builds the adjacency list of a directed graph from a file in the DIMACS
+   shortest path format (.gr). The adjacency list is initialized by the
+   operation with the "p sp" line of the file, and each "a u v w" line is
+   pushed as an arc (u - 1, v - 1). The number of "a" lines must equal the
+   number of arcs in the "p sp" line. The pairs of vt_size and wt_size
+   blocks are aligned according to adj_lst_base_init.
+   a           : pointer to a preallocated block of size
+                 sizeof(struct adj_lst) that is not initialized
+   path        : path of a file in the DIMACS shortest path format
+   vt_size     : non-zero size of the integer type used to represent a
+                 vertex according to sizeof; the number of vertices in the
+                 file is representable by the type
+   wt_size     : - 0 if the weights in the file are skipped
+                 - otherwise non-zero size of the wt_size block of a weight;
+                 must account for internal and trailing padding according to
+                 sizeof
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   scan_wt     : - NULL if wt_size is 0
+                 - otherwise reads a weight value from the beginning of the
+                 string pointed to by the second argument after skipping
+                 leading white space, writes the value into the wt_size block
+                 pointed to by the first argument, and returns a pointer to
+                 the first character after the value, or NULL if no value
+                 was read
+*/
+void adj_lst_dimacs_build(struct adj_lst *a,
+                          const char *path,
+                          size_t vt_size,
+                          size_t wt_size,
+                          void (*write_vt)(void *, size_t),
+                          const char *(*scan_wt)(void *, const char *)){
+  int is_init = 0;
+  size_t num_vts = 0, num_es = 0;
+  size_t u, v;
+  const char *s = NULL;
+  struct graph g;
+  struct reader r;
+  reader_init(&r, path);
+  while (reader_next_data(&r, 'c')){
+    s = skip_space(r.s);
+    if (*s == 'p'){
+      if (is_init) reader_error(&r, "repeated problem line");
+      s = skip_space(s + 1);
+      if (!token_eq(s, 2, "sp")) reader_error(&r, "not a sp problem");
+      if ((s = scan_size(s + 2, &num_vts)) == NULL ||
+          (s = scan_size(s, &num_es)) == NULL){
+        reader_error(&r, "invalid problem line");
+      }
+      graph_base_init(&g, num_vts, vt_size, wt_size);
+      adj_lst_base_init(a, &g);
+      adj_lst_unbound(a);
+      is_init = 1;
+    }else if (*s == 'a'){
+      if (!is_init) reader_error(&r, "arc before problem line");
+      s = scan_vt(&r, s + 1, num_vts, &u);
+      s = scan_vt(&r, s, num_vts, &v);
+      write_vt(a->buf, v);
+      if (wt_size > 0 &&
+          scan_wt((char *)a->buf + a->wt_offset, s) == NULL){
+        reader_error(&r, "invalid arc weight");
+      }
+      stack_push(a->vt_wts[u], a->buf);
+      a->num_es++;
+    }else{
+      reader_error(&r, "unknown line type");
+    }
+  }
+  if (!is_init) reader_error(&r, "no problem line");
+  if (a->num_es != num_es){
+    reader_error(&r, "not a DIMACS file: arc count differs from header");
+  }
+  reader_free(&r);
+}
+
+/**
+   Builds the adjacency list of an undirected graph from a file in the
+   METIS format (.graph). The adjacency list is initialized by the operation
+   with the header line of the file. The ith non-comment line after the
+   header lists the neighbors of the vertex i, with the edge weights if the
+   format field of the header specifies edge weights. Because each edge is
+   listed by both of its vertices, the adjacency list contains two pairs
+   per edge, as after adj_lst_undir_build, and the number of pairs must be
+   twice the number of edges in the header. Vertex sizes and weights are
+   skipped. Please see the parameter specification in adj_lst_dimacs_build.
+*/
+void adj_lst_metis_build(struct adj_lst *a,
+                         const char *path,
+                         size_t vt_size,
+                         size_t wt_size,
+                         void (*write_vt)(void *, size_t),
+                         const char *(*scan_wt)(void *, const char *)){
+  int has_size = 0, has_vt_wts = 0, has_wts = 0;
+  size_t i, j;
+  size_t num_vts, num_es, num_cons = 1;
+  size_t v;
+  const char *s = NULL, *fmt = NULL;
+  struct graph g;
+  struct reader r;
+  reader_init(&r, path);
+  if (!reader_next_data(&r, '%')) reader_error(&r, "no header line");
+  if ((s = scan_size(r.s, &num_vts)) == NULL ||
+      (s = scan_size(s, &num_es)) == NULL){
+    reader_error(&r, "invalid header line");
+  }
+  fmt = skip_space(s);
+  if (*fmt != '\0'){
+    /* up to three 0/1 digits, right-aligned */
+    s = skip_token(fmt);
+    if (s - fmt > 3) reader_error(&r, "invalid format field");
+    for (i = 0; fmt + i < s; i++){
+      if (fmt[i] != '0' && fmt[i] != '1'){
+        reader_error(&r, "invalid format field");
+      }
+    }
+    has_wts = (s[-1] == '1');
+    has_vt_wts = (s - fmt >= 2 && s[-2] == '1');
+    has_size = (s - fmt == 3 && s[-3] == '1');
+    if (*skip_space(s) != '\0' &&
+        (s = scan_size(s, &num_cons)) == NULL){
+      reader_error(&r, "invalid constraint field");
+    }
+  }
+  if (wt_size > 0 && !has_wts) reader_error(&r, "no edge weights");
+  graph_base_init(&g, num_vts, vt_size, wt_size);
+  adj_lst_base_init(a, &g);
+  adj_lst_unbound(a);
+  for (i = 0; i < num_vts; i++){
+    /* an empty line is a vertex without neighbors */
+    do{
+      if (!reader_next(&r)) reader_error(&r, "missing vertex line");
+    }while (r.s[0] == '%');
+    s = r.s;
+    if (has_size && (s = skip_token(s)) == NULL){
+      reader_error(&r, "missing vertex size");
+    }
+    for (j = 0; has_vt_wts && j < num_cons; j++){
+      if ((s = skip_token(s)) == NULL){
+        reader_error(&r, "missing vertex weight");
+      }
+    }
+    while (*(s = skip_space(s)) != '\0'){
+      s = scan_vt(&r, s, num_vts, &v);
+      write_vt(a->buf, v);
+      if (has_wts){
+        if (wt_size > 0){
+          s = scan_wt((char *)a->buf + a->wt_offset, s);
+        }else{
+          s = skip_token(s);
+        }
+        if (s == NULL) reader_error(&r, "missing edge weight");
+      }
+      stack_push(a->vt_wts[i], a->buf);
+      a->num_es++;
+    }
+  }
+  if (reader_next_data(&r, '%')) reader_error(&r, "extra vertex line");
+  if (a->num_es % 2 != 0 || a->num_es / 2 != num_es){
+    reader_error(&r, "not a METIS file: edge count differs from header");
+  }
+  reader_free(&r);
+}
+
+/**
+   Builds the adjacency list of a graph from a file in the Matrix Market
+   coordinate format (.mtx). The number of vertices is the maximum of the
+   numbers of rows and columns, so that the row i and the column i of a
+   non-square matrix are the same vertex i - 1, and the vertices beyond the
+   smaller dimension only have arcs in one direction. Each "i j [value]"
+   entry is pushed as an arc (i - 1, j - 1). If the symmetry field of the
+   header is symmetric or hermitian, then each off-diagonal entry is also
+   pushed as an arc (j - 1, i - 1) with the same weight. The
+   skew-symmetric and complex fields are only accepted if wt_size is 0. If
+   the field of the header is pattern, then wt_size must be 0. Please see
+   the parameter specification
+   in adj_lst_dimacs_build.
+*/
+void adj_lst_mtx_build(struct adj_lst *a,
+                       const char *path,
+                       size_t vt_size,
+                       size_t wt_size,
+                       void (*write_vt)(void *, size_t),
+                       const char *(*scan_wt)(void *, const char *)){
+  int is_sym = 0, is_pattern = 0;
+  size_t k;
+  size_t num_rows, num_cols, num_vts, num_nzs;
+  size_t u, v;
+  const char *s = NULL, *t = NULL;
+  struct graph g;
+  struct reader r;
+  reader_init(&r, path);
+  if (!reader_next(&r) || strncmp(r.s, "%%MatrixMarket", 14) != 0){
+    reader_error(&r, "no MatrixMarket banner");
+  }
+  s = skip_space(r.s + 14);
+  if (!token_eq(s, 6, "matrix")) reader_error(&r, "not a matrix");
+  s = skip_space(s + 6);
+  if (!token_eq(s, 10, "coordinate")) reader_error(&r, "not coordinate");
+  s = skip_space(s + 10);
+  t = skip_token(s);
+  if (t != NULL && token_eq(s, t - s, "pattern")){
+    is_pattern = 1;
+  }else if (t != NULL && token_eq(s, t - s, "complex")){
+    if (wt_size > 0) reader_error(&r, "complex weights");
+  }else if (t == NULL ||
+            !(token_eq(s, t - s, "real") ||
+              token_eq(s, t - s, "double") ||
+              token_eq(s, t - s, "integer"))){
+    reader_error(&r, "invalid field");
+  }
+  if (is_pattern && wt_size > 0) reader_error(&r, "no edge weights");
+  s = skip_space(t);
+  t = skip_token(s);
+  if (t != NULL &&
+      (token_eq(s, t - s, "symmetric") || token_eq(s, t - s, "hermitian"))){
+    is_sym = 1;
+  }else if (t != NULL && token_eq(s, t - s, "skew-symmetric")){
+    if (wt_size > 0) reader_error(&r, "skew-symmetric weights");
+    is_sym = 1;
+  }else if (t == NULL || !token_eq(s, t - s, "general")){
+    reader_error(&r, "invalid symmetry");
+  }
+  if (!reader_next_data(&r, '%') ||
+      (s = scan_size(r.s, &num_rows)) == NULL ||
+      (s = scan_size(s, &num_cols)) == NULL ||
+      (s = scan_size(s, &num_nzs)) == NULL){
+    reader_error(&r, "invalid size line");
+  }
+  /* the rows and columns of a non-square matrix share vertex ids */
+  num_vts = (num_rows > num_cols) ? num_rows : num_cols;
+  graph_base_init(&g, num_vts, vt_size, wt_size);
+  adj_lst_base_init(a, &g);
+  adj_lst_unbound(a);
+  for (k = 0; k < num_nzs; k++){
+    if (!reader_next_data(&r, '%')) reader_error(&r, "missing entry");
+    s = scan_vt(&r, r.s, num_rows, &u);
+    s = scan_vt(&r, s, num_cols, &v);
+    write_vt(a->buf, v);
+    if (wt_size > 0 &&
+        scan_wt((char *)a->buf + a->wt_offset, s) == NULL){
+      reader_error(&r, "invalid entry value");
+    }
+    stack_push(a->vt_wts[u], a->buf);
+    a->num_es++;
+    if (is_sym && u != v){
+      write_vt(a->buf, u);
+      stack_push(a->vt_wts[v], a->buf);
+      a->num_es++;
+    }
+  }
+  reader_free(&r);
+}
+
+/**
+   Builds the adjacency list of a graph from a file according to the
+   extension of the path of the file: .gr for the DIMACS shortest path
+   format, .graph or .metis for the METIS format, and .mtx for the Matrix
+   Market coordinate format. An error message is provided and an exit is
+   executed if the extension is not recognized. Please see the parameter
+   specification in adj_lst_dimacs_build.
+*/
+void adj_lst_file_build(struct adj_lst *a,
+                        const char *path,
+                        size_t vt_size,
+                        size_t wt_size,
+                        void (*write_vt)(void *, size_t),
+                        const char *(*scan_wt)(void *, const char *)){
+  const char *ext = strrchr(path, '.');
+  if (ext == NULL){
+    fprintf(stderr, "no extension in %s\n", path);
+    exit(EXIT_FAILURE);
+  }else if (strcmp(ext, ".gr") == 0){
+    adj_lst_dimacs_build(a, path, vt_size, wt_size, write_vt, scan_wt);
+  }else if (strcmp(ext, ".graph") == 0 || strcmp(ext, ".metis") == 0){
+    adj_lst_metis_build(a, path, vt_size, wt_size, write_vt, scan_wt);
+  }else if (strcmp(ext, ".mtx") == 0){
+    adj_lst_mtx_build(a, path, vt_size, wt_size, write_vt, scan_wt);
+  }else{
+    fprintf(stderr, "unknown extension in %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+   Returns the number of vertices in the header of a file of a graph in a
+   format recognized by adj_lst_file_build, without reading the arcs, so
+   that the vertices can be tested for representability before a build.
+   An error message is provided and an exit is executed if the extension
+   is not recognized or the header is invalid.
+   path        : path of the file
+*/
+size_t graph_io_file_num_vts(const char *path){
+  size_t num_vts = 0, num_rows, num_cols;
+  const char *s = NULL;
+  const char *ext = strrchr(path, '.');
+  struct reader r;
+  if (ext == NULL){
+    fprintf(stderr, "no extension in %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+  reader_init(&r, path);
+  if (strcmp(ext, ".gr") == 0){
+    if (!reader_next_data(&r, 'c') ||
+        *(s = skip_space(r.s)) != 'p' ||
+        !token_eq((s = skip_space(s + 1)), 2, "sp") ||
+        scan_size(s + 2, &num_vts) == NULL){
+      reader_error(&r, "invalid problem line");
+    }
+  }else if (strcmp(ext, ".graph") == 0 || strcmp(ext, ".metis") == 0){
+    if (!reader_next_data(&r, '%') || scan_size(r.s, &num_vts) == NULL){
+      reader_error(&r, "invalid header line");
+    }
+  }else if (strcmp(ext, ".mtx") == 0){
+    if (!reader_next(&r) || strncmp(r.s, "%%MatrixMarket", 14) != 0){
+      reader_error(&r, "no MatrixMarket banner");
+    }
+    if (!reader_next_data(&r, '%') ||
+        (s = scan_size(r.s, &num_rows)) == NULL ||
+        scan_size(s, &num_cols) == NULL){
+      reader_error(&r, "invalid size line");
+    }
+    num_vts = (num_rows > num_cols) ? num_rows : num_cols;
+  }else{
+    fprintf(stderr, "unknown extension in %s\n", path);
+    exit(EXIT_FAILURE);
+  }
+  reader_free(&r);
+  return num_vts;
+}
+
+/**
+   Reads the coordinates of the vertices from a file in the DIMACS
+   coordinate format (.co). For each "v id x y" line, the x and y values
+   are written into the two consecutive coord_size blocks at the index
+   2 * (id - 1) in the array pointed to by coords.
+   path        : path of a file in the DIMACS coordinate format
+   num_vts     : number of vertices in the graph of the coordinates
+   coords      : pointer to a preallocated array of 2 * num_vts blocks of
+                 size coord_size
+   coord_size  : non-zero size of a coordinate value; must account for
+                 internal and trailing padding according to sizeof
+   scan_coord  : reads a coordinate value; please see the specification of
+                 scan_wt in adj_lst_dimacs_build
+*/
+void graph_io_dimacs_co_read(const char *path,
+                             size_t num_vts,
+                             void *coords,
+                             size_t coord_size,
+                             const char *(*scan_coord)(void *, const char *)){
+  size_t u;
+  const char *s = NULL;
+  char *p = NULL;
+  struct reader r;
+  reader_init(&r, path);
+  while (reader_next_data(&r, 'c')){
+    s = skip_space(r.s);
+    if (*s == 'p'){
+      continue;
+    }else if (*s == 'v'){
+      s = scan_vt(&r, s + 1, num_vts, &u);
+      p = (char *)coords + 2 * u * coord_size;
+      if ((s = scan_coord(p, s)) == NULL ||
+          scan_coord(p + coord_size, s) == NULL){
+        reader_error(&r, "invalid coordinates");
+      }
+    }else{
+      reader_error(&r, "unknown line type");
+    }
+  }
+  reader_free(&r);
+}
+
+/**
+   Read a value of an integer type from the beginning of the string pointed
+   to by the second argument after skipping leading white space, write
+   the value into the block pointed to by the first argument, and return a
+   pointer to the first character after the value. Return NULL if no value
+   was read. An error message is provided and an exit is executed if the
+   value is not representable by the type.
+*/
+
+const char *graph_io_scan_ushort(void *a, const char *s){
+  unsigned long val;
+  s = scan_unsigned(s, &val, C_USHORT_ULIMIT);
+  if (s != NULL) *(unsigned short *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_uint(void *a, const char *s){
+  unsigned long val;
+  s = scan_unsigned(s, &val, C_UINT_ULIMIT);
+  if (s != NULL) *(unsigned int *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_ulong(void *a, const char *s){
+  unsigned long val;
+  s = scan_unsigned(s, &val, C_ULONG_ULIMIT);
+  if (s != NULL) *(unsigned long *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_sz(void *a, const char *s){
+  unsigned long val;
+  s = scan_unsigned(s, &val, C_SZ_ULIMIT);
+  if (s != NULL) *(size_t *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_short(void *a, const char *s){
+  long val;
+  s = scan_signed(s, &val, C_SHORT_LLIMIT, C_SHORT_ULIMIT);
+  if (s != NULL) *(short *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_int(void *a, const char *s){
+  long val;
+  s = scan_signed(s, &val, C_INT_LLIMIT, C_INT_ULIMIT);
+  if (s != NULL) *(int *)a = val;
+  return s;
+}
+
+const char *graph_io_scan_long(void *a, const char *s){
+  long val;
+  s = scan_signed(s, &val, C_LONG_LLIMIT, C_LONG_ULIMIT);
+  if (s != NULL) *(long *)a = val;
+  return s;
+}
+
+/**
+   Helper functions for reading a file line by line.
+*/
+
+static void reader_init(struct reader *r, const char *path){
+  r->f = fopen(path, "r");
+  if (r->f == NULL){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+  r->path = path;
+  r->count = C_LINE_INIT_COUNT;
+  r->s = malloc_perror(r->count, 1);
+  r->s[0] = '\0';
+  r->num = 0;
+}
+
+/**
+   Reads the next line into the buffer of a reader without the newline
+   character. Returns 0 if the end of the file was reached before a line
+   was read, otherwise returns 1.
+*/
+static int reader_next(struct reader *r){
+  int c;
+  size_t len = 0;
+  c = getc(r->f);
+  if (c == EOF){
+    if (ferror(r->f)){
+      perror(r->path);
+      exit(EXIT_FAILURE);
+    }
+    return 0;
+  }
+  while (c != EOF && c != '\n'){
+    if (len == r->count - 1){
+      r->count = mul_sz_perror(2, r->count);
+      r->s = realloc_perror(r->s, r->count, 1);
+    }
+    r->s[len] = c;
+    len++;
+    c = getc(r->f);
+  }
+  r->s[len] = '\0';
+  r->num++;
+  return 1;
+}
+
+/**
+   Reads the next line that is neither a comment line beginning with the
+   comment character nor a line of white space. Returns 0 if the end of
+   the file was reached before such a line was read, otherwise returns 1.
+*/
+static int reader_next_data(struct reader *r, char comment){
+  while (reader_next(r)){
+    if (r->s[0] != comment && *skip_space(r->s) != '\0') return 1;
+  }
+  return 0;
+}
+
+static void reader_free(struct reader *r){
+  fclose(r->f);
+  free(r->s);
+  r->f = NULL;
+  r->s = NULL;
+}
+
+/**
+   Prints an error message with the path and line number of the file of a
+   reader and exits.
+*/
+static void reader_error(const struct reader *r, const char *s){
+  fprintf(stderr, "%s in %s at line %lu\n", s, r->path, TOLU(r->num));
+  exit(EXIT_FAILURE);
+}
+
+/**
+   Helper functions for scanning a line.
+*/
+
+static const char *skip_space(const char *s){
+  while (isspace((unsigned char)*s)) s++;
+  return s;
+}
+
+/**
+   Skips leading white space and the following token. Returns a pointer to
+   the first character after the token, or NULL if there is no token.
+*/
+static const char *skip_token(const char *s){
+  s = skip_space(s);
+  if (*s == '\0') return NULL;
+  while (*s != '\0' && !isspace((unsigned char)*s)) s++;
+  return s;
+}
+
+static const char *scan_size(const char *s, size_t *val){
+  unsigned long v;
+  s = scan_unsigned(s, &v, C_SZ_ULIMIT);
+  if (s != NULL) *val = v;
+  return s;
+}
+
+/**
+   Scans a 1-based vertex index that is not greater than num_vts and sets
+   the value pointed to by val to the 0-based index.
+*/
+static const char *scan_vt(const struct reader *r,
+                           const char *s,
+                           size_t num_vts,
+                           size_t *val){
+  s = scan_size(s, val);
+  if (s == NULL || *val == 0 || *val > num_vts){
+    reader_error(r, "invalid vertex");
+  }
+  (*val)--;
+  return s;
+}
+
+/**
+   Compares the token of length len pointed to by s and the string t
+   without case sensitivity. Returns nonzero if the token and t are equal.
+*/
+static int token_eq(const char *s, size_t len, const char *t){
+  size_t i;
+  if (strlen(t) != len) return 0;
+  for (i = 0; i < len; i++){
+    if (tolower((unsigned char)s[i]) != tolower((unsigned char)t[i])){
+      return 0;
+    }
+  }
+  return s[len] == '\0' || isspace((unsigned char)s[len]);
+}
+
+/**
+   Scans an unsigned or signed integer value and checks if the value is
+   within the limits.
+*/
+
+static const char *scan_unsigned(const char *s,
+                                 unsigned long *val,
+                                 unsigned long ulimit){
+  char *end = NULL;
+  s = skip_space(s);
+  if (*s == '-' && isdigit((unsigned char)s[1])){
+    fprintf_stderr_exit("negative unsigned value", __LINE__);
+  }
+  if (!isdigit((unsigned char)*s) && *s != '+') return NULL;
+  errno = 0;
+  *val = strtoul(s, &end, 10);
+  if (end == s) return NULL;
+  if (errno == ERANGE || *val > ulimit){
+    fprintf_stderr_exit("unsigned value out of range", __LINE__);
+  }
+  return end;
+}
+
+static const char *scan_signed(const char *s,
+                               long *val,
+                               long llimit,
+                               long ulimit){
+  char *end = NULL;
+  errno = 0;
+  *val = strtol(s, &end, 10);
+  if (end == s) return NULL;
+  if (errno == ERANGE || *val < llimit || *val > ulimit){
+    fprintf_stderr_exit("signed value out of range", __LINE__);
+  }
+  return end;
+}
+
+/**
+   Prints an error message and exits.
+*/
+static void fprintf_stderr_exit(const char *s, int line){
+  fprintf(stderr, "%s in %s at line %d\n", s,  __FILE__, line);
+  exit(EXIT_FAILURE);
+}
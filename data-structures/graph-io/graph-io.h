@@ -0,0 +1,177 @@
+/**
+   graph-io.h
+
+   Declarations of accessible functions for reading graphs in the DIMACS
+   shortest path (.gr, .co), METIS (.graph), and Matrix Market coordinate
+   (.mtx) formats into adjacency lists with generic integer vertices and
+   generic contiguous weights.
+
+   The vertices in a file are indexed from 1 and are copied into an
+   adjacency list as vt_size blocks with values decreased by 1, so that the
+   vertex values in the adjacency list start from 0. The arcs and edges of
+   a file are pushed directly onto the stacks of an adjacency list while
+   the file is read, without building an intermediate edge array.
+
+   The weight values in a file are read with a user-defined or predefined
+   scanning operation that reads a weight value from a character string and
+   writes it into a wt_size block. If wt_size is 0, the weight values in a
+   file are skipped and an unweighted adjacency list is built. The predefined
+   scanning operations are provided for integer weights. Non-integer weight
+   operations on suitable systems are defined by the user.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted, an allocation is not completed due to
+   insufficient resources, a file cannot be opened, or a file does not
+   follow its format. The behavior outside the specified parameter ranges
+   is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Builds the adjacency list of a directed graph from a file in the DIMACS
+   shortest path format (.gr). The adjacency list is initialized by the
+   operation with the "p sp" line of the file, and each "a u v w" line is
+   pushed as an arc (u - 1, v - 1). The number of "a" lines must equal the
+   number of arcs in the "p sp" line. The pairs of vt_size and wt_size
+   blocks are aligned according to adj_lst_base_init.
+   a           : pointer to a preallocated block of size
+                 sizeof(struct adj_lst) that is not initialized
+   path        : path of a file in the DIMACS shortest path format
+   vt_size     : non-zero size of the integer type used to represent a
+                 vertex according to sizeof; the number of vertices in the
+                 file is representable by the type
+   wt_size     : - 0 if the weights in the file are skipped
+                 - otherwise non-zero size of the wt_size block of a weight;
+                 must account for internal and trailing padding according to
+                 sizeof
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   scan_wt     : - NULL if wt_size is 0
+                 - otherwise reads a weight value from the beginning of the
+                 string pointed to by the second argument after skipping
+                 leading white space, writes the value into the wt_size block
+                 pointed to by the first argument, and returns a pointer to
+                 the first character after the value, or NULL if no value
+                 was read
+*/
+void adj_lst_dimacs_build(struct adj_lst *a,
+                          const char *path,
+                          size_t vt_size,
+                          size_t wt_size,
+                          void (*write_vt)(void *, size_t),
+                          const char *(*scan_wt)(void *, const char *));
+
+/**
+   Builds the adjacency list of an undirected graph from a file in the
+   METIS format (.graph). The adjacency list is initialized by the operation
+   with the header line of the file. The ith non-comment line after the
+   header lists the neighbors of the vertex i, with the edge weights if the
+   format field of the header specifies edge weights. Because each edge is
+   listed by both of its vertices, the adjacency list contains two pairs
+   per edge, as after adj_lst_undir_build, and the number of pairs must be
+   twice the number of edges in the header. Vertex sizes and weights are
+   skipped. Please see the parameter specification in adj_lst_dimacs_build.
+*/
+void adj_lst_metis_build(struct adj_lst *a,
+                         const char *path,
+                         size_t vt_size,
+                         size_t wt_size,
+                         void (*write_vt)(void *, size_t),
+                         const char *(*scan_wt)(void *, const char *));
+
+/**
+   Builds the adjacency list of a graph from a file in the Matrix Market
+   coordinate format (.mtx). The number of vertices is the maximum of the
+   numbers of rows and columns, so that the row i and the column i of a
+   non-square matrix are the same vertex i - 1, and the vertices beyond the
+   smaller dimension only have arcs in one direction. Each "i j [value]"
+   entry is pushed as an arc (i - 1, j - 1). If the symmetry field of the
+   header is symmetric or hermitian, then each off-diagonal entry is also
+   pushed as an arc (j - 1, i - 1) with the same weight. The
+   skew-symmetric and complex fields are only accepted if wt_size is 0. If
+   the field of the header is pattern, then wt_size must be 0. Please see
+   the parameter specification
+   in adj_lst_dimacs_build.
+*/
+void adj_lst_mtx_build(struct adj_lst *a,
+                       const char *path,
+                       size_t vt_size,
+                       size_t wt_size,
+                       void (*write_vt)(void *, size_t),
+                       const char *(*scan_wt)(void *, const char *));
+
+/**
+   Builds the adjacency list of a graph from a file according to the
+   extension of the path of the file: .gr for the DIMACS shortest path
+   format, .graph or .metis for the METIS format, and .mtx for the Matrix
+   Market coordinate format. An error message is provided and an exit is
+   executed if the extension is not recognized. Please see the parameter
+   specification in adj_lst_dimacs_build.
+*/
+void adj_lst_file_build(struct adj_lst *a,
+                        const char *path,
+                        size_t vt_size,
+                        size_t wt_size,
+                        void (*write_vt)(void *, size_t),
+                        const char *(*scan_wt)(void *, const char *));
+
+/**
+   Returns the number of vertices in the header of a file of a graph in a
+   format recognized by adj_lst_file_build, without reading the arcs, so
+   that the vertices can be tested for representability before a build.
+   An error message is provided and an exit is executed if the extension
+   is not recognized or the header is invalid.
+   path        : path of the file
+*/
+size_t graph_io_file_num_vts(const char *path);
+
+/**
+   Reads the coordinates of the vertices from a file in the DIMACS
+   coordinate format (.co). For each "v id x y" line, the x and y values
+   are written into the two consecutive coord_size blocks at the index
+   2 * (id - 1) in the array pointed to by coords.
+   path        : path of a file in the DIMACS coordinate format
+   num_vts     : number of vertices in the graph of the coordinates
+   coords      : pointer to a preallocated array of 2 * num_vts blocks of
+                 size coord_size
+   coord_size  : non-zero size of a coordinate value; must account for
+                 internal and trailing padding according to sizeof
+   scan_coord  : reads a coordinate value; please see the specification of
+                 scan_wt in adj_lst_dimacs_build
+*/
+void graph_io_dimacs_co_read(const char *path,
+                             size_t num_vts,
+                             void *coords,
+                             size_t coord_size,
+                             const char *(*scan_coord)(void *, const char *));
+
+/**
+   Read a value of an integer type from the beginning of the string pointed
+   to by the second argument after skipping leading white space, write
+   the value into the block pointed to by the first argument, and return a
+   pointer to the first character after the value. Return NULL if no value
+   was read. An error message is provided and an exit is executed if the
+   value is not representable by the type.
+*/
+
+const char *graph_io_scan_ushort(void *a, const char *s);
+const char *graph_io_scan_uint(void *a, const char *s);
+const char *graph_io_scan_ulong(void *a, const char *s);
+const char *graph_io_scan_sz(void *a, const char *s);
+
+const char *graph_io_scan_short(void *a, const char *s);
+const char *graph_io_scan_int(void *a, const char *s);
+const char *graph_io_scan_long(void *a, const char *s);
+
+#endif
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <math.h>
 #include <time.h>
 #include "graph.h"
 #include "stack.h"
@@ -85,6 +86,11 @@ void (* const C_WRITE[4])(void *, size_t) ={
   graph_write_uint,
   graph_write_ulong,
   graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
 const size_t C_VT_SIZES[4] = {
   sizeof(unsigned short),
   sizeof(unsigned int),
@@ -94,6 +100,8 @@ const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
 const double C_PROB_ONE = 1.0;
 const double C_PROB_HALF = 0.5;
 const double C_PROB_ZERO = 0.0;
+const size_t C_RMAT_EDGE_FACTOR = 16u;
+const int C_BERN_ZERO = 0;
 
 void print_uchar(const void *a);
 void print_ulong(const void *a);
@@ -101,6 +109,10 @@ void print_double(const void *a);
 void print_adj_lst(const struct adj_lst *a,
                    void (*print_vt)(const void *),
                    void (*print_wt)(const void *));
+int cmp_sorted_lsts(const struct adj_lst *a,
+                    const struct adj_lst *b,
+                    size_t (*read_vt)(const void *));
+int cmp_sz(const void *a, const void *b);
 size_t sum_vts(const struct adj_lst *a,
                size_t i,
                size_t (*read_vt)(const void *));
@@ -513,6 +525,614 @@ void rand_build_helper(size_t log_start,
   }
 }
 
+/**
+   Test adj_lst_rand_dir_geo and adj_lst_rand_undir_geo.
+*/
+
+struct geo_arg{
+  double p;
+};
+
+size_t geo(void *arg){
+  double k;
+  struct geo_arg *g = arg;
+  if (g->p >= C_PROB_ONE) return 0;
+  if (g->p <= C_PROB_ZERO) return (size_t)-1;
+  k = floor(log((RANDOM() + 1.0) / (RAND_MAX + 1.0)) / log(1.0 - g->p));
+  if (k >= (double)((size_t)-1)) return (size_t)-1;
+  return k;
+}
+
+void rand_geo_build_helper(size_t log_start,
+                           size_t log_end,
+                           void (*rand_build)(struct adj_lst *,
+                                              void (*)(void *, size_t),
+                                              size_t (*)(void *),
+                                              void *));
+
+void run_adj_lst_rand_dir_geo_test(size_t log_start, size_t log_end){
+  printf("Test adj_lst_rand_dir_geo on the number of edges in expectation "
+         "and on complete and empty graphs\n");
+  printf("\tn vertices, E[# of directed edges] = n(n - 1) * (%.1f * 1)\n",
+         C_PROB_HALF);
+  rand_geo_build_helper(log_start, log_end, adj_lst_rand_dir_geo);
+}
+
+void run_adj_lst_rand_undir_geo_test(size_t log_start, size_t log_end){
+  printf("Test adj_lst_rand_undir_geo on the number of edges in "
+         "expectation and on complete and empty graphs\n");
+  printf("\tn vertices, E[# of directed edges] = n(n - 1)/2 * (%.1f * 2)\n",
+         C_PROB_HALF);
+  rand_geo_build_helper(log_start, log_end, adj_lst_rand_undir_geo);
+}
+
+void rand_geo_build_helper(size_t log_start,
+                           size_t log_end,
+                           void (*rand_build)(struct adj_lst *,
+                                              void (*)(void *, size_t),
+                                              size_t (*)(void *),
+                                              void *)){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  struct geo_arg ga;
+  clock_t t;
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, expected directed edges: %.1f\n",
+           TOLU(num_vts), C_PROB_HALF * num_vts * (num_vts - 1));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      /* probability 1/2 */
+      ga.p = C_PROB_HALF;
+      adj_lst_base_init(&a, &g);
+      t = clock();
+      rand_build(&a, C_WRITE[j], geo, &ga);
+      t = clock() - t;
+      printf("\t\t\t%s directed edges:   %lu\n",
+             C_VT_TYPES[j],
+             TOLU(a.num_es));
+      printf("\t\t\t%s build time:       %.6f seconds\n",
+             C_VT_TYPES[j], (float)t / CLOCKS_PER_SEC);
+      adj_lst_free(&a);
+      /* probability 1, each vertex is adjacent to all other vertices */
+      ga.p = C_PROB_ONE;
+      adj_lst_base_init(&a, &g);
+      rand_build(&a, C_WRITE[j], geo, &ga);
+      res *= (a.num_es == num_vts * (num_vts - 1));
+      for (k = 0; k < num_vts; k++){
+        res *= (a.vt_wts[k]->num_elts == num_vts - 1);
+        res *= (sum_vts(&a, k, C_READ[j]) ==
+                num_vts * (num_vts - 1) / 2 - k);
+      }
+      adj_lst_free(&a);
+      /* probability 0 */
+      ga.p = C_PROB_ZERO;
+      adj_lst_base_init(&a, &g);
+      rand_build(&a, C_WRITE[j], geo, &ga);
+      res *= (a.num_es == 0);
+      adj_lst_free(&a);
+    }
+  }
+  printf("\t\tcorrectness on complete and empty graphs --> ");
+  print_test_result(res);
+}
+
+/**
+   Test graph_grid on the number of edges, the end vertices of edges,
+   the degrees of vertices, and the order of weight generation.
+*/
+
+void gen_wt_ulong(void *wt, void *arg){
+  unsigned long *count = arg;
+  (*count)++;
+  *(unsigned long *)wt = *count;
+}
+
+void grid_dims(size_t log_num_vts, size_t num_dims, size_t *dims){
+  size_t i;
+  size_t log_rem = log_num_vts;
+  for (i = 0; i < 3; i++){
+    if (i < num_dims){
+      dims[i] = pow_two_perror(log_rem / (num_dims - i));
+      log_rem -= log_rem / (num_dims - i);
+    }else{
+      dims[i] = 1;
+    }
+  }
+}
+
+void run_graph_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, d;
+  size_t u, v, x, y, z, xy, deg;
+  size_t num_vts;
+  size_t dims[3];
+  unsigned long count;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test graph_grid on the number of edges, end vertices, degrees, "
+         "and weights\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    for (d = 2; d <= 3; d++){
+      grid_dims(i, d, dims);
+      xy = dims[0] * dims[1];
+      printf("\t\t%luD grid %lu x %lu x %lu\n",
+             TOLU(d), TOLU(dims[0]), TOLU(dims[1]), TOLU(dims[2]));
+      for (j = 0; j < C_FN_COUNT; j++){
+        count = 0;
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+        graph_grid(&g, dims[0], dims[1], dims[2], C_WRITE[j],
+                   gen_wt_ulong, &count);
+        printf("\t\t\t%s edges: %lu\n", C_VT_TYPES[j], TOLU(g.num_es));
+        res *= (g.num_es == ((dims[0] - 1) * dims[1] * dims[2] +
+                             dims[0] * (dims[1] - 1) * dims[2] +
+                             xy * (dims[2] - 1)));
+        res *= (count == g.num_es);
+        for (k = 0; k < g.num_es; k++){
+          u = C_READ[j]((char *)g.u + k * g.vt_size);
+          v = C_READ[j]((char *)g.v + k * g.vt_size);
+          res *= (u < v && v < num_vts &&
+                  (v - u == 1 || v - u == dims[0] || v - u == xy));
+          res *= (*(unsigned long *)((char *)g.wts + k * g.wt_size) ==
+                  k + 1);
+        }
+        adj_lst_base_init(&a, &g);
+        adj_lst_undir_build(&a, &g, C_READ[j]);
+        for (k = 0; k < num_vts; k++){
+          x = k % dims[0];
+          y = (k / dims[0]) % dims[1];
+          z = k / xy;
+          deg = ((x > 0) + (x + 1 < dims[0]) +
+                 (y > 0) + (y + 1 < dims[1]) +
+                 (z > 0) + (z + 1 < dims[2]));
+          res *= (a.vt_wts[k]->num_elts == deg);
+        }
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test graph_rmat on the number of edges and the range of vertices of
+   random graphs with Graph500 parameters, and on graphs where the same
+   quadrant is selected at each level.
+*/
+
+struct quad_arg{
+  size_t q; /* fixed quadrant if less than 4, otherwise random */
+};
+
+size_t rand_quad(void *arg){
+  struct quad_arg *qa = arg;
+  if (qa->q < 4) return qa->q;
+  return graph_rmat_quad(NULL);
+}
+
+void run_graph_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t u, v;
+  size_t num_vts, num_es, max_deg;
+  struct quad_arg qa;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test graph_rmat on the number of edges, range of vertices, "
+         "and fixed quadrant graphs\n");
+  printf("\tn vertices, %lu * n directed edges, "
+         "graph_rmat_quad with Graph500 probabilities\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_es = mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts);
+    printf("\t\tvertices: %lu, directed edges: %lu\n",
+           TOLU(num_vts), TOLU(num_es));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      qa.q = 4;
+      t = clock();
+      graph_rmat(&g, num_es, C_WRITE[j], rand_quad, NULL, &qa);
+      t = clock() - t;
+      res *= (g.num_es == num_es && g.wts == NULL);
+      for (k = 0; k < g.num_es; k++){
+        res *= (C_READ[j]((char *)g.u + k * g.vt_size) < num_vts);
+        res *= (C_READ[j]((char *)g.v + k * g.vt_size) < num_vts);
+      }
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      max_deg = 0;
+      for (k = 0; k < num_vts; k++){
+        if (a.vt_wts[k]->num_elts > max_deg){
+          max_deg = a.vt_wts[k]->num_elts;
+        }
+      }
+      res *= (a.num_es == num_es);
+      printf("\t\t\t%s max out-degree: %lu\n",
+             C_VT_TYPES[j], TOLU(max_deg));
+      printf("\t\t\t%s build time:     %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      adj_lst_free(&a);
+      graph_free(&g);
+      for (qa.q = 0; qa.q < 4; qa.q++){
+        graph_rmat(&g, num_es, C_WRITE[j], rand_quad, NULL, &qa);
+        for (k = 0; k < g.num_es; k++){
+          u = C_READ[j]((char *)g.u + k * g.vt_size);
+          v = C_READ[j]((char *)g.v + k * g.vt_size);
+          res *= (u == (qa.q & 2 ? num_vts - 1 : 0));
+          res *= (v == (qa.q & 1 ? num_vts - 1 : 0));
+        }
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test graph_subset with graph_bern on grid graphs with unsigned long
+   weights set to the edge indices, and graph_rmat_quad on the frequencies
+   of quadrants.
+*/
+
+void run_graph_subset_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, l;
+  size_t num_vts, num_x, num_y;
+  size_t counts[4];
+  unsigned long count, w;
+  struct graph g, h;
+  printf("Test graph_subset with graph_bern on grid graphs and "
+         "graph_rmat_quad\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    for (j = 0; j < C_FN_COUNT; j++){
+      count = 0;
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], gen_wt_ulong, &count);
+      graph_base_init(&h, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_subset(&h, &g, graph_bern, NULL);
+      printf("\t\t\t%s edges: %lu, kept with probability 1/2: %lu\n",
+             C_VT_TYPES[j], TOLU(g.num_es), TOLU(h.num_es));
+      /* the weight of the edge with the index l in g is l + 1 */
+      for (k = 0, l = 0; k < h.num_es; k++){
+        w = *(unsigned long *)((char *)h.wts + k * h.wt_size);
+        res *= (w > l && w <= g.num_es);
+        if (w <= l || w > g.num_es) break;
+        l = w;
+        res *= (C_READ[j]((char *)h.u + k * h.vt_size) ==
+                C_READ[j]((char *)g.u + (l - 1) * g.vt_size));
+        res *= (C_READ[j]((char *)h.v + k * h.vt_size) ==
+                C_READ[j]((char *)g.v + (l - 1) * g.vt_size));
+      }
+      graph_free(&h);
+      graph_subset(&h, &g, graph_bern, (void *)&C_BERN_ZERO);
+      res *= (h.num_es == 0);
+      graph_free(&h);
+      graph_free(&g);
+    }
+    memset(counts, 0, sizeof(counts));
+    for (k = 0; k < mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts); k++){
+      counts[graph_rmat_quad(NULL)]++;
+    }
+    printf("\t\t\tgraph_rmat_quad frequencies: %.2f, %.2f, %.2f, %.2f\n",
+           (double)counts[0] / k, (double)counts[1] / k,
+           (double)counts[2] / k, (double)counts[3] / k);
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_dir_del and adj_lst_undir_del on R-MAT multigraphs and
+   grid graphs with size_t weights set to u * num_vts + v. A random half of
+   the edges is deleted and the result is compared with the adjacency list
+   of the other half, and the pairs are tested to keep their weights. All
+   edges are then deleted, including the edges that are no longer present.
+*/
+
+void split_graph(struct graph *d, struct graph *k, const struct graph *g){
+  size_t i;
+  struct graph *h = NULL;
+  graph_base_init(d, g->num_vts, g->vt_size, g->wt_size);
+  graph_base_init(k, g->num_vts, g->vt_size, g->wt_size);
+  d->u = malloc_perror(g->num_es, g->vt_size);
+  d->v = malloc_perror(g->num_es, g->vt_size);
+  d->wts = malloc_perror(g->num_es, g->wt_size);
+  k->u = malloc_perror(g->num_es, g->vt_size);
+  k->v = malloc_perror(g->num_es, g->vt_size);
+  k->wts = malloc_perror(g->num_es, g->wt_size);
+  for (i = 0; i < g->num_es; i++){
+    h = (RANDOM() % 2) ? d : k;
+    memcpy((char *)h->u + h->num_es * g->vt_size,
+           (char *)g->u + i * g->vt_size, g->vt_size);
+    memcpy((char *)h->v + h->num_es * g->vt_size,
+           (char *)g->v + i * g->vt_size, g->vt_size);
+    memcpy((char *)h->wts + h->num_es * g->wt_size,
+           (char *)g->wts + i * g->wt_size, g->wt_size);
+    h->num_es++;
+  }
+}
+
+void set_wts(struct graph *g, size_t (*read_vt)(const void *)){
+  size_t i;
+  g->wts = malloc_perror(g->num_es, sizeof(size_t));
+  for (i = 0; i < g->num_es; i++){
+    ((size_t *)g->wts)[i] =
+      read_vt((char *)g->u + i * g->vt_size) * g->num_vts +
+      read_vt((char *)g->v + i * g->vt_size);
+  }
+}
+
+int is_wts(const struct adj_lst *a,
+           int is_undir,
+           size_t (*read_vt)(const void *)){
+  size_t i, v;
+  const char *p = NULL, *p_end = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    p = a->vt_wts[i]->elts;
+    p_end = p + a->vt_wts[i]->num_elts * a->pair_size;
+    for (; p != p_end; p += a->pair_size){
+      v = read_vt(p);
+      if (*(const size_t *)(p + a->wt_offset) != i * a->num_vts + v &&
+          (!is_undir ||
+           *(const size_t *)(p + a->wt_offset) != v * a->num_vts + i)){
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+void del_helper(const struct graph *g,
+                size_t j,
+                int is_undir,
+                int *res){
+  size_t i;
+  struct graph d, k;
+  struct adj_lst a, b;
+  clock_t t;
+  split_graph(&d, &k, g);
+  adj_lst_base_init(&a, g);
+  adj_lst_base_init(&b, g);
+  adj_lst_unbound(&a);
+  adj_lst_unbound(&b);
+  if (is_undir){
+    adj_lst_undir_build(&a, g, C_READ[j]);
+    adj_lst_undir_build(&b, &k, C_READ[j]);
+    t = clock();
+    adj_lst_undir_del(&a, &d, C_READ[j]);
+    t = clock() - t;
+  }else{
+    adj_lst_dir_build(&a, g, C_READ[j]);
+    adj_lst_dir_build(&b, &k, C_READ[j]);
+    t = clock();
+    adj_lst_dir_del(&a, &d, C_READ[j]);
+    t = clock() - t;
+  }
+  *res *= (a.num_es == b.num_es);
+  *res *= cmp_sorted_lsts(&a, &b, C_READ[j]);
+  *res *= is_wts(&a, is_undir, C_READ[j]);
+  printf("\t\t\t%s %s del time: %.6f seconds\n",
+         C_VT_TYPES[j], is_undir ? "undir" : "dir  ",
+         (double)t / CLOCKS_PER_SEC);
+  if (is_undir){
+    adj_lst_undir_del(&a, g, C_READ[j]);
+  }else{
+    adj_lst_dir_del(&a, g, C_READ[j]);
+  }
+  *res *= (a.num_es == 0);
+  for (i = 0; i < a.num_vts; i++){
+    *res *= (a.vt_wts[i]->num_elts == 0);
+  }
+  adj_lst_free(&a);
+  adj_lst_free(&b);
+  graph_free(&d);
+  graph_free(&k);
+}
+
+void run_adj_lst_del_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  size_t dims[3];
+  struct quad_arg qa;
+  struct graph g;
+  printf("Test adj_lst_dir_del on R-MAT graphs and adj_lst_undir_del on "
+         "2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    grid_dims(i, 2, dims);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      qa.q = 4;
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, NULL, &qa);
+      g.wt_size = sizeof(size_t);
+      set_wts(&g, C_READ[j]);
+      del_helper(&g, j, 0, &res);
+      graph_free(&g);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, dims[0], dims[1], 1, C_WRITE[j], NULL, NULL);
+      g.wt_size = sizeof(size_t);
+      set_wts(&g, C_READ[j]);
+      del_helper(&g, j, 1, &res);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_transpose on R-MAT multigraphs with size_t weights set to
+   u * num_vts + v. The pairs of the transpose are tested to keep their
+   weights and to be in the non-decreasing order of vertices, and the
+   transpose of the transpose is compared with the adjacency list.
+*/
+
+void run_adj_lst_transpose_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, u;
+  size_t num_vts;
+  const char *p = NULL;
+  struct quad_arg qa;
+  struct graph g;
+  struct adj_lst a, b, c;
+  clock_t t;
+  printf("Test adj_lst_transpose on R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      qa.q = 4;
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, NULL, &qa);
+      g.wt_size = sizeof(size_t);
+      set_wts(&g, C_READ[j]);
+      adj_lst_base_init(&a, &g);
+      adj_lst_base_init(&b, &g);
+      adj_lst_base_init(&c, &g);
+      adj_lst_unbound(&a);
+      adj_lst_unbound(&b);
+      adj_lst_unbound(&c);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      t = clock();
+      adj_lst_transpose(&b, &a, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s transpose time: %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (b.num_es == a.num_es);
+      for (k = 0; k < num_vts; k++){
+        p = b.vt_wts[k]->elts;
+        for (u = 0; u < b.vt_wts[k]->num_elts; u++){
+          res *= (*(const size_t *)(p + b.wt_offset) ==
+                  C_READ[j](p) * num_vts + k);
+          res *= (u == 0 || C_READ[j](p - b.pair_size) <= C_READ[j](p));
+          p += b.pair_size;
+        }
+      }
+      adj_lst_transpose(&c, &b, C_READ[j], C_WRITE[j]);
+      res *= (c.num_es == a.num_es);
+      res *= cmp_sorted_lsts(&a, &c, C_READ[j]);
+      res *= is_wts(&c, 0, C_READ[j]);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      adj_lst_free(&c);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Test adj_lst_sort, adj_lst_dedup, and adj_lst_has_edge.
+*/
+
+int is_in_lst(const struct adj_lst *a,
+              size_t u,
+              size_t v,
+              size_t (*read_vt)(const void *)){
+  size_t k;
+  const char *p = a->vt_wts[u]->elts;
+  for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+    if (read_vt(p) == v) return 1;
+    p += a->pair_size;
+  }
+  return 0;
+}
+
+void run_adj_lst_sort_dedup_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, u, v;
+  size_t num_vts, num_es;
+  const char *p = NULL;
+  struct quad_arg qa;
+  struct graph g;
+  struct adj_lst a, c;
+  clock_t t_sort, t_dedup, t_has;
+  printf("Test adj_lst_sort, adj_lst_dedup, and adj_lst_has_edge on "
+         "R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      qa.q = 4;
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], rand_quad, NULL, &qa);
+      g.wt_size = sizeof(size_t);
+      set_wts(&g, C_READ[j]);
+      adj_lst_base_init(&a, &g);
+      adj_lst_base_init(&c, &g);
+      adj_lst_unbound(&a);
+      adj_lst_unbound(&c);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      adj_lst_dir_build(&c, &g, C_READ[j]);
+      t_sort = clock();
+      adj_lst_sort(&a, C_CMP[j]);
+      t_sort = clock() - t_sort;
+      res *= cmp_sorted_lsts(&a, &c, C_READ[j]);
+      res *= is_wts(&a, 0, C_READ[j]);
+      t_dedup = clock();
+      adj_lst_dedup(&a, C_CMP[j]);
+      t_dedup = clock() - t_dedup;
+      res *= is_wts(&a, 0, C_READ[j]);
+      num_es = 0;
+      for (k = 0; k < num_vts; k++){
+        p = a.vt_wts[k]->elts;
+        for (u = 0; u < a.vt_wts[k]->num_elts; u++){
+          res *= (u == 0 || C_READ[j](p - a.pair_size) < C_READ[j](p));
+          p += a.pair_size;
+        }
+        num_es += a.vt_wts[k]->num_elts;
+      }
+      res *= (a.num_es == num_es);
+      t_has = clock();
+      for (k = 0; k < num_vts; k++){
+        p = c.vt_wts[k]->elts;
+        for (u = 0; u < c.vt_wts[k]->num_elts; u++){
+          res *= adj_lst_has_edge(&a, k, C_READ[j](p), C_READ[j]);
+          p += c.pair_size;
+        }
+      }
+      t_has = clock() - t_has;
+      for (k = 0; k < num_vts; k++){
+        v = RANDOM() % num_vts;
+        res *= (adj_lst_has_edge(&a, k, v, C_READ[j]) ==
+                is_in_lst(&c, k, v, C_READ[j]));
+        res *= !adj_lst_has_edge(&a, k, num_vts, C_READ[j]);
+      }
+      printf("\t\t\t%s sort time: %.6f seconds\n"
+             "\t\t\t%s dedup time: %.6f seconds\n"
+             "\t\t\t%s has_edge time: %.6f seconds\n",
+             C_VT_TYPES[j], (double)t_sort / CLOCKS_PER_SEC,
+             C_VT_TYPES[j], (double)t_dedup / CLOCKS_PER_SEC,
+             C_VT_TYPES[j], (double)t_has / CLOCKS_PER_SEC);
+      adj_lst_free(&a);
+      adj_lst_free(&c);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
 /**
    Auxiliary functions.
 */
@@ -579,6 +1199,48 @@ void print_adj_lst(const struct adj_lst *a,
   }
 }
 
+/**
+   Compares the lists of two adjacency lists with the same number of
+   vertices as multisets of vertices. Returns 1 if the lists are equal,
+   otherwise returns 0.
+*/
+int cmp_sorted_lsts(const struct adj_lst *a,
+                    const struct adj_lst *b,
+                    size_t (*read_vt)(const void *)){
+  int res = 1;
+  size_t i, k, num;
+  size_t *avs = NULL, *bvs = NULL;
+  for (i = 0; i < a->num_vts && res; i++){
+    num = a->vt_wts[i]->num_elts;
+    if (num != b->vt_wts[i]->num_elts) return 0;
+    if (num == 0) continue;
+    avs = malloc_perror(num, sizeof(size_t));
+    bvs = malloc_perror(num, sizeof(size_t));
+    for (k = 0; k < num; k++){
+      avs[k] = read_vt((char *)a->vt_wts[i]->elts + k * a->pair_size);
+      bvs[k] = read_vt((char *)b->vt_wts[i]->elts + k * b->pair_size);
+    }
+    qsort(avs, num, sizeof(size_t), cmp_sz);
+    qsort(bvs, num, sizeof(size_t), cmp_sz);
+    res = (memcmp(avs, bvs, num * sizeof(size_t)) == 0);
+    free(avs);
+    free(bvs);
+    avs = NULL;
+    bvs = NULL;
+  }
+  return res;
+}
+
+int cmp_sz(const void *a, const void *b){
+  if (*(const size_t *)a > *(const size_t *)b){
+    return 1;
+  }else if (*(const size_t *)a < *(const size_t *)b){
+    return -1;
+  }else{
+    return 0;
+  }
+}
+
 void print_test_result(int res){
   if (res){
     printf("SUCCESS\n");
@@ -610,12 +1272,22 @@ int main(int argc, char *argv[]){
     exit(EXIT_FAILURE);
   }
   if (args[2]) run_small_graph_test();
-  if (args[3]) run_adj_lst_undir_build_test(args[0], args[1]);
+  if (args[3]){
+    run_adj_lst_undir_build_test(args[0], args[1]);
+    run_graph_grid_test(args[0], args[1]);
+  }
   if (args[4]){
     run_adj_lst_add_dir_edge_test(args[0], args[1]);
     run_adj_lst_add_undir_edge_test(args[0], args[1]);
     run_adj_lst_rand_dir_test(args[0], args[1]);
     run_adj_lst_rand_undir_test(args[0], args[1]);
+    run_adj_lst_rand_dir_geo_test(args[0], args[1]);
+    run_adj_lst_rand_undir_geo_test(args[0], args[1]);
+    run_graph_rmat_test(args[0], args[1]);
+    run_graph_subset_test(args[0], args[1]);
+    run_adj_lst_del_test(args[0], args[1]);
+    run_adj_lst_transpose_test(args[0], args[1]);
+    run_adj_lst_sort_dedup_test(args[0], args[1]);
   }
   free(args);
   args = NULL;
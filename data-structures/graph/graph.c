@@ -59,6 +59,18 @@ static const int C_INT_ULIMIT = INT_MAX;
 static const long C_LONG_ULIMIT = LONG_MAX;
 
 static const size_t C_STACK_INIT_COUNT = 1;
+static const size_t C_STACK_MAX_COUNT = 0; /* < init count, unbounded */
+static const int C_RMAT_GRAPH500[3] = {RAND_MAX / 100 * 57,
+                                       RAND_MAX / 100 * 19,
+                                       RAND_MAX / 100 * 19};
+static const int C_BERN_HALF = RAND_MAX / 2 + 1;
+
+static void del_edges(struct adj_lst *a,
+                      const struct graph *g,
+                      size_t (*read_vt)(const void *),
+                      int is_undir);
+static size_t lower_bound(const size_t *vs, size_t num, size_t v);
+static void *ptr(const void *block, size_t i, size_t size);
 
 /**
    Initializes a weighted or unweighted graph with num_vts vertices
@@ -88,6 +100,292 @@ void graph_base_init(struct graph *g,
   g->wts = NULL;
 }
 
+/**
+   Generates the edges of a graph with num_vts vertices according to the
+   recursive matrix (R-MAT) model, which results in a skewed degree
+   distribution. For each of the num_es edges, the adjacency matrix is
+   recursively divided into four quadrants until a single cell is reached,
+   where at each level a quadrant is selected by rand_quad. If a range of
+   vertices has an odd count, then its upper half has one more vertex. If
+   a range has a single vertex, then the bit of the quadrant index that
+   corresponds to the range is ignored. The generated edges may include
+   self-loops and multiple edges between the same vertices, as in the
+   Graph500 generator, and are stored in the order of generation. An
+   adjacency list of the graph can be built after its bound is removed
+   with adj_lst_unbound. The u, v, and wts arrays are allocated by the
+   call; a prior edge set, if any, must be freed with graph_free before
+   the call.
+   g            : pointer to a graph struct initialized with
+                  graph_base_init
+   num_es       : number of edges
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   rand_quad    : takes arg as the value of its parameter and returns the
+                  index of the selected quadrant in [0, 3], where the bit of
+                  value 2 selects the upper half of u vertices and the bit
+                  of value 1 selects the upper half of v vertices; e.g.
+                  the Graph500 parameters are probabilities 0.57, 0.19,
+                  0.19, and 0.05 of the 0, 1, 2, and 3 indices, as in
+                  graph_rmat_quad with a NULL arg
+   gen_wt       : - NULL if the graph is not weighted
+                  - otherwise writes a weight value to the wt_size block
+                  pointed to by the first argument and takes arg as the
+                  value of its second parameter
+   arg          : pointer that is taken as the value of the parameter of
+                  rand_quad and the second parameter of gen_wt
+*/
+void graph_rmat(struct graph *g,
+                size_t num_es,
+                void (*write_vt)(void *, size_t),
+                size_t (*rand_quad)(void *),
+                void (*gen_wt)(void *, void *),
+                void *arg){
+  size_t i;
+  size_t u, v;
+  g->num_es = num_es;
+  if (num_es == 0) return;
+  g->u = malloc_perror(num_es, g->vt_size);
+  g->v = malloc_perror(num_es, g->vt_size);
+  if (g->wt_size > 0) g->wts = malloc_perror(num_es, g->wt_size);
+  for (i = 0; i < num_es; i++){
+    graph_rmat_edge(&u, &v, g->num_vts, rand_quad, arg);
+    graph_set_edge(g, i, u, v, write_vt, gen_wt, arg);
+  }
+}
+
+/**
+   Generates the edges of a 2D or 3D grid graph with num_x * num_y * num_z
+   vertices, where the vertex x + num_x * (y + num_y * z) is connected to
+   the vertices at a distance 1 along each axis. Each undirected edge is
+   generated once as a (u, v) edge with u < v, and the edges can be added
+   to an adjacency list with adj_lst_undir_build. A 2D grid is generated if
+   num_z is 1. Grids with random weights provide high-diameter inputs
+   similar to road networks. The u, v, and wts arrays are allocated by the
+   call; a prior edge set, if any, must be freed with graph_free before
+   the call.
+   g            : pointer to a graph struct initialized with
+                  graph_base_init, where num_vts equals
+                  num_x * num_y * num_z; otherwise an error message is
+                  provided and an exit is executed
+   num_x        : > 0 number of vertices along the x axis
+   num_y        : > 0 number of vertices along the y axis
+   num_z        : > 0 number of vertices along the z axis
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   gen_wt       : - NULL if the graph is not weighted
+                  - otherwise writes a weight value to the wt_size block
+                  pointed to by the first argument and takes arg as the
+                  value of its second parameter
+   arg          : pointer that is taken as the value of the second
+                  parameter of gen_wt
+*/
+void graph_grid(struct graph *g,
+                size_t num_x,
+                size_t num_y,
+                size_t num_z,
+                void (*write_vt)(void *, size_t),
+                void (*gen_wt)(void *, void *),
+                void *arg){
+  size_t i, j;
+  size_t x, y, z;
+  size_t xy = mul_sz_perror(num_x, num_y);
+  if (g->num_vts != mul_sz_perror(xy, num_z)){
+    perror("graph_grid number of vertices");
+    exit(EXIT_FAILURE);
+  }
+  g->num_es = add_sz_perror(mul_sz_perror((num_x - 1) * num_y, num_z),
+                            mul_sz_perror(num_x * (num_y - 1), num_z));
+  g->num_es = add_sz_perror(g->num_es, xy * (num_z - 1));
+  if (g->num_es == 0) return;
+  g->u = malloc_perror(g->num_es, g->vt_size);
+  g->v = malloc_perror(g->num_es, g->vt_size);
+  if (g->wt_size > 0) g->wts = malloc_perror(g->num_es, g->wt_size);
+  for (i = 0, j = 0; i < g->num_vts; i++){
+    x = i % num_x;
+    y = (i / num_x) % num_y;
+    z = i / xy;
+    if (x + 1 < num_x){
+      graph_set_edge(g, j++, i, i + 1, write_vt, gen_wt, arg);
+    }
+    if (y + 1 < num_y){
+      graph_set_edge(g, j++, i, i + num_x, write_vt, gen_wt, arg);
+    }
+    if (z + 1 < num_z){
+      graph_set_edge(g, j++, i, i + xy, write_vt, gen_wt, arg);
+    }
+  }
+}
+
+/**
+   Selects a quadrant for graph_rmat with rand. The 0, 1, and 2 indices are
+   returned with the probabilities a / (RAND_MAX + 1), b / (RAND_MAX + 1),
+   and c / (RAND_MAX + 1), and the index 3 is returned otherwise. The
+   generator of rand is seeded by the user with srand. The function is not
+   thread-safe; graph_rmat_pthread requires a user-defined function with a
+   generator in the argument of each thread.
+   arg          : - NULL for the Graph500 probabilities 0.57, 0.19, and
+                  0.19 of the 0, 1, and 2 indices
+                  - otherwise pointer to an array of three int values a, b,
+                  and c, which are non-negative and a + b + c <= RAND_MAX
+*/
+size_t graph_rmat_quad(void *arg){
+  int r = rand();
+  const int *abc = (arg == NULL) ? C_RMAT_GRAPH500 : arg;
+  if (r < abc[0]) return 0;
+  r -= abc[0];
+  if (r < abc[1]) return 1;
+  r -= abc[1];
+  if (r < abc[2]) return 2;
+  return 3;
+}
+
+/**
+   Returns 1 with the probability p / (RAND_MAX + 1) and 0 otherwise with
+   rand, e.g. as the bern parameter of graph_subset or adj_lst_rand_dir.
+   The generator of rand is seeded by the user with srand. The function is
+   not thread-safe.
+   arg          : - NULL for the probability 1/2
+                  - otherwise pointer to an int value p in [0, RAND_MAX]
+*/
+int graph_bern(void *arg){
+  int p = (arg == NULL) ? C_BERN_HALF : *(const int *)arg;
+  return rand() < p;
+}
+
+/**
+   Copies each edge of a graph g with its weight to a graph h if bern
+   returns a non-zero value, in the order of the edges of g, e.g. to
+   generate a grid graph with a random half of the edges removed. The u, v,
+   and wts arrays of h are allocated by the call and are freed with
+   graph_free; a prior edge set of h, if any, must be freed with graph_free
+   before the call.
+   h            : pointer to a graph struct initialized with
+                  graph_base_init with the num_vts, vt_size, and wt_size of
+                  g
+   g            : pointer to a graph
+   bern         : returns 0 or 1 and takes arg as the value of its
+                  parameter
+   arg          : pointer that is taken as the value of the parameter of
+                  bern
+*/
+void graph_subset(struct graph *h,
+                  const struct graph *g,
+                  int (*bern)(void *),
+                  void *arg){
+  size_t i;
+  h->num_es = 0;
+  if (g->num_es == 0) return;
+  h->u = malloc_perror(g->num_es, g->vt_size);
+  h->v = malloc_perror(g->num_es, g->vt_size);
+  if (g->wt_size > 0) h->wts = malloc_perror(g->num_es, g->wt_size);
+  for (i = 0; i < g->num_es; i++){
+    if (!bern(arg)) continue;
+    memcpy(ptr(h->u, h->num_es, h->vt_size),
+           ptr(g->u, i, g->vt_size),
+           g->vt_size);
+    memcpy(ptr(h->v, h->num_es, h->vt_size),
+           ptr(g->v, i, g->vt_size),
+           g->vt_size);
+    if (g->wt_size > 0){
+      memcpy(ptr(h->wts, h->num_es, h->wt_size),
+             ptr(g->wts, i, g->wt_size),
+             g->wt_size);
+    }
+    h->num_es++;
+  }
+}
+
+/**
+   Selects an edge of an R-MAT graph with num_vts vertices by recursively
+   dividing the ranges of u and v vertices into halves according to the
+   quadrants returned by rand_quad, as in graph_rmat. The function is used
+   by the generators of graph_rmat and graph_rmat_pthread.
+   u            : pointer to a size_t object for the start vertex
+   v            : pointer to a size_t object for the end vertex
+   num_vts      : > 0 number of vertices
+   rand_quad    : returns a quadrant index in [0, 4) and takes arg as the
+                  value of its parameter; please see graph_rmat
+   arg          : pointer that is taken as the value of the parameter of
+                  rand_quad
+*/
+void graph_rmat_edge(size_t *u,
+                     size_t *v,
+                     size_t num_vts,
+                     size_t (*rand_quad)(void *),
+                     void *arg){
+  size_t q;
+  size_t u_count = num_vts, v_count = num_vts;
+  *u = 0;
+  *v = 0;
+  while (u_count > 1 || v_count > 1){
+    q = rand_quad(arg);
+    if (u_count > 1){
+      if (q & 2){
+        *u += u_count / 2;
+        u_count -= u_count / 2;
+      }else{
+        u_count /= 2;
+      }
+    }
+    if (v_count > 1){
+      if (q & 1){
+        *v += v_count / 2;
+        v_count -= v_count / 2;
+      }else{
+        v_count /= 2;
+      }
+    }
+  }
+}
+
+/**
+   Sets the ith edge of a graph to (u, v) and generates its weight with
+   gen_wt if gen_wt is not NULL. The function is used by the generators of
+   graph.h and graph-pthread.h.
+   g            : pointer to a graph with allocated u and v arrays, and an
+                  allocated wts array if gen_wt is not NULL
+   i            : index of an edge in [0, num_es)
+   u            : start vertex
+   v            : end vertex
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   gen_wt       : - NULL if the graph is not weighted
+                  - otherwise writes a weight value to the wt_size block
+                  pointed to by the first argument and takes arg as the
+                  value of its second parameter
+   arg          : pointer that is taken as the value of the second
+                  parameter of gen_wt
+*/
+void graph_set_edge(struct graph *g,
+                    size_t i,
+                    size_t u,
+                    size_t v,
+                    void (*write_vt)(void *, size_t),
+                    void (*gen_wt)(void *, void *),
+                    void *arg){
+  write_vt(ptr(g->u, i, g->vt_size), u);
+  write_vt(ptr(g->v, i, g->vt_size), v);
+  if (gen_wt != NULL) gen_wt(ptr(g->wts, i, g->wt_size), arg);
+}
+
+/**
+   Frees the u, v, and wts arrays of a graph that were allocated by a
+   graph_ generator, and leaves a block of size sizeof(struct graph)
+   pointed to by the g parameter. The arrays of graphs constructed by the
+   user are freed by the user.
+*/
+void graph_free(struct graph *g){
+  free(g->u); /* free(NULL) performs no operation */
+  free(g->v);
+  free(g->wts);
+  g->u = NULL;
+  g->v = NULL;
+  g->wts = NULL;
+}
+
 /**
    Initializes an empty adjacency list according to a graph. The alignment
    of vt_size and wt_size blocks in the adjacency list is computed by
@@ -180,6 +478,23 @@ void adj_lst_align(struct adj_lst *a,
   }
 }
 
+/**
+   Removes the bound of num_vts on the number of pairs in each list of an
+   adjacency list, which is required to represent a graph with multiple
+   edges between the same vertices, e.g. a graph generated by graph_rmat
+   or read from a file. The operation is optionally called after
+   adj_lst_base_init and optionally adj_lst_align are completed and before
+   any other adj_lst_ operation is called.
+   a            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init
+*/
+void adj_lst_unbound(struct adj_lst *a){
+  size_t i;
+  for (i = 0; i < a->num_vts; i++){
+    stack_bound(a->vt_wts[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+}
+
 /**
    Builds the adjacency list of a directed graph. The adjacency list keeps
    the effective type of the copied vt_size blocks (with integer values)
@@ -311,6 +626,42 @@ void adj_lst_add_undir_edge(struct adj_lst *a,
   }
 }
 
+/**
+   Deletes a batch of directed edges from the adjacency list of a directed
+   graph. For each (u, v) edge in the graph g, one pair with the vertex v
+   is removed from the list of u if such a pair exists, otherwise the edge
+   is ignored. The edges are grouped by u in O(num_vts + num_es) time, the
+   end vertices of each group are sorted, and each list is scanned once,
+   where a pair is removed by moving the last pair of the list into its
+   place. The order of pairs in a list with a removed pair is not
+   preserved. The weights of g are not used, and if a list contains
+   several pairs with the vertex v, then the removed pair is unspecified.
+   a            : pointer to an adjacency list
+   g            : pointer to the graph struct of a graph with the same
+                  num_vts and vt_size as the adjacency list, with the edges
+                  to be deleted
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+*/
+void adj_lst_dir_del(struct adj_lst *a,
+                     const struct graph *g,
+                     size_t (*read_vt)(const void *)){
+  del_edges(a, g, read_vt, 0);
+}
+
+/**
+   Deletes a batch of undirected edges from the adjacency list of an
+   undirected graph. For each (u, v) edge in the graph g, one pair with the
+   vertex v is removed from the list of u and one pair with the vertex u
+   is removed from the list of v, if such pairs exist. Please see the
+   specification of adj_lst_dir_del.
+*/
+void adj_lst_undir_del(struct adj_lst *a,
+                       const struct graph *g,
+                       size_t (*read_vt)(const void *)){
+  del_edges(a, g, read_vt, 1);
+}
+
 /**
    Builds the adjacency list of a directed graph with num_vts
    vertices, where each of the num_vts(num_vts - 1) possible edges is added
@@ -374,6 +725,358 @@ void adj_lst_rand_undir(struct adj_lst *a,
   }
 }
 
+/**
+   Builds the adjacency list of a directed graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1) possible edges is added according
+   to a Bernoulli distribution in O(num_vts + num_es) time. Instead of a
+   Bernoulli trial per possible edge, the possible edges of each vertex are
+   scanned in the increasing order of their end vertices by skipping over
+   geometrically distributed numbers of edges that are not added (geometric
+   skipping by Batagelj and Brandes), which results in the same distribution
+   of graphs as adj_lst_rand_dir. The added pairs of vt_size and wt_size
+   blocks are aligned in memory according to the preceding calls to
+   adj_lst_base_init and optionally adj_lst_align. If the graph is weighted,
+   then the effective type of the wt_size block in each vt_size and wt_size
+   block pair is not set and can be set by writing a weight value according
+   to wt_offset after the call is completed. If the graph is not weighted,
+   then there are no wt_size blocks.
+   a            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init and optionally with adj_lst_align
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+   geo          : takes arg as the value of its parameter and returns the
+                  number of failures before the first success in a sequence
+                  of independent Bernoulli trials, e.g. floor(log(U) /
+                  log(1 - p)) for U uniform on (0, 1] and 0 < p < 1, 0 for
+                  p = 1, and (size_t)-1 for p = 0; a value greater or equal
+                  to the number of the remaining possible edges of a vertex
+                  completes the list of the vertex
+   arg          : pointer that is taken as the value of the parameter of
+                  geo
+*/
+void adj_lst_rand_dir_geo(struct adj_lst *a,
+                          void (*write_vt)(void *, size_t),
+                          size_t (*geo)(void *),
+                          void *arg){
+  size_t i, j, k;
+  for (i = 0; i < a->num_vts; i++){
+    /* j is the index of the next possible edge (i, j + (j >= i)) */
+    j = 0;
+    while ((k = geo(arg)) < a->num_vts - 1 - j){
+      j += k;
+      write_vt(a->buf, j + (j >= i));
+      stack_push(a->vt_wts[i], a->buf);
+      a->num_es++;
+      j++;
+    }
+  }
+}
+
+/**
+   Builds the adjacency list of an undirected graph with num_vts vertices,
+   where each of the num_vts(num_vts - 1)/2 possible edges is added
+   according to a Bernoulli distribution in O(num_vts + num_es) time by
+   geometric skipping, which results in the same distribution of graphs as
+   adj_lst_rand_undir. If the graph is weighted, then the effective type of
+   the wt_size block in each vt_size and wt_size block pair is not set and
+   can be set by writing the same weight value into the two pairs
+   corresponding to (u, v) and (v, u) edges according to wt_offset after
+   the call is completed. Please see the parameter specification in
+   adj_lst_rand_dir_geo.
+*/
+void adj_lst_rand_undir_geo(struct adj_lst *a,
+                            void (*write_vt)(void *, size_t),
+                            size_t (*geo)(void *),
+                            void *arg){
+  size_t i, j, k;
+  for (i = 0; i + 1 < a->num_vts; i++){
+    /* j is the next possible end vertex of an (i, j) edge with i < j */
+    j = i + 1;
+    while ((k = geo(arg)) < a->num_vts - j){
+      j += k;
+      write_vt(a->buf, j);
+      stack_push(a->vt_wts[i], a->buf);
+      write_vt(a->buf, i);
+      stack_push(a->vt_wts[j], a->buf);
+      a->num_es += 2;
+      j++;
+    }
+  }
+}
+
+/**
+   Builds the adjacency list b as a copy of the adjacency list a with the
+   vertices relabeled according to a permutation, where the list of the
+   vertex u in a becomes the list of the vertex perm[u] in b, and the
+   end vertex v of each pair becomes perm[v]. The order of pairs in each
+   list and the wt_size blocks are preserved. Relabeling by a permutation
+   that improves the locality of vertex ids, e.g. computed by the reorder
+   module, may improve the cache efficiency of algorithms without changes
+   to the algorithms.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges
+   a            : pointer to an adjacency list
+   perm         : pointer to an array of num_vts size_t elements, where
+                  perm[u] is the new label of the vertex u and each value in
+                  [0, num_vts) appears once
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+*/
+void adj_lst_relabel(struct adj_lst *b,
+                     const struct adj_lst *a,
+                     const size_t *perm,
+                     size_t (*read_vt)(const void *),
+                     void (*write_vt)(void *, size_t)){
+  size_t i;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      write_vt(b->buf, perm[read_vt(p)]);
+      if (a->wt_size > 0){
+        memcpy((char *)b->buf + b->wt_offset,
+               (char *)p + a->wt_offset,
+               a->wt_size);
+      }
+      stack_push(b->vt_wts[perm[i]], b->buf);
+    }
+  }
+  b->num_es = a->num_es;
+}
+
+/**
+   Builds the adjacency list b of the transpose of the graph of the
+   adjacency list a, where each (u, v) pair in the list of u in a becomes
+   a (v, u) pair in the list of v in b with the same wt_size block. The
+   pairs in each list of b are in the non-decreasing order of vertices,
+   and the pairs with the same vertex are in the order of the list in a.
+   The transpose provides the in-edges of a directed graph, e.g. for
+   backward search and pull-based algorithms.
+   b            : pointer to an adj_lst struct initialized with
+                  adj_lst_base_init according to a graph with the same
+                  num_vts, vt_size, and wt_size as a, optionally with
+                  adj_lst_align and adj_lst_unbound, and with no edges;
+                  unbounded if an in-degree may exceed num_vts
+   a            : pointer to an adjacency list
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+   write_vt     : writes the integer value of the second argument to
+                  the vt_size block pointed to by the first argument
+                  as a value of the integer type used to represent vertices
+*/
+void adj_lst_transpose(struct adj_lst *b,
+                       const struct adj_lst *a,
+                       size_t (*read_vt)(const void *),
+                       void (*write_vt)(void *, size_t)){
+  size_t i;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    write_vt(b->buf, i);
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      if (a->wt_size > 0){
+        memcpy((char *)b->buf + b->wt_offset,
+               (char *)p + a->wt_offset,
+               a->wt_size);
+      }
+      stack_push(b->vt_wts[read_vt(p)], b->buf);
+    }
+  }
+  b->num_es = a->num_es;
+}
+
+/**
+   Sorts the pairs of each list of an adjacency list in the non-decreasing
+   order of vertices according to cmp_vt, in O(d log d) expected time for
+   a list of d pairs. The wt_size block of each pair is moved together
+   with its vt_size block, and the order of the pairs with the same
+   vertex is unspecified. The sorted lists enable adj_lst_dedup and
+   adj_lst_has_edge, and a sequential access of the end vertices.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns a negative integer
+                  value if the value in the vt_size block pointed to by the
+                  first argument is less than the value in the vt_size
+                  block pointed to by the second argument, a positive
+                  integer value if the former is greater than the latter,
+                  and zero otherwise
+*/
+void adj_lst_sort(struct adj_lst *a,
+                  int (*cmp_vt)(const void *, const void *)){
+  size_t i;
+  for (i = 0; i < a->num_vts; i++){
+    adj_lst_vt_sort(a, i, cmp_vt);
+  }
+}
+
+/**
+   Removes the duplicate pairs from each list of an adjacency list, where
+   the pairs with the same vertex are consecutive in each list, e.g. after
+   adj_lst_sort, by keeping the first pair with a given vertex in O(d)
+   time for a list of d pairs. The order of the remaining pairs is
+   preserved and num_es is decreased by the number of removed pairs. If a
+   graph is weighted, the wt_size block of the first pair is kept, which
+   after adj_lst_sort is unspecified.
+   a            : pointer to an adjacency list
+   cmp_vt       : comparison function which returns zero if and only if
+                  the values in the vt_size blocks pointed to by the two
+                  arguments are equal, e.g. a comparison function of
+                  adj_lst_sort or a graph_cmpeq_ function
+*/
+void adj_lst_dedup(struct adj_lst *a,
+                   int (*cmp_vt)(const void *, const void *)){
+  size_t i;
+  for (i = 0; i < a->num_vts; i++){
+    a->num_es -= adj_lst_vt_dedup(a, i, a->buf, cmp_vt);
+  }
+}
+
+/**
+   Sorts the pairs of the list of the vertex u according to the
+   specification of adj_lst_sort. The lists of different vertices can be
+   sorted by different threads.
+   a            : pointer to an adjacency list
+   u            : vertex in [0, num_vts)
+   cmp_vt       : comparison function; please see adj_lst_sort
+*/
+void adj_lst_vt_sort(const struct adj_lst *a,
+                     size_t u,
+                     int (*cmp_vt)(const void *, const void *)){
+  struct stack *s = a->vt_wts[u];
+  if (s->num_elts > 1) qsort(s->elts, s->num_elts, a->pair_size, cmp_vt);
+}
+
+/**
+   Removes the duplicate pairs from the list of the vertex u according to
+   the specification of adj_lst_dedup, and returns the number of removed
+   pairs. num_es is not modified, so that the lists of different vertices
+   can be processed by different threads, and is decreased by the caller.
+   a            : pointer to an adjacency list
+   u            : vertex in [0, num_vts)
+   buf          : pointer to a pair_size block, where the removed pairs are
+                  popped, e.g. a->buf or a block of a thread
+   cmp_vt       : comparison function; please see adj_lst_dedup
+*/
+size_t adj_lst_vt_dedup(const struct adj_lst *a,
+                        size_t u,
+                        void *buf,
+                        int (*cmp_vt)(const void *, const void *)){
+  size_t k, n = 1, ret;
+  struct stack *s = a->vt_wts[u];
+  if (s->num_elts < 2) return 0;
+  for (k = 1; k < s->num_elts; k++){
+    if (cmp_vt(ptr(s->elts, n - 1, a->pair_size),
+               ptr(s->elts, k, a->pair_size)) != 0){
+      if (n < k){
+        memcpy(ptr(s->elts, n, a->pair_size),
+               ptr(s->elts, k, a->pair_size),
+               a->pair_size);
+      }
+      n++;
+    }
+  }
+  ret = s->num_elts - n;
+  while (s->num_elts > n){
+    stack_pop(s, buf);
+  }
+  return ret;
+}
+
+/**
+   Removes from the list of the vertex u one pair per element of the array
+   vs of num end vertices, if such a pair exists, by moving the last pair
+   into the place of a removed pair, and returns the number of removed
+   pairs. The array vs is sorted by the call, and the list is scanned once
+   with a binary search in vs for each pair. num_es is not modified, so
+   that the lists of different vertices can be processed by different
+   threads, and is decreased by the caller.
+   a            : pointer to an adjacency list
+   u            : vertex in [0, num_vts)
+   vs           : pointer to an array of num end vertices
+   num          : number of elements in vs
+   cnts         : pointer to an array of at least num size_t elements that
+                  is used to count the removed pairs
+   buf          : pointer to a pair_size block, where the removed pairs are
+                  popped, e.g. a->buf or a block of a thread
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+*/
+size_t adj_lst_vt_del(const struct adj_lst *a,
+                      size_t u,
+                      size_t *vs,
+                      size_t num,
+                      size_t *cnts,
+                      void *buf,
+                      size_t (*read_vt)(const void *)){
+  size_t k = 0, ret = 0;
+  size_t v, lb, ub;
+  void *p = NULL;
+  struct stack *s = a->vt_wts[u];
+  qsort(vs, num, sizeof(size_t), graph_cmp_sz);
+  memset(cnts, 0, num * sizeof(size_t));
+  while (k < s->num_elts && ret < num){
+    p = ptr(s->elts, k, a->pair_size);
+    v = read_vt(p);
+    lb = lower_bound(vs, num, v);
+    if (lb < num && vs[lb] == v){
+      ub = lower_bound(vs, num, v + 1);
+      if (cnts[lb] < ub - lb){
+        cnts[lb]++;
+        ret++;
+        stack_pop(s, (k == s->num_elts - 1) ? buf : p);
+        continue;
+      }
+    }
+    k++;
+  }
+  return ret;
+}
+
+/**
+   Returns 1 if the list of the vertex u contains a pair with the vertex v
+   and 0 otherwise. The list is assumed to be sorted in the non-decreasing
+   order of vertices, e.g. with adj_lst_sort. The search gallops from the
+   start of the list by doubling the step and performs a binary search in
+   the last step, in O(log k) time if the first pair with a vertex not
+   less than v is the kth pair, which for high-degree vertices is
+   O(log d) in the worst case and less if v is near the start.
+   a            : pointer to an adjacency list with sorted lists
+   u            : start vertex in [0, num_vts)
+   v            : end vertex
+   read_vt      : reads the integer value in the vt_size block of a vertex
+                  pointed to by the argument and returns a size_t value
+*/
+int adj_lst_has_edge(const struct adj_lst *a,
+                     size_t u,
+                     size_t v,
+                     size_t (*read_vt)(const void *)){
+  size_t l = 0, h = 1, m;
+  size_t num = a->vt_wts[u]->num_elts;
+  const void *elts = a->vt_wts[u]->elts;
+  /* gallop: vertices at indices below l are less than v */
+  while (h < num && read_vt(ptr(elts, h - 1, a->pair_size)) < v){
+    l = h;
+    h = (h > num - h) ? num : 2 * h;
+  }
+  if (h > num) h = num;
+  while (l < h){
+    m = l + (h - l) / 2;
+    if (read_vt(ptr(elts, m, a->pair_size)) < v){
+      l = m + 1;
+    }else{
+      h = m;
+    }
+  }
+  return (l < num && read_vt(ptr(elts, l, a->pair_size)) == v);
+}
+
 /**
    Frees the memory allocated by adj_lst_base_init and any subsequent
    calls to adj_lst_ operations, and leaves a block of size
@@ -683,3 +1386,83 @@ void graph_add_long_perror(void *s, const void *a, const void *b){
   }
   *(long *)s = *(const long *)a + *(const long *)b;
 }
+
+/**
+   Deletes a batch of directed edges, or of undirected edges if is_undir
+   is nonzero, by grouping the end vertices by start vertex with a
+   counting sort, and sorting and deleting each group with adj_lst_vt_del.
+*/
+static void del_edges(struct adj_lst *a,
+                      const struct graph *g,
+                      size_t (*read_vt)(const void *),
+                      int is_undir){
+  size_t i, u, start;
+  size_t max_num = 0;
+  size_t *offsets = NULL, *vs = NULL, *cnts = NULL;
+  if (g->num_es == 0) return;
+  offsets = calloc_perror(add_sz_perror(a->num_vts, 1), sizeof(size_t));
+  vs = malloc_perror(mul_sz_perror(g->num_es, 1 + (is_undir != 0)),
+                     sizeof(size_t));
+  for (i = 0; i < g->num_es; i++){
+    offsets[read_vt(ptr(g->u, i, g->vt_size)) + 1]++;
+    if (is_undir) offsets[read_vt(ptr(g->v, i, g->vt_size)) + 1]++;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    if (offsets[i + 1] > max_num) max_num = offsets[i + 1];
+    offsets[i + 1] += offsets[i];
+  }
+  /* after scattering, offsets[u] is the end of the group of u */
+  for (i = 0; i < g->num_es; i++){
+    u = read_vt(ptr(g->u, i, g->vt_size));
+    vs[offsets[u]++] = read_vt(ptr(g->v, i, g->vt_size));
+    if (is_undir){
+      u = read_vt(ptr(g->v, i, g->vt_size));
+      vs[offsets[u]++] = read_vt(ptr(g->u, i, g->vt_size));
+    }
+  }
+  cnts = malloc_perror(max_num, sizeof(size_t));
+  start = 0;
+  for (i = 0; i < a->num_vts; i++){
+    if (offsets[i] > start){
+      a->num_es -= adj_lst_vt_del(a,
+                                  i,
+                                  &vs[start],
+                                  offsets[i] - start,
+                                  cnts,
+                                  a->buf,
+                                  read_vt);
+    }
+    start = offsets[i];
+  }
+  free(offsets);
+  free(vs);
+  free(cnts);
+  offsets = NULL;
+  vs = NULL;
+  cnts = NULL;
+}
+
+/**
+   Returns the index of the first element in a sorted array of num
+   size_t elements that is not less than v, or num if there is no such
+   element.
+*/
+static size_t lower_bound(const size_t *vs, size_t num, size_t v){
+  size_t l = 0, h = num, m;
+  while (l < h){
+    m = l + (h - l) / 2;
+    if (vs[m] < v){
+      l = m + 1;
+    }else{
+      h = m;
+    }
+  }
+  return l;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
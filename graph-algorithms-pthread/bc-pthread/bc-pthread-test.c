@@ -0,0 +1,432 @@
+/**
+   bc-pthread-test.c
+
+   Tests of betweenness centrality with multiple threads across graphs with
+   different integer types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   bc-pthread-test
+      [0, ushort width - 2] : n for 2**n vertices in smallest graph
+      [0, ushort width - 2] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : unweighted R-MAT graph test on/off
+      [0, 1] : weighted R-MAT graph test on/off
+
+   usage examples:
+   ./bc-pthread-test
+   ./bc-pthread-test 5 8
+   ./bc-pthread-test 5 8 8
+   ./bc-pthread-test 5 8 8 0 1
+
+   bc-pthread-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "bc-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "bc-pthread-test \n"
+  "[0, ushort width - 2] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 2] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : unweighted R-MAT graph test on/off \n"
+  "[0, 1] : weighted R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {0u, 7u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+void *(* const C_AT[4])(const void *, const void *) ={
+  graph_at_ushort,
+  graph_at_uint,
+  graph_at_ulong,
+  graph_at_sz};
+int (* const C_CMPEQ[4])(const void *, const void *) ={
+  graph_cmpeq_ushort,
+  graph_cmpeq_uint,
+  graph_cmpeq_ulong,
+  graph_cmpeq_sz};
+void (* const C_INCR[4])(void *) ={
+  graph_incr_ushort,
+  graph_incr_uint,
+  graph_incr_ulong,
+  graph_incr_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTOR = 4u;
+const size_t C_SAMPLE_DIV = 4u; /* num_vts / 4 + 1 sampled sources */
+const long C_WT_ZERO = 0;
+const long C_WT_RANGE = 4; /* weights in [1, 4] result in ties */
+const double C_BC_ZERO = 0.0;
+const double C_BC_ONE = 1.0;
+const double C_BC_TOL = 1e-9;
+
+void add_double(void *s, const void *a, const void *b);
+void add_dep_double(void *d,
+                    const void *sv,
+                    const void *sw,
+                    const void *dw);
+void bc_def(const struct adj_lst *a,
+            const size_t *srcs,
+            size_t num_srcs,
+            double *bc,
+            size_t (*read_vt)(const void *));
+int cmp_bc(const double *a, const double *b, size_t n);
+void rand_perm(size_t *perm, size_t n);
+void print_test_result(int res);
+
+/**
+   Runs bc_pthread or bc_wt_pthread with one thread and with num_threads
+   threads from all vertices, and with num_threads threads from a random
+   sample of vertices, and compares the results with the centralities
+   computed according to the definition.
+*/
+void bc_helper(const struct adj_lst *a,
+               size_t j,
+               size_t num_threads,
+               int *res){
+  size_t n = a->num_vts;
+  size_t num_srcs = n / C_SAMPLE_DIV + 1;
+  size_t *srcs = NULL;
+  double *bc = NULL, *bc_thds = NULL, *bc_smpl = NULL;
+  double *bc_d = NULL, *bc_smpl_d = NULL;
+  clock_t t_one, t_thds;
+  srcs = malloc_perror(n, sizeof(size_t));
+  bc = malloc_perror(n, sizeof(double));
+  bc_thds = malloc_perror(n, sizeof(double));
+  bc_smpl = malloc_perror(n, sizeof(double));
+  bc_d = malloc_perror(n, sizeof(double));
+  bc_smpl_d = malloc_perror(n, sizeof(double));
+  rand_perm(srcs, n);
+  if (a->wt_size == 0){
+    t_one = clock();
+    bc_pthread(a, NULL, 0, bc, sizeof(double), &C_BC_ZERO, &C_BC_ONE,
+               C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j], C_INCR[j],
+               add_double, add_dep_double, 1);
+    t_one = clock() - t_one;
+    t_thds = clock();
+    bc_pthread(a, NULL, 0, bc_thds, sizeof(double), &C_BC_ZERO, &C_BC_ONE,
+               C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j], C_INCR[j],
+               add_double, add_dep_double, num_threads);
+    t_thds = clock() - t_thds;
+    bc_pthread(a, srcs, num_srcs, bc_smpl, sizeof(double),
+               &C_BC_ZERO, &C_BC_ONE,
+               C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j], C_INCR[j],
+               add_double, add_dep_double, num_threads);
+  }else{
+    t_one = clock();
+    bc_wt_pthread(a, NULL, 0, bc, sizeof(double), &C_BC_ZERO, &C_BC_ONE,
+                  &C_WT_ZERO, C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j],
+                  graph_cmp_long, graph_add_long,
+                  add_double, add_dep_double, 1);
+    t_one = clock() - t_one;
+    t_thds = clock();
+    bc_wt_pthread(a, NULL, 0, bc_thds, sizeof(double),
+                  &C_BC_ZERO, &C_BC_ONE,
+                  &C_WT_ZERO, C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j],
+                  graph_cmp_long, graph_add_long,
+                  add_double, add_dep_double, num_threads);
+    t_thds = clock() - t_thds;
+    bc_wt_pthread(a, srcs, num_srcs, bc_smpl, sizeof(double),
+                  &C_BC_ZERO, &C_BC_ONE,
+                  &C_WT_ZERO, C_READ[j], C_WRITE[j], C_AT[j], C_CMPEQ[j],
+                  graph_cmp_long, graph_add_long,
+                  add_double, add_dep_double, num_threads);
+  }
+  printf("\t\t\t%s one thread time:      %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], (double)t_one / CLOCKS_PER_SEC);
+  printf("\t\t\t%s %lu thread(s) time:     %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], TOLU(num_threads), (double)t_thds / CLOCKS_PER_SEC);
+  bc_def(a, NULL, 0, bc_d, C_READ[j]);
+  bc_def(a, srcs, num_srcs, bc_smpl_d, C_READ[j]);
+  *res *= cmp_bc(bc, bc_d, n);
+  *res *= cmp_bc(bc_thds, bc_d, n);
+  *res *= cmp_bc(bc_smpl, bc_smpl_d, n);
+  free(srcs);
+  free(bc);
+  free(bc_thds);
+  free(bc_smpl);
+  free(bc_d);
+  free(bc_smpl_d);
+  srcs = NULL;
+  bc = NULL;
+  bc_thds = NULL;
+  bc_smpl = NULL;
+  bc_d = NULL;
+  bc_smpl_d = NULL;
+}
+
+/**
+   Run tests on directed and undirected R-MAT graphs, which may have
+   multiple edges between the same vertices. If wt_size is non-zero, the
+   graphs have weights of the long type in [1, C_WT_RANGE].
+*/
+
+void gen_wt(void *wt, void *arg){
+  (void)arg;
+  *(long *)wt = 1 + RANDOM() % C_WT_RANGE;
+}
+
+void run_rmat_test(size_t log_start,
+                   size_t log_end,
+                   size_t num_threads,
+                   size_t wt_size){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test %s on %s R-MAT graphs\n",
+         (wt_size == 0) ? "bc_pthread" : "bc_wt_pthread",
+         (wt_size == 0) ? "unweighted" : "weighted");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts),
+           TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], wt_size);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, (wt_size == 0) ? NULL : gen_wt,
+                 NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      bc_helper(&a, j, num_threads, &res);
+      adj_lst_free(&a);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      bc_helper(&a, j, num_threads, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Operations on the values of the double type for centralities.
+*/
+void add_double(void *s, const void *a, const void *b){
+  *(double *)s = *(const double *)a + *(const double *)b;
+}
+
+void add_dep_double(void *d,
+                    const void *sv,
+                    const void *sw,
+                    const void *dw){
+  *(double *)d += *(const double *)sv / *(const double *)sw *
+    (1.0 + *(const double *)dw);
+}
+
+/**
+   Computes the betweenness centralities according to the definition as
+   sums of sigma(s, v) * sigma(v, t) / sigma(s, t) for each source s and
+   each t, where d(s, v) + d(v, t) = d(s, t), and sigma(u, v) is the number
+   of shortest paths from u to v. The distances and the numbers of paths
+   between all pairs are computed by an array-based Dijkstra's algorithm
+   from each vertex. The weight of an edge is 1 if a graph is unweighted.
+*/
+void bc_def(const struct adj_lst *a,
+            const size_t *srcs,
+            size_t num_srcs,
+            double *bc,
+            size_t (*read_vt)(const void *)){
+  size_t i, k, s, u, v, w, t;
+  size_t n = a->num_vts;
+  size_t *ord = NULL;
+  unsigned char *done = NULL;
+  long wt = 1;
+  long *dist = NULL;
+  double *sig = NULL;
+  const char *p = NULL;
+  ord = malloc_perror(n, sizeof(size_t));
+  done = malloc_perror(n, sizeof(unsigned char));
+  dist = malloc_perror(mul_sz_perror(n, n), sizeof(long));
+  sig = malloc_perror(mul_sz_perror(n, n), sizeof(double));
+  for (u = 0; u < n; u++){
+    for (v = 0; v < n; v++){
+      dist[u * n + v] = LONG_MAX;
+      sig[u * n + v] = 0.0;
+      done[v] = 0;
+    }
+    dist[u * n + u] = 0;
+    for (i = 0; i < n; i++){
+      v = n;
+      for (w = 0; w < n; w++){
+        if (!done[w] && dist[u * n + w] < LONG_MAX &&
+            (v == n || dist[u * n + w] < dist[u * n + v])) v = w;
+      }
+      if (v == n) break;
+      done[v] = 1;
+      ord[i] = v;
+      p = a->vt_wts[v]->elts;
+      for (k = 0; k < a->vt_wts[v]->num_elts; k++){
+        if (a->wt_size > 0) memcpy(&wt, p + a->wt_offset, sizeof(long));
+        w = read_vt(p);
+        if (dist[u * n + v] + wt < dist[u * n + w]){
+          dist[u * n + w] = dist[u * n + v] + wt;
+        }
+        p += a->pair_size;
+      }
+    }
+    /* i vertices are reached in the non-decreasing order of distances */
+    sig[u * n + u] = 1.0;
+    for (t = 0; t < i; t++){
+      v = ord[t];
+      p = a->vt_wts[v]->elts;
+      for (k = 0; k < a->vt_wts[v]->num_elts; k++){
+        if (a->wt_size > 0) memcpy(&wt, p + a->wt_offset, sizeof(long));
+        w = read_vt(p);
+        if (dist[u * n + v] + wt == dist[u * n + w]){
+          sig[u * n + w] += sig[u * n + v];
+        }
+        p += a->pair_size;
+      }
+    }
+  }
+  for (v = 0; v < n; v++){
+    bc[v] = 0.0;
+  }
+  for (i = 0; i < ((srcs == NULL) ? n : num_srcs); i++){
+    s = (srcs == NULL) ? i : srcs[i];
+    for (v = 0; v < n; v++){
+      if (v == s || dist[s * n + v] == LONG_MAX) continue;
+      for (t = 0; t < n; t++){
+        if (t == s || t == v || dist[v * n + t] == LONG_MAX) continue;
+        if (dist[s * n + v] + dist[v * n + t] == dist[s * n + t]){
+          bc[v] += sig[s * n + v] * sig[v * n + t] / sig[s * n + t];
+        }
+      }
+    }
+  }
+  free(ord);
+  free(done);
+  free(dist);
+  free(sig);
+  ord = NULL;
+  done = NULL;
+  dist = NULL;
+  sig = NULL;
+}
+
+/**
+   Returns 1 if the centralities in two arrays are equal within a relative
+   tolerance, otherwise returns 0.
+*/
+int cmp_bc(const double *a, const double *b, size_t n){
+  int ret = 1;
+  size_t i;
+  double diff;
+  for (i = 0; i < n; i++){
+    diff = (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+    ret *= (diff <= C_BC_TOL * (1.0 + ((b[i] > 0.0) ? b[i] : -b[i])));
+  }
+  return ret;
+}
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 2 ||
+      args[1] > C_USHORT_BIT - 2 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_rmat_test(args[0], args[1], args[2], 0);
+  if (args[4]) run_rmat_test(args[0], args[1], args[2], sizeof(long));
+  free(args);
+  args = NULL;
+  return 0;
+}
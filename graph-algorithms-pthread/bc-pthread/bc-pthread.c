@@ -0,0 +1,496 @@
+/**
+   bc-pthread.c
+
+   Functions for computing the betweenness centrality of the vertices of
+   graphs with generic integer vertices indexed from 0 according to
+   Brandes' algorithm with multiple threads.
+   A graph may be unweighted, in which case bfs in bfs.h is run from each
+   source, or weighted with positive generic weights, in which case
+   dijkstra in dijkstra.h is run from each source.
+
+   After a traversal from a source s, the reached vertices are ordered by
+   their distances from s, the numbers of shortest paths from s are
+   computed in the increasing order of distances, and the dependencies of
+   s on the vertices are accumulated in the decreasing order of distances.
+   An edge (v, w) is on a shortest path from s iff the distance of w equals
+   the distance of v plus the weight of the edge, and only the outgoing
+   edges of vertices are scanned. The sources are taken by num_threads
+   threads one at a time, each thread accumulates the dependencies in its
+   own array, and the arrays of the threads are reduced in parallel after
+   all sources are processed.
+
+   The betweenness centrality of v is the sum of the dependencies of the
+   sources on v, where a dependency of s on v is the sum of the fractions
+   of the shortest paths from s to t that pass through v, for each t. The
+   numbers of shortest paths, the dependencies, and the centralities are
+   represented by a user-provided type, e.g. a floating-point type on
+   suitable systems, and are only modified by user-provided functions.
+   If the sources are a sample of k vertices, multiplying the computed
+   values by num_vts / k provides unbiased estimates. If a graph is
+   undirected, then each pair of vertices is counted twice.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "bc-pthread.h"
+#include "bfs.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the betweenness centrality of the vertices of a graph, where
+   the weights, if any, are ignored, with num_threads threads. Runs in
+   O(k * (num_vts + num_es)) time, where k is the number of sources, which
+   is split across threads.
+   a           : pointer to an adjacency list with at least one and at most
+                 2**P - 1 vertices, where P is the precision of the integer
+                 type used to represent vertices
+   srcs        : - NULL pointer, if every vertex is a source
+                 - otherwise pointer to an array of num_srcs sources, e.g.
+                 a random sample of vertices
+   num_srcs    : number of sources, if srcs is not NULL
+   bc          : pointer to a preallocated array of num_vts bc_size blocks,
+                 where the centrality of v is set at the index v
+   bc_size     : non-zero size of the type used to represent the numbers of
+                 paths, the dependencies, and the centralities
+   bc_zero     : pointer to a block of size bc_size with a zero value
+   bc_one      : pointer to a block of size bc_size with a value one
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   at_vt       : returns a pointer to the element in the array pointed to by
+                 the first argument at the index pointed to by the second
+                 argument; the first argument points to the integer type
+                 used to represent vertices and is not dereferenced; the
+                 second argument points to a value of the integer type used
+                 to represent vertices and is dereferenced
+   cmp_vt      : returns 0 iff the element pointed to by the first
+                 argument is equal to the element pointed to by the second
+                 argument; each argument points to a value of the integer
+                 type used to represent vertices
+   incr_vt     : increments a value of the integer type used to represent
+                 vertices
+   add_bc      : addition function which copies the sum of the values
+                 pointed to by the second and third arguments to the
+                 preallocated bc_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument; the function is called concurrently by threads
+                 and must be thread-safe
+   add_dep     : adds to the value pointed to by the first argument the
+                 ratio of the values pointed to by the second and third
+                 arguments multiplied by the sum of one and the value
+                 pointed to by the fourth argument, i.e. d += sv / sw *
+                 (1 + dw), where the value pointed to by the third argument
+                 is non-zero; the function is called concurrently by
+                 threads and must be thread-safe
+   num_threads : > 0 number of threads
+*/
+
+struct bc_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t *next;              /* next source, shared across threads */
+  pthread_mutex_t *lock;     /* guards next */
+  const struct adj_lst *a;
+  const size_t *srcs;
+  size_t num_srcs;
+  void *bc;
+  void *accs;                /* dependency sums, num_vts per thread */
+  size_t bc_size;
+  const void *bc_zero;
+  const void *bc_one;
+  const void *wt_zero;       /* NULL if the weights are ignored */
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+  void *(*at_vt)(const void *, const void *);
+  int (*cmp_vt)(const void *, const void *);
+  void (*incr_vt)(void *);
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+  void (*add_bc)(void *, const void *, const void *);
+  void (*add_dep)(void *, const void *, const void *, const void *);
+};
+
+/**
+   Orders the reached vertices by their distances with a counting sort
+   if the weights are ignored, and with a merge sort otherwise. Returns
+   the number of reached vertices, which are copied to the array pointed
+   to by ord. The array pointed to by buf has num_vts + 1 elements.
+*/
+static size_t sort_rch(const struct bc_arg *ba,
+                       const void *dist,
+                       const void *prev,
+                       size_t *ord,
+                       size_t *buf){
+  size_t i, j, k, m, v;
+  size_t lo, mid, hi;
+  size_t num = 0;
+  size_t *src = ord, *dst = buf, *tmp = NULL;
+  const struct adj_lst *a = ba->a;
+  if (ba->wt_zero == NULL){
+    for (i = 0; i <= a->num_vts; i++){
+      buf[i] = 0;
+    }
+    for (v = 0; v < a->num_vts; v++){
+      if (ba->read_vt(ptr(prev, v, a->vt_size)) == a->num_vts) continue;
+      buf[ba->read_vt(ptr(dist, v, a->vt_size)) + 1]++;
+      num++;
+    }
+    for (i = 1; i < a->num_vts; i++){
+      buf[i] += buf[i - 1];
+    }
+    for (v = 0; v < a->num_vts; v++){
+      if (ba->read_vt(ptr(prev, v, a->vt_size)) == a->num_vts) continue;
+      ord[buf[ba->read_vt(ptr(dist, v, a->vt_size))]++] = v;
+    }
+    return num;
+  }
+  for (v = 0; v < a->num_vts; v++){
+    if (ba->read_vt(ptr(prev, v, a->vt_size)) != a->num_vts) ord[num++] = v;
+  }
+  for (m = 1; m < num; m *= 2){
+    for (lo = 0; lo < num; lo += 2 * m){
+      mid = (num - lo < m) ? num : lo + m;
+      hi = (num - mid < m) ? num : mid + m;
+      i = lo;
+      j = mid;
+      k = lo;
+      while (i < mid && j < hi){
+        if (ba->cmp_wt(ptr(dist, src[j], a->wt_size),
+                       ptr(dist, src[i], a->wt_size)) < 0){
+          dst[k++] = src[j++];
+        }else{
+          dst[k++] = src[i++];
+        }
+      }
+      while (i < mid) dst[k++] = src[i++];
+      while (j < hi) dst[k++] = src[j++];
+    }
+    tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+  if (src != ord) memcpy(ord, src, num * sizeof(size_t));
+  return num;
+}
+
+/**
+   Returns 1 if the edge from v at the pair pointed to by p is on a
+   shortest path from the source, otherwise returns 0. The block pointed
+   to by s is used for the sum of weights.
+*/
+static int is_sp(const struct bc_arg *ba,
+                 const void *dist,
+                 size_t v,
+                 const void *p,
+                 void *s){
+  const struct adj_lst *a = ba->a;
+  if (ba->wt_zero == NULL){
+    return (ba->read_vt(ptr(dist, ba->read_vt(p), a->vt_size)) ==
+            ba->read_vt(ptr(dist, v, a->vt_size)) + 1);
+  }
+  ba->add_wt(s, ptr(dist, v, a->wt_size), (const char *)p + a->wt_offset);
+  return (ba->cmp_wt(ptr(dist, ba->read_vt(p), a->wt_size), s) == 0);
+}
+
+static void *bc_thread(void *arg){
+  size_t i, k, u, v, w;
+  size_t num_rch;
+  size_t *ord = NULL, *buf = NULL;
+  void *dist = NULL, *prev = NULL, *sigma = NULL, *delta = NULL;
+  void *acc = NULL, *s = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct bc_arg *ba = arg;
+  const struct adj_lst *a = ba->a;
+  size_t n = a->num_vts;
+  size_t bc_size = ba->bc_size;
+  dist = malloc_perror(n, (ba->wt_zero == NULL) ? a->vt_size : a->wt_size);
+  prev = malloc_perror(n, a->vt_size);
+  ord = malloc_perror(n, sizeof(size_t));
+  buf = malloc_perror(add_sz_perror(n, 1), sizeof(size_t));
+  sigma = malloc_perror(n, bc_size);
+  delta = malloc_perror(n, bc_size);
+  if (ba->wt_zero != NULL) s = malloc_perror(1, a->wt_size);
+  acc = ptr(ba->accs, mul_sz_perror(ba->ix, n), bc_size);
+  for (v = 0; v < n; v++){
+    memcpy(ptr(acc, v, bc_size), ba->bc_zero, bc_size);
+  }
+  while (1){
+    mutex_lock_perror(ba->lock);
+    i = (*ba->next)++;
+    mutex_unlock_perror(ba->lock);
+    if (i >= ba->num_srcs) break;
+    u = (ba->srcs == NULL) ? i : ba->srcs[i];
+    if (ba->wt_zero == NULL){
+      bfs(a, u, dist, prev,
+          ba->read_vt, ba->write_vt, ba->at_vt, ba->cmp_vt, ba->incr_vt);
+    }else{
+      dijkstra(a, u, dist, prev, ba->wt_zero, NULL,
+               ba->read_vt, ba->write_vt, ba->at_vt, ba->cmp_vt,
+               ba->cmp_wt, ba->add_wt);
+    }
+    num_rch = sort_rch(ba, dist, prev, ord, buf);
+    for (k = 0; k < num_rch; k++){
+      memcpy(ptr(sigma, ord[k], bc_size), ba->bc_zero, bc_size);
+      memcpy(ptr(delta, ord[k], bc_size), ba->bc_zero, bc_size);
+    }
+    memcpy(ptr(sigma, u, bc_size), ba->bc_one, bc_size);
+    /* numbers of shortest paths in the increasing order of distances */
+    for (k = 0; k < num_rch; k++){
+      v = ord[k];
+      p_start = a->vt_wts[v]->elts;
+      p_end = ptr(p_start, a->vt_wts[v]->num_elts, a->pair_size);
+      for (p = p_start; p != p_end; p = (const char *)p + a->pair_size){
+        if (is_sp(ba, dist, v, p, s)){
+          w = ba->read_vt(p);
+          ba->add_bc(ptr(sigma, w, bc_size),
+                     ptr(sigma, w, bc_size),
+                     ptr(sigma, v, bc_size));
+        }
+      }
+    }
+    /* dependencies in the decreasing order of distances */
+    for (k = num_rch; k > 0; k--){
+      v = ord[k - 1];
+      p_start = a->vt_wts[v]->elts;
+      p_end = ptr(p_start, a->vt_wts[v]->num_elts, a->pair_size);
+      for (p = p_start; p != p_end; p = (const char *)p + a->pair_size){
+        if (is_sp(ba, dist, v, p, s)){
+          w = ba->read_vt(p);
+          ba->add_dep(ptr(delta, v, bc_size),
+                      ptr(sigma, v, bc_size),
+                      ptr(sigma, w, bc_size),
+                      ptr(delta, w, bc_size));
+        }
+      }
+      if (v != u){
+        ba->add_bc(ptr(acc, v, bc_size),
+                   ptr(acc, v, bc_size),
+                   ptr(delta, v, bc_size));
+      }
+    }
+  }
+  free(dist);
+  free(prev);
+  free(ord);
+  free(buf);
+  free(sigma);
+  free(delta);
+  free(s);
+  dist = NULL;
+  prev = NULL;
+  ord = NULL;
+  buf = NULL;
+  sigma = NULL;
+  delta = NULL;
+  s = NULL;
+  acc = NULL;
+  return NULL;
+}
+
+/**
+   Sums the dependencies accumulated by the threads for a contiguous range
+   of vertices, where the ranges of the first threads have one more
+   vertex.
+*/
+static void *reduce_thread(void *arg){
+  size_t i, v;
+  size_t start, end;
+  struct bc_arg *ba = arg;
+  size_t n = ba->a->num_vts;
+  size_t seg_count = n / ba->num_threads;
+  size_t rem_count = n - seg_count * ba->num_threads;
+  start = ba->ix * seg_count + ((ba->ix < rem_count) ? ba->ix : rem_count);
+  end = start + seg_count + (ba->ix < rem_count);
+  for (v = start; v < end; v++){
+    memcpy(ptr(ba->bc, v, ba->bc_size), ba->bc_zero, ba->bc_size);
+    for (i = 0; i < ba->num_threads; i++){
+      ba->add_bc(ptr(ba->bc, v, ba->bc_size),
+                 ptr(ba->bc, v, ba->bc_size),
+                 ptr(ba->accs, i * n + v, ba->bc_size));
+    }
+  }
+  return NULL;
+}
+
+static void run_phase(struct bc_arg *bas,
+                      pthread_t *tids,
+                      size_t num_threads,
+                      void *(*thread)(void *)){
+  size_t i;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &bas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+}
+
+/**
+   Runs the source and reduction phases for bc_pthread and bc_wt_pthread,
+   where the arguments are set in the struct pointed to by ba_init.
+*/
+static void bc_run(const struct bc_arg *ba_init, size_t num_threads){
+  size_t i;
+  size_t next = 0;
+  pthread_t *tids = NULL;
+  pthread_mutex_t lock;
+  struct bc_arg *bas = NULL;
+  void *accs = NULL;
+  accs = malloc_perror(mul_sz_perror(num_threads, ba_init->a->num_vts),
+                       ba_init->bc_size);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  bas = malloc_perror(num_threads, sizeof(struct bc_arg));
+  mutex_init_perror(&lock);
+  for (i = 0; i < num_threads; i++){
+    bas[i] = *ba_init;
+    bas[i].ix = i;
+    bas[i].num_threads = num_threads;
+    bas[i].next = &next;
+    bas[i].lock = &lock;
+    bas[i].accs = accs;
+  }
+  run_phase(bas, tids, num_threads, bc_thread);
+  run_phase(bas, tids, num_threads, reduce_thread);
+  free(accs);
+  free(tids);
+  free(bas);
+  accs = NULL;
+  tids = NULL;
+  bas = NULL;
+}
+
+void bc_pthread(const struct adj_lst *a,
+                const size_t *srcs,
+                size_t num_srcs,
+                void *bc,
+                size_t bc_size,
+                const void *bc_zero,
+                const void *bc_one,
+                size_t (*read_vt)(const void *),
+                void (*write_vt)(void *, size_t),
+                void *(*at_vt)(const void *, const void *),
+                int (*cmp_vt)(const void *, const void *),
+                void (*incr_vt)(void *),
+                void (*add_bc)(void *, const void *, const void *),
+                void (*add_dep)(void *,
+                                const void *,
+                                const void *,
+                                const void *),
+                size_t num_threads){
+  struct bc_arg ba;
+  ba.a = a;
+  ba.srcs = srcs;
+  ba.num_srcs = (srcs == NULL) ? a->num_vts : num_srcs;
+  ba.bc = bc;
+  ba.bc_size = bc_size;
+  ba.bc_zero = bc_zero;
+  ba.bc_one = bc_one;
+  ba.wt_zero = NULL;
+  ba.read_vt = read_vt;
+  ba.write_vt = write_vt;
+  ba.at_vt = at_vt;
+  ba.cmp_vt = cmp_vt;
+  ba.incr_vt = incr_vt;
+  ba.cmp_wt = NULL;
+  ba.add_wt = NULL;
+  ba.add_bc = add_bc;
+  ba.add_dep = add_dep;
+  bc_run(&ba, num_threads);
+}
+
+/**
+   Computes the betweenness centrality of the vertices of a graph with
+   positive weights with num_threads threads. Runs in
+   O(k * (num_vts + num_es) * log num_vts) time, where k is the number of
+   sources, which is split across threads.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   Please see the specification of the other parameters in bc_pthread.
+*/
+void bc_wt_pthread(const struct adj_lst *a,
+                   const size_t *srcs,
+                   size_t num_srcs,
+                   void *bc,
+                   size_t bc_size,
+                   const void *bc_zero,
+                   const void *bc_one,
+                   const void *wt_zero,
+                   size_t (*read_vt)(const void *),
+                   void (*write_vt)(void *, size_t),
+                   void *(*at_vt)(const void *, const void *),
+                   int (*cmp_vt)(const void *, const void *),
+                   int (*cmp_wt)(const void *, const void *),
+                   void (*add_wt)(void *, const void *, const void *),
+                   void (*add_bc)(void *, const void *, const void *),
+                   void (*add_dep)(void *,
+                                   const void *,
+                                   const void *,
+                                   const void *),
+                   size_t num_threads){
+  struct bc_arg ba;
+  ba.a = a;
+  ba.srcs = srcs;
+  ba.num_srcs = (srcs == NULL) ? a->num_vts : num_srcs;
+  ba.bc = bc;
+  ba.bc_size = bc_size;
+  ba.bc_zero = bc_zero;
+  ba.bc_one = bc_one;
+  ba.wt_zero = wt_zero;
+  ba.read_vt = read_vt;
+  ba.write_vt = write_vt;
+  ba.at_vt = at_vt;
+  ba.cmp_vt = cmp_vt;
+  ba.incr_vt = NULL;
+  ba.cmp_wt = cmp_wt;
+  ba.add_wt = add_wt;
+  ba.add_bc = add_bc;
+  ba.add_dep = add_dep;
+  bc_run(&ba, num_threads);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -0,0 +1,166 @@
+/**
+   bc-pthread.h
+
+   Declarations of accessible functions for computing the betweenness
+   centrality of the vertices of graphs with generic integer vertices
+   indexed from 0 according to Brandes' algorithm with multiple threads.
+   A graph may be unweighted, in which case bfs in bfs.h is run from each
+   source, or weighted with positive generic weights, in which case
+   dijkstra in dijkstra.h is run from each source.
+
+   After a traversal from a source s, the reached vertices are ordered by
+   their distances from s, the numbers of shortest paths from s are
+   computed in the increasing order of distances, and the dependencies of
+   s on the vertices are accumulated in the decreasing order of distances.
+   An edge (v, w) is on a shortest path from s iff the distance of w equals
+   the distance of v plus the weight of the edge, and only the outgoing
+   edges of vertices are scanned. The sources are taken by num_threads
+   threads one at a time, each thread accumulates the dependencies in its
+   own array, and the arrays of the threads are reduced in parallel after
+   all sources are processed.
+
+   The betweenness centrality of v is the sum of the dependencies of the
+   sources on v, where a dependency of s on v is the sum of the fractions
+   of the shortest paths from s to t that pass through v, for each t. The
+   numbers of shortest paths, the dependencies, and the centralities are
+   represented by a user-provided type, e.g. a floating-point type on
+   suitable systems, and are only modified by user-provided functions.
+   If the sources are a sample of k vertices, multiplying the computed
+   values by num_vts / k provides unbiased estimates. If a graph is
+   undirected, then each pair of vertices is counted twice.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef BC_PTHREAD_H
+#define BC_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the betweenness centrality of the vertices of a graph, where
+   the weights, if any, are ignored, with num_threads threads. Runs in
+   O(k * (num_vts + num_es)) time, where k is the number of sources, which
+   is split across threads.
+   a           : pointer to an adjacency list with at least one and at most
+                 2**P - 1 vertices, where P is the precision of the integer
+                 type used to represent vertices
+   srcs        : - NULL pointer, if every vertex is a source
+                 - otherwise pointer to an array of num_srcs sources, e.g.
+                 a random sample of vertices
+   num_srcs    : number of sources, if srcs is not NULL
+   bc          : pointer to a preallocated array of num_vts bc_size blocks,
+                 where the centrality of v is set at the index v
+   bc_size     : non-zero size of the type used to represent the numbers of
+                 paths, the dependencies, and the centralities
+   bc_zero     : pointer to a block of size bc_size with a zero value
+   bc_one      : pointer to a block of size bc_size with a value one
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   at_vt       : returns a pointer to the element in the array pointed to by
+                 the first argument at the index pointed to by the second
+                 argument; the first argument points to the integer type
+                 used to represent vertices and is not dereferenced; the
+                 second argument points to a value of the integer type used
+                 to represent vertices and is dereferenced
+   cmp_vt      : returns 0 iff the element pointed to by the first
+                 argument is equal to the element pointed to by the second
+                 argument; each argument points to a value of the integer
+                 type used to represent vertices
+   incr_vt     : increments a value of the integer type used to represent
+                 vertices
+   add_bc      : addition function which copies the sum of the values
+                 pointed to by the second and third arguments to the
+                 preallocated bc_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument; the function is called concurrently by threads
+                 and must be thread-safe
+   add_dep     : adds to the value pointed to by the first argument the
+                 ratio of the values pointed to by the second and third
+                 arguments multiplied by the sum of one and the value
+                 pointed to by the fourth argument, i.e. d += sv / sw *
+                 (1 + dw), where the value pointed to by the third argument
+                 is non-zero; the function is called concurrently by
+                 threads and must be thread-safe
+   num_threads : > 0 number of threads
+*/
+void bc_pthread(const struct adj_lst *a,
+                const size_t *srcs,
+                size_t num_srcs,
+                void *bc,
+                size_t bc_size,
+                const void *bc_zero,
+                const void *bc_one,
+                size_t (*read_vt)(const void *),
+                void (*write_vt)(void *, size_t),
+                void *(*at_vt)(const void *, const void *),
+                int (*cmp_vt)(const void *, const void *),
+                void (*incr_vt)(void *),
+                void (*add_bc)(void *, const void *, const void *),
+                void (*add_dep)(void *,
+                                const void *,
+                                const void *,
+                                const void *),
+                size_t num_threads);
+
+/**
+   Computes the betweenness centrality of the vertices of a graph with
+   positive weights with num_threads threads. Runs in
+   O(k * (num_vts + num_es) * log num_vts) time, where k is the number of
+   sources, which is split across threads.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   Please see the specification of the other parameters in bc_pthread.
+*/
+void bc_wt_pthread(const struct adj_lst *a,
+                   const size_t *srcs,
+                   size_t num_srcs,
+                   void *bc,
+                   size_t bc_size,
+                   const void *bc_zero,
+                   const void *bc_one,
+                   const void *wt_zero,
+                   size_t (*read_vt)(const void *),
+                   void (*write_vt)(void *, size_t),
+                   void *(*at_vt)(const void *, const void *),
+                   int (*cmp_vt)(const void *, const void *),
+                   int (*cmp_wt)(const void *, const void *),
+                   void (*add_wt)(void *, const void *, const void *),
+                   void (*add_bc)(void *, const void *, const void *),
+                   void (*add_dep)(void *,
+                                   const void *,
+                                   const void *,
+                                   const void *),
+                   size_t num_threads);
+
+#endif
@@ -0,0 +1,363 @@
+/**
+   bellman-ford-pthread.c
+
+   Functions for running the Bellman-Ford algorithm on graphs with generic
+   integer vertices indexed from 0 and generic weights, which may be
+   negative, with multiple threads.
+
+   The algorithm proceeds in rounds, where only the lists of the vertices
+   with a distance updated in the previous round are relaxed, and
+   terminates after a round without updates. A negative cycle reachable
+   from the start vertex is detected if a distance is updated in the
+   round num_vts. The conventions for the dist and prev arrays are as in
+   bellman_ford in bellman-ford.h, and the computed distances are equal
+   to the distances computed by bellman_ford.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "bellman-ford-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_STACK_INIT_COUNT = 1u;
+static const size_t C_STACK_MAX_COUNT = 0u; /* < init count, unbounded */
+
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes and copies the shortest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, with the number of vertices as the special value in the prev
+   array for unreached vertices, with num_threads threads. Returns 1 if
+   there is no negative cycle reachable from start, otherwise returns 0,
+   in which case the content of the dist and prev arrays is undefined.
+
+   The vertices are partitioned across threads into contiguous ranges, and
+   the distance and the previous vertex of a vertex are only written by
+   its owner thread. In each round, the threads relax the lists of the
+   frontier vertices in slices with about the same number of pairs, and
+   buffer the improving distances per owner thread. After all threads are
+   joined, each owner thread applies the lowest buffered distance of each
+   of its vertices, and the updated vertices form the next frontier. No
+   locks and no atomic operations are used.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   start       : start vertex for running the algorithm
+   dist        : pointer to a preallocated array of num_vts wt_size blocks;
+                 if the block pointed to by dist has no declared type then
+                 the effective type of each element corresponding to a
+                 reached vertex is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   prev        : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the block pointed to by prev has no declared type then
+                 it is guaranteed that the effective type of every element
+                 is set to the integer type used to represent vertices by
+                 writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   num_threads : > 0 number of threads
+*/
+
+struct bf_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t lst_start;      /* slice of the frontier with relaxed lists */
+  size_t lst_count;
+  size_t seg_count;      /* vertices are owned in contiguous ranges */
+  size_t rem_count;
+  size_t num;            /* number of vertices in the next frontier */
+  size_t elt_size;       /* size of a (v, u, distance) buffer element */
+  const size_t *vs;      /* vertices of the frontier */
+  unsigned char *in_next;
+  void *elt;             /* buffer element of the thread */
+  void *wt;              /* aligned distance of the thread */
+  struct stack *bufs;    /* num_threads x num_threads element buffers */
+  struct stack *next;    /* next frontier per thread */
+  const struct adj_lst *a;
+  void *dist;
+  void *prev;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+};
+
+static void reset_stack(struct stack *s, size_t elt_size){
+  stack_free(s);
+  stack_init(s, elt_size, NULL);
+  stack_bound(s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+}
+
+static void *relax_thread(void *arg){
+  size_t i, k, u, v;
+  struct bf_arg *ba = arg;
+  const struct adj_lst *a = ba->a;
+  const void *p = NULL;
+  void *dv = NULL;
+  for (i = ba->lst_start; i < ba->lst_start + ba->lst_count; i++){
+    u = ba->vs[i];
+    ba->in_next[u] = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = ba->read_vt(p);
+      ba->add_wt(ba->wt,
+                 ptr(ba->dist, u, a->wt_size),
+                 (char *)p + a->wt_offset);
+      dv = ptr(ba->dist, v, a->wt_size);
+      /* distances are not written in this phase */
+      if (ba->read_vt(ptr(ba->prev, v, a->vt_size)) == a->num_vts ||
+          ba->cmp_wt(dv, ba->wt) > 0){
+        memcpy(ba->elt, &v, sizeof(size_t));
+        memcpy((char *)ba->elt + sizeof(size_t), &u, sizeof(size_t));
+        memcpy((char *)ba->elt + 2 * sizeof(size_t), ba->wt, a->wt_size);
+        stack_push(&ba->bufs[ba->ix * ba->num_threads +
+                             range_owner(v, ba->seg_count, ba->rem_count)],
+                   ba->elt);
+      }
+      p = (char *)p + a->pair_size;
+    }
+  }
+  return NULL;
+}
+
+static void *update_thread(void *arg){
+  size_t i, j, u, v;
+  struct bf_arg *ba = arg;
+  const struct adj_lst *a = ba->a;
+  const char *e = NULL;
+  void *dv = NULL;
+  struct stack *s = NULL;
+  for (i = 0; i < ba->num_threads; i++){
+    s = &ba->bufs[i * ba->num_threads + ba->ix];
+    e = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      memcpy(&v, e, sizeof(size_t));
+      memcpy(&u, e + sizeof(size_t), sizeof(size_t));
+      memcpy(ba->wt, e + 2 * sizeof(size_t), a->wt_size);
+      dv = ptr(ba->dist, v, a->wt_size);
+      if (ba->read_vt(ptr(ba->prev, v, a->vt_size)) == a->num_vts ||
+          ba->cmp_wt(dv, ba->wt) > 0){
+        memcpy(dv, ba->wt, a->wt_size);
+        ba->write_vt(ptr(ba->prev, v, a->vt_size), u);
+        if (!ba->in_next[v]){
+          ba->in_next[v] = 1;
+          stack_push(ba->next, &v);
+        }
+      }
+      e += ba->elt_size;
+    }
+    reset_stack(s, ba->elt_size);
+  }
+  ba->num = ba->next->num_elts;
+  return NULL;
+}
+
+static size_t run_phase(struct bf_arg *bas,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &bas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += bas[i].num;
+  }
+  return ret;
+}
+
+/**
+   Splits the lists of the vertices in vs[0, num_vs) into contiguous
+   slices with about the same number of pairs.
+*/
+static void split_lsts(struct bf_arg *bas,
+                       size_t num_threads,
+                       const size_t *vs,
+                       size_t num_vs){
+  size_t i, j;
+  size_t num = 0, cum = 0, target = 0;
+  size_t lst_seg_count, lst_rem_count;
+  const struct adj_lst *a = bas[0].a;
+  for (j = 0; j < num_vs; j++){
+    num += a->vt_wts[vs[j]]->num_elts;
+  }
+  lst_seg_count = num / num_threads;
+  lst_rem_count = num - lst_seg_count * num_threads;
+  j = 0;
+  for (i = 0; i < num_threads; i++){
+    target += lst_seg_count;
+    target += (lst_rem_count > 0 && lst_rem_count--);
+    bas[i].vs = vs;
+    bas[i].lst_start = j;
+    while (j < num_vs &&
+           (cum + a->vt_wts[vs[j]]->num_elts <= target ||
+            i == num_threads - 1)){
+      cum += a->vt_wts[vs[j]]->num_elts;
+      j++;
+    }
+    bas[i].lst_count = j - bas[i].lst_start;
+  }
+}
+
+int bellman_ford_pthread(const struct adj_lst *a,
+                         size_t start,
+                         void *dist,
+                         void *prev,
+                         const void *wt_zero,
+                         size_t (*read_vt)(const void *),
+                         void (*write_vt)(void *, size_t),
+                         int (*cmp_wt)(const void *, const void *),
+                         void (*add_wt)(void *, const void *, const void *),
+                         size_t num_threads){
+  size_t i;
+  size_t n = a->num_vts;
+  size_t num_vs = 1, num_rounds = 0;
+  size_t seg_count, rem_count;
+  size_t num_bufs = mul_sz_perror(num_threads, num_threads);
+  size_t elt_size = add_sz_perror(2 * sizeof(size_t), a->wt_size);
+  size_t *vs = NULL;
+  unsigned char *in_next = NULL;
+  char *elts = NULL;
+  pthread_t *tids = NULL;
+  struct stack *bufs = NULL, *next = NULL;
+  struct bf_arg *bas = NULL;
+  vs = malloc_perror(n, sizeof(size_t));
+  in_next = calloc_perror(n, sizeof(unsigned char));
+  elts = malloc_perror(num_threads, elt_size);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  bas = malloc_perror(num_threads, sizeof(struct bf_arg));
+  bufs = malloc_perror(num_bufs, sizeof(struct stack));
+  next = malloc_perror(num_threads, sizeof(struct stack));
+  for (i = 0; i < num_bufs; i++){
+    stack_init(&bufs[i], elt_size, NULL);
+    stack_bound(&bufs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  for (i = 0; i < n; i++){
+    write_vt(ptr(prev, i, a->vt_size), n);
+  }
+  memcpy(ptr(dist, start, a->wt_size), wt_zero, a->wt_size);
+  write_vt(ptr(prev, start, a->vt_size), start);
+  vs[0] = start;
+  seg_count = n / num_threads;
+  rem_count = n - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    stack_init(&next[i], sizeof(size_t), NULL);
+    stack_bound(&next[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+    bas[i].ix = i;
+    bas[i].num_threads = num_threads;
+    bas[i].seg_count = seg_count;
+    bas[i].rem_count = rem_count;
+    bas[i].num = 0;
+    bas[i].elt_size = elt_size;
+    bas[i].in_next = in_next;
+    bas[i].elt = elts + i * elt_size;
+    bas[i].wt = malloc_perror(1, a->wt_size);
+    bas[i].bufs = bufs;
+    bas[i].next = &next[i];
+    bas[i].a = a;
+    bas[i].dist = dist;
+    bas[i].prev = prev;
+    bas[i].read_vt = read_vt;
+    bas[i].write_vt = write_vt;
+    bas[i].cmp_wt = cmp_wt;
+    bas[i].add_wt = add_wt;
+  }
+  while (num_vs > 0 && num_rounds < n){
+    split_lsts(bas, num_threads, vs, num_vs);
+    run_phase(bas, tids, num_threads, relax_thread);
+    run_phase(bas, tids, num_threads, update_thread);
+    /* the next frontiers are concatenated in the order of threads */
+    num_vs = 0;
+    for (i = 0; i < num_threads; i++){
+      if (next[i].num_elts > 0){
+        memcpy(&vs[num_vs], next[i].elts,
+               next[i].num_elts * sizeof(size_t));
+        num_vs += next[i].num_elts;
+      }
+      reset_stack(&next[i], sizeof(size_t));
+    }
+    num_rounds++;
+  }
+  for (i = 0; i < num_bufs; i++){
+    stack_free(&bufs[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    stack_free(&next[i]);
+    free(bas[i].wt);
+    bas[i].wt = NULL;
+  }
+  free(vs);
+  free(in_next);
+  free(elts);
+  free(tids);
+  free(bas);
+  free(bufs);
+  free(next);
+  vs = NULL;
+  in_next = NULL;
+  elts = NULL;
+  tids = NULL;
+  bas = NULL;
+  bufs = NULL;
+  next = NULL;
+  return (num_vs == 0);
+}
+
+/**
+   Returns the thread that owns a vertex if the vertices are split into
+   contiguous ranges, where the first rem_count threads own seg_count + 1
+   vertices and the other threads own seg_count vertices.
+*/
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count){
+  if (u < rem_count * (seg_count + 1)) return u / (seg_count + 1);
+  return rem_count + (u - rem_count * (seg_count + 1)) / seg_count;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
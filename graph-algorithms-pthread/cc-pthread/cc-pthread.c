@@ -0,0 +1,317 @@
+/**
+   cc-pthread.c
+
+   Functions for computing the connected components of a graph with
+   generic integer vertices indexed from 0 with multiple threads. A graph
+   may be unweighted or weighted. In the latter case the weights of the
+   graph are ignored.
+
+   Each vertex is labeled with the lowest vertex in its component, as in
+   cc in cc.h, and the computed labels are equal to the labels computed
+   by cc on an undirected graph.
+
+   The vertices are partitioned across threads into contiguous ranges,
+   and the parent of a vertex in the forest of a computation is written
+   only by the owner thread of the vertex. Proposals to modify the parents
+   of vertices owned by other threads are buffered per owner thread and
+   applied in a subsequent phase after all threads of the first phase are
+   joined. As a result, no locks are acquired and no atomic operations,
+   which are not available under C89/C90, are required.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "cc-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_STACK_INIT_COUNT = 1u;
+static const size_t C_STACK_MAX_COUNT = 0u; /* < init count, unbounded */
+
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the connected components of an undirected graph with
+   num_threads threads according to the Shiloach-Vishkin approach, where
+   the vertices of each component are organized in a forest of rooted
+   trees that are hooked and shortcut in rounds until each component is a
+   single star rooted at its lowest vertex. Returns the number of
+   components.
+
+   A round consists of the following phases separated by joining all
+   threads. i) Each thread scans the lists of a contiguous range of
+   vertices with about the same number of pairs, and for a vertex u with
+   a neighbor in a tree with a lower root, proposes to hook the root of u
+   onto the lowest such root; the proposals are buffered per owner thread
+   of the root of u. ii) Each thread applies the lowest proposal to each
+   root in its contiguous range of vertices. iii) The trees are shortcut
+   by pointer jumping with a second parent array until each tree is a
+   star. The computation terminates after a round without proposals, and
+   as in ii) and iii), each parent is written only by its owner thread
+   while no other thread reads it, so no locks and no atomic operations
+   are used. In each round at least one tree of each component with more
+   than one tree is hooked, and the number of rounds on sparse graphs is
+   in practice logarithmic in the number of vertices.
+
+   The lists are assumed to be of an undirected graph, i.e. the vertex v
+   is in the list of u if and only if u is in the list of v. The weakly
+   connected components of a directed graph are computed on the
+   adjacency list built with adj_lst_undir_build from the graph struct of
+   the directed graph.
+   a           : pointer to an adjacency list of an undirected graph
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   num_threads : > 0 number of threads
+*/
+
+struct cc_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t start;          /* range of owned vertices */
+  size_t count;
+  size_t lst_start;      /* range of vertices with scanned lists */
+  size_t lst_count;
+  size_t seg_count;
+  size_t rem_count;
+  size_t num;            /* number of proposals, changes, or roots */
+  size_t *f;             /* parents */
+  size_t *g;             /* parents after pointer jumping */
+  struct stack *bufs;    /* num_threads x num_threads (r, m) buffers */
+  const struct adj_lst *a;
+  void *lbl;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+};
+
+static void push_hook(struct cc_arg *ca, size_t r, size_t m){
+  size_t rm[2];
+  rm[0] = r;
+  rm[1] = m;
+  stack_push(&ca->bufs[ca->ix * ca->num_threads +
+                       range_owner(r, ca->seg_count, ca->rem_count)],
+             rm);
+  ca->num++;
+}
+
+static void *hook_thread(void *arg){
+  size_t i, k, m, r;
+  size_t last_r, last_m;
+  const void *p = NULL;
+  struct cc_arg *ca = arg;
+  const struct adj_lst *a = ca->a;
+  const size_t *f = ca->f;
+  last_r = a->num_vts;
+  last_m = a->num_vts;
+  ca->num = 0;
+  for (i = ca->lst_start; i < ca->lst_start + ca->lst_count; i++){
+    r = f[i];
+    m = r;
+    p = a->vt_wts[i]->elts;
+    for (k = 0; k < a->vt_wts[i]->num_elts; k++){
+      if (f[ca->read_vt(p)] < m) m = f[ca->read_vt(p)];
+      p = (char *)p + a->pair_size;
+    }
+    if (m == r) continue;
+    /* a proposal is buffered after the proposals for the same root */
+    if (r == last_r){
+      if (m < last_m) last_m = m;
+    }else{
+      if (last_r < a->num_vts) push_hook(ca, last_r, last_m);
+      last_r = r;
+      last_m = m;
+    }
+  }
+  if (last_r < a->num_vts) push_hook(ca, last_r, last_m);
+  return NULL;
+}
+
+static void *link_thread(void *arg){
+  size_t i, j;
+  const size_t *rm = NULL;
+  struct cc_arg *ca = arg;
+  struct stack *s = NULL;
+  for (i = 0; i < ca->num_threads; i++){
+    s = &ca->bufs[i * ca->num_threads + ca->ix];
+    rm = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      if (rm[1] < ca->f[rm[0]]) ca->f[rm[0]] = rm[1];
+      rm += 2;
+    }
+    stack_free(s);
+    stack_init(s, 2 * sizeof(size_t), NULL);
+    stack_bound(s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  return NULL;
+}
+
+static void *jump_thread(void *arg){
+  size_t i;
+  struct cc_arg *ca = arg;
+  ca->num = 0;
+  for (i = ca->start; i < ca->start + ca->count; i++){
+    ca->g[i] = ca->f[ca->f[i]];
+    ca->num += (ca->g[i] != ca->f[i]);
+  }
+  return NULL;
+}
+
+static void *label_thread(void *arg){
+  size_t i;
+  struct cc_arg *ca = arg;
+  ca->num = 0;
+  for (i = ca->start; i < ca->start + ca->count; i++){
+    ca->write_vt(ptr(ca->lbl, i, ca->a->vt_size), ca->f[i]);
+    ca->num += (ca->f[i] == i);
+  }
+  return NULL;
+}
+
+static size_t run_phase(struct cc_arg *cas,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &cas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += cas[i].num;
+  }
+  return ret;
+}
+
+size_t cc_pthread(const struct adj_lst *a,
+                  void *lbl,
+                  size_t (*read_vt)(const void *),
+                  void (*write_vt)(void *, size_t),
+                  size_t num_threads){
+  size_t i, u;
+  size_t start = 0, num = 0, cum = 0, target = 0;
+  size_t seg_count, rem_count, lst_seg_count, lst_rem_count;
+  size_t ret;
+  size_t num_bufs = mul_sz_perror(num_threads, num_threads);
+  size_t *f = NULL, *g = NULL, *tmp = NULL;
+  pthread_t *tids = NULL;
+  struct stack *bufs = NULL;
+  struct cc_arg *cas = NULL;
+  if (a->num_vts == 0) return 0;
+  f = malloc_perror(a->num_vts, sizeof(size_t));
+  g = malloc_perror(a->num_vts, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    f[i] = i;
+    num += a->vt_wts[i]->num_elts;
+  }
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  cas = malloc_perror(num_threads, sizeof(struct cc_arg));
+  bufs = malloc_perror(num_bufs, sizeof(struct stack));
+  for (i = 0; i < num_bufs; i++){
+    stack_init(&bufs[i], 2 * sizeof(size_t), NULL);
+    stack_bound(&bufs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  lst_seg_count = num / num_threads;
+  lst_rem_count = num - lst_seg_count * num_threads;
+  u = 0;
+  for (i = 0; i < num_threads; i++){
+    cas[i].ix = i;
+    cas[i].num_threads = num_threads;
+    cas[i].start = start;
+    cas[i].count = seg_count + (i < rem_count);
+    start += cas[i].count;
+    /* contiguous ranges of lists with about num / num_threads pairs */
+    target += lst_seg_count;
+    target += (lst_rem_count > 0 && lst_rem_count--);
+    cas[i].lst_start = u;
+    while (u < a->num_vts &&
+           (cum + a->vt_wts[u]->num_elts <= target ||
+            i == num_threads - 1)){
+      cum += a->vt_wts[u]->num_elts;
+      u++;
+    }
+    cas[i].lst_count = u - cas[i].lst_start;
+    cas[i].seg_count = seg_count;
+    cas[i].rem_count = rem_count;
+    cas[i].num = 0;
+    cas[i].bufs = bufs;
+    cas[i].a = a;
+    cas[i].lbl = lbl;
+    cas[i].read_vt = read_vt;
+    cas[i].write_vt = write_vt;
+  }
+  while (1){
+    for (i = 0; i < num_threads; i++){
+      cas[i].f = f;
+    }
+    if (run_phase(cas, tids, num_threads, hook_thread) == 0) break;
+    run_phase(cas, tids, num_threads, link_thread);
+    do{
+      for (i = 0; i < num_threads; i++){
+        cas[i].f = f;
+        cas[i].g = g;
+      }
+      num = run_phase(cas, tids, num_threads, jump_thread);
+      tmp = f;
+      f = g;
+      g = tmp;
+    }while (num > 0);
+  }
+  ret = run_phase(cas, tids, num_threads, label_thread);
+  for (i = 0; i < num_bufs; i++){
+    stack_free(&bufs[i]);
+  }
+  free(f);
+  free(g);
+  free(tids);
+  free(cas);
+  free(bufs);
+  f = NULL;
+  g = NULL;
+  tids = NULL;
+  cas = NULL;
+  bufs = NULL;
+  return ret;
+}
+
+/**
+   Returns the thread that owns a vertex if the vertices are split into
+   contiguous ranges, where the first rem_count threads own seg_count + 1
+   vertices and the other threads own seg_count vertices.
+*/
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count){
+  if (u < rem_count * (seg_count + 1)) return u / (seg_count + 1);
+  return rem_count + (u - rem_count * (seg_count + 1)) / seg_count;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
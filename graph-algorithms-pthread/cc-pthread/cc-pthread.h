@@ -0,0 +1,76 @@
+/**
+   cc-pthread.h
+
+   Declarations of accessible functions for computing the connected
+   components of a graph with generic integer vertices indexed from 0
+   with multiple threads. A graph may be unweighted or weighted. In the
+   latter case the weights of the graph are ignored.
+
+   Each vertex is labeled with the lowest vertex in its component, as in
+   cc in cc.h, and the computed labels are equal to the labels computed
+   by cc on an undirected graph.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef CC_PTHREAD_H
+#define CC_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the connected components of an undirected graph with
+   num_threads threads according to the Shiloach-Vishkin approach, where
+   the vertices of each component are organized in a forest of rooted
+   trees that are hooked and shortcut in rounds until each component is a
+   single star rooted at its lowest vertex. Returns the number of
+   components.
+
+   A round consists of the following phases separated by joining all
+   threads. i) Each thread scans the lists of a contiguous range of
+   vertices with about the same number of pairs, and for a vertex u with
+   a neighbor in a tree with a lower root, proposes to hook the root of u
+   onto the lowest such root; the proposals are buffered per owner thread
+   of the root of u. ii) Each thread applies the lowest proposal to each
+   root in its contiguous range of vertices. iii) The trees are shortcut
+   by pointer jumping with a second parent array until each tree is a
+   star. The computation terminates after a round without proposals, and
+   as in ii) and iii), each parent is written only by its owner thread
+   while no other thread reads it, so no locks and no atomic operations
+   are used. In each round at least one tree of each component with more
+   than one tree is hooked, and the number of rounds on sparse graphs is
+   in practice logarithmic in the number of vertices.
+
+   The lists are assumed to be of an undirected graph, i.e. the vertex v
+   is in the list of u if and only if u is in the list of v. The weakly
+   connected components of a directed graph are computed on the
+   adjacency list built with adj_lst_undir_build from the graph struct of
+   the directed graph.
+   a           : pointer to an adjacency list of an undirected graph
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   num_threads : > 0 number of threads
+*/
+size_t cc_pthread(const struct adj_lst *a,
+                  void *lbl,
+                  size_t (*read_vt)(const void *),
+                  void (*write_vt)(void *, size_t),
+                  size_t num_threads);
+
+#endif
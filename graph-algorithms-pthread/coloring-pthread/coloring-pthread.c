@@ -0,0 +1,248 @@
+/**
+   coloring-pthread.c
+
+   Functions for computing a vertex coloring of an undirected graph with
+   generic integer vertices indexed from 0 with multiple threads by
+   speculative greedy coloring. A graph may be
+   unweighted or weighted. In the latter case the weights of the graph are
+   ignored.
+
+   A coloring assigns to each vertex a color in [0, number of colors), so
+   that the end vertices of each edge that is not a loop have different
+   colors, as in color_greedy in coloring.h. With one thread, the computed
+   coloring equals the coloring computed by color_greedy in the order of
+   vertices.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "coloring-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+/**
+   Computes a coloring of an undirected graph with num_threads threads
+   by speculative greedy coloring with conflict resolution rounds. Returns
+   the number of colors, which is at most the maximum number of pairs in
+   a list plus one, and 0 if the graph has no vertices.
+
+   Each thread owns a contiguous range of vertices with about the same
+   number of vertices, and keeps a compacted array of its uncolored
+   vertices. A round has the following phases separated by joining all
+   threads. i) Each thread colors its uncolored vertices in the order of
+   vertices with the least color that is not used by the neighbors, where
+   the tentative colors of the vertices of the thread and the committed
+   colors of the vertices of other threads are seen. ii) Each thread marks
+   an uncolored vertex as a conflict if a neighbor with a lower index,
+   owned by another thread, has the same tentative color. iii) Each thread
+   commits the colors of its vertices that are not conflicts, and keeps
+   the conflicts as its uncolored vertices for the next round. The vertex
+   with the lowest index among the uncolored vertices is not a conflict,
+   and the coloring completes after a round without conflicts. Tentative
+   and committed colors are written only by their owner threads, so no
+   locks and no atomic operations are used. The rounds run in
+   O(num_vts + num_es) work in addition to the scans of the lists of the
+   conflicts, which are only across the boundaries of the ranges.
+
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   color       : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the color
+                 of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+
+struct color_arg{
+  size_t start;          /* range of owned vertices */
+  size_t count;
+  size_t num;            /* number of uncolored vertices */
+  size_t num_mark;
+  size_t *work;          /* uncolored vertices at start, ..., start + num */
+  size_t *com;           /* committed colors */
+  size_t *mark;          /* mark[c] is v if c is used by a neighbor of v */
+  unsigned char *conf;
+  const struct adj_lst *a;
+  size_t *color;         /* tentative colors */
+  size_t (*read_vt)(const void *);
+};
+
+static void *init_thread(void *arg){
+  size_t u;
+  struct color_arg *ca = arg;
+  const struct adj_lst *a = ca->a;
+  /* a color of a vertex is at most the number of pairs in its list */
+  ca->num_mark = 1;
+  for (u = ca->start; u < ca->start + ca->count; u++){
+    ca->color[u] = a->num_vts;
+    ca->com[u] = a->num_vts;
+    ca->work[u] = u;
+    if (a->vt_wts[u]->num_elts >= ca->num_mark){
+      ca->num_mark = a->vt_wts[u]->num_elts + 1;
+    }
+  }
+  ca->mark = malloc_perror(ca->num_mark, sizeof(size_t));
+  for (u = 0; u < ca->num_mark; u++){
+    ca->mark[u] = a->num_vts;
+  }
+  ca->num = ca->count;
+  return NULL;
+}
+
+static void *color_thread(void *arg){
+  size_t i, c, v, w;
+  size_t end;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct color_arg *ca = arg;
+  const struct adj_lst *a = ca->a;
+  end = ca->start + ca->count;
+  for (i = 0; i < ca->num; i++){
+    v = ca->work[ca->start + i];
+    p_start = a->vt_wts[v]->elts;
+    p_end = (char *)p_start + a->vt_wts[v]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      w = ca->read_vt(p);
+      c = (w >= ca->start && w < end) ? ca->color[w] : ca->com[w];
+      if (w != v && c < ca->num_mark) ca->mark[c] = v;
+    }
+    for (c = 0; ca->mark[c] == v; c++);
+    ca->color[v] = c;
+  }
+  return NULL;
+}
+
+/**
+   Marks the conflicts of a thread, where a neighbor with a lower index
+   owned by another thread has an index lower than start.
+*/
+static void *detect_thread(void *arg){
+  size_t i, v, w;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct color_arg *ca = arg;
+  const struct adj_lst *a = ca->a;
+  for (i = 0; i < ca->num; i++){
+    v = ca->work[ca->start + i];
+    ca->conf[v] = 0;
+    p_start = a->vt_wts[v]->elts;
+    p_end = (char *)p_start + a->vt_wts[v]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      w = ca->read_vt(p);
+      if (w < ca->start && ca->color[w] == ca->color[v]){
+        ca->conf[v] = 1;
+        break;
+      }
+    }
+  }
+  return NULL;
+}
+
+static void *commit_thread(void *arg){
+  size_t i, v;
+  size_t num = 0;
+  size_t *work = NULL;
+  struct color_arg *ca = arg;
+  work = ca->work + ca->start;
+  for (i = 0; i < ca->num; i++){
+    v = work[i];
+    if (ca->conf[v]){
+      ca->color[v] = ca->a->num_vts;
+      work[num++] = v;
+    }else{
+      ca->com[v] = ca->color[v];
+    }
+  }
+  ca->num = num;
+  work = NULL;
+  return NULL;
+}
+
+static size_t run_phase(struct color_arg *cas,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &cas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += cas[i].num;
+  }
+  return ret;
+}
+
+size_t color_pthread(const struct adj_lst *a,
+                     size_t *color,
+                     size_t (*read_vt)(const void *),
+                     size_t num_threads){
+  size_t i;
+  size_t start = 0, ret = 0;
+  size_t seg_count, rem_count;
+  size_t *work = NULL, *com = NULL;
+  unsigned char *conf = NULL;
+  pthread_t *tids = NULL;
+  struct color_arg *cas = NULL;
+  if (a->num_vts == 0) return 0;
+  work = malloc_perror(a->num_vts, sizeof(size_t));
+  com = malloc_perror(a->num_vts, sizeof(size_t));
+  conf = malloc_perror(a->num_vts, sizeof(unsigned char));
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  cas = malloc_perror(num_threads, sizeof(struct color_arg));
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    cas[i].start = start;
+    cas[i].count = seg_count + (i < rem_count);
+    start += cas[i].count;
+    cas[i].num = 0;
+    cas[i].work = work;
+    cas[i].com = com;
+    cas[i].mark = NULL;
+    cas[i].conf = conf;
+    cas[i].a = a;
+    cas[i].color = color;
+    cas[i].read_vt = read_vt;
+  }
+  run_phase(cas, tids, num_threads, init_thread);
+  do{
+    run_phase(cas, tids, num_threads, color_thread);
+    run_phase(cas, tids, num_threads, detect_thread);
+  }while (run_phase(cas, tids, num_threads, commit_thread) > 0);
+  for (i = 0; i < a->num_vts; i++){
+    if (color[i] + 1 > ret) ret = color[i] + 1;
+  }
+  for (i = 0; i < num_threads; i++){
+    free(cas[i].mark);
+    cas[i].mark = NULL;
+  }
+  free(work);
+  free(com);
+  free(conf);
+  free(tids);
+  free(cas);
+  work = NULL;
+  com = NULL;
+  conf = NULL;
+  tids = NULL;
+  cas = NULL;
+  return ret;
+}
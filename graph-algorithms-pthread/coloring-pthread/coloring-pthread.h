@@ -0,0 +1,73 @@
+/**
+   coloring-pthread.h
+
+   Declarations of accessible functions for computing a vertex coloring of
+   an undirected graph with generic integer vertices indexed from 0 with
+   multiple threads by speculative greedy coloring. A graph may be
+   unweighted or weighted. In the latter case the weights of the graph are
+   ignored.
+
+   A coloring assigns to each vertex a color in [0, number of colors), so
+   that the end vertices of each edge that is not a loop have different
+   colors, as in color_greedy in coloring.h. With one thread, the computed
+   coloring equals the coloring computed by color_greedy in the order of
+   vertices.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef COLORING_PTHREAD_H
+#define COLORING_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a coloring of an undirected graph with num_threads threads
+   by speculative greedy coloring with conflict resolution rounds. Returns
+   the number of colors, which is at most the maximum number of pairs in
+   a list plus one, and 0 if the graph has no vertices.
+
+   Each thread owns a contiguous range of vertices with about the same
+   number of vertices, and keeps a compacted array of its uncolored
+   vertices. A round has the following phases separated by joining all
+   threads. i) Each thread colors its uncolored vertices in the order of
+   vertices with the least color that is not used by the neighbors, where
+   the tentative colors of the vertices of the thread and the committed
+   colors of the vertices of other threads are seen. ii) Each thread marks
+   an uncolored vertex as a conflict if a neighbor with a lower index,
+   owned by another thread, has the same tentative color. iii) Each thread
+   commits the colors of its vertices that are not conflicts, and keeps
+   the conflicts as its uncolored vertices for the next round. The vertex
+   with the lowest index among the uncolored vertices is not a conflict,
+   and the coloring completes after a round without conflicts. Tentative
+   and committed colors are written only by their owner threads, so no
+   locks and no atomic operations are used. The rounds run in
+   O(num_vts + num_es) work in addition to the scans of the lists of the
+   conflicts, which are only across the boundaries of the ranges.
+
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   color       : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the color
+                 of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+size_t color_pthread(const struct adj_lst *a,
+                     size_t *color,
+                     size_t (*read_vt)(const void *),
+                     size_t num_threads);
+
+#endif
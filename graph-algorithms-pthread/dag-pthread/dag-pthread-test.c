@@ -0,0 +1,348 @@
+/**
+   dag-pthread-test.c
+
+   Tests of topological sorting with multiple threads across graphs with
+   different integer types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   dag-pthread-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : path graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./dag-pthread-test
+   ./dag-pthread-test 10 14
+   ./dag-pthread-test 14 16 8
+   ./dag-pthread-test 14 16 8 0 1
+
+   dag-pthread-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "dag-pthread.h"
+#include "dag.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "dag-pthread-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : path graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {0u, 10u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 4u};
+
+void rand_perm(size_t *perm, size_t n);
+int is_toposort(const struct adj_lst *a,
+                const void *order,
+                size_t (*read_vt)(const void *));
+int bern_one(void *arg);
+void print_test_result(int res);
+
+/**
+   Compares the results of toposort and toposort_pthread on an adjacency
+   list, and verifies the order computed by toposort_pthread if the graph
+   is acyclic.
+*/
+void toposort_helper(const struct adj_lst *a,
+                     size_t j,
+                     size_t num_threads,
+                     int *res){
+  int ret, ret_pthd;
+  void *order = NULL, *order_pthd = NULL;
+  clock_t t;
+  order = malloc_perror(a->num_vts, a->vt_size);
+  order_pthd = malloc_perror(a->num_vts, a->vt_size);
+  t = clock();
+  ret = toposort(a, order, C_READ[j], C_WRITE[j]);
+  t = clock() - t;
+  printf("\t\t\t%s serial toposort time:         %.6f seconds, "
+         "acyclic: %d\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, ret);
+  t = clock();
+  ret_pthd = toposort_pthread(a, order_pthd, C_READ[j], C_WRITE[j],
+                              num_threads);
+  t = clock() - t;
+  printf("\t\t\t%s multithreaded toposort time:  %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  *res *= (ret == ret_pthd);
+  if (ret_pthd) *res *= is_toposort(a, order_pthd, C_READ[j]);
+  free(order);
+  free(order_pthd);
+  order = NULL;
+  order_pthd = NULL;
+}
+
+/**
+   Run tests on sets of directed paths with vertices in a random order,
+   where 2**n vertices are split into 2**(n / 2) paths. The paths are
+   cycles after an edge from the last to the first vertex of a path is
+   added.
+*/
+void run_path_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_paths, len;
+  size_t *perm = NULL;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test toposort_pthread on directed paths\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_paths = pow_two_perror(i / 2);
+    len = num_vts / num_paths;
+    printf("\t\tvertices: %lu, paths: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_paths), TOLU(num_threads));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      rand_perm(perm, num_vts);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      for (k = 0; k < num_vts; k++){
+        if ((k + 1) % len > 0){
+          adj_lst_add_dir_edge(&a, perm[k], perm[k + 1], NULL,
+                               C_WRITE[j], bern_one, NULL);
+        }
+      }
+      toposort_helper(&a, j, num_threads, &res);
+      adj_lst_add_dir_edge(&a, perm[len - 1], perm[0], NULL,
+                           C_WRITE[j], bern_one, NULL);
+      toposort_helper(&a, j, num_threads, &res);
+      adj_lst_free(&a);
+    }
+    free(perm);
+    perm = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on DAGs obtained from R-MAT graphs by removing self-loops,
+   orienting each edge from the lower to the higher vertex, and relabeling
+   the vertices with a random permutation. A cycle is obtained by adding a
+   reverse edge.
+*/
+
+void rmat_dag(struct graph *g,
+              size_t num_es,
+              const size_t *perm,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t));
+
+void run_rmat_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  size_t *perm = NULL;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test toposort_pthread on R-MAT DAGs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, at most %lu * n directed edges\n",
+           TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu, threads: %lu\n",
+             TOLU(num_vts), TOLU(num_threads));
+      perm = malloc_perror(num_vts, sizeof(size_t));
+      for (j = 0; j < C_FN_COUNT; j++){
+        rand_perm(perm, num_vts);
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        rmat_dag(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                 perm, C_READ[j], C_WRITE[j]);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        toposort_helper(&a, j, num_threads, &res);
+        if (g.num_es > 0){
+          adj_lst_add_dir_edge(&a, C_READ[j](g.v), C_READ[j](g.u), NULL,
+                               C_WRITE[j], bern_one, NULL);
+          toposort_helper(&a, j, num_threads, &res);
+        }
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+      free(perm);
+      perm = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Generates the edges of an R-MAT graph, removes the self-loops, orients
+   each edge (u, v) from min(u, v) to max(u, v), and relabels each vertex
+   u as perm[u].
+*/
+void rmat_dag(struct graph *g,
+              size_t num_es,
+              const size_t *perm,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t)){
+  size_t i, u, v;
+  size_t n = 0;
+  graph_rmat(g, num_es, write_vt, graph_rmat_quad, NULL, NULL);
+  for (i = 0; i < g->num_es; i++){
+    u = read_vt((char *)g->u + i * g->vt_size);
+    v = read_vt((char *)g->v + i * g->vt_size);
+    if (u == v) continue;
+    write_vt((char *)g->u + n * g->vt_size, perm[u < v ? u : v]);
+    write_vt((char *)g->v + n * g->vt_size, perm[u < v ? v : u]);
+    n++;
+  }
+  g->num_es = n;
+}
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+/**
+   Returns 1 if the order array contains each vertex once and u precedes
+   v for each (u, v) edge, otherwise returns 0.
+*/
+int is_toposort(const struct adj_lst *a,
+                const void *order,
+                size_t (*read_vt)(const void *)){
+  int ret = 1;
+  size_t i, k, u;
+  size_t *pos = malloc_perror(a->num_vts, sizeof(size_t));
+  const char *p = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    pos[i] = a->num_vts;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    u = read_vt((const char *)order + i * a->vt_size);
+    if (u >= a->num_vts || pos[u] < a->num_vts) ret = 0;
+    if (u < a->num_vts) pos[u] = i;
+  }
+  for (u = 0; u < a->num_vts && ret; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      if (pos[read_vt(p)] <= pos[u]) ret = 0;
+      p += a->pair_size;
+    }
+  }
+  free(pos);
+  pos = NULL;
+  return ret;
+}
+
+int bern_one(void *arg){
+  (void)arg;
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_path_test(args[0], args[1], args[2]);
+  if (args[4]) run_rmat_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,322 @@
+/**
+   dag-pthread.c
+
+   Functions for computing a topological order of a directed acyclic graph
+   (DAG) with generic integer vertices indexed from 0 with multiple
+   threads. A graph may be unweighted or weighted. In the latter case the
+   weights of the graph are ignored.
+
+   The computed order is a valid input of dag_sp and dag_lp in dag.h, and
+   lists the vertices level by level, where the level of a vertex is the
+   number of edges in a longest path ending at the vertex.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "dag-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_STACK_INIT_COUNT = 1u;
+static const size_t C_STACK_MAX_COUNT = 0u; /* < init count, unbounded */
+
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes a topological order of the vertices of a directed graph with
+   num_threads threads according to Kahn's algorithm with per-level
+   frontiers. Returns 1 if the graph is acyclic, and 0 if a cycle was
+   found, in which case the content of the order array is undefined.
+
+   The vertices are partitioned across threads into contiguous ranges, and
+   the in-degree of a vertex is only modified by its owner thread. In each
+   level, the threads scan the lists of the frontier vertices in slices
+   with about the same number of pairs, and buffer the scanned vertices
+   per owner thread. After all threads are joined, each owner thread
+   decrements the in-degrees of its buffered vertices, and the vertices
+   with an in-degree reaching zero form the next frontier. No locks and no
+   atomic operations are used. The number of rounds equals the number of
+   levels, and the computation is suited for shallow DAGs with wide
+   levels; toposort in dag.h is preferable on DAGs with long paths.
+   a           : pointer to an adjacency list
+   order       : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the graph is acyclic, the array is set to the vertices
+                 in a topological order, where u precedes v for each (u, v)
+                 edge
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   num_threads : > 0 number of threads
+*/
+
+struct dag_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t start;          /* range of owned vertices */
+  size_t count;
+  size_t lst_start;      /* slice of vs with scanned lists */
+  size_t lst_count;
+  size_t seg_count;
+  size_t rem_count;
+  size_t num;            /* number of vertices in the next frontier */
+  const size_t *vs;      /* vertices of a frontier, or NULL for all */
+  size_t *indeg;
+  size_t *ord;           /* vertices in the computed order */
+  struct stack *bufs;    /* num_threads x num_threads vertex buffers */
+  struct stack *next;    /* next frontier per thread */
+  const struct adj_lst *a;
+  void *order;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+};
+
+static void reset_stack(struct stack *s){
+  stack_free(s);
+  stack_init(s, sizeof(size_t), NULL);
+  stack_bound(s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+}
+
+static void *scan_thread(void *arg){
+  size_t i, k, u, v;
+  const void *p = NULL;
+  struct dag_arg *da = arg;
+  const struct adj_lst *a = da->a;
+  for (i = da->lst_start; i < da->lst_start + da->lst_count; i++){
+    u = (da->vs == NULL) ? i : da->vs[i];
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = da->read_vt(p);
+      stack_push(&da->bufs[da->ix * da->num_threads +
+                           range_owner(v, da->seg_count, da->rem_count)],
+                 &v);
+      p = (char *)p + a->pair_size;
+    }
+  }
+  return NULL;
+}
+
+static void *count_thread(void *arg){
+  size_t i, j;
+  const size_t *v = NULL;
+  struct dag_arg *da = arg;
+  struct stack *s = NULL;
+  for (i = da->start; i < da->start + da->count; i++){
+    da->indeg[i] = 0;
+  }
+  for (i = 0; i < da->num_threads; i++){
+    s = &da->bufs[i * da->num_threads + da->ix];
+    v = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      da->indeg[v[j]]++;
+    }
+    reset_stack(s);
+  }
+  for (i = da->start; i < da->start + da->count; i++){
+    if (da->indeg[i] == 0) stack_push(da->next, &i);
+  }
+  da->num = da->next->num_elts;
+  return NULL;
+}
+
+static void *release_thread(void *arg){
+  size_t i, j;
+  const size_t *v = NULL;
+  struct dag_arg *da = arg;
+  struct stack *s = NULL;
+  for (i = 0; i < da->num_threads; i++){
+    s = &da->bufs[i * da->num_threads + da->ix];
+    v = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      da->indeg[v[j]]--;
+      if (da->indeg[v[j]] == 0) stack_push(da->next, &v[j]);
+    }
+    reset_stack(s);
+  }
+  da->num = da->next->num_elts;
+  return NULL;
+}
+
+static void *write_thread(void *arg){
+  size_t i;
+  struct dag_arg *da = arg;
+  for (i = da->start; i < da->start + da->count; i++){
+    da->write_vt(ptr(da->order, i, da->a->vt_size), da->ord[i]);
+  }
+  return NULL;
+}
+
+static size_t run_phase(struct dag_arg *das,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &das[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += das[i].num;
+  }
+  return ret;
+}
+
+/**
+   Splits the lists of the vertices in vs[lo, hi), or of the vertices in
+   [lo, hi) if vs is NULL, into contiguous slices with about the same
+   number of pairs.
+*/
+static void split_lsts(struct dag_arg *das,
+                       size_t num_threads,
+                       const size_t *vs,
+                       size_t lo,
+                       size_t hi){
+  size_t i, j;
+  size_t num = 0, cum = 0, target = 0;
+  size_t lst_seg_count, lst_rem_count;
+  const struct adj_lst *a = das[0].a;
+  for (j = lo; j < hi; j++){
+    num += a->vt_wts[(vs == NULL) ? j : vs[j]]->num_elts;
+  }
+  lst_seg_count = num / num_threads;
+  lst_rem_count = num - lst_seg_count * num_threads;
+  j = lo;
+  for (i = 0; i < num_threads; i++){
+    target += lst_seg_count;
+    target += (lst_rem_count > 0 && lst_rem_count--);
+    das[i].vs = vs;
+    das[i].lst_start = j;
+    while (j < hi &&
+           (cum + a->vt_wts[(vs == NULL) ? j : vs[j]]->num_elts <= target ||
+            i == num_threads - 1)){
+      cum += a->vt_wts[(vs == NULL) ? j : vs[j]]->num_elts;
+      j++;
+    }
+    das[i].lst_count = j - das[i].lst_start;
+  }
+}
+
+int toposort_pthread(const struct adj_lst *a,
+                     void *order,
+                     size_t (*read_vt)(const void *),
+                     void (*write_vt)(void *, size_t),
+                     size_t num_threads){
+  int ret;
+  size_t i, num;
+  size_t start = 0, lo = 0, hi = 0;
+  size_t seg_count, rem_count;
+  size_t num_bufs = mul_sz_perror(num_threads, num_threads);
+  size_t *indeg = NULL, *ord = NULL;
+  pthread_t *tids = NULL;
+  struct stack *bufs = NULL, *next = NULL;
+  struct dag_arg *das = NULL;
+  if (a->num_vts == 0) return 1;
+  indeg = malloc_perror(a->num_vts, sizeof(size_t));
+  ord = malloc_perror(a->num_vts, sizeof(size_t));
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  das = malloc_perror(num_threads, sizeof(struct dag_arg));
+  bufs = malloc_perror(num_bufs, sizeof(struct stack));
+  next = malloc_perror(num_threads, sizeof(struct stack));
+  for (i = 0; i < num_bufs; i++){
+    stack_init(&bufs[i], sizeof(size_t), NULL);
+    stack_bound(&bufs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    stack_init(&next[i], sizeof(size_t), NULL);
+    stack_bound(&next[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+    das[i].ix = i;
+    das[i].num_threads = num_threads;
+    das[i].start = start;
+    das[i].count = seg_count + (i < rem_count);
+    start += das[i].count;
+    das[i].seg_count = seg_count;
+    das[i].rem_count = rem_count;
+    das[i].num = 0;
+    das[i].indeg = indeg;
+    das[i].ord = ord;
+    das[i].bufs = bufs;
+    das[i].next = &next[i];
+    das[i].a = a;
+    das[i].order = order;
+    das[i].read_vt = read_vt;
+    das[i].write_vt = write_vt;
+  }
+  split_lsts(das, num_threads, NULL, 0, a->num_vts);
+  run_phase(das, tids, num_threads, scan_thread);
+  num = run_phase(das, tids, num_threads, count_thread);
+  while (num > 0){
+    /* the next frontiers are appended in the order of threads */
+    lo = hi;
+    for (i = 0; i < num_threads; i++){
+      if (next[i].num_elts > 0){
+        memcpy(&ord[hi], next[i].elts, next[i].num_elts * sizeof(size_t));
+        hi += next[i].num_elts;
+      }
+      reset_stack(&next[i]);
+    }
+    split_lsts(das, num_threads, ord, lo, hi);
+    run_phase(das, tids, num_threads, scan_thread);
+    num = run_phase(das, tids, num_threads, release_thread);
+  }
+  ret = (hi == a->num_vts);
+  if (ret) run_phase(das, tids, num_threads, write_thread);
+  for (i = 0; i < num_bufs; i++){
+    stack_free(&bufs[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    stack_free(&next[i]);
+  }
+  free(indeg);
+  free(ord);
+  free(tids);
+  free(das);
+  free(bufs);
+  free(next);
+  indeg = NULL;
+  ord = NULL;
+  tids = NULL;
+  das = NULL;
+  bufs = NULL;
+  next = NULL;
+  return ret;
+}
+
+/**
+   Returns the thread that owns a vertex if the vertices are split into
+   contiguous ranges, where the first rem_count threads own seg_count + 1
+   vertices and the other threads own seg_count vertices.
+*/
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count){
+  if (u < rem_count * (seg_count + 1)) return u / (seg_count + 1);
+  return rem_count + (u - rem_count * (seg_count + 1)) / seg_count;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -0,0 +1,65 @@
+/**
+   dag-pthread.h
+
+   Declarations of accessible functions for computing a topological order
+   of a directed acyclic graph (DAG) with generic integer vertices indexed
+   from 0 with multiple threads. A graph may be unweighted or weighted. In
+   the latter case the weights of the graph are ignored.
+
+   The computed order is a valid input of dag_sp and dag_lp in dag.h, and
+   lists the vertices level by level, where the level of a vertex is the
+   number of edges in a longest path ending at the vertex.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef DAG_PTHREAD_H
+#define DAG_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a topological order of the vertices of a directed graph with
+   num_threads threads according to Kahn's algorithm with per-level
+   frontiers. Returns 1 if the graph is acyclic, and 0 if a cycle was
+   found, in which case the content of the order array is undefined.
+
+   The vertices are partitioned across threads into contiguous ranges, and
+   the in-degree of a vertex is only modified by its owner thread. In each
+   level, the threads scan the lists of the frontier vertices in slices
+   with about the same number of pairs, and buffer the scanned vertices
+   per owner thread. After all threads are joined, each owner thread
+   decrements the in-degrees of its buffered vertices, and the vertices
+   with an in-degree reaching zero form the next frontier. No locks and no
+   atomic operations are used. The number of rounds equals the number of
+   levels, and the computation is suited for shallow DAGs with wide
+   levels; toposort in dag.h is preferable on DAGs with long paths.
+   a           : pointer to an adjacency list
+   order       : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the graph is acyclic, the array is set to the vertices
+                 in a topological order, where u precedes v for each (u, v)
+                 edge
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   num_threads : > 0 number of threads
+*/
+int toposort_pthread(const struct adj_lst *a,
+                     void *order,
+                     size_t (*read_vt)(const void *),
+                     void (*write_vt)(void *, size_t),
+                     size_t num_threads);
+
+#endif
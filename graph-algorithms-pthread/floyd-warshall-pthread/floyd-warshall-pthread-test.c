@@ -0,0 +1,423 @@
+/**
+   floyd-warshall-pthread-test.c
+
+   Tests of the Floyd-Warshall algorithm with multiple threads across dense
+   graphs with different integer types of vertices within the same
+   translation unit.
+
+   The following command line arguments can be used to customize tests:
+   floyd-warshall-pthread-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : unsigned int and unsigned long weight test on/off
+      [0, 1] : generic long weight test on/off
+
+   usage examples:
+   ./floyd-warshall-pthread-test
+   ./floyd-warshall-pthread-test 8 10
+   ./floyd-warshall-pthread-test 8 10 8
+   ./floyd-warshall-pthread-test 8 10 8 0 1
+
+   floyd-warshall-pthread-test can be run with any subset of command line
+   arguments in the above-defined order. If the (i + 1)th argument is
+   specified then the ith argument must be specified for i >= 0. Default
+   values are used for the unspecified arguments according to the
+   C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "floyd-warshall-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "floyd-warshall-pthread-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : unsigned int and unsigned long weight test on/off \n"
+  "[0, 1] : generic long weight test on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {0u, 8u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_PROBS_COUNT = 3u;
+const double C_PROBS[3] = {1.000000, 0.250000, 0.062500};
+const long C_WT_ZERO = 0;
+const long C_WT_INF = LONG_MAX;
+const long C_WT_RANGE = 100; /* base weights and potentials */
+
+struct bern_arg{
+  double p;
+};
+
+int bern(void *arg);
+void rand_graph(struct adj_lst *a,
+                size_t num_vts,
+                size_t j,
+                size_t wt_size,
+                void (*write_wt)(void *, long),
+                double p);
+void fw_ref(const struct adj_lst *a,
+            long *dist,
+            size_t (*read_vt)(const void *),
+            long (*read_wt)(const void *));
+long read_uint(const void *wt);
+long read_ulong(const void *wt);
+long read_long(const void *wt);
+void write_uint(void *wt, long val);
+void write_ulong(void *wt, long val);
+void write_long(void *wt, long val);
+void print_test_result(int res);
+
+/**
+   Run tests on dense random graphs with 2**n and 2**n + 1 vertices, where
+   the latter results in partially filled tiles, and random non-negative
+   weights of the unsigned int and unsigned long types. The distances are
+   compared with the distances computed by a non-tiled serial algorithm.
+*/
+void run_unsigned_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j, k, l, m;
+  size_t num_vts;
+  unsigned int *dist_uint = NULL;
+  unsigned long *dist_ulong = NULL;
+  long *dist_ref = NULL;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test floyd_warshall_uint_pthread and "
+         "floyd_warshall_ulong_pthread on dense random graphs\n");
+  for (k = 0; k < C_PROBS_COUNT; k++){
+    printf("\tP[an edge is in a graph] = %.4f\n", C_PROBS[k]);
+    for (i = log_start; i <= log_end; i++){
+      for (l = 0; l < 2; l++){
+        num_vts = pow_two_perror(i) + l;
+        printf("\t\tvertices: %lu, threads: %lu\n",
+               TOLU(num_vts), TOLU(num_threads));
+        m = mul_sz_perror(num_vts, num_vts);
+        dist_uint = malloc_perror(m, sizeof(unsigned int));
+        dist_ulong = malloc_perror(m, sizeof(unsigned long));
+        dist_ref = malloc_perror(m, sizeof(long));
+        for (j = 0; j < C_FN_COUNT; j++){
+          rand_graph(&a, num_vts, j, sizeof(unsigned int),
+                     write_uint, C_PROBS[k]);
+          t = clock();
+          floyd_warshall_uint_pthread(&a, dist_uint, C_READ[j],
+                                      num_threads);
+          t = clock() - t;
+          printf("\t\t\t%s floyd_warshall_uint_pthread time:  "
+                 "%.6f seconds (cpu)\n",
+                 C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+          fw_ref(&a, dist_ref, C_READ[j], read_uint);
+          for (m = 0; m < num_vts * num_vts; m++){
+            res *= ((dist_ref[m] == C_WT_INF &&
+                     dist_uint[m] == (unsigned int)-1) ||
+                    (long)dist_uint[m] == dist_ref[m]);
+          }
+          adj_lst_free(&a);
+          rand_graph(&a, num_vts, j, sizeof(unsigned long),
+                     write_ulong, C_PROBS[k]);
+          t = clock();
+          floyd_warshall_ulong_pthread(&a, dist_ulong, C_READ[j],
+                                       num_threads);
+          t = clock() - t;
+          printf("\t\t\t%s floyd_warshall_ulong_pthread time: "
+                 "%.6f seconds (cpu)\n",
+                 C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+          fw_ref(&a, dist_ref, C_READ[j], read_ulong);
+          for (m = 0; m < num_vts * num_vts; m++){
+            res *= ((dist_ref[m] == C_WT_INF &&
+                     dist_ulong[m] == (unsigned long)-1) ||
+                    (long)dist_ulong[m] == dist_ref[m]);
+          }
+          adj_lst_free(&a);
+        }
+        free(dist_uint);
+        free(dist_ulong);
+        free(dist_ref);
+        dist_uint = NULL;
+        dist_ulong = NULL;
+        dist_ref = NULL;
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on dense random graphs with 2**n and 2**n + 1 vertices and
+   weights w(u, v) + p(u) - p(v) of the long type, where w(u, v) and the
+   potentials p(u) are random non-negative values. The weights can be
+   negative, and the weight of each cycle is non-negative. The distances
+   are compared with the distances computed by a non-tiled serial
+   algorithm. A negative cycle is obtained by adding a reverse edge with a
+   weight that is less than the negated weight of an edge, or a self-loop
+   with a negative weight if there are no edges.
+*/
+void run_long_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1, ret;
+  size_t i, j, k, l, m, u;
+  size_t num_vts;
+  long wt;
+  long *pot = NULL, *dist = NULL, *dist_ref = NULL;
+  char *p = NULL;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test floyd_warshall_pthread on dense random graphs with "
+         "negative weights\n");
+  for (k = 0; k < C_PROBS_COUNT; k++){
+    printf("\tP[an edge is in a graph] = %.4f\n", C_PROBS[k]);
+    for (i = log_start; i <= log_end; i++){
+      for (l = 0; l < 2; l++){
+        num_vts = pow_two_perror(i) + l;
+        printf("\t\tvertices: %lu, threads: %lu\n",
+               TOLU(num_vts), TOLU(num_threads));
+        m = mul_sz_perror(num_vts, num_vts);
+        pot = malloc_perror(num_vts, sizeof(long));
+        dist = malloc_perror(m, sizeof(long));
+        dist_ref = malloc_perror(m, sizeof(long));
+        for (j = 0; j < C_FN_COUNT; j++){
+          rand_graph(&a, num_vts, j, sizeof(long), write_long,
+                     C_PROBS[k]);
+          for (u = 0; u < num_vts; u++){
+            pot[u] = RANDOM() % (C_WT_RANGE + 1);
+          }
+          for (u = 0; u < num_vts; u++){
+            p = a.vt_wts[u]->elts;
+            for (m = 0; m < a.vt_wts[u]->num_elts; m++){
+              *(long *)(p + a.wt_offset) += pot[u] - pot[C_READ[j](p)];
+              p += a.pair_size;
+            }
+          }
+          t = clock();
+          ret = floyd_warshall_pthread(&a, dist, &C_WT_ZERO, &C_WT_INF,
+                                       C_READ[j], graph_cmp_long,
+                                       graph_add_long, num_threads);
+          t = clock() - t;
+          printf("\t\t\t%s floyd_warshall_pthread time:       "
+                 "%.6f seconds (cpu)\n",
+                 C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+          fw_ref(&a, dist_ref, C_READ[j], read_long);
+          res *= ret;
+          res *= (memcmp(dist, dist_ref,
+                         num_vts * num_vts * sizeof(long)) == 0);
+          for (u = 0; u < num_vts && a.vt_wts[u]->num_elts == 0; u++);
+          if (u < num_vts){
+            p = a.vt_wts[u]->elts;
+            wt = -*(long *)(p + a.wt_offset) - 1;
+            adj_lst_add_dir_edge(&a, C_READ[j](p), u, &wt,
+                                 C_WRITE[j], bern, NULL);
+          }else{
+            wt = -1;
+            adj_lst_add_dir_edge(&a, 0, 0, &wt, C_WRITE[j], bern, NULL);
+          }
+          ret = floyd_warshall_pthread(&a, dist, &C_WT_ZERO, &C_WT_INF,
+                                       C_READ[j], graph_cmp_long,
+                                       graph_add_long, num_threads);
+          res *= !ret;
+          adj_lst_free(&a);
+        }
+        free(pot);
+        free(dist);
+        free(dist_ref);
+        pot = NULL;
+        dist = NULL;
+        dist_ref = NULL;
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Returns nonzero with the probability in the bern_arg struct pointed to
+   by arg, or 1 if arg is NULL.
+*/
+int bern(void *arg){
+  struct bern_arg *b = arg;
+  if (b == NULL || b->p >= 1.0) return 1;
+  if (b->p <= 0.0) return 0;
+  if (b->p > DRAND()) return 1;
+  return 0;
+}
+
+/**
+   Builds a random directed graph with num_vts vertices of the jth type,
+   where each edge is added with probability p, and random weights in
+   [0, C_WT_RANGE] of size wt_size that are written by write_wt.
+*/
+void rand_graph(struct adj_lst *a,
+                size_t num_vts,
+                size_t j,
+                size_t wt_size,
+                void (*write_wt)(void *, long),
+                double p){
+  size_t u, k;
+  char *q = NULL;
+  struct graph g;
+  struct bern_arg b;
+  b.p = p;
+  graph_base_init(&g, num_vts, C_VT_SIZES[j], wt_size);
+  adj_lst_base_init(a, &g);
+  adj_lst_unbound(a);
+  adj_lst_rand_dir(a, C_WRITE[j], bern, &b);
+  for (u = 0; u < num_vts; u++){
+    q = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      write_wt(q + a->wt_offset, RANDOM() % (C_WT_RANGE + 1));
+      q += a->pair_size;
+    }
+  }
+}
+
+/**
+   Computes the distances between all pairs of vertices by the non-tiled
+   serial Floyd-Warshall algorithm with C_WT_INF as the distance of
+   unreached vertices.
+*/
+void fw_ref(const struct adj_lst *a,
+            long *dist,
+            size_t (*read_vt)(const void *),
+            long (*read_wt)(const void *)){
+  size_t i, j, k, v;
+  size_t n = a->num_vts;
+  long wt;
+  const char *p = NULL;
+  for (i = 0; i < n * n; i++){
+    dist[i] = C_WT_INF;
+  }
+  for (i = 0; i < n; i++){
+    dist[i * n + i] = 0;
+    p = a->vt_wts[i]->elts;
+    for (k = 0; k < a->vt_wts[i]->num_elts; k++){
+      v = read_vt(p);
+      wt = read_wt(p + a->wt_offset);
+      if (wt < dist[i * n + v]) dist[i * n + v] = wt;
+      p += a->pair_size;
+    }
+  }
+  for (k = 0; k < n; k++){
+    for (i = 0; i < n; i++){
+      if (dist[i * n + k] == C_WT_INF) continue;
+      for (j = 0; j < n; j++){
+        if (dist[k * n + j] == C_WT_INF) continue;
+        if (dist[i * n + k] + dist[k * n + j] < dist[i * n + j]){
+          dist[i * n + j] = dist[i * n + k] + dist[k * n + j];
+        }
+      }
+    }
+  }
+}
+
+long read_uint(const void *wt){
+  return *(const unsigned int *)wt;
+}
+
+long read_ulong(const void *wt){
+  return *(const unsigned long *)wt;
+}
+
+long read_long(const void *wt){
+  return *(const long *)wt;
+}
+
+void write_uint(void *wt, long val){
+  *(unsigned int *)wt = val;
+}
+
+void write_ulong(void *wt, long val){
+  *(unsigned long *)wt = val;
+}
+
+void write_long(void *wt, long val){
+  *(long *)wt = val;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_unsigned_test(args[0], args[1], args[2]);
+  if (args[4]) run_long_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,443 @@
+/**
+   floyd-warshall-pthread.c
+
+   Functions for computing the shortest distances between all pairs of
+   vertices according to the Floyd-Warshall algorithm on graphs with generic
+   integer vertices indexed from 0 and generic weights with multiple
+   threads. The algorithm is suited for dense graphs, where running a
+   single-source algorithm from every vertex provides no advantage over
+   O(num_vts**3) time.
+
+   The num_vts * num_vts distance matrix is stored in row-major order and
+   is split into square tiles. For each diagonal tile, the diagonal tile is
+   updated first, then the tiles in its row and column are updated in
+   parallel, and then the remaining tiles are updated in parallel, where
+   each tile is only written by one thread within a phase. The tiles are
+   sized to fit into a cache and each tile update accesses at most three
+   tiles.
+
+   In addition to the functions for generic weights, there are functions
+   for weights of unsigned int and unsigned long types, where the inner
+   loop over a row of a tile is written without function calls and without
+   branches, and can be vectorized by a compiler.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "floyd-warshall-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_TILE_COUNT = 64u; /* vertices per side of a tile */
+
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the shortest distances between all pairs of vertices of a graph
+   with generic weights, which may be negative, with num_threads threads.
+   Returns 1 if there is no negative cycle in the graph, otherwise returns
+   0, in which case the content of the dist array is undefined.
+   a           : pointer to an adjacency list of a weighted graph
+   dist        : pointer to a preallocated array of num_vts * num_vts
+                 wt_size blocks, where the distance from u to v is set at
+                 the index u * num_vts + v; if the block pointed to by
+                 dist has no declared type then the effective type of
+                 every element is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   wt_inf      : pointer to a block of size wt_size with a value of the type
+                 used to represent distances, which is set as the distance
+                 from u to v if v is not reachable from u; the value is not
+                 the distance of any path in the graph
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   num_threads : > 0 number of threads
+*/
+
+struct fw_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t num_vts;
+  size_t num_tiles;      /* tiles per side of the matrix */
+  size_t kb;             /* current diagonal tile */
+  size_t num;            /* number of negative diagonal distances */
+  void *dist;
+  void *s;               /* sum block of the thread */
+  const struct adj_lst *a;
+  const void *wt_zero;
+  const void *wt_inf;
+  size_t (*read_vt)(const void *);
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+  void (*tile)(struct fw_arg *, size_t, size_t);
+};
+
+/**
+   Returns the range [*start, *end) of the vertices of the ib-th tile
+   along a side of the matrix.
+*/
+static void tile_range(const struct fw_arg *fa,
+                       size_t ib,
+                       size_t *start,
+                       size_t *end){
+  *start = ib * C_TILE_COUNT;
+  *end = (fa->num_vts - *start < C_TILE_COUNT) ?
+    fa->num_vts :
+    *start + C_TILE_COUNT;
+}
+
+/**
+   Computes the range [*start, *end) of the items owned by a thread if
+   count items are split into contiguous ranges, where the ranges of the
+   first threads have one more item.
+*/
+static void thread_range(const struct fw_arg *fa,
+                         size_t count,
+                         size_t *start,
+                         size_t *end){
+  size_t seg_count = count / fa->num_threads;
+  size_t rem_count = count - seg_count * fa->num_threads;
+  *start = fa->ix * seg_count + ((fa->ix < rem_count) ? fa->ix : rem_count);
+  *end = *start + seg_count + (fa->ix < rem_count);
+}
+
+/**
+   Updates the tile (ib, jb) with the vertices of the diagonal tile as
+   intermediate vertices. The tile_uint and tile_ulong functions are
+   specialized for unsigned weights, where the maximal value of the weight
+   type is the distance of unreached vertices, and a sum is saturated at
+   the maximal value.
+*/
+static void tile_generic(struct fw_arg *fa, size_t ib, size_t jb){
+  size_t i, j, k;
+  size_t i_start, i_end, j_start, j_end, k_start, k_end;
+  size_t n = fa->num_vts;
+  size_t wt_size = fa->a->wt_size;
+  const void *dik = NULL, *dkj = NULL;
+  void *dij = NULL;
+  tile_range(fa, ib, &i_start, &i_end);
+  tile_range(fa, jb, &j_start, &j_end);
+  tile_range(fa, fa->kb, &k_start, &k_end);
+  for (k = k_start; k < k_end; k++){
+    for (i = i_start; i < i_end; i++){
+      dik = ptr(fa->dist, i * n + k, wt_size);
+      if (fa->cmp_wt(dik, fa->wt_inf) == 0) continue;
+      for (j = j_start; j < j_end; j++){
+        dkj = ptr(fa->dist, k * n + j, wt_size);
+        if (fa->cmp_wt(dkj, fa->wt_inf) == 0) continue;
+        fa->add_wt(fa->s, dik, dkj);
+        dij = ptr(fa->dist, i * n + j, wt_size);
+        if (fa->cmp_wt(dij, fa->wt_inf) == 0 ||
+            fa->cmp_wt(dij, fa->s) > 0){
+          memcpy(dij, fa->s, wt_size);
+        }
+      }
+    }
+  }
+}
+
+static void tile_uint(struct fw_arg *fa, size_t ib, size_t jb){
+  size_t i, j, k;
+  size_t i_start, i_end, j_start, j_end, k_start, k_end;
+  size_t n = fa->num_vts;
+  unsigned int dik, s;
+  unsigned int *d = fa->dist, *di = NULL;
+  const unsigned int *dk = NULL;
+  tile_range(fa, ib, &i_start, &i_end);
+  tile_range(fa, jb, &j_start, &j_end);
+  tile_range(fa, fa->kb, &k_start, &k_end);
+  for (k = k_start; k < k_end; k++){
+    dk = d + k * n;
+    for (i = i_start; i < i_end; i++){
+      di = d + i * n;
+      dik = di[k];
+      if (dik == (unsigned int)-1) continue;
+      for (j = j_start; j < j_end; j++){
+        s = dik + dk[j];
+        s = (s < dik) ? (unsigned int)-1 : s;
+        di[j] = (s < di[j]) ? s : di[j];
+      }
+    }
+  }
+}
+
+static void tile_ulong(struct fw_arg *fa, size_t ib, size_t jb){
+  size_t i, j, k;
+  size_t i_start, i_end, j_start, j_end, k_start, k_end;
+  size_t n = fa->num_vts;
+  unsigned long dik, s;
+  unsigned long *d = fa->dist, *di = NULL;
+  const unsigned long *dk = NULL;
+  tile_range(fa, ib, &i_start, &i_end);
+  tile_range(fa, jb, &j_start, &j_end);
+  tile_range(fa, fa->kb, &k_start, &k_end);
+  for (k = k_start; k < k_end; k++){
+    dk = d + k * n;
+    for (i = i_start; i < i_end; i++){
+      di = d + i * n;
+      dik = di[k];
+      if (dik == (unsigned long)-1) continue;
+      for (j = j_start; j < j_end; j++){
+        s = dik + dk[j];
+        s = (s < dik) ? (unsigned long)-1 : s;
+        di[j] = (s < di[j]) ? s : di[j];
+      }
+    }
+  }
+}
+
+/**
+   Initializes the rows of the vertices owned by a thread with the
+   weights of the lowest-weight edges.
+*/
+static void *init_thread(void *arg){
+  size_t i, j, k, v;
+  size_t start, end;
+  struct fw_arg *fa = arg;
+  const struct adj_lst *a = fa->a;
+  const void *p = NULL;
+  void *dv = NULL;
+  thread_range(fa, fa->num_vts, &start, &end);
+  for (i = start; i < end; i++){
+    for (j = 0; j < fa->num_vts; j++){
+      memcpy(ptr(fa->dist, i * fa->num_vts + j, a->wt_size),
+             (i == j) ? fa->wt_zero : fa->wt_inf,
+             a->wt_size);
+    }
+    p = a->vt_wts[i]->elts;
+    for (k = 0; k < a->vt_wts[i]->num_elts; k++){
+      v = fa->read_vt(p);
+      dv = ptr(fa->dist, i * fa->num_vts + v, a->wt_size);
+      if (fa->cmp_wt(dv, fa->wt_inf) == 0 ||
+          fa->cmp_wt(dv, (const char *)p + a->wt_offset) > 0){
+        memcpy(dv, (const char *)p + a->wt_offset, a->wt_size);
+      }
+      p = (const char *)p + a->pair_size;
+    }
+  }
+  return NULL;
+}
+
+/**
+   Updates the tiles in the row and the column of the diagonal tile that
+   are owned by a thread.
+*/
+static void *cross_thread(void *arg){
+  size_t t, jb;
+  size_t start, end;
+  struct fw_arg *fa = arg;
+  thread_range(fa, 2 * (fa->num_tiles - 1), &start, &end);
+  for (t = start; t < end; t++){
+    jb = t / 2;
+    jb += (jb >= fa->kb);
+    if (t % 2 == 0){
+      fa->tile(fa, fa->kb, jb);
+    }else{
+      fa->tile(fa, jb, fa->kb);
+    }
+  }
+  return NULL;
+}
+
+/**
+   Updates the tiles outside the row and the column of the diagonal tile
+   that are owned by a thread.
+*/
+static void *rest_thread(void *arg){
+  size_t t, ib, jb;
+  size_t start, end;
+  struct fw_arg *fa = arg;
+  thread_range(fa, (fa->num_tiles - 1) * (fa->num_tiles - 1), &start, &end);
+  for (t = start; t < end; t++){
+    ib = t / (fa->num_tiles - 1);
+    jb = t % (fa->num_tiles - 1);
+    ib += (ib >= fa->kb);
+    jb += (jb >= fa->kb);
+    fa->tile(fa, ib, jb);
+  }
+  return NULL;
+}
+
+/**
+   Counts the negative diagonal distances of the vertices owned by a
+   thread.
+*/
+static void *diag_thread(void *arg){
+  size_t i;
+  size_t start, end;
+  struct fw_arg *fa = arg;
+  thread_range(fa, fa->num_vts, &start, &end);
+  fa->num = 0;
+  for (i = start; i < end; i++){
+    fa->num += (fa->cmp_wt(ptr(fa->dist, i * fa->num_vts + i,
+                               fa->a->wt_size),
+                           fa->wt_zero) < 0);
+  }
+  return NULL;
+}
+
+static size_t run_phase(struct fw_arg *fas,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &fas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += fas[i].num;
+  }
+  return ret;
+}
+
+/**
+   Runs the tiled algorithm with a tile update function. Returns the
+   number of vertices with a negative diagonal distance.
+*/
+static size_t run(const struct adj_lst *a,
+                  void *dist,
+                  const void *wt_zero,
+                  const void *wt_inf,
+                  size_t (*read_vt)(const void *),
+                  int (*cmp_wt)(const void *, const void *),
+                  void (*add_wt)(void *, const void *, const void *),
+                  void (*tile)(struct fw_arg *, size_t, size_t),
+                  size_t num_threads){
+  size_t i, kb, ret;
+  size_t num_tiles;
+  pthread_t *tids = NULL;
+  struct fw_arg *fas = NULL;
+  if (a->num_vts == 0) return 0;
+  mul_sz_perror(mul_sz_perror(a->num_vts, a->num_vts), a->wt_size);
+  num_tiles = a->num_vts / C_TILE_COUNT + (a->num_vts % C_TILE_COUNT > 0);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  fas = malloc_perror(num_threads, sizeof(struct fw_arg));
+  for (i = 0; i < num_threads; i++){
+    fas[i].ix = i;
+    fas[i].num_threads = num_threads;
+    fas[i].num_vts = a->num_vts;
+    fas[i].num_tiles = num_tiles;
+    fas[i].kb = 0;
+    fas[i].num = 0;
+    fas[i].dist = dist;
+    fas[i].s = malloc_perror(1, a->wt_size);
+    fas[i].a = a;
+    fas[i].wt_zero = wt_zero;
+    fas[i].wt_inf = wt_inf;
+    fas[i].read_vt = read_vt;
+    fas[i].cmp_wt = cmp_wt;
+    fas[i].add_wt = add_wt;
+    fas[i].tile = tile;
+  }
+  run_phase(fas, tids, num_threads, init_thread);
+  for (kb = 0; kb < num_tiles; kb++){
+    for (i = 0; i < num_threads; i++){
+      fas[i].kb = kb;
+    }
+    tile(&fas[0], kb, kb);
+    if (num_tiles > 1){
+      run_phase(fas, tids, num_threads, cross_thread);
+      run_phase(fas, tids, num_threads, rest_thread);
+    }
+  }
+  ret = run_phase(fas, tids, num_threads, diag_thread);
+  for (i = 0; i < num_threads; i++){
+    free(fas[i].s);
+    fas[i].s = NULL;
+  }
+  free(tids);
+  free(fas);
+  tids = NULL;
+  fas = NULL;
+  return ret;
+}
+
+int floyd_warshall_pthread(const struct adj_lst *a,
+                           void *dist,
+                           const void *wt_zero,
+                           const void *wt_inf,
+                           size_t (*read_vt)(const void *),
+                           int (*cmp_wt)(const void *, const void *),
+                           void (*add_wt)(void *, const void *, const void *),
+                           size_t num_threads){
+  return (run(a, dist, wt_zero, wt_inf, read_vt, cmp_wt, add_wt,
+              tile_generic, num_threads) == 0);
+}
+
+/**
+   Computes the shortest distances between all pairs of vertices of a graph
+   with weights of the unsigned int or unsigned long type with num_threads
+   threads. The distance from u to v is set to the maximal value of the
+   weight type if v is not reachable from u, and a distance that exceeds
+   the maximal value is set to the maximal value.
+   a           : pointer to an adjacency list of a weighted graph, where the
+                 size of a weight is sizeof(unsigned int) or
+                 sizeof(unsigned long) respectively
+   dist        : pointer to a preallocated array of num_vts * num_vts
+                 elements, where the distance from u to v is set at the
+                 index u * num_vts + v
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+void floyd_warshall_uint_pthread(const struct adj_lst *a,
+                                 unsigned int *dist,
+                                 size_t (*read_vt)(const void *),
+                                 size_t num_threads){
+  unsigned int wt_zero = 0;
+  unsigned int wt_inf = (unsigned int)-1;
+  run(a, dist, &wt_zero, &wt_inf, read_vt, graph_cmp_uint, graph_add_uint,
+      tile_uint, num_threads);
+}
+
+void floyd_warshall_ulong_pthread(const struct adj_lst *a,
+                                  unsigned long *dist,
+                                  size_t (*read_vt)(const void *),
+                                  size_t num_threads){
+  unsigned long wt_zero = 0;
+  unsigned long wt_inf = (unsigned long)-1;
+  run(a, dist, &wt_zero, &wt_inf, read_vt, graph_cmp_ulong, graph_add_ulong,
+      tile_ulong, num_threads);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
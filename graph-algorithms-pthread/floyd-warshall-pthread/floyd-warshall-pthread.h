@@ -0,0 +1,114 @@
+/**
+   floyd-warshall-pthread.h
+
+   Declarations of accessible functions for computing the shortest
+   distances between all pairs of vertices according to the Floyd-Warshall
+   algorithm on graphs with generic integer vertices indexed from 0 and
+   generic weights with multiple threads. The algorithm is suited for dense
+   graphs, where running a single-source algorithm from every vertex
+   provides no advantage over O(num_vts**3) time.
+
+   The num_vts * num_vts distance matrix is stored in row-major order and
+   is split into square tiles. For each diagonal tile, the diagonal tile is
+   updated first, then the tiles in its row and column are updated in
+   parallel, and then the remaining tiles are updated in parallel, where
+   each tile is only written by one thread within a phase. The tiles are
+   sized to fit into a cache and each tile update accesses at most three
+   tiles.
+
+   In addition to the functions for generic weights, there are functions
+   for weights of unsigned int and unsigned long types, where the inner
+   loop over a row of a tile is written without function calls and without
+   branches, and can be vectorized by a compiler.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef FLOYD_WARSHALL_PTHREAD_H
+#define FLOYD_WARSHALL_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the shortest distances between all pairs of vertices of a graph
+   with generic weights, which may be negative, with num_threads threads.
+   Returns 1 if there is no negative cycle in the graph, otherwise returns
+   0, in which case the content of the dist array is undefined.
+   a           : pointer to an adjacency list of a weighted graph
+   dist        : pointer to a preallocated array of num_vts * num_vts
+                 wt_size blocks, where the distance from u to v is set at
+                 the index u * num_vts + v; if the block pointed to by
+                 dist has no declared type then the effective type of
+                 every element is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   wt_inf      : pointer to a block of size wt_size with a value of the type
+                 used to represent distances, which is set as the distance
+                 from u to v if v is not reachable from u; the value is not
+                 the distance of any path in the graph
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   num_threads : > 0 number of threads
+*/
+int floyd_warshall_pthread(const struct adj_lst *a,
+                           void *dist,
+                           const void *wt_zero,
+                           const void *wt_inf,
+                           size_t (*read_vt)(const void *),
+                           int (*cmp_wt)(const void *, const void *),
+                           void (*add_wt)(void *, const void *, const void *),
+                           size_t num_threads);
+
+/**
+   Computes the shortest distances between all pairs of vertices of a graph
+   with weights of the unsigned int or unsigned long type with num_threads
+   threads. The distance from u to v is set to the maximal value of the
+   weight type if v is not reachable from u, and a distance that exceeds
+   the maximal value is set to the maximal value.
+   a           : pointer to an adjacency list of a weighted graph, where the
+                 size of a weight is sizeof(unsigned int) or
+                 sizeof(unsigned long) respectively
+   dist        : pointer to a preallocated array of num_vts * num_vts
+                 elements, where the distance from u to v is set at the
+                 index u * num_vts + v
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+void floyd_warshall_uint_pthread(const struct adj_lst *a,
+                                 unsigned int *dist,
+                                 size_t (*read_vt)(const void *),
+                                 size_t num_threads);
+
+void floyd_warshall_ulong_pthread(const struct adj_lst *a,
+                                  unsigned long *dist,
+                                  size_t (*read_vt)(const void *),
+                                  size_t num_threads);
+
+#endif
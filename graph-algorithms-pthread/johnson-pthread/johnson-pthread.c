@@ -0,0 +1,297 @@
+/**
+   johnson-pthread.c
+
+   Functions for computing the shortest distances between all pairs of
+   vertices according to Johnson's algorithm on graphs with generic integer
+   vertices indexed from 0 and generic weights, which may be negative, with
+   multiple threads.
+
+   The graph is reweighted once with potentials computed by bellman_ford
+   in bellman-ford.h from a virtual vertex with a zero-weight edge to every
+   vertex, which results in non-negative weights and preserves shortest
+   paths. Then dijkstra in dijkstra.h is run from every source on the
+   reweighted graph by num_threads threads, where each thread has its own
+   workspace and the sources are taken by threads one at a time. Each
+   computed row of distances is written to a row-major distance matrix,
+   passed to a user-provided function, or both, which enables all-pairs
+   distances to be streamed, e.g. to disk, without allocating a matrix of
+   num_vts * num_vts distances.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "johnson-pthread.h"
+#include "bellman-ford.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the shortest distances between all pairs of vertices with
+   num_threads threads. Returns 1 if there is no negative cycle in the
+   graph, otherwise returns 0, in which case no row is computed. Runs in
+   O(num_vts * num_es) time in the worst case for the reweighting, and in
+   O(num_vts * num_es * log num_vts) time for the calls to dijkstra, which
+   are split across threads.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 2 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   dist        : - NULL pointer, if the rows are only passed to write_row
+                 - pointer to a preallocated array of num_vts * num_vts
+                 wt_size blocks, where the distance from u to v is set at
+                 the index u * num_vts + v; if the block pointed to by
+                 dist has no declared type then the effective type of
+                 every element is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   wt_inf      : pointer to a block of size wt_size with a value of the type
+                 used to represent distances, which is set as the distance
+                 from u to v if v is not reachable from u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   at_vt       : returns a pointer to the element in the array pointed to by
+                 the first argument at the index pointed to by the second
+                 argument; the first argument points to the integer type
+                 used to represent vertices and is not dereferenced; the
+                 second argument points to a value of the integer type used
+                 to represent vertices and is dereferenced
+   cmp_vt      : returns 0 iff the element pointed to by the first
+                 argument is equal to the element pointed to by the second
+                 argument; each argument points to a value of the integer
+                 type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   sub_wt      : subtraction function which copies the difference of the
+                 weight values pointed to by the second and third arguments
+                 to the preallocated wt_size block pointed to by the first
+                 argument; the function is called concurrently by threads
+                 and must be thread-safe
+   write_row   : - NULL pointer, if the rows are only written to dist
+                 - otherwise a function that is called once for each vertex
+                 u with u as the first argument, a pointer to the num_vts
+                 wt_size blocks of the distances from u as the second
+                 argument, and arg as the third argument; the rows are
+                 passed in an unspecified order, and the calls are
+                 serialized with a mutex; the pointed to row is only valid
+                 until the function returns
+   arg         : pointer that is taken as the third argument of write_row
+   num_threads : > 0 number of threads
+*/
+
+struct johnson_arg{
+  size_t *next;              /* next source, shared across threads */
+  pthread_mutex_t *lock;     /* guards next and the calls to write_row */
+  const struct adj_lst *b;   /* reweighted graph with a virtual vertex */
+  const void *pot;           /* potentials of the vertices */
+  void *dist;
+  const void *wt_zero;
+  const void *wt_inf;
+  size_t (*read_vt)(const void *);
+  void (*write_vt)(void *, size_t);
+  void *(*at_vt)(const void *, const void *);
+  int (*cmp_vt)(const void *, const void *);
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+  void (*sub_wt)(void *, const void *, const void *);
+  void (*write_row)(size_t, const void *, void *);
+  void *arg;
+};
+
+static int bern_one(void *arg){
+  (void)arg;
+  return 1;
+}
+
+static void *johnson_thread(void *arg){
+  size_t u, v;
+  size_t n;
+  struct johnson_arg *ja = arg;
+  const struct adj_lst *b = ja->b;
+  void *dist_b = NULL, *prev_b = NULL, *row = NULL, *row_buf = NULL;
+  void *s = NULL;
+  n = b->num_vts - 1;
+  dist_b = malloc_perror(b->num_vts, b->wt_size);
+  prev_b = malloc_perror(b->num_vts, b->vt_size);
+  s = malloc_perror(1, b->wt_size);
+  if (ja->dist == NULL) row_buf = malloc_perror(n, b->wt_size);
+  while (1){
+    mutex_lock_perror(ja->lock);
+    u = (*ja->next)++;
+    mutex_unlock_perror(ja->lock);
+    if (u >= n) break;
+    dijkstra(b, u, dist_b, prev_b, ja->wt_zero, NULL,
+             ja->read_vt, ja->write_vt, ja->at_vt, ja->cmp_vt,
+             ja->cmp_wt, ja->add_wt);
+    row = (ja->dist == NULL) ?
+      row_buf :
+      ptr(ja->dist, mul_sz_perror(u, n), b->wt_size);
+    for (v = 0; v < n; v++){
+      if (ja->read_vt(ptr(prev_b, v, b->vt_size)) == b->num_vts){
+        memcpy(ptr(row, v, b->wt_size), ja->wt_inf, b->wt_size);
+      }else{
+        /* d(u, v) = d'(u, v) + p(v) - p(u) */
+        ja->add_wt(s,
+                   ptr(dist_b, v, b->wt_size),
+                   ptr(ja->pot, v, b->wt_size));
+        ja->sub_wt(ptr(row, v, b->wt_size),
+                   s,
+                   ptr(ja->pot, u, b->wt_size));
+      }
+    }
+    if (ja->write_row != NULL){
+      mutex_lock_perror(ja->lock);
+      ja->write_row(u, row, ja->arg);
+      mutex_unlock_perror(ja->lock);
+    }
+  }
+  free(dist_b);
+  free(prev_b);
+  free(s);
+  free(row_buf);
+  dist_b = NULL;
+  prev_b = NULL;
+  s = NULL;
+  row_buf = NULL;
+  return NULL;
+}
+
+int johnson_pthread(const struct adj_lst *a,
+                    void *dist,
+                    const void *wt_zero,
+                    const void *wt_inf,
+                    size_t (*read_vt)(const void *),
+                    void (*write_vt)(void *, size_t),
+                    void *(*at_vt)(const void *, const void *),
+                    int (*cmp_vt)(const void *, const void *),
+                    int (*cmp_wt)(const void *, const void *),
+                    void (*add_wt)(void *, const void *, const void *),
+                    void (*sub_wt)(void *, const void *, const void *),
+                    void (*write_row)(size_t, const void *, void *),
+                    void *arg,
+                    size_t num_threads){
+  int ret;
+  size_t i, k, u;
+  size_t n = a->num_vts;
+  size_t next = 0;
+  void *pot = NULL, *prev = NULL, *s = NULL;
+  const void *p = NULL;
+  char *q = NULL;
+  pthread_t *tids = NULL;
+  pthread_mutex_t lock;
+  struct johnson_arg *jas = NULL;
+  struct graph g;
+  struct adj_lst b;
+  /* b is a copy of a with a virtual vertex n and zero-weight (n, v) edges */
+  graph_base_init(&g, add_sz_perror(n, 1), a->vt_size, a->wt_size);
+  adj_lst_base_init(&b, &g);
+  adj_lst_unbound(&b);
+  adj_lst_dir_build(&b, &g, read_vt);
+  for (u = 0; u < n; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      adj_lst_add_dir_edge(&b, u, read_vt(p), (const char *)p + a->wt_offset,
+                           write_vt, bern_one, NULL);
+      p = (const char *)p + a->pair_size;
+    }
+  }
+  for (u = 0; u < n; u++){
+    adj_lst_add_dir_edge(&b, n, u, wt_zero, write_vt, bern_one, NULL);
+  }
+  pot = malloc_perror(b.num_vts, b.wt_size);
+  prev = malloc_perror(b.num_vts, b.vt_size);
+  ret = bellman_ford(&b, n, pot, prev, wt_zero,
+                     read_vt, write_vt, cmp_wt, add_wt);
+  free(prev);
+  prev = NULL;
+  if (ret){
+    /* w'(u, v) = w(u, v) + p(u) - p(v) >= 0 */
+    s = malloc_perror(1, b.wt_size);
+    for (u = 0; u < n; u++){
+      q = b.vt_wts[u]->elts;
+      for (k = 0; k < b.vt_wts[u]->num_elts; k++){
+        add_wt(s, q + b.wt_offset, ptr(pot, u, b.wt_size));
+        sub_wt(q + b.wt_offset, s, ptr(pot, read_vt(q), b.wt_size));
+        q += b.pair_size;
+      }
+    }
+    free(s);
+    s = NULL;
+    tids = malloc_perror(num_threads, sizeof(pthread_t));
+    jas = malloc_perror(num_threads, sizeof(struct johnson_arg));
+    mutex_init_perror(&lock);
+    for (i = 0; i < num_threads; i++){
+      jas[i].next = &next;
+      jas[i].lock = &lock;
+      jas[i].b = &b;
+      jas[i].pot = pot;
+      jas[i].dist = dist;
+      jas[i].wt_zero = wt_zero;
+      jas[i].wt_inf = wt_inf;
+      jas[i].read_vt = read_vt;
+      jas[i].write_vt = write_vt;
+      jas[i].at_vt = at_vt;
+      jas[i].cmp_vt = cmp_vt;
+      jas[i].cmp_wt = cmp_wt;
+      jas[i].add_wt = add_wt;
+      jas[i].sub_wt = sub_wt;
+      jas[i].write_row = write_row;
+      jas[i].arg = arg;
+    }
+    for (i = 0; i < num_threads; i++){
+      thread_create_perror(&tids[i], johnson_thread, &jas[i]);
+    }
+    for (i = 0; i < num_threads; i++){
+      thread_join_perror(tids[i], NULL);
+    }
+    free(tids);
+    free(jas);
+    tids = NULL;
+    jas = NULL;
+  }
+  adj_lst_free(&b);
+  free(pot);
+  pot = NULL;
+  return ret;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -0,0 +1,120 @@
+/**
+   johnson-pthread.h
+
+   Declarations of accessible functions for computing the shortest distances
+   between all pairs of vertices according to Johnson's algorithm on graphs
+   with generic integer vertices indexed from 0 and generic weights, which
+   may be negative, with multiple threads.
+
+   The graph is reweighted once with potentials computed by bellman_ford
+   in bellman-ford.h from a virtual vertex with a zero-weight edge to every
+   vertex, which results in non-negative weights and preserves shortest
+   paths. Then dijkstra in dijkstra.h is run from every source on the
+   reweighted graph by num_threads threads, where each thread has its own
+   workspace and the sources are taken by threads one at a time. Each
+   computed row of distances is written to a row-major distance matrix,
+   passed to a user-provided function, or both, which enables all-pairs
+   distances to be streamed, e.g. to disk, without allocating a matrix of
+   num_vts * num_vts distances.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef JOHNSON_PTHREAD_H
+#define JOHNSON_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the shortest distances between all pairs of vertices with
+   num_threads threads. Returns 1 if there is no negative cycle in the
+   graph, otherwise returns 0, in which case no row is computed. Runs in
+   O(num_vts * num_es) time in the worst case for the reweighting, and in
+   O(num_vts * num_es * log num_vts) time for the calls to dijkstra, which
+   are split across threads.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 2 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   dist        : - NULL pointer, if the rows are only passed to write_row
+                 - pointer to a preallocated array of num_vts * num_vts
+                 wt_size blocks, where the distance from u to v is set at
+                 the index u * num_vts + v; if the block pointed to by
+                 dist has no declared type then the effective type of
+                 every element is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   wt_inf      : pointer to a block of size wt_size with a value of the type
+                 used to represent distances, which is set as the distance
+                 from u to v if v is not reachable from u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   at_vt       : returns a pointer to the element in the array pointed to by
+                 the first argument at the index pointed to by the second
+                 argument; the first argument points to the integer type
+                 used to represent vertices and is not dereferenced; the
+                 second argument points to a value of the integer type used
+                 to represent vertices and is dereferenced
+   cmp_vt      : returns 0 iff the element pointed to by the first
+                 argument is equal to the element pointed to by the second
+                 argument; each argument points to a value of the integer
+                 type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function; the function is
+                 called concurrently by threads and must be thread-safe
+   sub_wt      : subtraction function which copies the difference of the
+                 weight values pointed to by the second and third arguments
+                 to the preallocated wt_size block pointed to by the first
+                 argument; the function is called concurrently by threads
+                 and must be thread-safe
+   write_row   : - NULL pointer, if the rows are only written to dist
+                 - otherwise a function that is called once for each vertex
+                 u with u as the first argument, a pointer to the num_vts
+                 wt_size blocks of the distances from u as the second
+                 argument, and arg as the third argument; the rows are
+                 passed in an unspecified order, and the calls are
+                 serialized with a mutex; the pointed to row is only valid
+                 until the function returns
+   arg         : pointer that is taken as the third argument of write_row
+   num_threads : > 0 number of threads
+*/
+int johnson_pthread(const struct adj_lst *a,
+                    void *dist,
+                    const void *wt_zero,
+                    const void *wt_inf,
+                    size_t (*read_vt)(const void *),
+                    void (*write_vt)(void *, size_t),
+                    void *(*at_vt)(const void *, const void *),
+                    int (*cmp_vt)(const void *, const void *),
+                    int (*cmp_wt)(const void *, const void *),
+                    void (*add_wt)(void *, const void *, const void *),
+                    void (*sub_wt)(void *, const void *, const void *),
+                    void (*write_row)(size_t, const void *, void *),
+                    void *arg,
+                    size_t num_threads);
+
+#endif
@@ -0,0 +1,239 @@
+/**
+   kcore-pthread-test.c
+
+   Tests of core decomposition with multiple threads across graphs with
+   different integer types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   kcore-pthread-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./kcore-pthread-test
+   ./kcore-pthread-test 10 14
+   ./kcore-pthread-test 14 16 8
+   ./kcore-pthread-test 14 16 8 0 1
+
+   kcore-pthread-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "kcore-pthread.h"
+#include "kcore.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "kcore-pthread-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {0u, 12u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 16u};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+
+void print_test_result(int res);
+
+/**
+   Compares the core numbers and the maximum core numbers computed by
+   kcore and kcore_pthread on an adjacency list of an undirected graph.
+*/
+void kcore_helper(const struct adj_lst *a,
+                  size_t j,
+                  size_t num_threads,
+                  int *res){
+  size_t max_core, max_core_pthd;
+  size_t *core = NULL, *core_pthd = NULL;
+  clock_t t;
+  core = malloc_perror(a->num_vts, sizeof(size_t));
+  core_pthd = malloc_perror(a->num_vts, sizeof(size_t));
+  t = clock();
+  max_core = kcore(a, core, NULL, C_READ[j]);
+  t = clock() - t;
+  printf("\t\t\t%s serial kcore time:         %.6f seconds, "
+         "max core: %lu\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, TOLU(max_core));
+  t = clock();
+  max_core_pthd = kcore_pthread(a, core_pthd, C_READ[j], num_threads);
+  t = clock() - t;
+  printf("\t\t\t%s multithreaded kcore time:  %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  *res *= (max_core == max_core_pthd);
+  *res *= (memcmp(core, core_pthd, a->num_vts * sizeof(size_t)) == 0);
+  free(core);
+  free(core_pthd);
+  core = NULL;
+  core_pthd = NULL;
+}
+
+/**
+   Run tests on 2D grid graphs with half of the edges removed at random.
+*/
+void run_grid_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts, num_x, num_y;
+  struct graph g, h;
+  struct adj_lst a;
+  printf("Test kcore_pthread on 2D grid graphs with half of the edges "
+         "removed\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu, threads: %lu\n",
+           TOLU(num_x), TOLU(num_y), TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      graph_base_init(&h, num_vts, C_VT_SIZES[j], 0);
+      graph_subset(&h, &g, graph_bern, NULL);
+      adj_lst_base_init(&a, &h);
+      adj_lst_undir_build(&a, &h, C_READ[j]);
+      kcore_helper(&a, j, num_threads, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+      graph_free(&h);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on undirected R-MAT graphs, which may have multiple edges
+   between the same vertices and loops, before and after the lists are
+   sorted and deduplicated.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test kcore_pthread on undirected R-MAT graphs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n edges\n", TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu, threads: %lu\n",
+             TOLU(num_vts), TOLU(num_threads));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, NULL, NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_undir_build(&a, &g, C_READ[j]);
+        kcore_helper(&a, j, num_threads, &res);
+        adj_lst_sort(&a, C_CMP[j]);
+        adj_lst_dedup(&a, C_CMP[j]);
+        kcore_helper(&a, j, num_threads, &res);
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_grid_test(args[0], args[1], args[2]);
+  if (args[4]) run_rmat_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
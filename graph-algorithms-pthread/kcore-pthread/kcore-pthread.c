@@ -0,0 +1,312 @@
+/**
+   kcore-pthread.c
+
+   Functions for computing the core decomposition of an undirected graph
+   with generic integer vertices indexed from 0 with multiple threads. A
+   graph may be unweighted or weighted. In the latter case the weights of
+   the graph are ignored.
+
+   The degree of a vertex is the number of pairs in its list that are not
+   loops, as in kcore in kcore.h, and the computed core numbers are equal
+   to the core numbers computed by kcore.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "kcore-pthread.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_STACK_INIT_COUNT = 1u;
+static const size_t C_STACK_MAX_COUNT = 0u; /* < init count, unbounded */
+
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count);
+
+/**
+   Computes the core numbers of the vertices of an undirected graph with
+   num_threads threads by level-synchronous peeling. Returns the maximum
+   core number, i.e. the degeneracy of the graph, which is 0 if the graph
+   has no vertices.
+
+   Each thread owns a contiguous range of vertices with about the same
+   number of vertices, and keeps a compacted array of its remaining
+   vertices. A level k is the minimum degree of the remaining vertices,
+   and begins with each thread moving its remaining vertices of degree at
+   most k to its frontier. A level then proceeds in rounds with the
+   following phases separated by joining all threads. i) Each thread
+   scans the lists of the vertices in its frontier, and buffers a
+   decrement for each remaining neighbor per owner thread of the
+   neighbor. ii) Each thread applies the decrements to its vertices, and
+   moves a vertex to its frontier with core number k if its degree drops
+   to k. A level ends after a round without new frontier vertices. Each
+   degree is written only by its owner thread, so no locks and no atomic
+   operations are used. Runs in O(num_vts + num_es) work in addition to
+   the scans of the remaining vertices at each level, and the number of
+   rounds is the number of peeling steps across the levels.
+
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   core        : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the core
+                 number of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+
+struct kcore_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t start;          /* range of owned vertices */
+  size_t count;
+  size_t seg_count;
+  size_t rem_count;
+  size_t k;              /* current level */
+  size_t num;            /* number of frontier vertices */
+  size_t num_rem;        /* number of remaining vertices */
+  size_t min;            /* minimum degree of remaining vertices */
+  size_t *deg;           /* degrees of the remaining vertices */
+  size_t *rem;           /* remaining vertices at start, ..., start + count */
+  unsigned char *done;
+  struct stack *fr;      /* frontier of the thread */
+  struct stack *bufs;    /* num_threads x num_threads decrement buffers */
+  const struct adj_lst *a;
+  size_t *core;
+  size_t (*read_vt)(const void *);
+};
+
+static void *init_thread(void *arg){
+  size_t u;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct kcore_arg *ka = arg;
+  const struct adj_lst *a = ka->a;
+  for (u = ka->start; u < ka->start + ka->count; u++){
+    ka->deg[u] = 0;
+    p_start = a->vt_wts[u]->elts;
+    p_end = (char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      ka->deg[u] += (ka->read_vt(p) != u);
+    }
+    ka->done[u] = 0;
+    ka->rem[u] = u;
+  }
+  ka->num_rem = ka->count;
+  return NULL;
+}
+
+/**
+   Removes the peeled vertices from the remaining vertices of a thread
+   and computes the minimum degree of the remaining vertices.
+*/
+static void *min_thread(void *arg){
+  size_t i, u;
+  size_t *rem = NULL;
+  struct kcore_arg *ka = arg;
+  size_t num_rem = 0;
+  rem = ka->rem + ka->start;
+  for (i = 0; i < ka->num_rem; i++){
+    u = rem[i];
+    if (ka->done[u]) continue;
+    if (num_rem == 0 || ka->deg[u] < ka->min) ka->min = ka->deg[u];
+    rem[num_rem++] = u;
+  }
+  ka->num_rem = num_rem;
+  rem = NULL;
+  return NULL;
+}
+
+static void peel(struct kcore_arg *ka, size_t u){
+  ka->done[u] = 1;
+  ka->core[u] = ka->k;
+  stack_push(ka->fr, &u);
+  ka->num++;
+}
+
+static void *select_thread(void *arg){
+  size_t i, u;
+  struct kcore_arg *ka = arg;
+  ka->num = 0;
+  for (i = 0; i < ka->num_rem; i++){
+    u = ka->rem[ka->start + i];
+    if (ka->deg[u] <= ka->k) peel(ka, u);
+  }
+  return NULL;
+}
+
+static void *scatter_thread(void *arg){
+  size_t u, w;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct kcore_arg *ka = arg;
+  const struct adj_lst *a = ka->a;
+  while (ka->fr->num_elts > 0){
+    stack_pop(ka->fr, &u);
+    p_start = a->vt_wts[u]->elts;
+    p_end = (char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      w = ka->read_vt(p);
+      if (w == u || ka->done[w]) continue;
+      stack_push(&ka->bufs[ka->ix * ka->num_threads +
+                           range_owner(w, ka->seg_count, ka->rem_count)],
+                 &w);
+    }
+  }
+  return NULL;
+}
+
+static void *apply_thread(void *arg){
+  size_t i, j, w;
+  const size_t *d = NULL;
+  struct kcore_arg *ka = arg;
+  struct stack *s = NULL;
+  ka->num = 0;
+  for (i = 0; i < ka->num_threads; i++){
+    s = &ka->bufs[i * ka->num_threads + ka->ix];
+    d = s->elts;
+    for (j = 0; j < s->num_elts; j++){
+      w = d[j];
+      /* the degree of a remaining vertex is greater than k */
+      if (ka->done[w]) continue;
+      ka->deg[w]--;
+      if (ka->deg[w] == ka->k) peel(ka, w);
+    }
+    stack_free(s);
+    stack_init(s, sizeof(size_t), NULL);
+    stack_bound(s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  d = NULL;
+  s = NULL;
+  return NULL;
+}
+
+static size_t run_phase(struct kcore_arg *kas,
+                        pthread_t *tids,
+                        size_t num_threads,
+                        void *(*thread)(void *)){
+  size_t i;
+  size_t ret = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &kas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    ret += kas[i].num;
+  }
+  return ret;
+}
+
+size_t kcore_pthread(const struct adj_lst *a,
+                     size_t *core,
+                     size_t (*read_vt)(const void *),
+                     size_t num_threads){
+  size_t i;
+  size_t start = 0, num_rem, k = 0;
+  size_t seg_count, rem_count;
+  size_t num_bufs = mul_sz_perror(num_threads, num_threads);
+  size_t *deg = NULL, *rem = NULL;
+  unsigned char *done = NULL;
+  pthread_t *tids = NULL;
+  struct stack *frs = NULL, *bufs = NULL;
+  struct kcore_arg *kas = NULL;
+  if (a->num_vts == 0) return 0;
+  deg = malloc_perror(a->num_vts, sizeof(size_t));
+  rem = malloc_perror(a->num_vts, sizeof(size_t));
+  done = malloc_perror(a->num_vts, sizeof(unsigned char));
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  kas = malloc_perror(num_threads, sizeof(struct kcore_arg));
+  frs = malloc_perror(num_threads, sizeof(struct stack));
+  bufs = malloc_perror(num_bufs, sizeof(struct stack));
+  for (i = 0; i < num_bufs; i++){
+    stack_init(&bufs[i], sizeof(size_t), NULL);
+    stack_bound(&bufs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  }
+  seg_count = a->num_vts / num_threads;
+  rem_count = a->num_vts - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    stack_init(&frs[i], sizeof(size_t), NULL);
+    stack_bound(&frs[i], C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+    kas[i].ix = i;
+    kas[i].num_threads = num_threads;
+    kas[i].start = start;
+    kas[i].count = seg_count + (i < rem_count);
+    start += kas[i].count;
+    kas[i].seg_count = seg_count;
+    kas[i].rem_count = rem_count;
+    kas[i].num = 0;
+    kas[i].deg = deg;
+    kas[i].rem = rem;
+    kas[i].done = done;
+    kas[i].fr = &frs[i];
+    kas[i].bufs = bufs;
+    kas[i].a = a;
+    kas[i].core = core;
+    kas[i].read_vt = read_vt;
+  }
+  run_phase(kas, tids, num_threads, init_thread);
+  while (1){
+    run_phase(kas, tids, num_threads, min_thread);
+    num_rem = 0;
+    for (i = 0; i < num_threads; i++){
+      if (kas[i].num_rem > 0 && (num_rem == 0 || kas[i].min < k)){
+        k = kas[i].min;
+      }
+      num_rem += kas[i].num_rem;
+    }
+    if (num_rem == 0) break;
+    for (i = 0; i < num_threads; i++){
+      kas[i].k = k;
+    }
+    run_phase(kas, tids, num_threads, select_thread);
+    do{
+      run_phase(kas, tids, num_threads, scatter_thread);
+    }while (run_phase(kas, tids, num_threads, apply_thread) > 0);
+  }
+  for (i = 0; i < num_threads; i++){
+    stack_free(&frs[i]);
+  }
+  for (i = 0; i < num_bufs; i++){
+    stack_free(&bufs[i]);
+  }
+  free(deg);
+  free(rem);
+  free(done);
+  free(tids);
+  free(kas);
+  free(frs);
+  free(bufs);
+  deg = NULL;
+  rem = NULL;
+  done = NULL;
+  tids = NULL;
+  kas = NULL;
+  frs = NULL;
+  bufs = NULL;
+  return k;
+}
+
+/**
+   Returns the thread that owns a vertex if the vertices are split into
+   contiguous ranges, where the first rem_count threads own seg_count + 1
+   vertices and the other threads own seg_count vertices.
+*/
+static size_t range_owner(size_t u, size_t seg_count, size_t rem_count){
+  if (u < rem_count * (seg_count + 1)) return u / (seg_count + 1);
+  return rem_count + (u - rem_count * (seg_count + 1)) / seg_count;
+}
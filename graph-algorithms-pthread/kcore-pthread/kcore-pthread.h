@@ -0,0 +1,68 @@
+/**
+   kcore-pthread.h
+
+   Declarations of accessible functions for computing the core
+   decomposition of an undirected graph with generic integer vertices
+   indexed from 0 with multiple threads. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+
+   The degree of a vertex is the number of pairs in its list that are not
+   loops, as in kcore in kcore.h, and the computed core numbers are equal
+   to the core numbers computed by kcore.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef KCORE_PTHREAD_H
+#define KCORE_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the core numbers of the vertices of an undirected graph with
+   num_threads threads by level-synchronous peeling. Returns the maximum
+   core number, i.e. the degeneracy of the graph, which is 0 if the graph
+   has no vertices.
+
+   Each thread owns a contiguous range of vertices with about the same
+   number of vertices, and keeps a compacted array of its remaining
+   vertices. A level k is the minimum degree of the remaining vertices,
+   and begins with each thread moving its remaining vertices of degree at
+   most k to its frontier. A level then proceeds in rounds with the
+   following phases separated by joining all threads. i) Each thread
+   scans the lists of the vertices in its frontier, and buffers a
+   decrement for each remaining neighbor per owner thread of the
+   neighbor. ii) Each thread applies the decrements to its vertices, and
+   moves a vertex to its frontier with core number k if its degree drops
+   to k. A level ends after a round without new frontier vertices. Each
+   degree is written only by its owner thread, so no locks and no atomic
+   operations are used. Runs in O(num_vts + num_es) work in addition to
+   the scans of the remaining vertices at each level, and the number of
+   rounds is the number of peeling steps across the levels.
+
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   core        : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the core
+                 number of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+size_t kcore_pthread(const struct adj_lst *a,
+                     size_t *core,
+                     size_t (*read_vt)(const void *),
+                     size_t num_threads);
+
+#endif
@@ -0,0 +1,460 @@
+/**
+   pagerank-pthread-test.c
+
+   Tests of PageRank and sparse matrix-vector iterations with multiple
+   threads across graphs with different integer types of vertices within
+   the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   pagerank-pthread-test
+      [0, ushort width - 2] : n for 2**n vertices in smallest graph
+      [0, ushort width - 2] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : PageRank test on R-MAT graphs on/off
+      [0, 1] : weighted sparse matrix-vector test on R-MAT graphs on/off
+
+   usage examples:
+   ./pagerank-pthread-test
+   ./pagerank-pthread-test 10 14
+   ./pagerank-pthread-test 10 14 8
+   ./pagerank-pthread-test 10 14 8 0 1
+
+   pagerank-pthread-test can be run with any subset of command line
+   arguments in the above-defined order. If the (i + 1)th argument is
+   specified then the ith argument must be specified for i >= 0. Default
+   values are used for the unspecified arguments according to the
+   C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "pagerank-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "pagerank-pthread-test \n"
+  "[0, ushort width - 2] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 2] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : PageRank test on R-MAT graphs on/off \n"
+  "[0, 1] : weighted sparse matrix-vector test on R-MAT graphs on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {10u, 12u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTOR = 8u;
+const double C_ZERO = 0.0;
+const double C_DAMP = 0.85;
+const double C_PR_TOL = 1e-10;
+const double C_CMP_TOL = 1e-8;
+const double C_NO_TOL = -1.0;
+const size_t C_MAX_ITERS = 1000u;
+const size_t C_SPMV_ITERS = 2u; /* exact double values */
+const long C_WT_RANGE = 4;
+const long C_VAL_RANGE = 8;
+
+void div_double(void *q, const void *a, size_t n);
+void upd_double(void *r, const void *s, const void *t, size_t n);
+void add_double(void *s, const void *a, const void *b);
+void diff_double(void *d, const void *a, const void *b);
+int cmp_double(const void *a, const void *b);
+size_t pagerank_def(const struct adj_lst *a,
+                    double *rank,
+                    size_t (*read_vt)(const void *));
+int cmp_rank(const double *a, const double *b, size_t n);
+void print_test_result(int res);
+
+/**
+   Run PageRank tests on directed R-MAT graphs with a skewed degree
+   distribution, which may have multiple edges between the same vertices
+   and vertices without outgoing edges. The ranks computed with one thread,
+   and with num_threads threads with and without degree-based balancing,
+   are compared with the ranks computed by a single-threaded power
+   iteration.
+*/
+
+size_t pagerank_helper(const struct adj_lst *a,
+                       double *rank,
+                       size_t j,
+                       int bal,
+                       size_t num_threads,
+                       clock_t *t){
+  size_t i, ret;
+  for (i = 0; i < a->num_vts; i++){
+    rank[i] = 1.0 / a->num_vts;
+  }
+  *t = clock();
+  ret = pagerank_pthread(a, rank, sizeof(double), &C_ZERO, &C_PR_TOL,
+                         C_MAX_ITERS, div_double, upd_double, add_double,
+                         diff_double, cmp_double, C_READ[j], C_WRITE[j],
+                         bal, num_threads);
+  *t = clock() - *t;
+  return ret;
+}
+
+void run_pagerank_test(size_t log_start,
+                       size_t log_end,
+                       size_t num_threads){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts, iters_def, iters[3];
+  double *rank_def = NULL, *rank = NULL;
+  clock_t t[3];
+  struct graph g;
+  struct adj_lst a;
+  printf("Test pagerank_pthread on directed R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts),
+           TOLU(num_threads));
+    rank_def = malloc_perror(num_vts, sizeof(double));
+    rank = malloc_perror(num_vts, sizeof(double));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      iters_def = pagerank_def(&a, rank_def, C_READ[j]);
+      iters[0] = pagerank_helper(&a, rank, j, 0, 1, &t[0]);
+      res *= cmp_rank(rank, rank_def, num_vts);
+      iters[1] = pagerank_helper(&a, rank, j, 0, num_threads, &t[1]);
+      res *= cmp_rank(rank, rank_def, num_vts);
+      iters[2] = pagerank_helper(&a, rank, j, 1, num_threads, &t[2]);
+      res *= cmp_rank(rank, rank_def, num_vts);
+      res *= (iters[0] + 1 >= iters_def && iters[0] <= iters_def + 1);
+      res *= (iters[1] + 1 >= iters_def && iters[1] <= iters_def + 1);
+      res *= (iters[2] + 1 >= iters_def && iters[2] <= iters_def + 1);
+      printf("\t\t\t%s iterations: %lu\n", C_VT_TYPES[j], TOLU(iters[0]));
+      printf("\t\t\t%s one thread time:            %.6f seconds (cpu)\n",
+             C_VT_TYPES[j], (double)t[0] / CLOCKS_PER_SEC);
+      printf("\t\t\t%s %lu thread(s) time:           %.6f seconds (cpu)\n",
+             C_VT_TYPES[j], TOLU(num_threads),
+             (double)t[1] / CLOCKS_PER_SEC);
+      printf("\t\t\t%s %lu thread(s) balanced time:  %.6f seconds (cpu)\n",
+             C_VT_TYPES[j], TOLU(num_threads),
+             (double)t[2] / CLOCKS_PER_SEC);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+    free(rank_def);
+    free(rank);
+    rank_def = NULL;
+    rank = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests of spmv_pthread on directed weighted R-MAT graphs, where each
+   iteration computes y[v] = sum of wt(u, v) * x[u] + sum of x[u] across
+   all vertices, by providing the transpose of a graph. The values are
+   integral and the results are exactly compared with the results of a
+   single-threaded computation.
+*/
+
+void gen_wt(void *wt, void *arg){
+  (void)arg;
+  *(long *)wt = 1 + RANDOM() % C_WT_RANGE;
+}
+
+void pre_spmv(void *c, void *g, const void *xu, size_t u, void *arg){
+  (void)u;
+  (void)arg;
+  *(double *)c = *(const double *)xu;
+  *(double *)g = *(const double *)xu;
+}
+
+void gather_spmv(void *acc, const void *cu, const void *wt, void *arg){
+  (void)arg;
+  *(double *)acc += *(const long *)wt * *(const double *)cu;
+}
+
+void apply_spmv(void *y,
+                const void *acc,
+                const void *glob,
+                const void *xv,
+                size_t v,
+                void *arg){
+  (void)xv;
+  (void)v;
+  (void)arg;
+  *(double *)y = *(const double *)acc + *(const double *)glob;
+}
+
+void spmv_def(const struct adj_lst *a,
+              double *x,
+              size_t num_iters,
+              size_t (*read_vt)(const void *)){
+  size_t i, k, u;
+  size_t n = a->num_vts;
+  long wt;
+  double glob;
+  double *y = NULL;
+  const char *p = NULL;
+  y = malloc_perror(n, sizeof(double));
+  for (i = 0; i < num_iters; i++){
+    glob = 0.0;
+    for (u = 0; u < n; u++){
+      glob += x[u];
+      y[u] = 0.0;
+    }
+    for (u = 0; u < n; u++){
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        memcpy(&wt, p + a->wt_offset, sizeof(long));
+        y[read_vt(p)] += wt * x[u];
+        p += a->pair_size;
+      }
+    }
+    for (u = 0; u < n; u++){
+      x[u] = y[u] + glob;
+    }
+  }
+  free(y);
+  y = NULL;
+}
+
+void run_spmv_test(size_t log_start,
+                   size_t log_end,
+                   size_t num_threads){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  double *x_def = NULL, *x = NULL, *x_bal = NULL;
+  struct graph g;
+  struct adj_lst a, b;
+  printf("Test spmv_pthread on directed weighted R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts),
+           TOLU(num_threads));
+    x_def = malloc_perror(num_vts, sizeof(double));
+    x = malloc_perror(num_vts, sizeof(double));
+    x_bal = malloc_perror(num_vts, sizeof(double));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(long));
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, gen_wt, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      adj_lst_base_init(&b, &g);
+      adj_lst_unbound(&b);
+      adj_lst_transpose(&b, &a, C_READ[j], C_WRITE[j]);
+      for (k = 0; k < num_vts; k++){
+        x_def[k] = RANDOM() % C_VAL_RANGE;
+        x[k] = x_def[k];
+        x_bal[k] = x_def[k];
+      }
+      spmv_def(&a, x_def, C_SPMV_ITERS, C_READ[j]);
+      res *= (spmv_pthread(&b, x, sizeof(double), &C_ZERO, &C_NO_TOL,
+                           C_SPMV_ITERS, pre_spmv, gather_spmv, apply_spmv,
+                           add_double, diff_double, cmp_double, NULL,
+                           C_READ[j], 0, num_threads) == C_SPMV_ITERS);
+      res *= (spmv_pthread(&b, x_bal, sizeof(double), &C_ZERO, &C_NO_TOL,
+                           C_SPMV_ITERS, pre_spmv, gather_spmv, apply_spmv,
+                           add_double, diff_double, cmp_double, NULL,
+                           C_READ[j], 1, num_threads) == C_SPMV_ITERS);
+      for (k = 0; k < num_vts; k++){
+        res *= (x[k] == x_def[k] && x_bal[k] == x_def[k]);
+      }
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      graph_free(&g);
+    }
+    free(x_def);
+    free(x);
+    free(x_bal);
+    x_def = NULL;
+    x = NULL;
+    x_bal = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Operations on the values of the double type for ranks and values.
+*/
+void div_double(void *q, const void *a, size_t n){
+  *(double *)q = *(const double *)a / n;
+}
+
+void upd_double(void *r, const void *s, const void *t, size_t n){
+  *(double *)r = (1.0 - C_DAMP) / n +
+    C_DAMP * (*(const double *)s + *(const double *)t / n);
+}
+
+void add_double(void *s, const void *a, const void *b){
+  *(double *)s = *(const double *)a + *(const double *)b;
+}
+
+void diff_double(void *d, const void *a, const void *b){
+  double x = *(const double *)a, y = *(const double *)b;
+  *(double *)d = (x > y) ? x - y : y - x;
+}
+
+int cmp_double(const void *a, const void *b){
+  if (*(const double *)a > *(const double *)b){
+    return 1;
+  }else if (*(const double *)a < *(const double *)b){
+    return -1;
+  }else{
+    return 0;
+  }
+}
+
+/**
+   Computes PageRank by a single-threaded push-based power iteration with
+   the same damping factor, handling of vertices without outgoing edges,
+   and stopping criterion, and returns the number of iterations.
+*/
+size_t pagerank_def(const struct adj_lst *a,
+                    double *rank,
+                    size_t (*read_vt)(const void *)){
+  size_t i, k, u, deg;
+  size_t n = a->num_vts;
+  size_t num_iters = 0;
+  double dang, res;
+  double *next = NULL;
+  const char *p = NULL;
+  next = malloc_perror(n, sizeof(double));
+  for (u = 0; u < n; u++){
+    rank[u] = 1.0 / n;
+  }
+  for (i = 0; i < C_MAX_ITERS; i++){
+    dang = 0.0;
+    for (u = 0; u < n; u++){
+      next[u] = 0.0;
+      if (a->vt_wts[u]->num_elts == 0) dang += rank[u];
+    }
+    for (u = 0; u < n; u++){
+      deg = a->vt_wts[u]->num_elts;
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < deg; k++){
+        next[read_vt(p)] += rank[u] / deg;
+        p += a->pair_size;
+      }
+    }
+    res = 0.0;
+    for (u = 0; u < n; u++){
+      next[u] = (1.0 - C_DAMP) / n + C_DAMP * (next[u] + dang / n);
+      res += (next[u] > rank[u]) ? next[u] - rank[u] : rank[u] - next[u];
+      rank[u] = next[u];
+    }
+    num_iters++;
+    if (res <= C_PR_TOL) break;
+  }
+  free(next);
+  next = NULL;
+  return num_iters;
+}
+
+/**
+   Returns 1 if the ranks in two arrays are equal within a tolerance and
+   the ranks in the first array sum to one within a tolerance, otherwise
+   returns 0.
+*/
+int cmp_rank(const double *a, const double *b, size_t n){
+  int ret = 1;
+  size_t i;
+  double diff, sum = 0.0;
+  for (i = 0; i < n; i++){
+    diff = (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+    ret *= (diff <= C_CMP_TOL);
+    sum += a[i];
+  }
+  ret *= (sum > 1.0 - C_CMP_TOL && sum < 1.0 + C_CMP_TOL);
+  return ret;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 2 ||
+      args[1] > C_USHORT_BIT - 2 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_pagerank_test(args[0], args[1], args[2]);
+  if (args[4]) run_spmv_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
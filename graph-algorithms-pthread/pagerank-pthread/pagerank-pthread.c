@@ -0,0 +1,457 @@
+/**
+   pagerank-pthread.c
+
+   Functions for computing PageRank and for running generic sparse
+   matrix-vector iterations on graphs with generic integer vertices indexed
+   from 0 with multiple threads.
+
+   The iterations are pull-based. The value of a vertex v in the next
+   iteration is computed from the values of the start vertices of the
+   pairs in the list of v in an adjacency list of the transpose of a graph,
+   so that only the thread that owns v writes the value of v, and no locks
+   and no atomic operations are used. The values of an iteration and of the
+   next iteration are kept in two arrays that are swapped after each
+   iteration. Each thread owns a contiguous range of vertices, where the
+   ranges have about the same number of vertices, or about the same sum of
+   the number of pairs and the number of vertices if degree-based load
+   balancing is selected for graphs with a skewed degree distribution.
+
+   The values are represented by a user-provided type, e.g. a
+   floating-point type on suitable systems, and are only modified by
+   user-provided functions. An iteration stops after the sum of the
+   differences between the values of two consecutive iterations is not
+   greater than a tolerance value, or after a maximal number of
+   iterations.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "pagerank-pthread.h"
+#include "graph.h"
+#include "graph-pthread.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Runs a generic pull-based iteration with num_threads threads and returns
+   the number of completed iterations. In each iteration, first the value
+   sent along the edges from each vertex u and the contribution of u to a
+   global sum are computed by pre, and the contributions are summed. Then
+   for each vertex v, the values sent from the start vertices of the pairs
+   in the list of v are accumulated by gather, and the value of v in the
+   next iteration is computed by apply from the accumulated value, the
+   global sum, and the value of v. Runs in O(k * (num_vts + num_es)) time,
+   where k is the number of iterations, which is split across threads.
+   b           : pointer to an adjacency list, where the list of v contains
+                 a pair with u for each (u, v) edge of a graph, e.g. built
+                 by adj_lst_transpose; if b is weighted then the wt_size
+                 block of a pair is passed to gather
+   x           : pointer to an array of num_vts val_size blocks with the
+                 initial values, which are replaced by the values after the
+                 last iteration
+   val_size    : non-zero size of the type used to represent values
+   val_zero    : pointer to a block of size val_size with a zero value
+   tol         : pointer to a block of size val_size with the tolerance
+                 value for the sum of differences
+   max_iters   : maximal number of iterations
+   pre         : writes the value sent from u to the block pointed to by
+                 the first argument and the contribution of u to the global
+                 sum to the block pointed to by the second argument, given
+                 a pointer to the value of u as the third argument, u as the
+                 fourth argument, and arg as the fifth argument
+   gather      : adds the contribution of the value pointed to by the
+                 second argument, sent along an edge with the weight pointed
+                 to by the third argument, or NULL if b is not weighted, to
+                 the value pointed to by the first argument, and takes arg
+                 as the fourth argument
+   apply       : writes the value of v in the next iteration to the block
+                 pointed to by the first argument, given pointers to the
+                 accumulated value, the global sum, and the value of v as
+                 the second, third, and fourth arguments, v as the fifth
+                 argument, and arg as the sixth argument
+   add_val     : addition function which copies the sum of the values
+                 pointed to by the second and third arguments to the
+                 preallocated val_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument
+   diff_val    : writes the absolute value of the difference of the values
+                 pointed to by the second and third arguments to the
+                 preallocated val_size block pointed to by the first
+                 argument
+   cmp_val     : comparison function which returns a negative integer value
+                 if the value pointed to by the first argument is less than
+                 the value pointed to by the second, a positive integer
+                 value if the value pointed to by the first argument is
+                 greater than the value pointed to by the second, and zero
+                 integer value if the two values are equal
+   arg         : pointer that is taken as the last argument of pre, gather,
+                 and apply
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   bal         : non-zero if the ranges of vertices of threads are balanced
+                 by the number of pairs, otherwise zero
+   num_threads : > 0 number of threads
+   The functions pre, gather, apply, add_val, diff_val, and cmp_val are
+   called concurrently by threads and must be thread-safe.
+*/
+
+struct spmv_arg{
+  size_t start;              /* range of vertices owned by the thread */
+  size_t end;
+  const struct adj_lst *b;
+  void *x;                   /* values of the current iteration */
+  void *y;                   /* values of the next iteration */
+  void *c;                   /* values sent from vertices */
+  void *part;                /* partial sum of the thread */
+  void *acc;
+  void *tmp;
+  const void *glob;          /* global sum of the current iteration */
+  size_t val_size;
+  const void *val_zero;
+  void (*pre)(void *, void *, const void *, size_t, void *);
+  void (*gather)(void *, const void *, const void *, void *);
+  void (*apply)(void *,
+                const void *,
+                const void *,
+                const void *,
+                size_t,
+                void *);
+  void (*add_val)(void *, const void *, const void *);
+  void (*diff_val)(void *, const void *, const void *);
+  void *arg;
+  size_t (*read_vt)(const void *);
+};
+
+static void *pre_thread(void *arg){
+  size_t u;
+  struct spmv_arg *sa = arg;
+  size_t val_size = sa->val_size;
+  memcpy(sa->part, sa->val_zero, val_size);
+  for (u = sa->start; u < sa->end; u++){
+    sa->pre(ptr(sa->c, u, val_size), sa->tmp, ptr(sa->x, u, val_size),
+            u, sa->arg);
+    sa->add_val(sa->part, sa->part, sa->tmp);
+  }
+  return NULL;
+}
+
+static void *apply_thread(void *arg){
+  size_t v;
+  struct spmv_arg *sa = arg;
+  const struct adj_lst *b = sa->b;
+  size_t val_size = sa->val_size;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  memcpy(sa->part, sa->val_zero, val_size);
+  for (v = sa->start; v < sa->end; v++){
+    memcpy(sa->acc, sa->val_zero, val_size);
+    p_start = b->vt_wts[v]->elts;
+    p_end = ptr(p_start, b->vt_wts[v]->num_elts, b->pair_size);
+    for (p = p_start; p != p_end; p = (const char *)p + b->pair_size){
+      sa->gather(sa->acc,
+                 ptr(sa->c, sa->read_vt(p), val_size),
+                 (b->wt_size > 0) ? (const char *)p + b->wt_offset : NULL,
+                 sa->arg);
+    }
+    sa->apply(ptr(sa->y, v, val_size), sa->acc, sa->glob,
+              ptr(sa->x, v, val_size), v, sa->arg);
+    sa->diff_val(sa->tmp, ptr(sa->y, v, val_size), ptr(sa->x, v, val_size));
+    sa->add_val(sa->part, sa->part, sa->tmp);
+  }
+  return NULL;
+}
+
+/**
+   Runs a phase with num_threads threads, and sums the partial sums of the
+   threads in the block pointed to by s.
+*/
+static void run_phase(struct spmv_arg *sas,
+                      pthread_t *tids,
+                      size_t num_threads,
+                      void *s,
+                      void *(*thread)(void *)){
+  size_t i;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &sas[i]);
+  }
+  memcpy(s, sas[0].val_zero, sas[0].val_size);
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+    sas[i].add_val(s, s, sas[i].part);
+  }
+}
+
+/**
+   Splits the vertices into contiguous ranges with about the same number
+   of vertices, or with about the same sum of the number of pairs and the
+   number of vertices if bal is non-zero.
+*/
+static void split_vts(struct spmv_arg *sas,
+                      size_t num_threads,
+                      const struct adj_lst *b,
+                      int bal){
+  size_t i, v = 0;
+  size_t num, cum = 0, target = 0;
+  size_t seg_count, rem_count;
+  if (bal){
+    num = add_sz_perror(b->num_vts, b->num_es);
+  }else{
+    num = b->num_vts;
+  }
+  seg_count = num / num_threads;
+  rem_count = num - seg_count * num_threads;
+  for (i = 0; i < num_threads; i++){
+    target += seg_count + (i < rem_count);
+    sas[i].start = v;
+    if (bal){
+      while (v < b->num_vts && cum < target){
+        cum += b->vt_wts[v]->num_elts + 1;
+        v++;
+      }
+    }else{
+      v = target;
+    }
+    sas[i].end = v;
+  }
+}
+
+size_t spmv_pthread(const struct adj_lst *b,
+                    void *x,
+                    size_t val_size,
+                    const void *val_zero,
+                    const void *tol,
+                    size_t max_iters,
+                    void (*pre)(void *, void *, const void *, size_t, void *),
+                    void (*gather)(void *, const void *, const void *, void *),
+                    void (*apply)(void *,
+                                  const void *,
+                                  const void *,
+                                  const void *,
+                                  size_t,
+                                  void *),
+                    void (*add_val)(void *, const void *, const void *),
+                    void (*diff_val)(void *, const void *, const void *),
+                    int (*cmp_val)(const void *, const void *),
+                    void *arg,
+                    size_t (*read_vt)(const void *),
+                    int bal,
+                    size_t num_threads){
+  size_t i;
+  size_t num_iters = 0;
+  void *y = NULL, *c = NULL, *scr = NULL, *tmp = NULL;
+  void *glob = NULL, *res = NULL;
+  pthread_t *tids = NULL;
+  struct spmv_arg *sas = NULL;
+  y = malloc_perror(b->num_vts, val_size);
+  c = malloc_perror(b->num_vts, val_size);
+  scr = malloc_perror(mul_sz_perror(3, num_threads), val_size);
+  glob = malloc_perror(2, val_size);
+  res = ptr(glob, 1, val_size);
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  sas = malloc_perror(num_threads, sizeof(struct spmv_arg));
+  split_vts(sas, num_threads, b, bal);
+  for (i = 0; i < num_threads; i++){
+    sas[i].b = b;
+    sas[i].x = x;
+    sas[i].y = y;
+    sas[i].c = c;
+    sas[i].part = ptr(scr, 3 * i, val_size);
+    sas[i].acc = ptr(scr, 3 * i + 1, val_size);
+    sas[i].tmp = ptr(scr, 3 * i + 2, val_size);
+    sas[i].glob = glob;
+    sas[i].val_size = val_size;
+    sas[i].val_zero = val_zero;
+    sas[i].pre = pre;
+    sas[i].gather = gather;
+    sas[i].apply = apply;
+    sas[i].add_val = add_val;
+    sas[i].diff_val = diff_val;
+    sas[i].arg = arg;
+    sas[i].read_vt = read_vt;
+  }
+  while (num_iters < max_iters){
+    run_phase(sas, tids, num_threads, glob, pre_thread);
+    run_phase(sas, tids, num_threads, res, apply_thread);
+    num_iters++;
+    for (i = 0; i < num_threads; i++){
+      tmp = sas[i].y;
+      sas[i].y = sas[i].x;
+      sas[i].x = tmp;
+    }
+    if (cmp_val(res, tol) <= 0) break;
+  }
+  if (sas[0].x != x) memcpy(x, sas[0].x, b->num_vts * val_size);
+  free(y);
+  free(c);
+  free(scr);
+  free(glob);
+  free(tids);
+  free(sas);
+  y = NULL;
+  c = NULL;
+  scr = NULL;
+  glob = NULL;
+  res = NULL;
+  tmp = NULL;
+  tids = NULL;
+  sas = NULL;
+  return num_iters;
+}
+
+/**
+   Computes PageRank with num_threads threads and returns the number of
+   completed iterations. The transpose of a graph is built once with
+   adj_lst_transpose_pthread in graph-pthread.h, and the iterations are run
+   by spmv_pthread, where the rank of u is divided by the out-degree of u
+   and the ranks of the vertices without outgoing edges are summed as the
+   global sum. The weights, if any, are ignored.
+   a           : pointer to an adjacency list with at least one vertex
+   rank        : pointer to an array of num_vts rank_size blocks with the
+                 initial ranks, e.g. 1 / num_vts, which are replaced by
+                 the ranks after the last iteration
+   rank_size   : non-zero size of the type used to represent ranks
+   rank_zero   : pointer to a block of size rank_size with a zero value
+   tol         : pointer to a block of size rank_size with the tolerance
+                 value for the sum of differences of ranks
+   max_iters   : maximal number of iterations
+   div_rank    : writes the value pointed to by the second argument divided
+                 by the non-zero value of the third argument to the
+                 preallocated rank_size block pointed to by the first
+                 argument
+   upd_rank    : writes the rank of a vertex in the next iteration to the
+                 preallocated rank_size block pointed to by the first
+                 argument, given pointers to the sum of the divided ranks
+                 of its in-neighbors and to the sum of the ranks of the
+                 vertices without outgoing edges as the second and third
+                 arguments, and the number of vertices as the fourth
+                 argument, e.g. r = (1 - d) / n + d * (s + t / n) with a
+                 damping factor d
+   add_rank    : addition function which copies the sum of the ranks
+                 pointed to by the second and third arguments to the
+                 preallocated rank_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument
+   diff_rank   : writes the absolute value of the difference of the ranks
+                 pointed to by the second and third arguments to the
+                 preallocated rank_size block pointed to by the first
+                 argument
+   cmp_rank    : comparison function which returns a negative integer value
+                 if the rank pointed to by the first argument is less than
+                 the rank pointed to by the second, a positive integer
+                 value if the rank pointed to by the first argument is
+                 greater than the rank pointed to by the second, and zero
+                 integer value if the two ranks are equal
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   bal         : non-zero if the ranges of vertices of threads are balanced
+                 by the number of pairs, otherwise zero
+   num_threads : > 0 number of threads
+   The functions div_rank, upd_rank, add_rank, diff_rank, and cmp_rank are
+   called concurrently by threads and must be thread-safe.
+*/
+
+struct pr_arg{
+  const struct adj_lst *a;
+  size_t rank_size;
+  const void *rank_zero;
+  void (*div_rank)(void *, const void *, size_t);
+  void (*upd_rank)(void *, const void *, const void *, size_t);
+  void (*add_rank)(void *, const void *, const void *);
+};
+
+static void pre_pr(void *c, void *g, const void *xu, size_t u, void *arg){
+  struct pr_arg *pa = arg;
+  size_t deg = pa->a->vt_wts[u]->num_elts;
+  if (deg > 0){
+    pa->div_rank(c, xu, deg);
+    memcpy(g, pa->rank_zero, pa->rank_size);
+  }else{
+    memcpy(c, pa->rank_zero, pa->rank_size);
+    memcpy(g, xu, pa->rank_size);
+  }
+}
+
+static void gather_pr(void *acc, const void *cu, const void *wt, void *arg){
+  struct pr_arg *pa = arg;
+  (void)wt;
+  pa->add_rank(acc, acc, cu);
+}
+
+static void apply_pr(void *y,
+                     const void *acc,
+                     const void *glob,
+                     const void *xv,
+                     size_t v,
+                     void *arg){
+  struct pr_arg *pa = arg;
+  (void)xv;
+  (void)v;
+  pa->upd_rank(y, acc, glob, pa->a->num_vts);
+}
+
+size_t pagerank_pthread(const struct adj_lst *a,
+                        void *rank,
+                        size_t rank_size,
+                        const void *rank_zero,
+                        const void *tol,
+                        size_t max_iters,
+                        void (*div_rank)(void *, const void *, size_t),
+                        void (*upd_rank)(void *,
+                                         const void *,
+                                         const void *,
+                                         size_t),
+                        void (*add_rank)(void *, const void *, const void *),
+                        void (*diff_rank)(void *, const void *, const void *),
+                        int (*cmp_rank)(const void *, const void *),
+                        size_t (*read_vt)(const void *),
+                        void (*write_vt)(void *, size_t),
+                        int bal,
+                        size_t num_threads){
+  size_t ret;
+  struct graph g;
+  struct adj_lst b;
+  struct pr_arg pa;
+  graph_base_init(&g, a->num_vts, a->vt_size, a->wt_size);
+  adj_lst_base_init(&b, &g);
+  adj_lst_unbound(&b);
+  adj_lst_transpose_pthread(&b, a, read_vt, write_vt, num_threads);
+  pa.a = a;
+  pa.rank_size = rank_size;
+  pa.rank_zero = rank_zero;
+  pa.div_rank = div_rank;
+  pa.upd_rank = upd_rank;
+  pa.add_rank = add_rank;
+  ret = spmv_pthread(&b, rank, rank_size, rank_zero, tol, max_iters,
+                     pre_pr, gather_pr, apply_pr, add_rank, diff_rank,
+                     cmp_rank, &pa, read_vt, bal, num_threads);
+  adj_lst_free(&b);
+  return ret;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
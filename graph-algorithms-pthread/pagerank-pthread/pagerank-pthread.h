@@ -0,0 +1,202 @@
+/**
+   pagerank-pthread.h
+
+   Declarations of accessible functions for computing PageRank and for
+   running generic sparse matrix-vector iterations on graphs with generic
+   integer vertices indexed from 0 with multiple threads.
+
+   The iterations are pull-based. The value of a vertex v in the next
+   iteration is computed from the values of the start vertices of the
+   pairs in the list of v in an adjacency list of the transpose of a graph,
+   so that only the thread that owns v writes the value of v, and no locks
+   and no atomic operations are used. The values of an iteration and of the
+   next iteration are kept in two arrays that are swapped after each
+   iteration. Each thread owns a contiguous range of vertices, where the
+   ranges have about the same number of vertices, or about the same sum of
+   the number of pairs and the number of vertices if degree-based load
+   balancing is selected for graphs with a skewed degree distribution.
+
+   The values are represented by a user-provided type, e.g. a
+   floating-point type on suitable systems, and are only modified by
+   user-provided functions. An iteration stops after the sum of the
+   differences between the values of two consecutive iterations is not
+   greater than a tolerance value, or after a maximal number of
+   iterations.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef PAGERANK_PTHREAD_H
+#define PAGERANK_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Runs a generic pull-based iteration with num_threads threads and returns
+   the number of completed iterations. In each iteration, first the value
+   sent along the edges from each vertex u and the contribution of u to a
+   global sum are computed by pre, and the contributions are summed. Then
+   for each vertex v, the values sent from the start vertices of the pairs
+   in the list of v are accumulated by gather, and the value of v in the
+   next iteration is computed by apply from the accumulated value, the
+   global sum, and the value of v. Runs in O(k * (num_vts + num_es)) time,
+   where k is the number of iterations, which is split across threads.
+   b           : pointer to an adjacency list, where the list of v contains
+                 a pair with u for each (u, v) edge of a graph, e.g. built
+                 by adj_lst_transpose; if b is weighted then the wt_size
+                 block of a pair is passed to gather
+   x           : pointer to an array of num_vts val_size blocks with the
+                 initial values, which are replaced by the values after the
+                 last iteration
+   val_size    : non-zero size of the type used to represent values
+   val_zero    : pointer to a block of size val_size with a zero value
+   tol         : pointer to a block of size val_size with the tolerance
+                 value for the sum of differences
+   max_iters   : maximal number of iterations
+   pre         : writes the value sent from u to the block pointed to by
+                 the first argument and the contribution of u to the global
+                 sum to the block pointed to by the second argument, given
+                 a pointer to the value of u as the third argument, u as the
+                 fourth argument, and arg as the fifth argument
+   gather      : adds the contribution of the value pointed to by the
+                 second argument, sent along an edge with the weight pointed
+                 to by the third argument, or NULL if b is not weighted, to
+                 the value pointed to by the first argument, and takes arg
+                 as the fourth argument
+   apply       : writes the value of v in the next iteration to the block
+                 pointed to by the first argument, given pointers to the
+                 accumulated value, the global sum, and the value of v as
+                 the second, third, and fourth arguments, v as the fifth
+                 argument, and arg as the sixth argument
+   add_val     : addition function which copies the sum of the values
+                 pointed to by the second and third arguments to the
+                 preallocated val_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument
+   diff_val    : writes the absolute value of the difference of the values
+                 pointed to by the second and third arguments to the
+                 preallocated val_size block pointed to by the first
+                 argument
+   cmp_val     : comparison function which returns a negative integer value
+                 if the value pointed to by the first argument is less than
+                 the value pointed to by the second, a positive integer
+                 value if the value pointed to by the first argument is
+                 greater than the value pointed to by the second, and zero
+                 integer value if the two values are equal
+   arg         : pointer that is taken as the last argument of pre, gather,
+                 and apply
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   bal         : non-zero if the ranges of vertices of threads are balanced
+                 by the number of pairs, otherwise zero
+   num_threads : > 0 number of threads
+   The functions pre, gather, apply, add_val, diff_val, and cmp_val are
+   called concurrently by threads and must be thread-safe.
+*/
+size_t spmv_pthread(const struct adj_lst *b,
+                    void *x,
+                    size_t val_size,
+                    const void *val_zero,
+                    const void *tol,
+                    size_t max_iters,
+                    void (*pre)(void *, void *, const void *, size_t, void *),
+                    void (*gather)(void *, const void *, const void *, void *),
+                    void (*apply)(void *,
+                                  const void *,
+                                  const void *,
+                                  const void *,
+                                  size_t,
+                                  void *),
+                    void (*add_val)(void *, const void *, const void *),
+                    void (*diff_val)(void *, const void *, const void *),
+                    int (*cmp_val)(const void *, const void *),
+                    void *arg,
+                    size_t (*read_vt)(const void *),
+                    int bal,
+                    size_t num_threads);
+
+/**
+   Computes PageRank with num_threads threads and returns the number of
+   completed iterations. The transpose of a graph is built once with
+   adj_lst_transpose_pthread in graph-pthread.h, and the iterations are run
+   by spmv_pthread, where the rank of u is divided by the out-degree of u
+   and the ranks of the vertices without outgoing edges are summed as the
+   global sum. The weights, if any, are ignored.
+   a           : pointer to an adjacency list with at least one vertex
+   rank        : pointer to an array of num_vts rank_size blocks with the
+                 initial ranks, e.g. 1 / num_vts, which are replaced by
+                 the ranks after the last iteration
+   rank_size   : non-zero size of the type used to represent ranks
+   rank_zero   : pointer to a block of size rank_size with a zero value
+   tol         : pointer to a block of size rank_size with the tolerance
+                 value for the sum of differences of ranks
+   max_iters   : maximal number of iterations
+   div_rank    : writes the value pointed to by the second argument divided
+                 by the non-zero value of the third argument to the
+                 preallocated rank_size block pointed to by the first
+                 argument
+   upd_rank    : writes the rank of a vertex in the next iteration to the
+                 preallocated rank_size block pointed to by the first
+                 argument, given pointers to the sum of the divided ranks
+                 of its in-neighbors and to the sum of the ranks of the
+                 vertices without outgoing edges as the second and third
+                 arguments, and the number of vertices as the fourth
+                 argument, e.g. r = (1 - d) / n + d * (s + t / n) with a
+                 damping factor d
+   add_rank    : addition function which copies the sum of the ranks
+                 pointed to by the second and third arguments to the
+                 preallocated rank_size block pointed to by the first
+                 argument, which may be the block pointed to by the second
+                 argument
+   diff_rank   : writes the absolute value of the difference of the ranks
+                 pointed to by the second and third arguments to the
+                 preallocated rank_size block pointed to by the first
+                 argument
+   cmp_rank    : comparison function which returns a negative integer value
+                 if the rank pointed to by the first argument is less than
+                 the rank pointed to by the second, a positive integer
+                 value if the rank pointed to by the first argument is
+                 greater than the rank pointed to by the second, and zero
+                 integer value if the two ranks are equal
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   bal         : non-zero if the ranges of vertices of threads are balanced
+                 by the number of pairs, otherwise zero
+   num_threads : > 0 number of threads
+   The functions div_rank, upd_rank, add_rank, diff_rank, and cmp_rank are
+   called concurrently by threads and must be thread-safe.
+*/
+size_t pagerank_pthread(const struct adj_lst *a,
+                        void *rank,
+                        size_t rank_size,
+                        const void *rank_zero,
+                        const void *tol,
+                        size_t max_iters,
+                        void (*div_rank)(void *, const void *, size_t),
+                        void (*upd_rank)(void *,
+                                         const void *,
+                                         const void *,
+                                         size_t),
+                        void (*add_rank)(void *, const void *, const void *),
+                        void (*diff_rank)(void *, const void *, const void *),
+                        int (*cmp_rank)(const void *, const void *),
+                        size_t (*read_vt)(const void *),
+                        void (*write_vt)(void *, size_t),
+                        int bal,
+                        size_t num_threads);
+
+#endif
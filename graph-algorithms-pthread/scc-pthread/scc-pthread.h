@@ -0,0 +1,75 @@
+/**
+   scc-pthread.h
+
+   Declarations of accessible functions for computing the strongly
+   connected components of a directed graph with generic integer vertices
+   indexed from 0 with multiple threads. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+
+   Each vertex is labeled with the lowest vertex in its component, as in
+   scc in scc.h, and the computed labels are equal to the labels computed
+   by scc.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef SCC_PTHREAD_H
+#define SCC_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the strongly connected components of a directed graph with
+   num_threads threads by trimming and coloring, a variant of the
+   forward-backward approach that finds many components in each
+   iteration. Returns the number of components.
+
+   Each iteration consists of the following steps on the unlabeled
+   vertices. i) Trimming: a vertex without an unlabeled in-neighbor or
+   out-neighbor other than itself is a component, and is labeled, until
+   no vertex is trimmed. ii) Coloring: each vertex is colored with the
+   lowest vertex from which it is reachable, by propagating the lowest
+   colors along the edges until no color changes. A vertex colored with
+   itself is the root of a color. iii) Backward search: the vertices of
+   each color that reach the root of the color form the component of the
+   root, which is the lowest vertex of the component, and are labeled with
+   the root. The iterations end when all vertices are labeled.
+
+   Each step consists of rounds separated by joining all threads, where
+   each thread computes the new values of a contiguous range of vertices
+   with about the same number of pairs in a and its transpose from the
+   values of the previous round in a second array. As a result, no locks
+   and no atomic operations are used. The transpose is built with
+   adj_lst_transpose_pthread. The number of rounds of a step is bounded by
+   the length of the longest path among the unlabeled vertices, and the
+   approach is suitable for graphs with a small diameter, such as the
+   graphs of many real-world networks. scc is preferred for graphs with
+   long paths.
+   a           : pointer to an adjacency list
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   num_threads : > 0 number of threads
+*/
+size_t scc_pthread(const struct adj_lst *a,
+                   void *lbl,
+                   size_t (*read_vt)(const void *),
+                   void (*write_vt)(void *, size_t),
+                   size_t num_threads);
+
+#endif
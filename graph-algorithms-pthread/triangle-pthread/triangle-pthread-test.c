@@ -0,0 +1,362 @@
+/**
+   triangle-pthread-test.c
+
+   Tests of triangle counting and listing with multiple threads across
+   graphs with different integer types of vertices within the same
+   translation unit.
+
+   The following command line arguments can be used to customize tests:
+   triangle-pthread-test
+      [0, ushort width - 2] : n for 2**n vertices in smallest graph
+      [0, ushort width - 2] : n for 2**n vertices in largest graph
+      [1, 64] : number of threads
+      [0, 1] : R-MAT graph test on/off
+      [0, 1] : complete graph test on/off
+
+   usage examples:
+   ./triangle-pthread-test
+   ./triangle-pthread-test 10 14
+   ./triangle-pthread-test 10 14 8
+   ./triangle-pthread-test 10 14 8 0 1
+
+   triangle-pthread-test can be run with any subset of command line
+   arguments in the above-defined order. If the (i + 1)th argument is
+   specified then the ith argument must be specified for i >= 0. Default
+   values are used for the unspecified arguments according to the
+   C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, ii) size_t and clock_t are
+   convertible to double, and iii) pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include "triangle-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+#include "utilities-pthread.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "triangle-pthread-test \n"
+  "[0, ushort width - 2] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 2] : n for 2**n vertices in largest graph \n"
+  "[1, 64] : number of threads \n"
+  "[0, 1] : R-MAT graph test on/off \n"
+  "[0, 1] : complete graph test on/off \n";
+const int C_ARGC_ULIMIT = 6;
+const size_t C_ARGS_DEF[5] = {8u, 11u, 4u, 1u, 1u};
+const size_t C_THREADS_ULIMIT = 64u;
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTOR = 8u;
+const size_t C_CLIQUE_LOG_ULIMIT = 8u;
+
+struct visit_arg{
+  int res;
+  size_t num_tris;
+  size_t *tri;
+  pthread_mutex_t *lock;
+  const struct adj_lst *a;
+  size_t (*read_vt)(const void *);
+};
+
+void visit_tri(size_t u, size_t v, size_t w, void *arg);
+size_t tri_def(const struct adj_lst *a,
+               size_t *tri,
+               size_t (*read_vt)(const void *));
+int cmp_arr(const size_t *a, const size_t *b, size_t n);
+void print_test_result(int res);
+
+/**
+   Runs triangles_pthread with one thread and with num_threads threads on
+   an adjacency list as built, and with num_threads threads, while listing
+   the triangles, on the adjacency list after its lists are sorted and the
+   duplicate vertices are removed. The results are compared with the
+   results of a single-threaded computation, which for each vertex tests
+   each pair of its neighbors for adjacency.
+*/
+void tri_helper(struct adj_lst *a,
+                size_t j,
+                size_t num_threads,
+                int *res){
+  size_t n = a->num_vts;
+  size_t num_one, num_thds, num_def;
+  size_t *tri = NULL, *tri_thds = NULL, *tri_list = NULL, *tri_d = NULL;
+  clock_t t_one, t_thds;
+  pthread_mutex_t lock;
+  struct visit_arg va;
+  tri = malloc_perror(n, sizeof(size_t));
+  tri_thds = malloc_perror(n, sizeof(size_t));
+  tri_list = malloc_perror(n, sizeof(size_t));
+  tri_d = malloc_perror(n, sizeof(size_t));
+  t_one = clock();
+  num_one = triangles_pthread(a, tri, NULL, NULL, C_READ[j], 1);
+  t_one = clock() - t_one;
+  t_thds = clock();
+  num_thds = triangles_pthread(a, tri_thds, NULL, NULL, C_READ[j],
+                               num_threads);
+  t_thds = clock() - t_thds;
+  *res *= (triangles_pthread(a, NULL, NULL, NULL, C_READ[j],
+                             num_threads) == num_one);
+  adj_lst_sort(a, C_CMP[j]);
+  adj_lst_dedup(a, C_CMP[j]);
+  mutex_init_perror(&lock);
+  va.res = 1;
+  va.num_tris = 0;
+  va.tri = tri_list;
+  va.lock = &lock;
+  va.a = a;
+  va.read_vt = C_READ[j];
+  memset(tri_list, 0, n * sizeof(size_t));
+  *res *= (triangles_pthread(a, NULL, visit_tri, &va, C_READ[j],
+                             num_threads) == num_one);
+  num_def = tri_def(a, tri_d, C_READ[j]);
+  printf("\t\t\t%s # triangles:          %lu\n",
+         C_VT_TYPES[j], TOLU(num_one));
+  printf("\t\t\t%s one thread time:      %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], (double)t_one / CLOCKS_PER_SEC);
+  printf("\t\t\t%s %lu thread(s) time:     %.6f seconds (cpu)\n",
+         C_VT_TYPES[j], TOLU(num_threads), (double)t_thds / CLOCKS_PER_SEC);
+  *res *= (num_one == num_def && num_thds == num_def);
+  *res *= (va.res && va.num_tris == num_def);
+  *res *= cmp_arr(tri, tri_d, n);
+  *res *= cmp_arr(tri_thds, tri_d, n);
+  *res *= cmp_arr(tri_list, tri_d, n);
+  free(tri);
+  free(tri_thds);
+  free(tri_list);
+  free(tri_d);
+  tri = NULL;
+  tri_thds = NULL;
+  tri_list = NULL;
+  tri_d = NULL;
+}
+
+/**
+   Run tests on undirected R-MAT graphs with a skewed degree distribution,
+   which may have multiple edges between the same vertices and loops.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test triangles_pthread on undirected R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts),
+           TOLU(num_threads));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      tri_helper(&a, j, num_threads, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on complete graphs, where a graph with n vertices has
+   n * (n - 1) * (n - 2) / 6 triangles and each vertex is in
+   (n - 1) * (n - 2) / 2 triangles.
+*/
+
+int bern_one(void *arg){
+  (void)arg;
+  return 1;
+}
+
+void run_clique_test(size_t log_start, size_t log_end, size_t num_threads){
+  int res = 1;
+  size_t i, j, u, v;
+  size_t num_vts;
+  size_t *tri = NULL;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test triangles_pthread on complete graphs\n");
+  if (log_end > C_CLIQUE_LOG_ULIMIT) log_end = C_CLIQUE_LOG_ULIMIT;
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, threads: %lu\n",
+           TOLU(num_vts), TOLU(num_threads));
+    tri = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      for (u = 0; u < num_vts; u++){
+        for (v = u + 1; v < num_vts; v++){
+          adj_lst_add_undir_edge(&a, u, v, NULL, C_WRITE[j], bern_one, NULL);
+        }
+      }
+      res *= (triangles_pthread(&a, tri, NULL, NULL, C_READ[j],
+                                num_threads) ==
+              num_vts * (num_vts - 1) / 2 * (num_vts - 2) / 3);
+      for (u = 0; u < num_vts; u++){
+        res *= (tri[u] == (num_vts - 1) * (num_vts - 2) / 2);
+      }
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+    free(tri);
+    tri = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Tests that the vertices of a listed triangle are distinct and adjacent,
+   and counts the triangle. The lists of the adjacency list are sorted.
+*/
+void visit_tri(size_t u, size_t v, size_t w, void *arg){
+  struct visit_arg *va = arg;
+  int ret = (u != v && v != w && u != w &&
+             adj_lst_has_edge(va->a, u, v, va->read_vt) &&
+             adj_lst_has_edge(va->a, v, w, va->read_vt) &&
+             adj_lst_has_edge(va->a, w, u, va->read_vt));
+  mutex_lock_perror(va->lock);
+  va->res *= ret;
+  va->num_tris++;
+  va->tri[u]++;
+  va->tri[v]++;
+  va->tri[w]++;
+  mutex_unlock_perror(va->lock);
+}
+
+/**
+   Counts the triangles of an undirected graph, where the lists of the
+   adjacency list are sorted and have no duplicate vertices, by testing
+   each pair of distinct neighbors of each vertex for adjacency, and
+   returns the number of triangles.
+*/
+size_t tri_def(const struct adj_lst *a,
+               size_t *tri,
+               size_t (*read_vt)(const void *)){
+  size_t i, k, u, v, w;
+  size_t num_tris = 0;
+  const char *elts = NULL;
+  for (u = 0; u < a->num_vts; u++){
+    tri[u] = 0;
+    elts = a->vt_wts[u]->elts;
+    for (i = 0; i < a->vt_wts[u]->num_elts; i++){
+      v = read_vt(elts + i * a->pair_size);
+      if (v == u) continue;
+      for (k = i + 1; k < a->vt_wts[u]->num_elts; k++){
+        w = read_vt(elts + k * a->pair_size);
+        if (w != u && adj_lst_has_edge(a, v, w, read_vt)) tri[u]++;
+      }
+    }
+    num_tris += tri[u];
+  }
+  return num_tris / 3;
+}
+
+/**
+   Returns 1 if two arrays of size_t elements are equal, otherwise
+   returns 0.
+*/
+int cmp_arr(const size_t *a, const size_t *b, size_t n){
+  size_t i;
+  for (i = 0; i < n; i++){
+    if (a[i] != b[i]) return 0;
+  }
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 2 ||
+      args[1] > C_USHORT_BIT - 2 ||
+      args[1] < args[0] ||
+      args[2] < 1 ||
+      args[2] > C_THREADS_ULIMIT ||
+      args[3] > 1 ||
+      args[4] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[3]) run_rmat_test(args[0], args[1], args[2]);
+  if (args[4]) run_clique_test(args[0], args[1], args[2]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,366 @@
+/**
+   triangle-pthread.c
+
+   Functions for counting and listing the triangles of undirected graphs
+   with generic integer vertices indexed from 0 with multiple threads.
+
+   Each edge is oriented from the endpoint with the lower rank to the
+   endpoint with the higher rank, where the vertices are ranked by their
+   degrees and the ties are broken by their indices. The oriented lists
+   are sorted and have no duplicate vertices and no loops, and each
+   triangle is found exactly once as a vertex w in the intersection of the
+   oriented lists of u and v, where v is in the oriented list of u. Each
+   oriented list of a vertex of high degree has at most O(sqrt(num_es))
+   vertices. Two lists are intersected by a merge, where the positions in
+   both lists are advanced without branching on the comparison, or by a
+   galloping search of each vertex of the shorter list in the longer list
+   if the lengths of the lists differ by a large factor.
+
+   The vertices are taken by num_threads threads in chunks from a shared
+   counter, so that threads which process vertices with long oriented
+   lists take fewer chunks. If the numbers of triangles per vertex are
+   requested, each thread counts them in its own array, and the arrays of
+   the threads are reduced in parallel after all vertices are processed.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#define _XOPEN_SOURCE 600
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "triangle-pthread.h"
+#include "graph.h"
+#include "utilities-mem.h"
+#include "utilities-pthread.h"
+
+static const size_t C_CHUNK = 64u; /* vertices taken at once by a thread */
+static const size_t C_GALLOP_RATIO = 16u;
+
+/**
+   Counts the triangles of an undirected graph with num_threads threads and
+   returns the number of triangles, where multiple edges between the same
+   vertices are counted as one edge and loops are ignored. Runs in
+   O(num_es * sqrt(num_es)) time in the worst case, which is split across
+   threads, in addition to the time of sorting the oriented lists.
+   a           : pointer to an adjacency list of an undirected graph with at
+                 least one vertex, where an edge (u, v) is in the lists of
+                 u and v, e.g. built by adj_lst_undir_build, and with at
+                 most SIZE_MAX triangles; the weights, if any, are ignored
+   tri         : - NULL pointer, if the numbers of triangles per vertex are
+                 not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 size_t elements, where the number of triangles that
+                 contain v is set at the index v, e.g. to compute the local
+                 clustering coefficient of v as tri[v] / (d * (d - 1) / 2),
+                 where d is the number of distinct neighbors of v
+   visit       : - NULL pointer, if the triangles are not listed
+                 - otherwise called with the vertices of each triangle as
+                 the first three arguments, in an unspecified order of
+                 triangles, and with arg as the fourth argument; the
+                 function is called concurrently by threads and must be
+                 thread-safe
+   arg         : pointer that is taken as the fourth argument of visit
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+
+struct tri_arg{
+  size_t ix;
+  size_t num_threads;
+  size_t *next;              /* next vertex, shared across threads */
+  pthread_mutex_t *lock;     /* guards next */
+  const struct adj_lst *a;
+  size_t *offs;              /* start of the oriented list of each vertex */
+  size_t *cnt;               /* length of the oriented list of each vertex */
+  size_t *adj;               /* oriented lists */
+  size_t *accs;              /* triangles per vertex, num_vts per thread */
+  size_t *tri;
+  size_t num_tris;           /* triangles found by the thread */
+  void (*visit)(size_t, size_t, size_t, void *);
+  void *arg;
+  size_t (*read_vt)(const void *);
+};
+
+/**
+   Takes the next chunk of vertices. Returns 0 if all vertices are taken,
+   otherwise sets the range of the chunk and returns 1.
+*/
+static int next_chunk(struct tri_arg *ta, size_t *start, size_t *end){
+  size_t n = ta->a->num_vts;
+  mutex_lock_perror(ta->lock);
+  *start = *ta->next;
+  *end = (n - *start > C_CHUNK) ? *start + C_CHUNK : n;
+  *ta->next = *end;
+  mutex_unlock_perror(ta->lock);
+  return (*start < n);
+}
+
+/**
+   Returns 1 if v has a higher rank than u, otherwise returns 0.
+*/
+static int is_higher(const struct adj_lst *a, size_t u, size_t v){
+  size_t deg_u = a->vt_wts[u]->num_elts;
+  size_t deg_v = a->vt_wts[v]->num_elts;
+  return (deg_v > deg_u || (deg_v == deg_u && v > u));
+}
+
+/**
+   Computes the number of vertices of higher rank in the list of each
+   vertex, including duplicates.
+*/
+static void *count_thread(void *arg){
+  size_t u, v, start, end;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct tri_arg *ta = arg;
+  const struct adj_lst *a = ta->a;
+  while (next_chunk(ta, &start, &end)){
+    for (u = start; u < end; u++){
+      ta->cnt[u] = 0;
+      p_start = a->vt_wts[u]->elts;
+      p_end = (const char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+      for (p = p_start; p != p_end; p = (const char *)p + a->pair_size){
+        v = ta->read_vt(p);
+        ta->cnt[u] += is_higher(a, u, v);
+      }
+    }
+  }
+  return NULL;
+}
+
+/**
+   Fills, sorts, and removes the duplicates from the oriented list of each
+   vertex, and sets the length of the list.
+*/
+static void *fill_thread(void *arg){
+  size_t i, j, u, v, start, end;
+  size_t *s = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct tri_arg *ta = arg;
+  const struct adj_lst *a = ta->a;
+  while (next_chunk(ta, &start, &end)){
+    for (u = start; u < end; u++){
+      if (ta->cnt[u] == 0) continue;
+      s = ta->adj + ta->offs[u];
+      i = 0;
+      p_start = a->vt_wts[u]->elts;
+      p_end = (const char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+      for (p = p_start; p != p_end; p = (const char *)p + a->pair_size){
+        v = ta->read_vt(p);
+        if (is_higher(a, u, v)) s[i++] = v;
+      }
+      if (i > 1) qsort(s, i, sizeof(size_t), graph_cmp_sz);
+      for (j = 1, i = 1; j < ta->cnt[u]; j++){
+        if (s[j] != s[i - 1]) s[i++] = s[j];
+      }
+      ta->cnt[u] = i;
+    }
+  }
+  s = NULL;
+  return NULL;
+}
+
+/**
+   Records a triangle found by a thread.
+*/
+static void add_tri(struct tri_arg *ta, size_t u, size_t v, size_t w){
+  size_t *acc = NULL;
+  ta->num_tris++;
+  if (ta->tri != NULL){
+    acc = ta->accs + ta->ix * ta->a->num_vts;
+    acc[u]++;
+    acc[v]++;
+    acc[w]++;
+  }
+  if (ta->visit != NULL) ta->visit(u, v, w, ta->arg);
+}
+
+/**
+   Finds the triangles with the edge (u, v) by intersecting the oriented
+   lists of u and v. If the longer list is more than C_GALLOP_RATIO times
+   longer than the shorter list, each vertex of the shorter list is
+   searched in the longer list by galloping from the last position and a
+   binary search, otherwise the lists are merged.
+*/
+static void isect(struct tri_arg *ta, size_t u, size_t v){
+  size_t i = 0, j = 0, l, h, m;
+  size_t x_num = ta->cnt[u], y_num = ta->cnt[v];
+  size_t xi, yj;
+  const size_t *x = ta->adj + ta->offs[u];
+  const size_t *y = ta->adj + ta->offs[v];
+  const size_t *t = NULL;
+  if (x_num > y_num){
+    t = x;
+    x = y;
+    y = t;
+    l = x_num;
+    x_num = y_num;
+    y_num = l;
+  }
+  if (y_num / C_GALLOP_RATIO > x_num){
+    for (i = 0; i < x_num && j < y_num; i++){
+      /* gallop: vertices at indices below l are less than x[i] */
+      l = j;
+      h = j + 1;
+      while (h < y_num && y[h - 1] < x[i]){
+        l = h;
+        h = (h - j > y_num - h) ? y_num : h + (h - j);
+      }
+      if (h > y_num) h = y_num;
+      while (l < h){
+        m = l + (h - l) / 2;
+        if (y[m] < x[i]){
+          l = m + 1;
+        }else{
+          h = m;
+        }
+      }
+      j = l;
+      if (j < y_num && y[j] == x[i]) add_tri(ta, u, v, x[i]);
+    }
+  }else{
+    while (i < x_num && j < y_num){
+      xi = x[i];
+      yj = y[j];
+      if (xi == yj) add_tri(ta, u, v, xi);
+      i += (xi <= yj);
+      j += (yj <= xi);
+    }
+  }
+  x = NULL;
+  y = NULL;
+  t = NULL;
+}
+
+static void *tri_thread(void *arg){
+  size_t i, u, start, end;
+  struct tri_arg *ta = arg;
+  size_t n = ta->a->num_vts;
+  if (ta->tri != NULL){
+    memset(ta->accs + ta->ix * n, 0, n * sizeof(size_t));
+  }
+  while (next_chunk(ta, &start, &end)){
+    for (u = start; u < end; u++){
+      for (i = 0; i < ta->cnt[u]; i++){
+        isect(ta, u, ta->adj[ta->offs[u] + i]);
+      }
+    }
+  }
+  return NULL;
+}
+
+/**
+   Sums the triangles per vertex counted by the threads for a contiguous
+   range of vertices, where the ranges of the first threads have one more
+   vertex.
+*/
+static void *reduce_thread(void *arg){
+  size_t i, v;
+  size_t start, end;
+  struct tri_arg *ta = arg;
+  size_t n = ta->a->num_vts;
+  size_t seg_count = n / ta->num_threads;
+  size_t rem_count = n - seg_count * ta->num_threads;
+  start = ta->ix * seg_count + ((ta->ix < rem_count) ? ta->ix : rem_count);
+  end = start + seg_count + (ta->ix < rem_count);
+  for (v = start; v < end; v++){
+    ta->tri[v] = 0;
+    for (i = 0; i < ta->num_threads; i++){
+      ta->tri[v] += ta->accs[i * n + v];
+    }
+  }
+  return NULL;
+}
+
+static void run_phase(struct tri_arg *tas,
+                      pthread_t *tids,
+                      size_t num_threads,
+                      void *(*thread)(void *)){
+  size_t i;
+  *tas[0].next = 0;
+  for (i = 0; i < num_threads; i++){
+    thread_create_perror(&tids[i], thread, &tas[i]);
+  }
+  for (i = 0; i < num_threads; i++){
+    thread_join_perror(tids[i], NULL);
+  }
+}
+
+size_t triangles_pthread(const struct adj_lst *a,
+                         size_t *tri,
+                         void (*visit)(size_t, size_t, size_t, void *),
+                         void *arg,
+                         size_t (*read_vt)(const void *),
+                         size_t num_threads){
+  size_t i, u;
+  size_t next = 0, num_adj = 0, ret = 0;
+  size_t *offs = NULL, *cnt = NULL, *adj = NULL, *accs = NULL;
+  pthread_t *tids = NULL;
+  pthread_mutex_t lock;
+  struct tri_arg *tas = NULL;
+  offs = malloc_perror(a->num_vts, sizeof(size_t));
+  cnt = malloc_perror(a->num_vts, sizeof(size_t));
+  if (tri != NULL){
+    accs = malloc_perror(mul_sz_perror(num_threads, a->num_vts),
+                         sizeof(size_t));
+  }
+  tids = malloc_perror(num_threads, sizeof(pthread_t));
+  tas = malloc_perror(num_threads, sizeof(struct tri_arg));
+  mutex_init_perror(&lock);
+  for (i = 0; i < num_threads; i++){
+    tas[i].ix = i;
+    tas[i].num_threads = num_threads;
+    tas[i].next = &next;
+    tas[i].lock = &lock;
+    tas[i].a = a;
+    tas[i].offs = offs;
+    tas[i].cnt = cnt;
+    tas[i].accs = accs;
+    tas[i].tri = tri;
+    tas[i].num_tris = 0;
+    tas[i].visit = visit;
+    tas[i].arg = arg;
+    tas[i].read_vt = read_vt;
+  }
+  run_phase(tas, tids, num_threads, count_thread);
+  for (u = 0; u < a->num_vts; u++){
+    offs[u] = num_adj;
+    num_adj += cnt[u]; /* at most num_es */
+  }
+  adj = malloc_perror((num_adj > 0) ? num_adj : 1, sizeof(size_t));
+  for (i = 0; i < num_threads; i++){
+    tas[i].adj = adj;
+  }
+  run_phase(tas, tids, num_threads, fill_thread);
+  run_phase(tas, tids, num_threads, tri_thread);
+  if (tri != NULL) run_phase(tas, tids, num_threads, reduce_thread);
+  for (i = 0; i < num_threads; i++){
+    ret = add_sz_perror(ret, tas[i].num_tris);
+  }
+  free(offs);
+  free(cnt);
+  free(adj);
+  free(accs);
+  free(tids);
+  free(tas);
+  offs = NULL;
+  cnt = NULL;
+  adj = NULL;
+  accs = NULL;
+  tids = NULL;
+  tas = NULL;
+  return ret;
+}
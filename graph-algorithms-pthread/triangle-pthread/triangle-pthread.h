@@ -0,0 +1,79 @@
+/**
+   triangle-pthread.h
+
+   Declarations of accessible functions for counting and listing the
+   triangles of undirected graphs with generic integer vertices indexed
+   from 0 with multiple threads.
+
+   Each edge is oriented from the endpoint with the lower rank to the
+   endpoint with the higher rank, where the vertices are ranked by their
+   degrees and the ties are broken by their indices. The oriented lists
+   are sorted and have no duplicate vertices and no loops, and each
+   triangle is found exactly once as a vertex w in the intersection of the
+   oriented lists of u and v, where v is in the oriented list of u. Each
+   oriented list of a vertex of high degree has at most O(sqrt(num_es))
+   vertices. Two lists are intersected by a merge, where the positions in
+   both lists are advanced without branching on the comparison, or by a
+   galloping search of each vertex of the shorter list in the longer list
+   if the lengths of the lists differ by a large factor.
+
+   The vertices are taken by num_threads threads in chunks from a shared
+   counter, so that threads which process vertices with long oriented
+   lists take fewer chunks. If the numbers of triangles per vertex are
+   requested, each thread counts them in its own array, and the arrays of
+   the threads are reduced in parallel after all vertices are processed.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99. The requirement is that pthreads API is available.
+*/
+
+#ifndef TRIANGLE_PTHREAD_H
+#define TRIANGLE_PTHREAD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Counts the triangles of an undirected graph with num_threads threads and
+   returns the number of triangles, where multiple edges between the same
+   vertices are counted as one edge and loops are ignored. Runs in
+   O(num_es * sqrt(num_es)) time in the worst case, which is split across
+   threads, in addition to the time of sorting the oriented lists.
+   a           : pointer to an adjacency list of an undirected graph with at
+                 least one vertex, where an edge (u, v) is in the lists of
+                 u and v, e.g. built by adj_lst_undir_build, and with at
+                 most SIZE_MAX triangles; the weights, if any, are ignored
+   tri         : - NULL pointer, if the numbers of triangles per vertex are
+                 not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 size_t elements, where the number of triangles that
+                 contain v is set at the index v, e.g. to compute the local
+                 clustering coefficient of v as tri[v] / (d * (d - 1) / 2),
+                 where d is the number of distinct neighbors of v
+   visit       : - NULL pointer, if the triangles are not listed
+                 - otherwise called with the vertices of each triangle as
+                 the first three arguments, in an unspecified order of
+                 triangles, and with arg as the fourth argument; the
+                 function is called concurrently by threads and must be
+                 thread-safe
+   arg         : pointer that is taken as the fourth argument of visit
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   num_threads : > 0 number of threads
+*/
+size_t triangles_pthread(const struct adj_lst *a,
+                         size_t *tri,
+                         void (*visit)(size_t, size_t, size_t, void *),
+                         void *arg,
+                         size_t (*read_vt)(const void *),
+                         size_t num_threads);
+
+#endif
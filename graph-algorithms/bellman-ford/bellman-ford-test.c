@@ -0,0 +1,387 @@
+/**
+   bellman-ford-test.c
+
+   Tests of the Bellman-Ford algorithm across graphs with different integer
+   types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   bellman-ford-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : path graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./bellman-ford-test
+   ./bellman-ford-test 10 14
+   ./bellman-ford-test 14 16 0 1
+
+   bellman-ford-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "bellman-ford.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "bellman-ford-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : path graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 10u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 4u};
+const long C_WT_ZERO = 0;
+const long C_WT_RANGE = 100; /* base weights and potentials */
+
+void rand_perm(size_t *perm, size_t n);
+int cmp_paths(const struct adj_lst *a,
+              size_t start,
+              const long *dist,
+              const void *prev,
+              size_t (*read_vt)(const void *));
+int bern_one(void *arg);
+void print_test_result(int res);
+
+/**
+   Run tests on directed paths with vertices in a random order and
+   negative weights, where the number of rounds equals the number of
+   vertices. A path is a cycle after an edge from its last to its first
+   vertex is added, and the cycle is negative if the weight of the edge is
+   negative.
+*/
+void run_path_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  size_t *perm = NULL;
+  long wt = -1;
+  long *dist = NULL;
+  void *prev = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test bellman_ford on directed paths\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    dist = malloc_perror(num_vts, sizeof(long));
+    for (j = 0; j < C_FN_COUNT; j++){
+      rand_perm(perm, num_vts);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(long));
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      wt = -1;
+      for (k = 0; k + 1 < num_vts; k++){
+        adj_lst_add_dir_edge(&a, perm[k], perm[k + 1], &wt,
+                             C_WRITE[j], bern_one, NULL);
+      }
+      prev = malloc_perror(num_vts, C_VT_SIZES[j]);
+      t = clock();
+      res *= bellman_ford(&a, perm[0], dist, prev, &C_WT_ZERO,
+                          C_READ[j], C_WRITE[j],
+                          graph_cmp_long, graph_add_long);
+      t = clock() - t;
+      printf("\t\t\t%s bellman_ford time: %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      for (k = 0; k < num_vts; k++){
+        res *= (dist[perm[k]] == -(long)k);
+      }
+      wt = num_vts;
+      adj_lst_add_dir_edge(&a, perm[num_vts - 1], perm[0], &wt,
+                           C_WRITE[j], bern_one, NULL);
+      res *= bellman_ford(&a, perm[0], dist, prev, &C_WT_ZERO,
+                          C_READ[j], C_WRITE[j],
+                          graph_cmp_long, graph_add_long);
+      wt = -1;
+      adj_lst_add_dir_edge(&a, perm[num_vts - 1], perm[0], &wt,
+                           C_WRITE[j], bern_one, NULL);
+      res *= !bellman_ford(&a, perm[0], dist, prev, &C_WT_ZERO,
+                           C_READ[j], C_WRITE[j],
+                           graph_cmp_long, graph_add_long);
+      adj_lst_free(&a);
+      free(prev);
+      prev = NULL;
+    }
+    free(perm);
+    free(dist);
+    perm = NULL;
+    dist = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on R-MAT graphs with weights w(u, v) + p(u) - p(v), where
+   w(u, v) and the potentials p(u) are random non-negative values. The
+   weights can be negative, and the weight of each cycle is non-negative.
+   The distances computed by bellman_ford from a random start vertex are
+   compared with the result of relaxations of all edges until no distance
+   is updated. A negative cycle is obtained by adding a reverse edge with
+   a weight that is less than the negated weight of an edge.
+*/
+
+void gen_wt(void *wt, void *arg){
+  (void)arg;
+  *(long *)wt = RANDOM() % (C_WT_RANGE + 1);
+}
+
+void add_pots(struct graph *g, size_t (*read_vt)(const void *));
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, u, start;
+  size_t num_vts;
+  long wt;
+  long *dist = NULL;
+  void *prev = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test bellman_ford on R-MAT graphs with negative weights\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n directed edges\n",
+           TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      dist = malloc_perror(num_vts, sizeof(long));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(long));
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, gen_wt, NULL);
+        add_pots(&g, C_READ[j]);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        prev = malloc_perror(num_vts, C_VT_SIZES[j]);
+        start = RANDOM() % num_vts;
+        t = clock();
+        res *= bellman_ford(&a, start, dist, prev, &C_WT_ZERO,
+                            C_READ[j], C_WRITE[j],
+                            graph_cmp_long, graph_add_long);
+        t = clock() - t;
+        printf("\t\t\t%s bellman_ford time: %.6f seconds\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        res *= cmp_paths(&a, start, dist, prev, C_READ[j]);
+        u = C_READ[j](g.u);
+        wt = -*(long *)g.wts - 1;
+        adj_lst_add_dir_edge(&a, C_READ[j](g.v), u, &wt,
+                             C_WRITE[j], bern_one, NULL);
+        res *= !bellman_ford(&a, u, dist, prev, &C_WT_ZERO,
+                             C_READ[j], C_WRITE[j],
+                             graph_cmp_long, graph_add_long);
+        adj_lst_free(&a);
+        graph_free(&g);
+        free(prev);
+        prev = NULL;
+      }
+      free(dist);
+      dist = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Adds p(u) - p(v) to the weight of each (u, v) edge of a graph, where
+   p(u) is a random potential in [0, C_WT_RANGE].
+*/
+void add_pots(struct graph *g, size_t (*read_vt)(const void *)){
+  size_t i;
+  long *pot = malloc_perror(g->num_vts, sizeof(long));
+  long *wts = g->wts;
+  for (i = 0; i < g->num_vts; i++){
+    pot[i] = RANDOM() % (C_WT_RANGE + 1);
+  }
+  for (i = 0; i < g->num_es; i++){
+    wts[i] += pot[read_vt((char *)g->u + i * g->vt_size)] -
+              pot[read_vt((char *)g->v + i * g->vt_size)];
+  }
+  free(pot);
+  pot = NULL;
+}
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+/**
+   Computes the shortest distances from start by relaxing all edges until
+   no distance is updated, and compares the result with
+   the dist and prev arrays. The previous vertex of each reached vertex
+   v other than start must be a reached vertex u with a (u, v) edge of
+   weight dist[v] - dist[u]. Returns 1 if the results match, otherwise
+   returns 0.
+*/
+int cmp_paths(const struct adj_lst *a,
+              size_t start,
+              const long *dist,
+              const void *prev,
+              size_t (*read_vt)(const void *)){
+  int ret = 1, upd = 1, found;
+  size_t i, k, u, v;
+  size_t n = a->num_vts;
+  long s;
+  long *ref = malloc_perror(n, sizeof(long));
+  char *reached = calloc_perror(n, sizeof(char));
+  const char *p = NULL;
+  ref[start] = 0;
+  reached[start] = 1;
+  while (upd){
+    upd = 0;
+    for (u = 0; u < n; u++){
+      if (!reached[u]) continue;
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        v = read_vt(p);
+        s = ref[u] + *(const long *)(p + a->wt_offset);
+        if (!reached[v] || s < ref[v]){
+          ref[v] = s;
+          reached[v] = 1;
+          upd = 1;
+        }
+        p += a->pair_size;
+      }
+    }
+  }
+  for (i = 0; i < n; i++){
+    u = read_vt((const char *)prev + i * a->vt_size);
+    if (!reached[i]){
+      ret *= (u == n);
+      continue;
+    }
+    ret *= (dist[i] == ref[i]);
+    if (i == start){
+      ret *= (u == start);
+      continue;
+    }
+    if (u >= n || !reached[u]){
+      ret = 0;
+      continue;
+    }
+    found = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      if (read_vt(p) == i &&
+          ref[u] + *(const long *)(p + a->wt_offset) == ref[i]) found = 1;
+      p += a->pair_size;
+    }
+    ret *= found;
+  }
+  free(ref);
+  free(reached);
+  ref = NULL;
+  reached = NULL;
+  return ret;
+}
+
+int bern_one(void *arg){
+  (void)arg;
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_path_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
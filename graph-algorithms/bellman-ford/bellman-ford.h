@@ -0,0 +1,94 @@
+/**
+   bellman-ford.h
+
+   Declarations of accessible functions for running the Bellman-Ford
+   algorithm on graphs with generic integer vertices indexed from 0 and
+   generic weights, which may be negative.
+
+   The algorithm proceeds in rounds, where only the lists of the vertices
+   with a distance updated in the previous round are relaxed, and
+   terminates after a round without updates. A negative cycle reachable
+   from the start vertex is detected if a distance is updated in the
+   round num_vts.
+
+   The effective type of every element in the prev array is of the integer
+   type used to represent vertices. The value of every element in the prev
+   array is set by the algorithm to the value of the previous vertex, with
+   the number of vertices as the special value for unreached vertices. A
+   distance value in the dist array is only set if the corresponding
+   vertex was reached, as indicated by the prev array, as in dijkstra in
+   dijkstra.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef BELLMAN_FORD_H
+#define BELLMAN_FORD_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes and copies the shortest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, with the number of vertices as the special value in the prev
+   array for unreached vertices. Returns 1 if there is no negative cycle
+   reachable from start, otherwise returns 0, in which case the content of
+   the dist and prev arrays is undefined. Runs in O(num_vts * num_es) time
+   in the worst case, and in O(d * num_es) time if the shortest paths
+   have at most d edges.
+   a           : pointer to an adjacency list of a weighted graph with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   start       : start vertex for running the algorithm
+   dist        : pointer to a preallocated array of num_vts wt_size blocks;
+                 if the block pointed to by dist has no declared type then
+                 the effective type of each element corresponding to a
+                 reached vertex is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   prev        : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the block pointed to by prev has no declared type then
+                 it is guaranteed that the effective type of every element
+                 is set to the integer type used to represent vertices by
+                 writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function
+*/
+int bellman_ford(const struct adj_lst *a,
+                 size_t start,
+                 void *dist,
+                 void *prev,
+                 const void *wt_zero,
+                 size_t (*read_vt)(const void *),
+                 void (*write_vt)(void *, size_t),
+                 int (*cmp_wt)(const void *, const void *),
+                 void (*add_wt)(void *, const void *, const void *));
+
+#endif
@@ -234,6 +234,7 @@ const size_t C_VT_SIZES[4] = {
   sizeof(size_t)};
 const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
 const size_t C_ITER = 10u;
+const size_t C_MULTI_COUNT = 130u; /* > 2 * 64 sources in bfs_multi */
 const size_t C_PROBS_COUNT = 5u;
 const double C_PROBS[5] = {1.00, 0.75, 0.50, 0.25, 0.00};
 const double C_PROB_ONE = 1.0;
@@ -799,9 +800,13 @@ void run_random_dir_graph_helper(size_t num_vts,
                                  void (*incr_vt)(void *),
                                  int bern(void *),
                                  struct bern_arg *b){
-  size_t i;
-  size_t *start = NULL;
+  int res = 1;
+  size_t i, j, v, d;
+  size_t e, s, r;
+  size_t *start = NULL, *srcs = NULL;
+  size_t *ecc = NULL, *dsum = NULL, *num_rch = NULL;
   void *dist = NULL, *prev = NULL;
+  void *dist_m = NULL;
   struct graph g;
   struct adj_lst a;
   clock_t t;
@@ -826,13 +831,64 @@ void run_random_dir_graph_helper(size_t num_vts,
   t = clock() - t;
   printf("\t\t\t%s ave runtime:     %.6f seconds\n",
          type_string, (double)t / C_ITER / CLOCKS_PER_SEC);
+  /* each start vertex is a source more than once */
+  srcs = malloc_perror(C_MULTI_COUNT, sizeof(size_t));
+  ecc = malloc_perror(C_MULTI_COUNT, sizeof(size_t));
+  dsum = malloc_perror(C_MULTI_COUNT, sizeof(size_t));
+  num_rch = malloc_perror(C_MULTI_COUNT, sizeof(size_t));
+  dist_m = malloc_perror(mul_sz_perror(C_MULTI_COUNT, num_vts), vt_size);
+  for (i = 0; i < C_MULTI_COUNT; i++){
+    srcs[i] = start[i % C_ITER];
+  }
+  t = clock();
+  bfs_multi(&a, srcs, C_MULTI_COUNT, dist_m, ecc, dsum, num_rch,
+            read_vt, write_vt);
+  t = clock() - t;
+  printf("\t\t\t%s multi ave runtime: %.6f seconds\n",
+         type_string, (double)t / C_MULTI_COUNT / CLOCKS_PER_SEC);
+  for (i = 0; i < C_ITER; i++){
+    bfs(&a, start[i], dist, prev, read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    e = 0;
+    s = 0;
+    r = 0;
+    for (v = 0; v < num_vts; v++){
+      if (read_vt(ptr(prev, v, vt_size)) == num_vts) continue;
+      d = read_vt(ptr(dist, v, vt_size));
+      if (e < d) e = d;
+      s += d;
+      r++;
+    }
+    for (j = i; j < C_MULTI_COUNT; j += C_ITER){
+      for (v = 0; v < num_vts; v++){
+        d = read_vt(ptr(dist_m, j * num_vts + v, vt_size));
+        if (read_vt(ptr(prev, v, vt_size)) == num_vts){
+          res *= (d == num_vts);
+        }else{
+          res *= (d == read_vt(ptr(dist, v, vt_size)));
+        }
+      }
+      res *= (ecc[j] == e && dsum[j] == s && num_rch[j] == r);
+    }
+  }
+  printf("\t\t\t%s multi correctness: ", type_string);
+  print_test_result(res);
   adj_lst_free(&a); /* deallocates blocks with effective vertex type */
   free(start);
+  free(srcs);
+  free(ecc);
+  free(dsum);
+  free(num_rch);
   free(dist);
   free(prev);
+  free(dist_m);
   start = NULL;
+  srcs = NULL;
+  ecc = NULL;
+  dsum = NULL;
+  num_rch = NULL;
   dist = NULL;
   prev = NULL;
+  dist_m = NULL;
 }
 
 /**
@@ -22,6 +22,14 @@
    C11 (6.2.6.2), and it is safe to read such a representation even if the
    value was not set by the algorithm.
 
+   bfs_multi runs BFS from multiple sources at the same time. Each vertex
+   has a bit array with a bit for each source, and the bit arrays of the
+   vertices at the current level are merged into the bit arrays of their
+   neighbors in a single scan of the lists of the level. The scan of a
+   list is shared by all sources that reached the vertex at the same
+   level, and the bit arrays are processed one unsigned long word at a
+   time.
+
    The implementation only uses integer and pointer operations. Given
    parameter values within the specified ranges, the implementation
    provides an error message and an exit is executed if an integer
@@ -44,9 +52,20 @@
 #include "queue.h"
 #include "stack.h"
 #include "utilities-mem.h"
+#include "utilities-lim.h"
 
 static const size_t C_QUEUE_INIT_COUNT = 1;
+static const size_t C_ULONG_BIT = PRECISION_FROM_ULIMIT(ULONG_MAX);
 
+static void set_multi(const struct adj_lst *a,
+                      size_t i,
+                      size_t v,
+                      size_t d,
+                      void *dist,
+                      size_t *ecc,
+                      size_t *dsum,
+                      size_t *num_rch,
+                      void (*write_vt)(void *, size_t));
 static void *ptr(const void *block, size_t i, size_t size);
 
 /**
@@ -147,6 +166,191 @@ void bfs(const struct adj_lst *a,
   /* after this line vars cannot be dereferenced */
 }
 
+/**
+   Runs BFS from num_srcs sources at the same time and computes the lowest
+   # of edges from each source to each vertex, the eccentricity of each
+   source, the sum of the distances from each source to the reached
+   vertices, and the number of vertices reached from each source. Each of
+   the dist, ecc, dsum, and num_rch parameters may be NULL, in which case
+   the corresponding values are not provided. Runs in
+   O(num_vts * k + L * num_es * (k / B + 1)) time in the worst case, where
+   k is the number of sources, L is the maximal eccentricity of a source,
+   and B is the precision of unsigned long.
+   a           : pointer to an adjacency list with at least one and at most
+                 2**P - 1 vertices, where P is the precision of the integer
+                 type used to represent vertices
+   srcs        : pointer to an array of num_srcs source vertices, where a
+                 vertex may appear more than once
+   num_srcs    : > 0 number of sources
+   dist        : - NULL pointer, if the distances are not needed
+                 - pointer to a preallocated array of num_srcs * num_vts
+                 vt_size blocks, where the distance from srcs[i] to v is
+                 set at the index i * num_vts + v, with the number of
+                 vertices as the special value for unreached vertices; if
+                 the block pointed to by dist has no declared type then
+                 bfs_multi sets the effective type of every element to the
+                 integer type used to represent vertices by writing a value
+                 of the type
+   ecc         : - NULL pointer, if the eccentricities are not needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the maximal distance from srcs[i] to a reached vertex
+                 is set at the index i
+   dsum        : - NULL pointer, if the sums of distances are not needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the sum of the distances from srcs[i] to the reached
+                 vertices is set at the index i
+   num_rch     : - NULL pointer, if the numbers of reached vertices are not
+                 needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the number of vertices reached from srcs[i],
+                 including srcs[i], is set at the index i
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+void bfs_multi(const struct adj_lst *a,
+               const size_t *srcs,
+               size_t num_srcs,
+               void *dist,
+               size_t *ecc,
+               size_t *dsum,
+               size_t *num_rch,
+               size_t (*read_vt)(const void *),
+               void (*write_vt)(void *, size_t)){
+  size_t i, j, b, d = 0;
+  size_t u, v;
+  size_t n = a->num_vts;
+  size_t num_wds = num_srcs / C_ULONG_BIT + (num_srcs % C_ULONG_BIT > 0);
+  size_t num_cur = 0, num_next = 0;
+  size_t *cur = NULL, *next = NULL;
+  unsigned char *in_next = NULL;
+  unsigned long x;
+  unsigned long *seen = NULL, *visit = NULL, *nvisit = NULL;
+  unsigned long *vu = NULL, *vv = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  /* bit arrays of the vertices in single blocks; calloc sets 0 values */
+  seen = calloc_perror(mul_sz_perror(n, num_wds), sizeof(unsigned long));
+  visit = calloc_perror(mul_sz_perror(n, num_wds), sizeof(unsigned long));
+  nvisit = calloc_perror(mul_sz_perror(n, num_wds), sizeof(unsigned long));
+  cur = malloc_perror(n, sizeof(size_t));
+  next = malloc_perror(n, sizeof(size_t));
+  in_next = calloc_perror(n, sizeof(unsigned char));
+  if (dist != NULL){
+    for (i = 0; i < mul_sz_perror(num_srcs, n); i++){
+      write_vt(ptr(dist, i, a->vt_size), n);
+    }
+  }
+  for (i = 0; i < num_srcs; i++){
+    if (ecc != NULL) ecc[i] = 0;
+    if (dsum != NULL) dsum[i] = 0;
+    if (num_rch != NULL) num_rch[i] = 0;
+  }
+  for (i = 0; i < num_srcs; i++){
+    v = srcs[i];
+    x = 1ul << (i % C_ULONG_BIT);
+    seen[v * num_wds + i / C_ULONG_BIT] |= x;
+    visit[v * num_wds + i / C_ULONG_BIT] |= x;
+    if (!in_next[v]){
+      in_next[v] = 1;
+      cur[num_cur++] = v;
+    }
+    set_multi(a, i, v, d, dist, ecc, dsum, num_rch, write_vt);
+  }
+  for (i = 0; i < num_cur; i++){
+    in_next[cur[i]] = 0;
+  }
+  while (num_cur > 0){
+    d++;
+    /* merge the bit arrays of the current level into the neighbors */
+    for (i = 0; i < num_cur; i++){
+      u = cur[i];
+      vu = visit + u * num_wds;
+      p_start = a->vt_wts[u]->elts;
+      p_end = (char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+      for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+        v = read_vt(p);
+        vv = nvisit + v * num_wds;
+        for (j = 0; j < num_wds; j++){
+          vv[j] |= vu[j];
+        }
+        if (!in_next[v]){
+          in_next[v] = 1;
+          next[num_next++] = v;
+        }
+      }
+    }
+    for (i = 0; i < num_cur; i++){
+      vu = visit + cur[i] * num_wds;
+      for (j = 0; j < num_wds; j++){
+        vu[j] = 0;
+      }
+    }
+    /* keep the sources that reached a vertex for the first time */
+    num_cur = 0;
+    for (i = 0; i < num_next; i++){
+      v = next[i];
+      in_next[v] = 0;
+      vv = nvisit + v * num_wds;
+      vu = visit + v * num_wds;
+      x = 0;
+      for (j = 0; j < num_wds; j++){
+        vu[j] = vv[j] & ~seen[v * num_wds + j];
+        seen[v * num_wds + j] |= vu[j];
+        vv[j] = 0;
+        x |= vu[j];
+      }
+      if (x == 0) continue;
+      cur[num_cur++] = v;
+      for (j = 0; j < num_wds; j++){
+        for (b = 0, x = vu[j]; x != 0; b++, x >>= 1){
+          if (x & 1ul){
+            set_multi(a, j * C_ULONG_BIT + b, v, d,
+                      dist, ecc, dsum, num_rch, write_vt);
+          }
+        }
+      }
+    }
+    num_next = 0;
+  }
+  free(seen);
+  free(visit);
+  free(nvisit);
+  free(cur);
+  free(next);
+  free(in_next);
+  seen = NULL;
+  visit = NULL;
+  nvisit = NULL;
+  cur = NULL;
+  next = NULL;
+  in_next = NULL;
+  vu = NULL;
+  vv = NULL;
+}
+
+/**
+   Sets the distance from the ith source to v to d in bfs_multi.
+*/
+static void set_multi(const struct adj_lst *a,
+                      size_t i,
+                      size_t v,
+                      size_t d,
+                      void *dist,
+                      size_t *ecc,
+                      size_t *dsum,
+                      size_t *num_rch,
+                      void (*write_vt)(void *, size_t)){
+  if (dist != NULL){
+    write_vt(ptr(dist, i * a->num_vts + v, a->vt_size), d);
+  }
+  if (ecc != NULL && ecc[i] < d) ecc[i] = d;
+  if (dsum != NULL) dsum[i] = add_sz_perror(dsum[i], d);
+  if (num_rch != NULL) num_rch[i]++;
+}
+
 /**
    Computes a pointer to the ith element in the block of elements.
 
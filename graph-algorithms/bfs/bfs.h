@@ -23,6 +23,14 @@
    C11 (6.2.6.2), and it is safe to read such a representation even if the
    value was not set by the algorithm.
 
+   bfs_multi runs BFS from multiple sources at the same time. Each vertex
+   has a bit array with a bit for each source, and the bit arrays of the
+   vertices at the current level are merged into the bit arrays of their
+   neighbors in a single scan of the lists of the level. The scan of a
+   list is shared by all sources that reached the vertex at the same
+   level, and the bit arrays are processed one unsigned long word at a
+   time.
+
    The implementation only uses integer and pointer operations. Given
    parameter values within the specified ranges, the implementation
    provides an error message and an exit is executed if an integer
@@ -100,4 +108,59 @@ void bfs(const struct adj_lst *a,
          int (*cmp_vt)(const void *, const void *),
          void (*incr_vt)(void *));
 
+/**
+   Runs BFS from num_srcs sources at the same time and computes the lowest
+   # of edges from each source to each vertex, the eccentricity of each
+   source, the sum of the distances from each source to the reached
+   vertices, and the number of vertices reached from each source. Each of
+   the dist, ecc, dsum, and num_rch parameters may be NULL, in which case
+   the corresponding values are not provided. Runs in
+   O(num_vts * k + L * num_es * (k / B + 1)) time in the worst case, where
+   k is the number of sources, L is the maximal eccentricity of a source,
+   and B is the precision of unsigned long.
+   a           : pointer to an adjacency list with at least one and at most
+                 2**P - 1 vertices, where P is the precision of the integer
+                 type used to represent vertices
+   srcs        : pointer to an array of num_srcs source vertices, where a
+                 vertex may appear more than once
+   num_srcs    : > 0 number of sources
+   dist        : - NULL pointer, if the distances are not needed
+                 - pointer to a preallocated array of num_srcs * num_vts
+                 vt_size blocks, where the distance from srcs[i] to v is
+                 set at the index i * num_vts + v, with the number of
+                 vertices as the special value for unreached vertices; if
+                 the block pointed to by dist has no declared type then
+                 bfs_multi sets the effective type of every element to the
+                 integer type used to represent vertices by writing a value
+                 of the type
+   ecc         : - NULL pointer, if the eccentricities are not needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the maximal distance from srcs[i] to a reached vertex
+                 is set at the index i
+   dsum        : - NULL pointer, if the sums of distances are not needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the sum of the distances from srcs[i] to the reached
+                 vertices is set at the index i
+   num_rch     : - NULL pointer, if the numbers of reached vertices are not
+                 needed
+                 - pointer to a preallocated array of num_srcs elements,
+                 where the number of vertices reached from srcs[i],
+                 including srcs[i], is set at the index i
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+void bfs_multi(const struct adj_lst *a,
+               const size_t *srcs,
+               size_t num_srcs,
+               void *dist,
+               size_t *ecc,
+               size_t *dsum,
+               size_t *num_rch,
+               size_t (*read_vt)(const void *),
+               void (*write_vt)(void *, size_t));
+
 #endif
@@ -0,0 +1,304 @@
+/**
+   cc-test.c
+
+   Tests of connected components across graphs with different integer
+   types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   cc-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./cc-test
+   ./cc-test 10 14
+   ./cc-test 14 18 0 1
+
+   cc-test can be run with any subset of command line arguments in the
+   above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "cc.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "cc-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 12u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 16u};
+
+size_t ref_cc(const struct adj_lst *a,
+              size_t *lbl,
+              size_t (*read_vt)(const void *));
+int cmp_lbls(const void *lbl,
+             const size_t *ref,
+             size_t num_vts,
+             size_t vt_size,
+             size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Run tests on 2D grid graphs with edges removed at random. The labels
+   and the number of components computed by cc are compared with the
+   result of a traversal of each component.
+*/
+
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts, num_x, num_y, num_cc, num_ref;
+  size_t *ref = NULL;
+  void *lbl = NULL;
+  struct graph g, h;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test cc on 2D grid graphs with half of the edges removed\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    ref = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      graph_base_init(&h, num_vts, C_VT_SIZES[j], 0);
+      graph_subset(&h, &g, graph_bern, NULL);
+      adj_lst_base_init(&a, &h);
+      adj_lst_undir_build(&a, &h, C_READ[j]);
+      lbl = malloc_perror(num_vts, C_VT_SIZES[j]);
+      t = clock();
+      num_cc = cc(&a, lbl, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s cc time: %.6f seconds, components: %lu\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, TOLU(num_cc));
+      num_ref = ref_cc(&a, ref, C_READ[j]);
+      res *= (num_cc == num_ref);
+      res *= cmp_lbls(lbl, ref, num_vts, C_VT_SIZES[j], C_READ[j]);
+      adj_lst_free(&a);
+      graph_free(&g);
+      graph_free(&h);
+      free(lbl);
+      lbl = NULL;
+    }
+    free(ref);
+    ref = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on R-MAT graphs. The weakly connected components of a
+   directed graph are compared with the connected components of the
+   undirected graph with the same edges.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_cc, num_ref;
+  size_t *ref = NULL;
+  void *lbl = NULL;
+  struct graph g;
+  struct adj_lst a, b;
+  clock_t t;
+  printf("Test cc on R-MAT graphs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n edges\n", TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      ref = malloc_perror(num_vts, sizeof(size_t));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, NULL, NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_base_init(&b, &g);
+        adj_lst_unbound(&a);
+        adj_lst_unbound(&b);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        adj_lst_undir_build(&b, &g, C_READ[j]);
+        lbl = malloc_perror(num_vts, C_VT_SIZES[j]);
+        num_ref = ref_cc(&b, ref, C_READ[j]);
+        t = clock();
+        num_cc = cc(&b, lbl, C_READ[j], C_WRITE[j]);
+        t = clock() - t;
+        printf("\t\t\t%s undirected cc time: %.6f seconds, "
+               "components: %lu\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, TOLU(num_cc));
+        res *= (num_cc == num_ref);
+        res *= cmp_lbls(lbl, ref, num_vts, C_VT_SIZES[j], C_READ[j]);
+        t = clock();
+        num_cc = cc(&a, lbl, C_READ[j], C_WRITE[j]);
+        t = clock() - t;
+        printf("\t\t\t%s directed cc time:   %.6f seconds, "
+               "components: %lu\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, TOLU(num_cc));
+        res *= (num_cc == num_ref);
+        res *= cmp_lbls(lbl, ref, num_vts, C_VT_SIZES[j], C_READ[j]);
+        adj_lst_free(&a);
+        adj_lst_free(&b);
+        graph_free(&g);
+        free(lbl);
+        lbl = NULL;
+      }
+      free(ref);
+      ref = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Labels each vertex of an undirected graph with the lowest vertex in its
+   component by traversing the unvisited vertices in the increasing order,
+   and returns the number of components.
+*/
+size_t ref_cc(const struct adj_lst *a,
+              size_t *lbl,
+              size_t (*read_vt)(const void *)){
+  size_t i, u, v, k;
+  size_t num_top, ret = 0;
+  size_t *top = NULL;
+  const char *p = NULL;
+  if (a->num_vts == 0) return 0;
+  top = malloc_perror(a->num_vts, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    lbl[i] = a->num_vts;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    if (lbl[i] < a->num_vts) continue;
+    ret++;
+    lbl[i] = i;
+    top[0] = i;
+    num_top = 1;
+    while (num_top > 0){
+      u = top[--num_top];
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        v = read_vt(p);
+        if (lbl[v] == a->num_vts){
+          lbl[v] = i;
+          top[num_top++] = v;
+        }
+        p += a->pair_size;
+      }
+    }
+  }
+  free(top);
+  top = NULL;
+  return ret;
+}
+
+/**
+   Compares an array of labels in vt_size blocks with an array of size_t
+   labels. Returns 1 if the labels are equal, otherwise returns 0.
+*/
+int cmp_lbls(const void *lbl,
+             const size_t *ref,
+             size_t num_vts,
+             size_t vt_size,
+             size_t (*read_vt)(const void *)){
+  size_t i;
+  for (i = 0; i < num_vts; i++){
+    if (read_vt((const char *)lbl + i * vt_size) != ref[i]) return 0;
+  }
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+   cc.c
+
+   Functions for computing the connected components of a graph with
+   generic integer vertices indexed from 0. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+
+   Each vertex is labeled with the lowest vertex in its component, which
+   provides a unique representative of each component that does not
+   depend on the order of edges and lists. The labels are written in the
+   integer type used to represent vertices, and a label array can be
+   compared across implementations, e.g. with the labels computed by
+   cc_pthread in cc-pthread.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "cc.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static size_t find(size_t *parent, size_t u);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the connected components of an undirected graph with a
+   union-find forest, where the root of each tree is the lowest vertex of
+   the tree and the trees are compressed by path halving. If the
+   adjacency list is of a directed graph, the weakly connected components
+   are computed. Returns the number of components.
+   a           : pointer to an adjacency list
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+size_t cc(const struct adj_lst *a,
+          void *lbl,
+          size_t (*read_vt)(const void *),
+          void (*write_vt)(void *, size_t)){
+  size_t i, ru, rv;
+  size_t ret = 0;
+  size_t *parent = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  if (a->num_vts == 0) return 0;
+  parent = malloc_perror(a->num_vts, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    parent[i] = i;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      ru = find(parent, i);
+      rv = find(parent, read_vt(p));
+      /* the lower root remains a root */
+      if (ru < rv){
+        parent[rv] = ru;
+      }else if (rv < ru){
+        parent[ru] = rv;
+      }
+    }
+  }
+  /* parent[u] <= u, hence the root of u is labeled before u */
+  for (i = 0; i < a->num_vts; i++){
+    parent[i] = parent[parent[i]];
+    write_vt(ptr(lbl, i, a->vt_size), parent[i]);
+    ret += (parent[i] == i);
+  }
+  free(parent);
+  parent = NULL;
+  return ret;
+}
+
+/**
+   Returns the root of the tree of a vertex and halves the path from the
+   vertex to the root by pointing each other vertex on the path to its
+   grandparent.
+*/
+static size_t find(size_t *parent, size_t u){
+  while (parent[u] != u){
+    parent[u] = parent[parent[u]];
+    u = parent[u];
+  }
+  return u;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
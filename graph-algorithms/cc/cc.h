@@ -0,0 +1,55 @@
+/**
+   cc.h
+
+   Declarations of accessible functions for computing the connected
+   components of a graph with generic integer vertices indexed from 0.
+   A graph may be unweighted or weighted. In the latter case the weights
+   of the graph are ignored.
+
+   Each vertex is labeled with the lowest vertex in its component, which
+   provides a unique representative of each component that does not
+   depend on the order of edges and lists. The labels are written in the
+   integer type used to represent vertices, and a label array can be
+   compared across implementations, e.g. with the labels computed by
+   cc_pthread in cc-pthread.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef CC_H
+#define CC_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the connected components of an undirected graph with a
+   union-find forest, where the root of each tree is the lowest vertex of
+   the tree and the trees are compressed by path halving. If the
+   adjacency list is of a directed graph, the weakly connected components
+   are computed. Returns the number of components.
+   a           : pointer to an adjacency list
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+size_t cc(const struct adj_lst *a,
+          void *lbl,
+          size_t (*read_vt)(const void *),
+          void (*write_vt)(void *, size_t));
+
+#endif
@@ -0,0 +1,340 @@
+/**
+   ch-test.c
+
+   Tests of contraction hierarchies across graphs with different integer
+   types of vertices and witness search limits within the same translation
+   unit.
+
+   The following command line arguments can be used to customize tests:
+   ch-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./ch-test
+   ./ch-test 10 14
+   ./ch-test 14 16 1 0
+
+   ch-test can be run with any subset of command line arguments in the
+   above-defined order. If the (i + 1)th argument is specified then the ith
+   argument must be specified for i >= 0. Default values are used for the
+   unspecified arguments according to the C_ARGS_DEF array.
+
+   The tests write and read a contraction hierarchy file in the working
+   directory. The implementation of tests does not use stdint.h and is
+   portable under C89/C90 and C99. The requirements are: i) the widths of
+   the unsigned integral types are less than 2040 and even, and ii) size_t
+   and clock_t are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "ch.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "ch-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 11u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+void *(* const C_AT[4])(const void *, const void *) ={
+  graph_at_ushort,
+  graph_at_uint,
+  graph_at_ulong,
+  graph_at_sz};
+int (* const C_CMPEQ[4])(const void *, const void *) ={
+  graph_cmpeq_ushort,
+  graph_cmpeq_uint,
+  graph_cmpeq_ulong,
+  graph_cmpeq_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+
+const unsigned long C_ZERO = 0;
+const size_t C_WT_RANGE = 16u; /* weights in [0, 15] */
+const size_t C_LIM_COUNT = 2u;
+const size_t C_LIMS[2] = {16u, 256u};
+const size_t C_NUM_STARTS = 16u;
+const size_t C_NUM_ENDS = 64u;
+const char *C_PATH = "ch-test.tmp";
+const size_t C_RMAT_EDGE_FACTOR = 2u;
+
+int is_path(const struct adj_lst *a,
+            const struct stack *path,
+            size_t s,
+            size_t t,
+            unsigned long dist,
+            size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Builds a contraction hierarchy, writes it to a file and reads it back,
+   and compares the distances of ch_query on both hierarchies with the
+   distances computed by dijkstra from random start vertices to random end
+   vertices. Tests that the unpacked path of each query is a path of the
+   graph with the weight equal to the distance.
+*/
+void ch_helper(const struct adj_lst *a, size_t j, size_t lim, int *res){
+  size_t i, k, s, t, u, num_qrys = 0;
+  unsigned long d;
+  unsigned long *dist = NULL;
+  void *prev = NULL;
+  struct ch c, c_rd;
+  struct ch_qry q, q_rd;
+  struct stack path;
+  clock_t time, time_dijkstra = 0, time_ch = 0;
+  dist = malloc_perror(a->num_vts, sizeof(unsigned long));
+  prev = malloc_perror(a->num_vts, a->vt_size);
+  time = clock();
+  ch_build(&c, a, lim, &C_ZERO, C_READ[j],
+           graph_cmp_ulong, graph_add_ulong);
+  time = clock() - time;
+  printf("\t\t\t%s lim %2lu ch_build time: %.6f seconds, "
+         "arcs: %lu\n",
+         C_VT_TYPES[j], TOLU(lim), (double)time / CLOCKS_PER_SEC,
+         TOLU(c.num_arcs));
+  ch_write(&c, C_PATH);
+  ch_read(&c_rd, C_PATH, sizeof(unsigned long));
+  remove(C_PATH);
+  *res *= (c.num_vts == c_rd.num_vts && c.num_arcs == c_rd.num_arcs);
+  ch_qry_init(&q, &c, &C_ZERO, graph_cmp_ulong, graph_add_ulong);
+  ch_qry_init(&q_rd, &c_rd, &C_ZERO, graph_cmp_ulong, graph_add_ulong);
+  stack_init(&path, sizeof(size_t), NULL);
+  for (i = 0; i < C_NUM_STARTS; i++){
+    s = RANDOM() % a->num_vts;
+    time = clock();
+    dijkstra(a, s, dist, prev, &C_ZERO, NULL, C_READ[j], C_WRITE[j],
+             C_AT[j], C_CMPEQ[j], graph_cmp_ulong, graph_add_ulong);
+    time_dijkstra += clock() - time;
+    for (k = 0; k < C_NUM_ENDS; k++){
+      t = RANDOM() % a->num_vts;
+      time = clock();
+      if (ch_query(&q, s, t, &d)){
+        time_ch += clock() - time;
+        *res *= (C_READ[j]((char *)prev + t * a->vt_size) != a->num_vts &&
+                 d == dist[t]);
+        while (path.num_elts > 0) stack_pop(&path, &u);
+        ch_qry_path(&q, &path);
+        *res *= is_path(a, &path, s, t, d, C_READ[j]);
+      }else{
+        time_ch += clock() - time;
+        *res *= (C_READ[j]((char *)prev + t * a->vt_size) == a->num_vts);
+      }
+      if (ch_query(&q_rd, s, t, &d)){
+        *res *= (d == dist[t]);
+      }else{
+        *res *= (C_READ[j]((char *)prev + t * a->vt_size) == a->num_vts);
+      }
+      num_qrys++;
+    }
+  }
+  printf("\t\t\t%s lim %2lu dijkstra time per start: %.8f seconds\n",
+         C_VT_TYPES[j], TOLU(lim),
+         (double)time_dijkstra / C_NUM_STARTS / CLOCKS_PER_SEC);
+  printf("\t\t\t%s lim %2lu ch_query time per query: %.8f seconds\n",
+         C_VT_TYPES[j], TOLU(lim),
+         (double)time_ch / num_qrys / CLOCKS_PER_SEC);
+  ch_qry_free(&q);
+  ch_qry_free(&q_rd);
+  ch_free(&c);
+  ch_free(&c_rd);
+  stack_free(&path);
+  free(dist);
+  free(prev);
+  dist = NULL;
+  prev = NULL;
+}
+
+/**
+   Run tests on 2D grid graphs with random weights, where each edge of a
+   grid is in both directions with the same weight.
+*/
+
+void gen_ulong(void *wt, void *arg){
+  (void)arg;
+  *(unsigned long *)wt = RANDOM() % C_WT_RANGE;
+}
+
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, l;
+  size_t num_vts, num_x, num_y;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test ch_build and ch_query on 2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], gen_ulong, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      for (l = 0; l < C_LIM_COUNT; l++){
+        ch_helper(&a, j, C_LIMS[l], &res);
+      }
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on directed R-MAT graphs with random weights, which may have
+   multiple edges between the same vertices and loops.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, l;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test ch_build and ch_query on directed R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(unsigned long));
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, gen_ulong, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      for (l = 0; l < C_LIM_COUNT; l++){
+        ch_helper(&a, j, C_LIMS[l], &res);
+      }
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Returns 1 if the vertices of a stack are a path of a graph from s to t
+   with the sum of the lowest weights of its edges equal to dist, otherwise
+   returns 0.
+*/
+int is_path(const struct adj_lst *a,
+            const struct stack *path,
+            size_t s,
+            size_t t,
+            unsigned long dist,
+            size_t (*read_vt)(const void *)){
+  int found;
+  size_t i, k, u, v;
+  unsigned long wt, sum = 0;
+  const size_t *vts = path->elts;
+  const char *p = NULL;
+  if (path->num_elts == 0 ||
+      vts[0] != s ||
+      vts[path->num_elts - 1] != t) return 0;
+  for (i = 0; i + 1 < path->num_elts; i++){
+    u = vts[i];
+    v = vts[i + 1];
+    found = 0;
+    wt = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      if (read_vt(p) == v &&
+          (!found || *(const unsigned long *)(p + a->wt_offset) < wt)){
+        wt = *(const unsigned long *)(p + a->wt_offset);
+        found = 1;
+      }
+      p += a->pair_size;
+    }
+    if (!found) return 0;
+    sum += wt;
+  }
+  return (sum == dist);
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,1056 @@
+/**
+   ch.c
+
+   Functions for building contraction hierarchies of graphs with generic
+   integer vertices and generic non-negative weights, for answering
+   point-to-point shortest path queries with bidirectional upward searches,
+   and for writing and reading contraction hierarchies to and from files.
+
+   A contraction hierarchy is built once by contracting the vertices of a
+   graph one by one. When a vertex v is contracted, a shortcut (u, w) with
+   the weight of the path (u, v, w) is added for each pair of the remaining
+   (u, v) and (v, w) edges, unless a witness search, i.e. Dijkstra's
+   algorithm from u that does not visit v and settles at most lim vertices,
+   finds a path from u to w that is not longer. The order of contraction is
+   given by a heap of priorities, where the priority of a vertex is the
+   edge difference, i.e. the number of shortcuts that would be added minus
+   the number of the remaining edges of the vertex, plus the number of the
+   contracted neighbors of the vertex for the uniformity of contraction
+   across a graph. The priorities are updated lazily: the priority of a
+   popped vertex is recomputed, and the vertex is pushed back if its
+   priority increased, so that the priorities of high-degree neighbors are
+   not recomputed after each contraction. A lower witness search limit
+   results in shorter witness searches and more shortcuts, and does not
+   affect correctness.
+
+   A query from s to t runs Dijkstra's algorithm from s on the edges and
+   shortcuts leading to vertices contracted later, and from t on the
+   reversed edges and shortcuts leading from vertices contracted later,
+   and stops when both searches cannot improve the best distance through a
+   vertex reached by both searches. The searches only visit a small part
+   of a road-like graph. A query uses a preallocated workspace, where the
+   visited vertices are marked with a query number, so that no array of
+   size num_vts is reset between queries. The shortcuts record the two
+   edges or shortcuts they replace, so that the path of a query is unpacked
+   without a search. The arcs are renumbered after a build so that a
+   shortcut has a greater id than the arcs it replaces, and the order is
+   checked when a file is read, so that unpacking terminates.
+
+   A file of a contraction hierarchy contains the contraction order and the
+   edges and shortcuts as size_t values and wt_size blocks, and can only be
+   read on a system with the same representations of size_t and the type
+   of weights.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted, an allocation is not completed due to
+   insufficient resources, a file cannot be opened, or a file is not a file
+   of a contraction hierarchy with the given weight size. The behavior
+   outside the specified parameter ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ch.h"
+#include "graph.h"
+#include "heap.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static const size_t C_HEAP_INIT_COUNT = 1;
+static const size_t C_STACK_INIT_COUNT = 1;
+static const size_t C_ARC_COUNT = 4;
+static const char C_MAGIC[8] = "ch-file";
+static const size_t C_BUF_COUNT = 5;
+
+struct ht_def{
+  size_t absent;
+  size_t *elts;
+};
+
+/* state of a build */
+struct build{
+  size_t num_vts;
+  size_t lim;
+  size_t wt_size;
+  size_t deg_offset;
+  size_t num; /* witness search number */
+  size_t tgt_num; /* number of a set of witness search targets */
+  size_t *nums;
+  size_t *tgts;
+  size_t *del_nbrs; /* number of contracted neighbors */
+  size_t *marks;
+  void *dists;
+  void *bufs; /* zero, distance, sum, via, and maximal via */
+  struct stack arcs;
+  struct stack wts;
+  struct stack *outs; /* ids of remaining arcs (u, v) in the list of u */
+  struct stack *ins; /* ids of remaining arcs (u, v) in the list of v */
+  struct ht_def ht;
+  struct heap_ht hht;
+  struct heap h;
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+};
+
+static void build_init(struct build *b,
+                       const struct adj_lst *a,
+                       size_t lim,
+                       const void *wt_zero,
+                       size_t (*read_vt)(const void *),
+                       int (*cmp_wt)(const void *, const void *),
+                       void (*add_wt)(void *, const void *, const void *));
+static void build_free(struct build *b);
+static size_t new_arc(struct build *b,
+                      size_t u,
+                      size_t v,
+                      const void *wt,
+                      size_t e,
+                      size_t f);
+static void add_arc(struct build *b,
+                    size_t u,
+                    size_t v,
+                    const void *wt,
+                    size_t e,
+                    size_t f);
+static void remove_arc(struct stack *s, size_t e);
+static void witness(struct build *b,
+                    size_t u,
+                    size_t v,
+                    size_t num_tgts,
+                    const void *max);
+static size_t contract(struct build *b, size_t v, int sim);
+static size_t priority(struct build *b, size_t v);
+static void sort_arcs(struct ch *c);
+static void build_lists(struct ch *c);
+static void unpack(const struct ch *c, struct stack *s, struct stack *path);
+static void heap_ht_def_init(struct heap_ht *hht,
+                             struct ht_def *ht,
+                             size_t num_vts);
+static void ht_def_insert(void *ht, const void *vt, const void *ix);
+static void *ht_def_search(const void *ht, const void *vt);
+static void ht_def_remove(void *ht, const void *vt, void *ix);
+static void ht_def_free(void *ht);
+static size_t *arc_ptr(const struct build *b, size_t e);
+static void *ptr(const void *block, size_t i, size_t size);
+static void fread_perror(void *p,
+                         size_t size,
+                         size_t num,
+                         FILE *f,
+                         const char *path);
+static void fwrite_perror(const void *p,
+                          size_t size,
+                          size_t num,
+                          FILE *f,
+                          const char *path);
+static void fprintf_stderr_exit(const char *s, int line);
+
+/**
+   Builds a contraction hierarchy of a directed graph. An undirected graph
+   is represented by an adjacency list with a (u, v) and a (v, u) pair for
+   each edge, e.g. built by adj_lst_undir_build. Loops are skipped and of
+   multiple edges from u to v only an edge with the lowest weight is kept.
+   c           : pointer to a preallocated block of size sizeof(struct ch)
+   a           : pointer to a weighted adjacency list with at least one
+                 vertex and non-negative weights
+   lim         : > 0 maximal number of vertices settled by a witness search
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent weights
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function
+*/
+void ch_build(struct ch *c,
+              const struct adj_lst *a,
+              size_t lim,
+              const void *wt_zero,
+              size_t (*read_vt)(const void *),
+              int (*cmp_wt)(const void *, const void *),
+              void (*add_wt)(void *, const void *, const void *)){
+  size_t i, k, e, u, v, p, np, r = 0;
+  struct stack *l = NULL;
+  struct build b;
+  struct ht_def ht;
+  struct heap_ht hht;
+  struct heap h;
+  build_init(&b, a, lim, wt_zero, read_vt, cmp_wt, add_wt);
+  c->num_vts = a->num_vts;
+  c->wt_size = a->wt_size;
+  c->rank = malloc_perror(c->num_vts, sizeof(size_t));
+  heap_ht_def_init(&hht, &ht, b.num_vts);
+  heap_init(&h, sizeof(size_t), sizeof(size_t), b.num_vts, &hht,
+            graph_cmp_sz, NULL, NULL, NULL);
+  for (v = 0; v < b.num_vts; v++){
+    p = priority(&b, v);
+    heap_push(&h, &p, &v);
+  }
+  while (h.num_elts > 0){
+    heap_pop(&h, &p, &v);
+    np = priority(&b, v);
+    if (np > p){
+      /* lazy update */
+      heap_push(&h, &np, &v);
+      continue;
+    }
+    contract(&b, v, 0);
+    c->rank[v] = r;
+    r++;
+    /* remove the arcs of v and count v at its neighbors */
+    for (k = 0; k < 2; k++){
+      l = (k ? &b.outs[v] : &b.ins[v]);
+      for (i = 0; i < l->num_elts; i++){
+        e = ((size_t *)l->elts)[i];
+        u = arc_ptr(&b, e)[k];
+        remove_arc((k ? &b.ins[u] : &b.outs[u]), e);
+        if (b.marks[u] != v){
+          b.marks[u] = v;
+          b.del_nbrs[u]++;
+        }
+      }
+    }
+    stack_free(&b.outs[v]);
+    stack_free(&b.ins[v]);
+  }
+  heap_free(&h);
+  c->num_arcs = b.arcs.num_elts;
+  c->arcs = NULL;
+  c->wts = NULL;
+  if (c->num_arcs > 0){
+    c->arcs = malloc_perror(c->num_arcs, b.arcs.elt_size);
+    c->wts = malloc_perror(c->num_arcs, c->wt_size);
+    memcpy(c->arcs, b.arcs.elts, c->num_arcs * b.arcs.elt_size);
+    memcpy(c->wts, b.wts.elts, c->num_arcs * c->wt_size);
+  }
+  build_free(&b);
+  sort_arcs(c);
+  build_lists(c);
+}
+
+/**
+   Writes a contraction hierarchy to a file. The file is created or
+   truncated.
+   c           : pointer to a contraction hierarchy
+   path        : path of the file
+*/
+void ch_write(const struct ch *c, const char *path){
+  unsigned char sz = sizeof(size_t);
+  FILE *f = fopen(path, "wb");
+  if (f == NULL){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+  fwrite_perror(C_MAGIC, 1, sizeof(C_MAGIC), f, path);
+  fwrite_perror(&sz, 1, 1, f, path);
+  fwrite_perror(&c->num_vts, sizeof(size_t), 1, f, path);
+  fwrite_perror(&c->num_arcs, sizeof(size_t), 1, f, path);
+  fwrite_perror(&c->wt_size, sizeof(size_t), 1, f, path);
+  fwrite_perror(c->rank, sizeof(size_t), c->num_vts, f, path);
+  fwrite_perror(c->arcs, C_ARC_COUNT * sizeof(size_t), c->num_arcs,
+                f, path);
+  fwrite_perror(c->wts, c->wt_size, c->num_arcs, f, path);
+  if (fclose(f) == EOF){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+   Reads a contraction hierarchy from a file written by ch_write.
+   c           : pointer to a preallocated block of size sizeof(struct ch)
+   path        : path of the file
+   wt_size     : size of the type used to represent weights in the file
+*/
+void ch_read(struct ch *c, const char *path, size_t wt_size){
+  size_t i;
+  unsigned char sz;
+  unsigned char *ranked = NULL;
+  const size_t *arc = NULL;
+  char magic[sizeof(C_MAGIC)];
+  FILE *f = fopen(path, "rb");
+  if (f == NULL){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+  fread_perror(magic, 1, sizeof(C_MAGIC), f, path);
+  fread_perror(&sz, 1, 1, f, path);
+  if (memcmp(magic, C_MAGIC, sizeof(C_MAGIC)) != 0 ||
+      sz != sizeof(size_t)){
+    fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+  }
+  fread_perror(&c->num_vts, sizeof(size_t), 1, f, path);
+  fread_perror(&c->num_arcs, sizeof(size_t), 1, f, path);
+  fread_perror(&c->wt_size, sizeof(size_t), 1, f, path);
+  if (c->num_vts == 0 || c->wt_size != wt_size){
+    fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+  }
+  c->rank = malloc_perror(c->num_vts, sizeof(size_t));
+  fread_perror(c->rank, sizeof(size_t), c->num_vts, f, path);
+  c->arcs = NULL;
+  c->wts = NULL;
+  if (c->num_arcs > 0){
+    c->arcs = malloc_perror(c->num_arcs, C_ARC_COUNT * sizeof(size_t));
+    c->wts = malloc_perror(c->num_arcs, c->wt_size);
+    fread_perror(c->arcs, C_ARC_COUNT * sizeof(size_t), c->num_arcs,
+                 f, path);
+    fread_perror(c->wts, c->wt_size, c->num_arcs, f, path);
+  }
+  if (fclose(f) == EOF){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+  /* rank is a permutation */
+  ranked = calloc_perror(c->num_vts, 1);
+  for (i = 0; i < c->num_vts; i++){
+    if (c->rank[i] >= c->num_vts || ranked[c->rank[i]]){
+      fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+    }
+    ranked[c->rank[i]] = 1;
+  }
+  free(ranked);
+  ranked = NULL;
+  /* a shortcut replaces a path of two arcs with lower ids */
+  for (i = 0; i < c->num_arcs; i++){
+    arc = c->arcs + C_ARC_COUNT * i;
+    if (arc[0] >= c->num_vts || arc[1] >= c->num_vts){
+      fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+    }
+    if (arc[2] == i && arc[3] == i) continue;
+    if (arc[2] >= i || arc[3] >= i ||
+        c->arcs[C_ARC_COUNT * arc[2]] != arc[0] ||
+        c->arcs[C_ARC_COUNT * arc[3] + 1] != arc[1] ||
+        c->arcs[C_ARC_COUNT * arc[2] + 1] != c->arcs[C_ARC_COUNT * arc[3]]){
+      fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+    }
+  }
+  build_lists(c);
+}
+
+/**
+   Frees a contraction hierarchy and leaves the block of size
+   sizeof(struct ch) pointed to by c.
+*/
+void ch_free(struct ch *c){
+  free(c->rank);
+  free(c->arcs);
+  free(c->wts);
+  free(c->up_offs);
+  free(c->up_vts);
+  free(c->up_ids);
+  free(c->up_wts);
+  free(c->dn_offs);
+  free(c->dn_vts);
+  free(c->dn_ids);
+  free(c->dn_wts);
+  c->rank = NULL;
+  c->arcs = NULL;
+  c->wts = NULL;
+  c->up_offs = NULL;
+  c->up_vts = NULL;
+  c->up_ids = NULL;
+  c->up_wts = NULL;
+  c->dn_offs = NULL;
+  c->dn_vts = NULL;
+  c->dn_ids = NULL;
+  c->dn_wts = NULL;
+}
+
+/**
+   Initializes a query workspace for a contraction hierarchy. The workspace
+   must not be copied and can be used by one thread at a time.
+   q           : pointer to a preallocated block of size
+                 sizeof(struct ch_qry)
+   c           : pointer to a contraction hierarchy that is not modified
+                 or freed during the lifetime of the workspace
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent weights
+   cmp_wt      : comparison function for weights; please see ch_build
+   add_wt      : addition function for weights; please see ch_build
+*/
+void ch_qry_init(struct ch_qry *q,
+                 const struct ch *c,
+                 const void *wt_zero,
+                 int (*cmp_wt)(const void *, const void *),
+                 void (*add_wt)(void *, const void *, const void *)){
+  size_t k;
+  struct ht_def *hts = NULL;
+  q->num = 0;
+  q->meet = c->num_vts;
+  q->nums = calloc_perror(mul_sz_perror(2, c->num_vts), sizeof(size_t));
+  q->prevs = malloc_perror(mul_sz_perror(2, c->num_vts), sizeof(size_t));
+  q->dists = malloc_perror(mul_sz_perror(2, c->num_vts), c->wt_size);
+  q->bufs = malloc_perror(C_BUF_COUNT - 1, c->wt_size);
+  memcpy(q->bufs, wt_zero, c->wt_size);
+  hts = malloc_perror(2, sizeof(struct ht_def));
+  for (k = 0; k < 2; k++){
+    heap_ht_def_init(&q->hhts[k], &hts[k], c->num_vts);
+    heap_init(&q->hs[k], c->wt_size, sizeof(size_t), C_HEAP_INIT_COUNT,
+              &q->hhts[k], cmp_wt, NULL, NULL, NULL);
+  }
+  q->hts = hts;
+  q->c = c;
+  q->cmp_wt = cmp_wt;
+  q->add_wt = add_wt;
+}
+
+/**
+   Frees a query workspace and leaves the block of size
+   sizeof(struct ch_qry) pointed to by q.
+*/
+void ch_qry_free(struct ch_qry *q){
+  heap_free(&q->hs[0]);
+  heap_free(&q->hs[1]);
+  free(q->nums);
+  free(q->prevs);
+  free(q->dists);
+  free(q->bufs);
+  free(q->hts);
+  q->nums = NULL;
+  q->prevs = NULL;
+  q->dists = NULL;
+  q->bufs = NULL;
+  q->hts = NULL;
+}
+
+/**
+   Computes the shortest distance from s to t. Returns 1 and copies the
+   distance to the wt_size block pointed to by dist if t is reachable from
+   s, otherwise returns 0 and the block pointed to by dist remains
+   unchanged.
+   q           : pointer to an initialized query workspace
+   s           : start vertex
+   t           : end vertex
+   dist        : pointer to a preallocated wt_size block
+*/
+int ch_query(struct ch_qry *q, size_t s, size_t t, void *dist){
+  int found = 0;
+  size_t i, k, u, v, uk, vk;
+  size_t n = q->c->num_vts;
+  const size_t *offs = NULL, *vts = NULL, *ids = NULL;
+  const void *wts = NULL;
+  void *dv = NULL;
+  void * const zero = q->bufs;
+  void * const du = ptr(q->bufs, 1, q->c->wt_size);
+  void * const sum = ptr(q->bufs, 2, q->c->wt_size);
+  void * const best = ptr(q->bufs, 3, q->c->wt_size);
+  q->num++;
+  q->meet = n;
+  for (k = 0; k < 2; k++){
+    u = (k ? t : s);
+    q->nums[k * n + u] = q->num;
+    q->prevs[k * n + u] = q->c->num_arcs;
+    memcpy(ptr(q->dists, k * n + u, q->c->wt_size), zero, q->c->wt_size);
+    heap_push(&q->hs[k], zero, &u);
+  }
+  while (q->hs[0].num_elts > 0 || q->hs[1].num_elts > 0){
+    /* alternate between the forward and backward searches */
+    for (k = 0; k < 2; k++){
+      if (q->hs[k].num_elts == 0) continue;
+      heap_pop(&q->hs[k], du, &u);
+      if (found && q->cmp_wt(du, best) >= 0){
+        /* the search cannot improve the best distance */
+        while (q->hs[k].num_elts > 0) heap_pop(&q->hs[k], du, &u);
+        continue;
+      }
+      uk = (1 - k) * n + u;
+      if (q->nums[uk] == q->num){
+        q->add_wt(sum, du, ptr(q->dists, uk, q->c->wt_size));
+        if (!found || q->cmp_wt(sum, best) < 0){
+          memcpy(best, sum, q->c->wt_size);
+          q->meet = u;
+          found = 1;
+        }
+      }
+      offs = (k ? q->c->dn_offs : q->c->up_offs);
+      vts = (k ? q->c->dn_vts : q->c->up_vts);
+      ids = (k ? q->c->dn_ids : q->c->up_ids);
+      wts = (k ? q->c->dn_wts : q->c->up_wts);
+      for (i = offs[u]; i < offs[u + 1]; i++){
+        v = vts[i];
+        vk = k * n + v;
+        dv = ptr(q->dists, vk, q->c->wt_size);
+        q->add_wt(sum, du, ptr(wts, i, q->c->wt_size));
+        if (q->nums[vk] != q->num){
+          q->nums[vk] = q->num;
+          q->prevs[vk] = ids[i];
+          memcpy(dv, sum, q->c->wt_size);
+          heap_push(&q->hs[k], dv, &v);
+        }else if (q->cmp_wt(dv, sum) > 0){
+          /* must be in the heap */
+          q->prevs[vk] = ids[i];
+          memcpy(dv, sum, q->c->wt_size);
+          heap_update(&q->hs[k], dv, &v);
+        }
+      }
+    }
+  }
+  if (found) memcpy(dist, best, q->c->wt_size);
+  return found;
+}
+
+/**
+   Unpacks the shortest path of the last query that returned 1 into the
+   edges of the graph of the contraction hierarchy, and pushes the vertices
+   of the path from s to t onto a stack.
+   q           : pointer to a query workspace
+   path        : pointer to a stack initialized with an elt_size of
+                 sizeof(size_t)
+*/
+void ch_qry_path(const struct ch_qry *q, struct stack *path){
+  size_t e, u;
+  size_t n = q->c->num_vts;
+  struct stack s;
+  stack_init(&s, sizeof(size_t), NULL);
+  /* arcs from s to meet, with the first arc on top */
+  u = q->meet;
+  while (q->prevs[u] != q->c->num_arcs){
+    e = q->prevs[u];
+    stack_push(&s, &e);
+    u = q->c->arcs[C_ARC_COUNT * e];
+  }
+  stack_push(path, &u);
+  unpack(q->c, &s, path);
+  /* arcs from meet to t, one at a time */
+  u = q->meet;
+  while (q->prevs[n + u] != q->c->num_arcs){
+    e = q->prevs[n + u];
+    stack_push(&s, &e);
+    unpack(q->c, &s, path);
+    u = q->c->arcs[C_ARC_COUNT * e + 1];
+  }
+  stack_free(&s);
+}
+
+/**
+   Pops the arcs of a stack and pushes the end vertices of the edges of
+   the arcs onto the stack of a path, in the order of the arcs from the
+   top of the stack.
+*/
+static void unpack(const struct ch *c, struct stack *s, struct stack *path){
+  size_t e;
+  const size_t *arc = NULL;
+  while (s->num_elts > 0){
+    stack_pop(s, &e);
+    arc = c->arcs + C_ARC_COUNT * e;
+    if (arc[2] == e){
+      stack_push(path, &arc[1]);
+    }else{
+      stack_push(s, &arc[3]);
+      stack_push(s, &arc[2]);
+    }
+  }
+}
+
+/**
+   Initializes the state of a build with the arcs of an adjacency list
+   without loops and with an arc of the lowest weight from u to v.
+*/
+static void build_init(struct build *b,
+                       const struct adj_lst *a,
+                       size_t lim,
+                       const void *wt_zero,
+                       size_t (*read_vt)(const void *),
+                       int (*cmp_wt)(const void *, const void *),
+                       void (*add_wt)(void *, const void *, const void *)){
+  size_t i, u, v, e;
+  size_t *pos = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  b->num_vts = a->num_vts;
+  b->lim = lim;
+  b->wt_size = a->wt_size;
+  b->deg_offset = mul_sz_perror(2, a->num_vts);
+  b->num = 0;
+  b->tgt_num = 0;
+  b->nums = calloc_perror(a->num_vts, sizeof(size_t));
+  b->tgts = calloc_perror(a->num_vts, sizeof(size_t));
+  b->del_nbrs = calloc_perror(a->num_vts, sizeof(size_t));
+  b->marks = malloc_perror(a->num_vts, sizeof(size_t));
+  b->dists = malloc_perror(a->num_vts, a->wt_size);
+  b->bufs = malloc_perror(C_BUF_COUNT, a->wt_size);
+  memcpy(b->bufs, wt_zero, a->wt_size);
+  stack_init(&b->arcs, C_ARC_COUNT * sizeof(size_t), NULL);
+  stack_init(&b->wts, a->wt_size, NULL);
+  b->outs = malloc_perror(a->num_vts, sizeof(struct stack));
+  b->ins = malloc_perror(a->num_vts, sizeof(struct stack));
+  for (i = 0; i < a->num_vts; i++){
+    b->marks[i] = a->num_vts;
+    stack_init(&b->outs[i], sizeof(size_t), NULL);
+    stack_init(&b->ins[i], sizeof(size_t), NULL);
+    stack_bound(&b->outs[i], C_STACK_INIT_COUNT, 0);
+    stack_bound(&b->ins[i], C_STACK_INIT_COUNT, 0);
+  }
+  heap_ht_def_init(&b->hht, &b->ht, a->num_vts);
+  heap_init(&b->h, a->wt_size, sizeof(size_t), C_HEAP_INIT_COUNT, &b->hht,
+            cmp_wt, NULL, NULL, NULL);
+  b->cmp_wt = cmp_wt;
+  b->add_wt = add_wt;
+  pos = malloc_perror(a->num_vts, sizeof(size_t));
+  for (u = 0; u < a->num_vts; u++){
+    b->num++;
+    p_start = a->vt_wts[u]->elts;
+    p_end = ptr(p_start, a->vt_wts[u]->num_elts, a->pair_size);
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      v = read_vt(p);
+      if (v == u) continue;
+      if (b->nums[v] == b->num){
+        e = pos[v];
+        if (cmp_wt(ptr(b->wts.elts, e, b->wt_size),
+                   (char *)p + a->wt_offset) > 0){
+          memcpy(ptr(b->wts.elts, e, b->wt_size),
+                 (char *)p + a->wt_offset,
+                 b->wt_size);
+        }
+      }else{
+        b->nums[v] = b->num;
+        e = b->arcs.num_elts;
+        pos[v] = new_arc(b, u, v, (char *)p + a->wt_offset, e, e);
+      }
+    }
+  }
+  free(pos);
+  pos = NULL;
+}
+
+static void build_free(struct build *b){
+  free(b->nums);
+  free(b->tgts);
+  free(b->del_nbrs);
+  free(b->marks);
+  free(b->dists);
+  free(b->bufs);
+  stack_free(&b->arcs);
+  stack_free(&b->wts);
+  free(b->outs);
+  free(b->ins);
+  heap_free(&b->h);
+  b->nums = NULL;
+  b->tgts = NULL;
+  b->del_nbrs = NULL;
+  b->marks = NULL;
+  b->dists = NULL;
+  b->bufs = NULL;
+  b->outs = NULL;
+  b->ins = NULL;
+}
+
+/**
+   Pushes an arc (u, v) with a weight, replacing the arcs e and f, and
+   returns the id of the arc. If the arc is an edge, then e and f are equal
+   to the id of the arc.
+*/
+static size_t new_arc(struct build *b,
+                      size_t u,
+                      size_t v,
+                      const void *wt,
+                      size_t e,
+                      size_t f){
+  size_t g = b->arcs.num_elts;
+  size_t arc[4];
+  arc[0] = u;
+  arc[1] = v;
+  arc[2] = e;
+  arc[3] = f;
+  stack_push(&b->arcs, arc);
+  stack_push(&b->wts, wt);
+  stack_push(&b->outs[u], &g);
+  stack_push(&b->ins[v], &g);
+  return g;
+}
+
+/**
+   Adds a shortcut (u, v) with a weight, replacing the arcs e and f, or
+   updates the weight of a remaining arc (u, v) if the weight is lower.
+*/
+static void add_arc(struct build *b,
+                    size_t u,
+                    size_t v,
+                    const void *wt,
+                    size_t e,
+                    size_t f){
+  size_t i, g;
+  size_t *arc = NULL;
+  for (i = 0; i < b->outs[u].num_elts; i++){
+    g = ((size_t *)b->outs[u].elts)[i];
+    arc = arc_ptr(b, g);
+    if (arc[1] == v){
+      if (b->cmp_wt(ptr(b->wts.elts, g, b->wt_size), wt) > 0){
+        memcpy(ptr(b->wts.elts, g, b->wt_size), wt, b->wt_size);
+        arc[2] = e;
+        arc[3] = f;
+      }
+      return;
+    }
+  }
+  new_arc(b, u, v, wt, e, f);
+}
+
+/**
+   Removes the arc id e from a list by moving the last id in its place.
+*/
+static void remove_arc(struct stack *s, size_t e){
+  size_t i, buf;
+  size_t *elts = s->elts;
+  for (i = 0; i < s->num_elts; i++){
+    if (elts[i] == e){
+      stack_pop(s, (i == s->num_elts - 1) ? &buf : &elts[i]);
+      return;
+    }
+  }
+}
+
+/**
+   Runs a witness search from u that does not visit v, settles at most lim
+   vertices, and stops after num_tgts vertices marked as targets are
+   settled. The vertices with distances greater than the value pointed to
+   by max are not reached. The reached vertices are marked with the
+   witness search number and their distances are upper bounds of the
+   distances from u without v.
+*/
+static void witness(struct build *b,
+                    size_t u,
+                    size_t v,
+                    size_t num_tgts,
+                    const void *max){
+  size_t i, e, x, y, n = 0;
+  const size_t *elts = NULL;
+  void *dy = NULL;
+  void * const du = ptr(b->bufs, 1, b->wt_size);
+  void * const sum = ptr(b->bufs, 2, b->wt_size);
+  b->num++;
+  b->nums[u] = b->num;
+  memcpy(ptr(b->dists, u, b->wt_size), b->bufs, b->wt_size);
+  heap_push(&b->h, b->bufs, &u);
+  while (b->h.num_elts > 0){
+    heap_pop(&b->h, du, &x);
+    if (n == b->lim) break;
+    if (b->tgts[x] == b->tgt_num){
+      num_tgts--;
+      if (num_tgts == 0) break;
+    }
+    n++;
+    elts = b->outs[x].elts;
+    for (i = 0; i < b->outs[x].num_elts; i++){
+      e = elts[i];
+      y = arc_ptr(b, e)[1];
+      if (y == v) continue;
+      dy = ptr(b->dists, y, b->wt_size);
+      b->add_wt(sum, du, ptr(b->wts.elts, e, b->wt_size));
+      if (b->cmp_wt(sum, max) > 0) continue;
+      if (b->nums[y] != b->num){
+        b->nums[y] = b->num;
+        memcpy(dy, sum, b->wt_size);
+        heap_push(&b->h, dy, &y);
+      }else if (b->cmp_wt(dy, sum) > 0){
+        /* must be in the heap */
+        memcpy(dy, sum, b->wt_size);
+        heap_update(&b->h, dy, &y);
+      }
+    }
+  }
+  while (b->h.num_elts > 0) heap_pop(&b->h, du, &x);
+}
+
+/**
+   Returns the number of shortcuts that are added by the contraction of v,
+   and adds the shortcuts if sim is zero.
+*/
+static size_t contract(struct build *b, size_t v, int sim){
+  size_t i, j, k, e, f, u, w, ret = 0;
+  const struct stack *in = &b->ins[v], *out = &b->outs[v];
+  void * const sum = ptr(b->bufs, 3, b->wt_size);
+  void * const max = ptr(b->bufs, 4, b->wt_size);
+  for (i = 0; i < in->num_elts; i++){
+    e = ((const size_t *)in->elts)[i];
+    u = arc_ptr(b, e)[0];
+    k = 0;
+    b->tgt_num++;
+    for (j = 0; j < out->num_elts; j++){
+      f = ((const size_t *)out->elts)[j];
+      w = arc_ptr(b, f)[1];
+      if (w == u) continue;
+      b->tgts[w] = b->tgt_num;
+      b->add_wt(sum,
+                ptr(b->wts.elts, e, b->wt_size),
+                ptr(b->wts.elts, f, b->wt_size));
+      if (k == 0 || b->cmp_wt(sum, max) > 0){
+        memcpy(max, sum, b->wt_size);
+      }
+      k++;
+    }
+    if (k == 0) continue;
+    witness(b, u, v, k, max);
+    for (j = 0; j < out->num_elts; j++){
+      f = ((const size_t *)out->elts)[j];
+      w = arc_ptr(b, f)[1];
+      if (w == u) continue;
+      b->add_wt(sum,
+                ptr(b->wts.elts, e, b->wt_size),
+                ptr(b->wts.elts, f, b->wt_size));
+      if (b->nums[w] == b->num &&
+          b->cmp_wt(ptr(b->dists, w, b->wt_size), sum) <= 0) continue;
+      ret++;
+      if (!sim) add_arc(b, u, w, sum, e, f);
+    }
+  }
+  return ret;
+}
+
+/**
+   Computes the priority of v as the edge difference plus the number of
+   the contracted neighbors of v, offset by 2 * num_vts to be non-negative.
+*/
+static size_t priority(struct build *b, size_t v){
+  size_t ret = add_sz_perror(contract(b, v, 1), b->del_nbrs[v]);
+  ret = add_sz_perror(ret, b->deg_offset);
+  return ret - b->ins[v].num_elts - b->outs[v].num_elts;
+}
+
+/**
+   Renumbers the arcs of a contraction hierarchy with a counting sort, where
+   the edges precede the shortcuts and the shortcuts are in the
+   non-decreasing order of the lower rank of their end vertices. The middle
+   vertex of a shortcut has a lower rank than its end vertices, so that
+   each shortcut has a greater id than the arcs it replaces, including an
+   arc that was updated during a build to replace arcs added later.
+*/
+static void sort_arcs(struct ch *c){
+  size_t i, k;
+  size_t *cnts = NULL, *ids = NULL, *arcs = NULL;
+  const size_t *arc = NULL;
+  void *wts = NULL;
+  if (c->num_arcs == 0) return;
+  cnts = calloc_perror(add_sz_perror(c->num_vts, 2), sizeof(size_t));
+  ids = malloc_perror(c->num_arcs, sizeof(size_t));
+  for (i = 0; i < c->num_arcs; i++){
+    arc = c->arcs + C_ARC_COUNT * i;
+    if (arc[2] == i){
+      ids[i] = 0;
+    }else if (c->rank[arc[0]] < c->rank[arc[1]]){
+      ids[i] = c->rank[arc[0]] + 1;
+    }else{
+      ids[i] = c->rank[arc[1]] + 1;
+    }
+    cnts[ids[i] + 1]++;
+  }
+  for (k = 0; k < c->num_vts; k++){
+    cnts[k + 1] += cnts[k];
+  }
+  for (i = 0; i < c->num_arcs; i++){
+    ids[i] = cnts[ids[i]]++;
+  }
+  arcs = malloc_perror(c->num_arcs, C_ARC_COUNT * sizeof(size_t));
+  wts = malloc_perror(c->num_arcs, c->wt_size);
+  for (i = 0; i < c->num_arcs; i++){
+    arc = c->arcs + C_ARC_COUNT * i;
+    k = C_ARC_COUNT * ids[i];
+    arcs[k] = arc[0];
+    arcs[k + 1] = arc[1];
+    arcs[k + 2] = ids[arc[2]];
+    arcs[k + 3] = ids[arc[3]];
+    memcpy(ptr(wts, ids[i], c->wt_size),
+           ptr(c->wts, i, c->wt_size),
+           c->wt_size);
+  }
+  free(c->arcs);
+  free(c->wts);
+  free(cnts);
+  free(ids);
+  c->arcs = arcs;
+  c->wts = wts;
+  cnts = NULL;
+  ids = NULL;
+}
+
+/**
+   Builds the upward and downward lists of a contraction hierarchy from
+   the ranks of vertices and the arcs.
+*/
+static void build_lists(struct ch *c){
+  size_t i, j, u, v;
+  size_t n = c->num_vts;
+  const size_t *arc = NULL;
+  c->up_offs = calloc_perror(add_sz_perror(n, 1), sizeof(size_t));
+  c->dn_offs = calloc_perror(add_sz_perror(n, 1), sizeof(size_t));
+  for (i = 0; i < c->num_arcs; i++){
+    arc = c->arcs + C_ARC_COUNT * i;
+    if (c->rank[arc[0]] < c->rank[arc[1]]){
+      c->up_offs[arc[0] + 1]++;
+    }else{
+      c->dn_offs[arc[1] + 1]++;
+    }
+  }
+  for (i = 0; i < n; i++){
+    c->up_offs[i + 1] += c->up_offs[i];
+    c->dn_offs[i + 1] += c->dn_offs[i];
+  }
+  c->up_vts = NULL;
+  c->up_ids = NULL;
+  c->up_wts = NULL;
+  c->dn_vts = NULL;
+  c->dn_ids = NULL;
+  c->dn_wts = NULL;
+  if (c->up_offs[n] > 0){
+    c->up_vts = malloc_perror(c->up_offs[n], sizeof(size_t));
+    c->up_ids = malloc_perror(c->up_offs[n], sizeof(size_t));
+    c->up_wts = malloc_perror(c->up_offs[n], c->wt_size);
+  }
+  if (c->dn_offs[n] > 0){
+    c->dn_vts = malloc_perror(c->dn_offs[n], sizeof(size_t));
+    c->dn_ids = malloc_perror(c->dn_offs[n], sizeof(size_t));
+    c->dn_wts = malloc_perror(c->dn_offs[n], c->wt_size);
+  }
+  /* fill with offsets moved forward, then move them back */
+  for (i = 0; i < c->num_arcs; i++){
+    arc = c->arcs + C_ARC_COUNT * i;
+    u = arc[0];
+    v = arc[1];
+    if (c->rank[u] < c->rank[v]){
+      j = c->up_offs[u]++;
+      c->up_vts[j] = v;
+      c->up_ids[j] = i;
+      memcpy(ptr(c->up_wts, j, c->wt_size),
+             ptr(c->wts, i, c->wt_size),
+             c->wt_size);
+    }else{
+      j = c->dn_offs[v]++;
+      c->dn_vts[j] = u;
+      c->dn_ids[j] = i;
+      memcpy(ptr(c->dn_wts, j, c->wt_size),
+             ptr(c->wts, i, c->wt_size),
+             c->wt_size);
+    }
+  }
+  for (i = n; i > 0; i--){
+    c->up_offs[i] = c->up_offs[i - 1];
+    c->dn_offs[i] = c->dn_offs[i - 1];
+  }
+  c->up_offs[0] = 0;
+  c->dn_offs[0] = 0;
+}
+
+/**
+   Default hash table operations, mapping size_t vertices to size_t
+   indices for in-heap operations. The hash table is left with all
+   vertices absent after a heap is emptied, and is reused by searches.
+*/
+
+static void heap_ht_def_init(struct heap_ht *hht,
+                             struct ht_def *ht,
+                             size_t num_vts){
+  size_t i;
+  ht->absent = num_vts;
+  ht->elts = malloc_perror(num_vts, sizeof(size_t));
+  for (i = 0; i < num_vts; i++){
+    ht->elts[i] = num_vts;
+  }
+  hht->ht = ht;
+  hht->alpha_n = 0;
+  hht->log_alpha_d = 0;
+  hht->init = NULL;
+  hht->align = NULL;
+  hht->insert = ht_def_insert;
+  hht->search = ht_def_search;
+  hht->remove = ht_def_remove;
+  hht->free = ht_def_free;
+}
+
+static void ht_def_insert(void *ht, const void *vt, const void *ix){
+  struct ht_def *ht_def = ht;
+  ht_def->elts[*(const size_t *)vt] = *(const size_t *)ix;
+}
+
+static void *ht_def_search(const void *ht, const void *vt){
+  const struct ht_def *ht_def = ht;
+  const size_t *p = ht_def->elts + *(const size_t *)vt;
+  if (*p != ht_def->absent){
+    return (void *)p;
+  }else{
+    return NULL;
+  }
+}
+
+static void ht_def_remove(void *ht, const void *vt, void *ix){
+  struct ht_def *ht_def = ht;
+  size_t *p = ht_def->elts + *(const size_t *)vt;
+  if (*p != ht_def->absent){
+    *(size_t *)ix = *p;
+    *p = ht_def->absent;
+  }
+}
+
+static void ht_def_free(void *ht){
+  struct ht_def *ht_def = ht;
+  free(ht_def->elts);
+  ht_def->elts = NULL;
+}
+
+/**
+   Returns a pointer to the values of the arc e in a build.
+*/
+static size_t *arc_ptr(const struct build *b, size_t e){
+  return (size_t *)b->arcs.elts + C_ARC_COUNT * e;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
+
+/**
+   Read and write num blocks of size size, and exit if a block is not
+   read or written.
+*/
+
+static void fread_perror(void *p,
+                         size_t size,
+                         size_t num,
+                         FILE *f,
+                         const char *path){
+  if (num == 0) return;
+  if (fread(p, size, num, f) != num){
+    if (ferror(f)){
+      perror(path);
+      exit(EXIT_FAILURE);
+    }
+    fprintf_stderr_exit("not a contraction hierarchy file", __LINE__);
+  }
+}
+
+static void fwrite_perror(const void *p,
+                          size_t size,
+                          size_t num,
+                          FILE *f,
+                          const char *path){
+  if (num == 0) return;
+  if (fwrite(p, size, num, f) != num){
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+   Prints an error message and exits.
+*/
+static void fprintf_stderr_exit(const char *s, int line){
+  fprintf(stderr, "%s in %s at line %d\n", s,  __FILE__, line);
+  exit(EXIT_FAILURE);
+}
@@ -0,0 +1,211 @@
+/**
+   ch.h
+
+   Struct declarations and declarations of accessible functions for
+   building contraction hierarchies of graphs with generic integer vertices
+   and generic non-negative weights, for answering point-to-point shortest
+   path queries with bidirectional upward searches, and for writing and
+   reading contraction hierarchies to and from files.
+
+   A contraction hierarchy is built once by contracting the vertices of a
+   graph one by one. When a vertex v is contracted, a shortcut (u, w) with
+   the weight of the path (u, v, w) is added for each pair of the remaining
+   (u, v) and (v, w) edges, unless a witness search, i.e. Dijkstra's
+   algorithm from u that does not visit v and settles at most lim vertices,
+   finds a path from u to w that is not longer. The order of contraction is
+   given by a heap of priorities, where the priority of a vertex is the
+   edge difference, i.e. the number of shortcuts that would be added minus
+   the number of the remaining edges of the vertex, plus the number of the
+   contracted neighbors of the vertex for the uniformity of contraction
+   across a graph. The priorities are updated lazily: the priority of a
+   popped vertex is recomputed, and the vertex is pushed back if its
+   priority increased, so that the priorities of high-degree neighbors are
+   not recomputed after each contraction. A lower witness search limit
+   results in shorter witness searches and more shortcuts, and does not
+   affect correctness.
+
+   A query from s to t runs Dijkstra's algorithm from s on the edges and
+   shortcuts leading to vertices contracted later, and from t on the
+   reversed edges and shortcuts leading from vertices contracted later,
+   and stops when both searches cannot improve the best distance through a
+   vertex reached by both searches. The searches only visit a small part
+   of a road-like graph. A query uses a preallocated workspace, where the
+   visited vertices are marked with a query number, so that no array of
+   size num_vts is reset between queries. The shortcuts record the two
+   edges or shortcuts they replace, so that the path of a query is unpacked
+   without a search.
+
+   A file of a contraction hierarchy contains the contraction order and the
+   edges and shortcuts as size_t values and wt_size blocks, and can only be
+   read on a system with the same representations of size_t and the type
+   of weights.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted, an allocation is not completed due to
+   insufficient resources, a file cannot be opened, or a file is not a file
+   of a contraction hierarchy with the given weight size. The behavior
+   outside the specified parameter ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99.
+*/
+
+#ifndef CH_H
+#define CH_H
+
+#include <stddef.h>
+#include "graph.h"
+#include "heap.h"
+#include "stack.h"
+
+/**
+   Contraction hierarchy struct. An arc is an edge of a graph or a
+   shortcut. The values of an edge (u, v) with the id i are u, v, i, and i.
+   A shortcut has a greater id than the two arcs it replaces.
+   The upward list of u contains the arcs (u, v) with rank[u] < rank[v],
+   and the downward list of v contains the arcs (u, v) with
+   rank[u] > rank[v], which are searched backward from v to u.
+*/
+struct ch{
+  size_t num_vts;
+  size_t num_arcs;
+  size_t wt_size;
+  size_t *rank; /* position of a vertex in the contraction order */
+  size_t *arcs; /* 4 values per arc: u, v, and two replaced arcs */
+  void *wts; /* weight of each arc */
+  size_t *up_offs; /* num_vts + 1 offsets of upward lists */
+  size_t *up_vts; /* v of each arc in upward lists */
+  size_t *up_ids; /* id of each arc in upward lists */
+  void *up_wts; /* weight of each arc in upward lists */
+  size_t *dn_offs; /* num_vts + 1 offsets of downward lists */
+  size_t *dn_vts; /* u of each arc in downward lists */
+  size_t *dn_ids; /* id of each arc in downward lists */
+  void *dn_wts; /* weight of each arc in downward lists */
+};
+
+/**
+   Query workspace struct. Holds the state of the last query for unpacking
+   its path.
+*/
+struct ch_qry{
+  size_t num; /* query number */
+  size_t meet; /* vertex of the last shortest path reached by both */
+  size_t *nums; /* 2 * num_vts: forward and backward query numbers */
+  size_t *prevs; /* 2 * num_vts: forward and backward previous arcs */
+  void *dists; /* 2 * num_vts: forward and backward distances */
+  void *bufs; /* 4 wt_size blocks, including a zero weight */
+  void *hts; /* default hash tables of the heaps */
+  struct heap_ht hhts[2];
+  struct heap hs[2];
+  const struct ch *c;
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+};
+
+/**
+   Builds a contraction hierarchy of a directed graph. An undirected graph
+   is represented by an adjacency list with a (u, v) and a (v, u) pair for
+   each edge, e.g. built by adj_lst_undir_build. Loops are skipped and of
+   multiple edges from u to v only an edge with the lowest weight is kept.
+   c           : pointer to a preallocated block of size sizeof(struct ch)
+   a           : pointer to a weighted adjacency list with at least one
+                 vertex and non-negative weights
+   lim         : > 0 maximal number of vertices settled by a witness search
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent weights
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function
+*/
+void ch_build(struct ch *c,
+              const struct adj_lst *a,
+              size_t lim,
+              const void *wt_zero,
+              size_t (*read_vt)(const void *),
+              int (*cmp_wt)(const void *, const void *),
+              void (*add_wt)(void *, const void *, const void *));
+
+/**
+   Writes a contraction hierarchy to a file. The file is created or
+   truncated.
+   c           : pointer to a contraction hierarchy
+   path        : path of the file
+*/
+void ch_write(const struct ch *c, const char *path);
+
+/**
+   Reads a contraction hierarchy from a file written by ch_write.
+   c           : pointer to a preallocated block of size sizeof(struct ch)
+   path        : path of the file
+   wt_size     : size of the type used to represent weights in the file
+*/
+void ch_read(struct ch *c, const char *path, size_t wt_size);
+
+/**
+   Frees a contraction hierarchy and leaves the block of size
+   sizeof(struct ch) pointed to by c.
+*/
+void ch_free(struct ch *c);
+
+/**
+   Initializes a query workspace for a contraction hierarchy. The workspace
+   must not be copied and can be used by one thread at a time.
+   q           : pointer to a preallocated block of size
+                 sizeof(struct ch_qry)
+   c           : pointer to a contraction hierarchy that is not modified
+                 or freed during the lifetime of the workspace
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent weights
+   cmp_wt      : comparison function for weights; please see ch_build
+   add_wt      : addition function for weights; please see ch_build
+*/
+void ch_qry_init(struct ch_qry *q,
+                 const struct ch *c,
+                 const void *wt_zero,
+                 int (*cmp_wt)(const void *, const void *),
+                 void (*add_wt)(void *, const void *, const void *));
+
+/**
+   Frees a query workspace and leaves the block of size
+   sizeof(struct ch_qry) pointed to by q.
+*/
+void ch_qry_free(struct ch_qry *q);
+
+/**
+   Computes the shortest distance from s to t. Returns 1 and copies the
+   distance to the wt_size block pointed to by dist if t is reachable from
+   s, otherwise returns 0 and the block pointed to by dist remains
+   unchanged.
+   q           : pointer to an initialized query workspace
+   s           : start vertex
+   t           : end vertex
+   dist        : pointer to a preallocated wt_size block
+*/
+int ch_query(struct ch_qry *q, size_t s, size_t t, void *dist);
+
+/**
+   Unpacks the shortest path of the last query that returned 1 into the
+   edges of the graph of the contraction hierarchy, and pushes the vertices
+   of the path from s to t onto a stack.
+   q           : pointer to a query workspace
+   path        : pointer to a stack initialized with an elt_size of
+                 sizeof(size_t)
+*/
+void ch_qry_path(const struct ch_qry *q, struct stack *path);
+
+#endif
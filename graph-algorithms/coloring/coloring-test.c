@@ -0,0 +1,310 @@
+/**
+   coloring-test.c
+
+   Tests of greedy vertex coloring across graphs with different integer
+   types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   coloring-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./coloring-test
+   ./coloring-test 10 14
+   ./coloring-test 14 18 0 1
+
+   coloring-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "coloring.h"
+#include "kcore.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "coloring-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 14u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 16u};
+
+int is_coloring(const struct adj_lst *a,
+                const size_t *color,
+                size_t num_colors,
+                size_t (*read_vt)(const void *));
+size_t max_degree(const struct adj_lst *a, size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Computes colorings with color_greedy in the order of vertices and in a
+   random order, and with color_sl. Tests that each coloring is valid and
+   uses the returned number of colors, which is at most the maximum degree
+   plus one, and at most the degeneracy plus one for color_sl.
+*/
+void coloring_helper(const struct adj_lst *a,
+                     size_t j,
+                     const char *s,
+                     size_t *num_colors,
+                     int *res){
+  size_t i, k, u, n = a->num_vts;
+  size_t max_deg, degen, num_rand, num_sl;
+  size_t *color = NULL, *ord = NULL;
+  clock_t t_greedy, t_sl;
+  color = malloc_perror(n, sizeof(size_t));
+  ord = malloc_perror(n, sizeof(size_t));
+  max_deg = max_degree(a, C_READ[j]);
+  t_greedy = clock();
+  *num_colors = color_greedy(a, NULL, color, C_READ[j]);
+  t_greedy = clock() - t_greedy;
+  *res *= is_coloring(a, color, *num_colors, C_READ[j]);
+  *res *= (*num_colors <= max_deg + 1);
+  for (i = 0; i < n; i++){
+    ord[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    u = ord[i - 1];
+    ord[i - 1] = ord[k];
+    ord[k] = u;
+  }
+  num_rand = color_greedy(a, ord, color, C_READ[j]);
+  *res *= is_coloring(a, color, num_rand, C_READ[j]);
+  *res *= (num_rand <= max_deg + 1);
+  degen = kcore(a, color, NULL, C_READ[j]);
+  t_sl = clock();
+  num_sl = color_sl(a, color, C_READ[j]);
+  t_sl = clock() - t_sl;
+  *res *= is_coloring(a, color, num_sl, C_READ[j]);
+  *res *= (num_sl <= degen + 1);
+  printf("\t\t\t%s %scolor_greedy time: %.6f seconds, colors: %lu\n"
+         "\t\t\t%s %scolor_sl time:     %.6f seconds, colors: %lu\n",
+         C_VT_TYPES[j], s, (double)t_greedy / CLOCKS_PER_SEC,
+         TOLU(*num_colors),
+         C_VT_TYPES[j], s, (double)t_sl / CLOCKS_PER_SEC, TOLU(num_sl));
+  free(color);
+  free(ord);
+  color = NULL;
+  ord = NULL;
+}
+
+/**
+   Run tests on 2D grid graphs, where the coloring in the order of
+   vertices uses two colors if there are at least two vertices.
+*/
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts, num_x, num_y, num_colors;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test color_greedy and color_sl on 2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      coloring_helper(&a, j, "", &num_colors, &res);
+      res *= (num_colors == 1 + (num_vts > 1));
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on undirected R-MAT graphs, which may have multiple edges
+   between the same vertices and loops, before and after the lists are
+   sorted and deduplicated.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_colors;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test color_greedy and color_sl on undirected R-MAT graphs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n edges\n", TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, NULL, NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_undir_build(&a, &g, C_READ[j]);
+        coloring_helper(&a, j, "multigraph ", &num_colors, &res);
+        adj_lst_sort(&a, C_CMP[j]);
+        adj_lst_dedup(&a, C_CMP[j]);
+        coloring_helper(&a, j, "simple     ", &num_colors, &res);
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Returns 1 if each color is less than num_colors, each color in
+   [0, num_colors) is used, and the end vertices of each edge that is not
+   a loop have different colors, otherwise returns 0.
+*/
+int is_coloring(const struct adj_lst *a,
+                const size_t *color,
+                size_t num_colors,
+                size_t (*read_vt)(const void *)){
+  int ret = 1;
+  size_t k, u, v;
+  unsigned char *used = NULL;
+  const char *p = NULL;
+  if (a->num_vts == 0) return (num_colors == 0);
+  used = calloc_perror(a->num_vts, sizeof(unsigned char));
+  for (u = 0; ret && u < a->num_vts; u++){
+    if (color[u] >= num_colors){
+      ret = 0;
+      break;
+    }
+    used[color[u]] = 1;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(p);
+      if (v != u && color[v] == color[u]) ret = 0;
+      p += a->pair_size;
+    }
+  }
+  for (k = 0; ret && k < num_colors; k++){
+    ret = used[k];
+  }
+  free(used);
+  used = NULL;
+  return ret;
+}
+
+/**
+   Returns the maximum number of pairs in a list that are not loops.
+*/
+size_t max_degree(const struct adj_lst *a, size_t (*read_vt)(const void *)){
+  size_t k, u, deg, ret = 0;
+  const char *p = NULL;
+  for (u = 0; u < a->num_vts; u++){
+    deg = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      deg += (read_vt(p) != u);
+      p += a->pair_size;
+    }
+    if (deg > ret) ret = deg;
+  }
+  return ret;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+   coloring.h
+
+   Declarations of accessible functions for computing a vertex coloring of
+   an undirected graph with generic integer vertices indexed from 0 by
+   greedy first-fit algorithms. A graph may be unweighted or weighted. In
+   the latter case the weights of the graph are ignored.
+
+   A coloring assigns to each vertex a color in [0, number of colors), so
+   that the end vertices of each edge that is not a loop have different
+   colors. A vertex in a given order is assigned the least color that is
+   not assigned to its colored neighbors, which results in at most
+   d + 1 colors, where d is the maximum degree. In the smallest-last order,
+   i.e. the reverse of the order of removal of a vertex of minimum degree,
+   at most k + 1 colors are used, where k is the degeneracy of a graph.
+   The colors of the neighbors of a vertex are marked in an array with the
+   vertex as the mark, so that the array is not cleared for each vertex.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef COLORING_H
+#define COLORING_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a greedy coloring of an undirected graph, where the vertices
+   are colored in a given order, in O(num_vts + num_es) time. Returns the
+   number of colors, which is 0 if the graph has no vertices.
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   ord         : - NULL pointer, if the vertices are colored in the order
+                 0, 1, ..., num_vts - 1
+                 - otherwise pointer to an array of num_vts size_t elements
+                 with a permutation of the vertices, which are colored in
+                 the order of the array
+   color       : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the color
+                 of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t color_greedy(const struct adj_lst *a,
+                    const size_t *ord,
+                    size_t *color,
+                    size_t (*read_vt)(const void *));
+
+/**
+   Computes a greedy coloring of an undirected graph in the smallest-last
+   order, which is computed by kcore in kcore.h, in O(num_vts + num_es)
+   time. Returns the number of colors, which is at most the degeneracy of
+   the graph plus one, and 0 if the graph has no vertices. Please see the
+   parameter specification in color_greedy.
+*/
+size_t color_sl(const struct adj_lst *a,
+                size_t *color,
+                size_t (*read_vt)(const void *));
+
+#endif
@@ -0,0 +1,455 @@
+/**
+   dag-test.c
+
+   Tests of topological sorting and the shortest and longest paths in
+   directed acyclic graphs across graphs with different integer types of
+   vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   dag-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : path graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./dag-test
+   ./dag-test 10 14
+   ./dag-test 14 16 0 1
+
+   dag-test can be run with any subset of command line arguments in the
+   above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "dag.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "dag-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : path graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 10u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 4u};
+const long C_WT_ZERO = 0;
+const long C_WT_RANGE = 100; /* weights in [-C_WT_RANGE, C_WT_RANGE] */
+
+void rand_perm(size_t *perm, size_t n);
+int is_toposort(const struct adj_lst *a,
+                const void *order,
+                size_t (*read_vt)(const void *));
+int cmp_paths(const struct adj_lst *a,
+              size_t start,
+              const long *dist,
+              const void *prev,
+              int longest,
+              size_t (*read_vt)(const void *));
+int bern_one(void *arg);
+void print_test_result(int res);
+
+/**
+   Run tests on directed paths with vertices in a random order, where the
+   DFS depth equals the number of vertices and the topological order is
+   unique. A path is a cycle after an edge from its last to its first
+   vertex is added.
+*/
+void run_path_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  size_t *perm = NULL;
+  long wt = 1;
+  long *dist = NULL;
+  void *order = NULL, *prev = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test toposort and dag_sp on directed paths\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    dist = malloc_perror(num_vts, sizeof(long));
+    for (j = 0; j < C_FN_COUNT; j++){
+      rand_perm(perm, num_vts);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(long));
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      for (k = 0; k + 1 < num_vts; k++){
+        adj_lst_add_dir_edge(&a, perm[k], perm[k + 1], &wt,
+                             C_WRITE[j], bern_one, NULL);
+      }
+      order = malloc_perror(num_vts, C_VT_SIZES[j]);
+      prev = malloc_perror(num_vts, C_VT_SIZES[j]);
+      t = clock();
+      res *= toposort(&a, order, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s toposort time: %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      for (k = 0; k < num_vts; k++){
+        res *= (C_READ[j]((char *)order + k * a.vt_size) == perm[k]);
+      }
+      t = clock();
+      dag_sp(&a, perm[0], order, dist, prev, &C_WT_ZERO,
+             C_READ[j], C_WRITE[j], graph_cmp_long, graph_add_long);
+      t = clock() - t;
+      printf("\t\t\t%s dag_sp time:   %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      for (k = 0; k < num_vts; k++){
+        res *= (dist[perm[k]] == (long)k);
+      }
+      adj_lst_add_dir_edge(&a, perm[num_vts - 1], perm[0], &wt,
+                           C_WRITE[j], bern_one, NULL);
+      res *= !toposort(&a, order, C_READ[j], C_WRITE[j]);
+      adj_lst_free(&a);
+      free(order);
+      free(prev);
+      order = NULL;
+      prev = NULL;
+    }
+    free(perm);
+    free(dist);
+    perm = NULL;
+    dist = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on DAGs obtained from R-MAT graphs by removing self-loops,
+   orienting each edge from the lower to the higher vertex, and relabeling
+   the vertices with a random permutation. The computed order is verified
+   for each edge, and the distances computed by dag_sp and dag_lp from a
+   random start vertex are compared with the result of Bellman-Ford
+   relaxations. A cycle is obtained by adding a reverse edge.
+*/
+
+void gen_wt(void *wt, void *arg){
+  (void)arg;
+  *(long *)wt = RANDOM() % (2 * C_WT_RANGE + 1) - C_WT_RANGE;
+}
+
+void rmat_dag(struct graph *g,
+              size_t num_es,
+              const size_t *perm,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t));
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, start;
+  size_t num_vts;
+  size_t *perm = NULL;
+  long *dist = NULL;
+  void *order = NULL, *prev = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test toposort, dag_sp, and dag_lp on R-MAT DAGs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, at most %lu * n directed edges\n",
+           TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      perm = malloc_perror(num_vts, sizeof(size_t));
+      dist = malloc_perror(num_vts, sizeof(long));
+      for (j = 0; j < C_FN_COUNT; j++){
+        rand_perm(perm, num_vts);
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], sizeof(long));
+        rmat_dag(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                 perm, C_READ[j], C_WRITE[j]);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        order = malloc_perror(num_vts, C_VT_SIZES[j]);
+        prev = malloc_perror(num_vts, C_VT_SIZES[j]);
+        t = clock();
+        res *= toposort(&a, order, C_READ[j], C_WRITE[j]);
+        t = clock() - t;
+        printf("\t\t\t%s toposort time: %.6f seconds\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        res *= is_toposort(&a, order, C_READ[j]);
+        start = RANDOM() % num_vts;
+        t = clock();
+        dag_sp(&a, start, order, dist, prev, &C_WT_ZERO,
+               C_READ[j], C_WRITE[j], graph_cmp_long, graph_add_long);
+        t = clock() - t;
+        printf("\t\t\t%s dag_sp time:   %.6f seconds\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        res *= cmp_paths(&a, start, dist, prev, 0, C_READ[j]);
+        t = clock();
+        dag_lp(&a, start, order, dist, prev, &C_WT_ZERO,
+               C_READ[j], C_WRITE[j], graph_cmp_long, graph_add_long);
+        t = clock() - t;
+        printf("\t\t\t%s dag_lp time:   %.6f seconds\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+        res *= cmp_paths(&a, start, dist, prev, 1, C_READ[j]);
+        if (g.num_es > 0){
+          adj_lst_add_dir_edge(&a, C_READ[j](g.v), C_READ[j](g.u),
+                               g.wts, C_WRITE[j], bern_one, NULL);
+          res *= !toposort(&a, order, C_READ[j], C_WRITE[j]);
+        }
+        adj_lst_free(&a);
+        graph_free(&g);
+        free(order);
+        free(prev);
+        order = NULL;
+        prev = NULL;
+      }
+      free(perm);
+      free(dist);
+      perm = NULL;
+      dist = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Generates the edges of an R-MAT graph, removes the self-loops, orients
+   each edge (u, v) from min(u, v) to max(u, v), and relabels each vertex
+   u as perm[u].
+*/
+void rmat_dag(struct graph *g,
+              size_t num_es,
+              const size_t *perm,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t)){
+  size_t i, u, v;
+  size_t n = 0;
+  char *pu = NULL, *pv = NULL;
+  graph_rmat(g, num_es, write_vt, graph_rmat_quad, gen_wt, NULL);
+  for (i = 0; i < g->num_es; i++){
+    u = read_vt((char *)g->u + i * g->vt_size);
+    v = read_vt((char *)g->v + i * g->vt_size);
+    if (u == v) continue;
+    pu = (char *)g->u + n * g->vt_size;
+    pv = (char *)g->v + n * g->vt_size;
+    write_vt(pu, perm[u < v ? u : v]);
+    write_vt(pv, perm[u < v ? v : u]);
+    memcpy((char *)g->wts + n * g->wt_size,
+           (char *)g->wts + i * g->wt_size,
+           g->wt_size);
+    n++;
+  }
+  g->num_es = n;
+}
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+/**
+   Returns 1 if the order array contains each vertex once and u precedes
+   v for each (u, v) edge, otherwise returns 0.
+*/
+int is_toposort(const struct adj_lst *a,
+                const void *order,
+                size_t (*read_vt)(const void *)){
+  int ret = 1;
+  size_t i, k, u;
+  size_t *pos = malloc_perror(a->num_vts, sizeof(size_t));
+  const char *p = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    pos[i] = a->num_vts;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    u = read_vt((const char *)order + i * a->vt_size);
+    if (u >= a->num_vts || pos[u] < a->num_vts) ret = 0;
+    if (u < a->num_vts) pos[u] = i;
+  }
+  for (u = 0; u < a->num_vts && ret; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      if (pos[read_vt(p)] <= pos[u]) ret = 0;
+      p += a->pair_size;
+    }
+  }
+  free(pos);
+  pos = NULL;
+  return ret;
+}
+
+/**
+   Computes the shortest or longest distances from start by Bellman-Ford
+   relaxations until no distance is updated, and compares the result with
+   the dist and prev arrays. The previous vertex of each reached vertex
+   v other than start must be a reached vertex u with a (u, v) edge of
+   weight dist[v] - dist[u]. Returns 1 if the results match, otherwise
+   returns 0.
+*/
+int cmp_paths(const struct adj_lst *a,
+              size_t start,
+              const long *dist,
+              const void *prev,
+              int longest,
+              size_t (*read_vt)(const void *)){
+  int ret = 1, upd = 1, found;
+  size_t i, k, u, v;
+  size_t n = a->num_vts;
+  long s;
+  long *ref = malloc_perror(n, sizeof(long));
+  char *reached = calloc_perror(n, sizeof(char));
+  const char *p = NULL;
+  ref[start] = 0;
+  reached[start] = 1;
+  while (upd){
+    upd = 0;
+    for (u = 0; u < n; u++){
+      if (!reached[u]) continue;
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        v = read_vt(p);
+        s = ref[u] + *(const long *)(p + a->wt_offset);
+        if (!reached[v] ||
+            (longest && s > ref[v]) ||
+            (!longest && s < ref[v])){
+          ref[v] = s;
+          reached[v] = 1;
+          upd = 1;
+        }
+        p += a->pair_size;
+      }
+    }
+  }
+  for (i = 0; i < n; i++){
+    u = read_vt((const char *)prev + i * a->vt_size);
+    if (!reached[i]){
+      ret *= (u == n);
+      continue;
+    }
+    ret *= (dist[i] == ref[i]);
+    if (i == start){
+      ret *= (u == start);
+      continue;
+    }
+    if (u >= n || !reached[u]){
+      ret = 0;
+      continue;
+    }
+    found = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      if (read_vt(p) == i &&
+          ref[u] + *(const long *)(p + a->wt_offset) == ref[i]) found = 1;
+      p += a->pair_size;
+    }
+    ret *= found;
+  }
+  free(ref);
+  free(reached);
+  ref = NULL;
+  reached = NULL;
+  return ret;
+}
+
+int bern_one(void *arg){
+  (void)arg;
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_path_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
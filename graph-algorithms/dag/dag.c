@@ -0,0 +1,287 @@
+/**
+   dag.c
+
+   Functions for computing a topological order of a directed acyclic graph
+   (DAG) with generic integer vertices indexed from 0, and for computing
+   the shortest and longest paths from a start vertex of a DAG with generic
+   weights in linear time.
+
+   The paths are computed by relaxing the lists of the vertices in a
+   topological order, where each list is relaxed once. As a result,
+   distances are computed in O(num_vts + num_es) time instead of the
+   O((num_vts + num_es) log num_vts) time of Dijkstra's algorithm, and
+   negative weights are allowed.
+
+   The effective type of every element in the order and prev arrays is of
+   the integer type used to represent vertices. The value of every element
+   in the prev array is set by the algorithm to the value of the previous
+   vertex, with the number of vertices as the special value for unreached
+   vertices. A distance value in the dist array is only set if the
+   corresponding vertex was reached, as indicated by the prev array, as in
+   dijkstra in dijkstra.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dag.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static const size_t C_STACK_INIT_COUNT = 1;
+static const size_t C_STACK_MAX_COUNT = 0; /* < init count, unbounded */
+
+/* states of vertices in the DFS */
+static const unsigned char C_UNVISITED = 0;
+static const unsigned char C_ACTIVE = 1;
+static const unsigned char C_FINISHED = 2;
+
+/* frame of the emulated recursion */
+struct dag_frame{
+  size_t u;
+  size_t k;       /* index of the next pair in the list of u */
+};
+
+static void paths(const struct adj_lst *a,
+                  size_t start,
+                  const void *order,
+                  void *dist,
+                  void *prev,
+                  const void *wt_zero,
+                  size_t (*read_vt)(const void *),
+                  void (*write_vt)(void *, size_t),
+                  int (*cmp_wt)(const void *, const void *),
+                  void (*add_wt)(void *, const void *, const void *),
+                  int longest);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes a topological order of the vertices of a directed graph as the
+   reverse DFS postorder in O(num_vts + num_es) time, where the DFS is run
+   from each unvisited vertex in the increasing order of vertices and the
+   recursion is emulated on a dynamically allocated stack. Returns 1 if
+   the graph is acyclic, and 0 if a cycle was found, in which case the
+   content of the order array is undefined. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+   a           : pointer to an adjacency list
+   order       : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the graph is acyclic, the array is set to the vertices
+                 in a topological order, where u precedes v for each (u, v)
+                 edge
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+int toposort(const struct adj_lst *a,
+             void *order,
+             size_t (*read_vt)(const void *),
+             void (*write_vt)(void *, size_t)){
+  int ret = 1;
+  size_t i;
+  size_t v = 0;
+  size_t n = a->num_vts;
+  size_t top = n; /* the order is filled from the end */
+  unsigned char *state = NULL;
+  struct dag_frame f;
+  struct stack s;
+  if (n == 0) return 1;
+  state = malloc_perror(n, sizeof(unsigned char));
+  memset(state, C_UNVISITED, n);
+  stack_init(&s, sizeof(struct dag_frame), NULL);
+  stack_bound(&s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  for (i = 0; i < n && ret; i++){
+    if (state[i] != C_UNVISITED) continue;
+    state[i] = C_ACTIVE;
+    f.u = i;
+    f.k = 0;
+    stack_push(&s, &f);
+    while (s.num_elts > 0 && ret){
+      stack_pop(&s, &f);
+      while (f.k < a->vt_wts[f.u]->num_elts){
+        v = read_vt(ptr(a->vt_wts[f.u]->elts, f.k, a->pair_size));
+        if (state[v] == C_UNVISITED) break;
+        if (state[v] == C_ACTIVE){
+          ret = 0; /* back edge */
+          break;
+        }
+        f.k++;
+      }
+      if (!ret) break;
+      if (f.k < a->vt_wts[f.u]->num_elts){
+        f.k++;
+        stack_push(&s, &f); /* push the unfinished vertex */
+        state[v] = C_ACTIVE;
+        f.u = v;
+        f.k = 0;
+        stack_push(&s, &f); /* then push an unexplored vertex */
+      }else{
+        state[f.u] = C_FINISHED;
+        top--;
+        write_vt(ptr(order, top, a->vt_size), f.u);
+      }
+    }
+  }
+  stack_free(&s);
+  free(state);
+  state = NULL;
+  return ret;
+}
+
+/**
+   Computes and copies the shortest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, with the number of vertices as the special value in the prev
+   array for unreached vertices. The lists of the reached vertices are
+   relaxed in a topological order in O(num_vts + num_es) time. The weights
+   may be negative.
+   a           : pointer to an adjacency list of a weighted DAG with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   start       : start vertex for running the algorithm
+   order       : pointer to an array of num_vts vt_size blocks with the
+                 vertices in a topological order, e.g. computed by
+                 toposort; the same order can be used across start vertices
+   dist        : pointer to a preallocated array of num_vts wt_size blocks;
+                 if the block pointed to by dist has no declared type then
+                 the effective type of each element corresponding to a
+                 reached vertex is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   prev        : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the block pointed to by prev has no declared type then
+                 it is guaranteed that the effective type of every element
+                 is set to the integer type used to represent vertices by
+                 writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function
+*/
+void dag_sp(const struct adj_lst *a,
+            size_t start,
+            const void *order,
+            void *dist,
+            void *prev,
+            const void *wt_zero,
+            size_t (*read_vt)(const void *),
+            void (*write_vt)(void *, size_t),
+            int (*cmp_wt)(const void *, const void *),
+            void (*add_wt)(void *, const void *, const void *)){
+  paths(a, start, order, dist, prev, wt_zero,
+        read_vt, write_vt, cmp_wt, add_wt, 0);
+}
+
+/**
+   Computes and copies the longest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, according to the specification of dag_sp, where a distance is
+   updated if the new distance is greater according to cmp_wt. On a DAG
+   with task durations as weights, the longest distances are the earliest
+   start times of the tasks after start, and the longest path is a
+   critical path.
+*/
+void dag_lp(const struct adj_lst *a,
+            size_t start,
+            const void *order,
+            void *dist,
+            void *prev,
+            const void *wt_zero,
+            size_t (*read_vt)(const void *),
+            void (*write_vt)(void *, size_t),
+            int (*cmp_wt)(const void *, const void *),
+            void (*add_wt)(void *, const void *, const void *)){
+  paths(a, start, order, dist, prev, wt_zero,
+        read_vt, write_vt, cmp_wt, add_wt, 1);
+}
+
+/**
+   Relaxes the lists of the reached vertices in the topological order,
+   starting at the position of start in the order, where the vertices
+   preceding start are not reachable from start. A distance is updated if
+   the new distance is less, or greater if longest is nonzero.
+*/
+static void paths(const struct adj_lst *a,
+                  size_t start,
+                  const void *order,
+                  void *dist,
+                  void *prev,
+                  const void *wt_zero,
+                  size_t (*read_vt)(const void *),
+                  void (*write_vt)(void *, size_t),
+                  int (*cmp_wt)(const void *, const void *),
+                  void (*add_wt)(void *, const void *, const void *),
+                  int longest){
+  int c;
+  size_t i, k, u, v;
+  size_t n = a->num_vts;
+  const void *p = NULL;
+  void *dp = NULL;
+  void *s = malloc_perror(1, a->wt_size);
+  for (i = 0; i < n; i++){
+    write_vt(ptr(prev, i, a->vt_size), n);
+  }
+  memcpy(ptr(dist, start, a->wt_size), wt_zero, a->wt_size);
+  write_vt(ptr(prev, start, a->vt_size), start);
+  i = 0;
+  while (read_vt(ptr(order, i, a->vt_size)) != start) i++;
+  for (; i < n; i++){
+    u = read_vt(ptr(order, i, a->vt_size));
+    if (read_vt(ptr(prev, u, a->vt_size)) == n) continue;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(p);
+      add_wt(s, ptr(dist, u, a->wt_size), (char *)p + a->wt_offset);
+      dp = ptr(dist, v, a->wt_size);
+      if (read_vt(ptr(prev, v, a->vt_size)) == n){
+        memcpy(dp, s, a->wt_size);
+        write_vt(ptr(prev, v, a->vt_size), u);
+      }else{
+        c = cmp_wt(dp, s);
+        if ((longest && c < 0) || (!longest && c > 0)){
+          memcpy(dp, s, a->wt_size);
+          write_vt(ptr(prev, v, a->vt_size), u);
+        }
+      }
+      p = (char *)p + a->pair_size;
+    }
+  }
+  free(s);
+  s = NULL;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
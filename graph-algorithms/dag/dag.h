@@ -0,0 +1,142 @@
+/**
+   dag.h
+
+   Declarations of accessible functions for computing a topological order
+   of a directed acyclic graph (DAG) with generic integer vertices indexed
+   from 0, and for computing the shortest and longest paths from a start
+   vertex of a DAG with generic weights in linear time.
+
+   The paths are computed by relaxing the lists of the vertices in a
+   topological order, where each list is relaxed once. As a result,
+   distances are computed in O(num_vts + num_es) time instead of the
+   O((num_vts + num_es) log num_vts) time of Dijkstra's algorithm, and
+   negative weights are allowed.
+
+   The effective type of every element in the order and prev arrays is of
+   the integer type used to represent vertices. The value of every element
+   in the prev array is set by the algorithm to the value of the previous
+   vertex, with the number of vertices as the special value for unreached
+   vertices. A distance value in the dist array is only set if the
+   corresponding vertex was reached, as indicated by the prev array, as in
+   dijkstra in dijkstra.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef DAG_H
+#define DAG_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a topological order of the vertices of a directed graph as the
+   reverse DFS postorder in O(num_vts + num_es) time, where the DFS is run
+   from each unvisited vertex in the increasing order of vertices and the
+   recursion is emulated on a dynamically allocated stack. Returns 1 if
+   the graph is acyclic, and 0 if a cycle was found, in which case the
+   content of the order array is undefined. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+   a           : pointer to an adjacency list
+   order       : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the graph is acyclic, the array is set to the vertices
+                 in a topological order, where u precedes v for each (u, v)
+                 edge
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+int toposort(const struct adj_lst *a,
+             void *order,
+             size_t (*read_vt)(const void *),
+             void (*write_vt)(void *, size_t));
+
+/**
+   Computes and copies the shortest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, with the number of vertices as the special value in the prev
+   array for unreached vertices. The lists of the reached vertices are
+   relaxed in a topological order in O(num_vts + num_es) time. The weights
+   may be negative.
+   a           : pointer to an adjacency list of a weighted DAG with at
+                 least one and at most 2**P - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   start       : start vertex for running the algorithm
+   order       : pointer to an array of num_vts vt_size blocks with the
+                 vertices in a topological order, e.g. computed by
+                 toposort; the same order can be used across start vertices
+   dist        : pointer to a preallocated array of num_vts wt_size blocks;
+                 if the block pointed to by dist has no declared type then
+                 the effective type of each element corresponding to a
+                 reached vertex is set to the type of a weight in the
+                 adjacency list by writing a value of the type
+   prev        : pointer to a preallocated array of num_vts vt_size blocks;
+                 if the block pointed to by prev has no declared type then
+                 it is guaranteed that the effective type of every element
+                 is set to the integer type used to represent vertices by
+                 writing a value of the type
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent distances
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument;
+                 if the distribution of weights can result in an overflow,
+                 the user may include an overflow test in the function or
+                 use a provided _perror-suffixed function
+*/
+void dag_sp(const struct adj_lst *a,
+            size_t start,
+            const void *order,
+            void *dist,
+            void *prev,
+            const void *wt_zero,
+            size_t (*read_vt)(const void *),
+            void (*write_vt)(void *, size_t),
+            int (*cmp_wt)(const void *, const void *),
+            void (*add_wt)(void *, const void *, const void *));
+
+/**
+   Computes and copies the longest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to
+   by prev, according to the specification of dag_sp, where a distance is
+   updated if the new distance is greater according to cmp_wt. On a DAG
+   with task durations as weights, the longest distances are the earliest
+   start times of the tasks after start, and the longest path is a
+   critical path.
+*/
+void dag_lp(const struct adj_lst *a,
+            size_t start,
+            const void *order,
+            void *dist,
+            void *prev,
+            const void *wt_zero,
+            size_t (*read_vt)(const void *),
+            void (*write_vt)(void *, size_t),
+            int (*cmp_wt)(const void *, const void *),
+            void (*add_wt)(void *, const void *, const void *));
+
+#endif
@@ -16,11 +16,15 @@
      [0, 1] : on/off for max edges test
      [0, 1] : on/off for no edges test
      [0, 1] : on/off for rand graph test
+     [0, ushort width - 1) : g
+     [0, ushort width - 1) : h s.t. 2**g <= V <= 2**h for bicon test
+     [0, 1] : on/off for bicon test
 
    usage examples:
    ./dfs-test
    ./dfs-test 10 14 10 14 10 14
    ./dfs-test 10 14 10 14 10 14 0 1 1 1
+   ./dfs-test 10 14 10 14 10 14 0 0 0 0 8 12 1
 
    dfs-test can be run with any subset of command line arguments in the
    above-defined order. If the (i + 1)th argument is specified then the ith
@@ -61,8 +65,8 @@
 
 #define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
 
-/* input handling */
-const char *C_USAGE =
+/* input handling; usage is split within the C89/C90 string length limit */
+const char *C_USAGE[2] ={
   "dfs-test\n"
   "[0, ushort width - 1) : a\n"
   "[0, ushort width - 1) : b s.t. 2**a <= V <= 2**b for max edges test\n"
@@ -73,9 +77,13 @@ const char *C_USAGE =
   "[0, 1] : on/off for small graph tests\n"
   "[0, 1] : on/off for max edges test\n"
   "[0, 1] : on/off for no edges test\n"
-  "[0, 1] : on/off for rand graph test\n";
-const int C_ARGC_ULIMIT = 11;
-const size_t C_ARGS_DEF[10] = {0u, 6u, 0u, 6u, 0u, 14u, 1u, 1u, 1u, 1u};
+  "[0, 1] : on/off for rand graph test\n",
+  "[0, ushort width - 1) : g\n"
+  "[0, ushort width - 1) : h s.t. 2**g <= V <= 2**h for bicon test\n"
+  "[0, 1] : on/off for bicon test\n"};
+const int C_ARGC_ULIMIT = 14;
+const size_t C_ARGS_DEF[13] = {0u, 6u, 0u, 6u, 0u, 14u, 1u, 1u, 1u, 1u,
+                               0u, 10u, 1u};
 const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
 
 /* small graph test */
@@ -165,11 +173,28 @@ const double C_PROBS[5] = {1.00, 0.75, 0.50, 0.25, 0.00};
 const double C_PROB_ONE = 1.0;
 const double C_PROB_ZERO = 0.0;
 
+/* biconnectivity tests */
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_BICON_DEGS_COUNT = 3u;
+const double C_BICON_DEGS[3] = {1.0, 2.0, 4.0}; /* E[degree] */
+const size_t C_BICON_REF_NUM_VTS = 2048u; /* removal tests upto the count */
+
 int cmp_arr(const void *a,
             const void *b,
             size_t size,
             size_t n,
             int (*cmp)(const void *, const void *));
+int bicon_check(const struct adj_lst *a,
+                const unsigned char *art,
+                const unsigned char *bridge,
+                const size_t *bcc,
+                size_t num_bcc,
+                int ref,
+                size_t (*read_vt)(const void *));
 void *ptr(const void *block, size_t i, size_t size);
 void print_test_result(int res);
 
@@ -760,6 +785,131 @@ void run_random_dir_graph_helper(size_t num_vts,
   post = NULL;
 }
 
+/**
+   Run a dfs_bicon test on random undirected graphs and on paths.
+*/
+
+/**
+   Runs a dfs_bicon test on random undirected graphs with a low expected
+   degree, where the results are compared with the articulation points and
+   bridges computed by removing each vertex and each edge, if the number
+   of vertices is not greater than C_BICON_REF_NUM_VTS.
+*/
+void run_bicon_rand_graph_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_bcc;
+  size_t *bcc = NULL;
+  unsigned char *art = NULL, *bridge = NULL;
+  struct graph g;
+  struct adj_lst a;
+  struct bern_arg b;
+  clock_t t;
+  printf("Run a dfs_bicon test on random undirected graphs\n");
+  for (i = 0; i < C_BICON_DEGS_COUNT; i++){
+    printf("\tE[degree] = %.1f\n", C_BICON_DEGS[i]);
+    for (j = log_start; j <= log_end; j++){
+      num_vts = pow_two_perror(j);
+      b.p = (num_vts > 1) ? C_BICON_DEGS[i] / (num_vts - 1) : C_PROB_ZERO;
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      art = malloc_perror(num_vts, sizeof(unsigned char));
+      for (k = 0; k < C_FN_COUNT; k++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[k], 0);
+        adj_lst_base_init(&a, &g);
+        adj_lst_rand_undir(&a, C_WRITE[k], bern, &b);
+        /* at least one element for the case without edges */
+        bridge = malloc_perror(a.num_es + 1, sizeof(unsigned char));
+        bcc = malloc_perror(a.num_es + 1, sizeof(size_t));
+        t = clock();
+        num_bcc = dfs_bicon(&a, art, bridge, bcc, C_READ[k]);
+        t = clock() - t;
+        printf("\t\t\t%s runtime:         %.6f seconds, "
+               "components: %lu\n",
+               C_VT_TYPES[k], (double)t / CLOCKS_PER_SEC, TOLU(num_bcc));
+        res *= bicon_check(&a, art, bridge, bcc, num_bcc,
+                           (num_vts <= C_BICON_REF_NUM_VTS), C_READ[k]);
+        adj_lst_free(&a);
+        free(bridge);
+        free(bcc);
+        bridge = NULL;
+        bcc = NULL;
+      }
+      free(art);
+      art = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Runs a dfs_bicon test on paths of num_vts vertices with a loop at the
+   last vertex and two edges between the vertices 0 and 1, where the
+   depth of the DFS from the vertex 0 is num_vts - 1.
+*/
+void run_bicon_path_graph_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, u, v, m;
+  size_t num_vts, num_bcc;
+  size_t *bcc = NULL;
+  unsigned char *art = NULL, *bridge = NULL;
+  const char *p = NULL;
+  struct graph g;
+  struct adj_lst a;
+  struct bern_arg b;
+  clock_t t;
+  b.p = C_PROB_ONE;
+  printf("Run a dfs_bicon test on paths\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    art = malloc_perror(num_vts, sizeof(unsigned char));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      for (u = 0; u + 1 < num_vts; u++){
+        adj_lst_add_undir_edge(&a, u, u + 1, NULL, C_WRITE[j], bern, &b);
+      }
+      if (num_vts > 1){
+        adj_lst_add_undir_edge(&a, 0, 1, NULL, C_WRITE[j], bern, &b);
+      }
+      adj_lst_add_dir_edge(&a, num_vts - 1, num_vts - 1, NULL,
+                           C_WRITE[j], bern, &b);
+      bridge = malloc_perror(a.num_es, sizeof(unsigned char));
+      bcc = malloc_perror(a.num_es, sizeof(size_t));
+      t = clock();
+      num_bcc = dfs_bicon(&a, art, bridge, bcc, C_READ[j]);
+      t = clock() - t;
+      printf("\t\t\t%s runtime:         %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (num_bcc == num_vts - 1);
+      for (u = 0, m = 0; u < num_vts; u++){
+        res *= (art[u] == (u > 0 && u + 1 < num_vts));
+        p = a.vt_wts[u]->elts;
+        for (k = 0; k < a.vt_wts[u]->num_elts; k++, m++){
+          v = C_READ[j](p);
+          p += a.pair_size;
+          if (u == v){
+            res *= (bridge[m] == 0 && bcc[m] == a.num_es);
+          }else{
+            res *= (bridge[m] == (u + v > 1) && bcc[m] < num_bcc);
+          }
+        }
+      }
+      adj_lst_free(&a);
+      free(bridge);
+      free(bcc);
+      bridge = NULL;
+      bcc = NULL;
+    }
+    free(art);
+    art = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
 /**
    Auxiliary functions.
 */
@@ -784,6 +934,162 @@ int cmp_arr(const void *a,
   return res;
 }
 
+/**
+   Returns the number of vertices reached by a BFS from the vertex u. If
+   y is less than num_vts, then the first pair with y in the list of x and
+   the first pair with x in the list of y are not used. Otherwise the
+   vertex x is not visited if x is less than num_vts. Reached vertices are
+   set to 1 in seen.
+*/
+size_t bicon_bfs(const struct adj_lst *a,
+                 size_t u,
+                 size_t x,
+                 size_t y,
+                 size_t *queue,
+                 unsigned char *seen,
+                 size_t (*read_vt)(const void *)){
+  int skip_xy = 0, skip_yx = 0;
+  size_t i, k, v, w, num = 1;
+  const char *p = NULL;
+  memset(seen, 0, a->num_vts);
+  seen[u] = 1;
+  queue[0] = u;
+  if (y == a->num_vts && x < a->num_vts) seen[x] = 1;
+  for (i = 0; i < num; i++){
+    v = queue[i];
+    p = a->vt_wts[v]->elts;
+    for (k = 0; k < a->vt_wts[v]->num_elts; k++){
+      w = read_vt(p);
+      p += a->pair_size;
+      if (v == x && w == y && !skip_xy){
+        skip_xy = 1;
+      }else if (v == y && w == x && !skip_yx){
+        skip_yx = 1;
+      }else if (!seen[w]){
+        seen[w] = 1;
+        queue[num++] = w;
+      }
+    }
+  }
+  return num;
+}
+
+/**
+   Tests the results of dfs_bicon on an undirected graph. If ref is
+   non-zero, an articulation point and a bridge are tested by removing the
+   vertex and the edge. Each component is tested to be a component of the
+   block-cut tree:
+   - the pairs of an edge are in the same component,
+   - a vertex is an articulation point iff it is in more than one
+   component,
+   - an edge is a bridge iff its component has two pairs, and
+   - the number of components equals the number of connected components
+   with an edge that is not a loop, plus the sum of the number of the
+   components of each vertex minus one.
+*/
+int bicon_check(const struct adj_lst *a,
+                const unsigned char *art,
+                const unsigned char *bridge,
+                const size_t *bcc,
+                size_t num_bcc,
+                int ref,
+                size_t (*read_vt)(const void *)){
+  int res = 1, found;
+  size_t i, k, l, u, v, w, num_rch, num_cc = 0, sum = 0;
+  size_t n = a->num_vts;
+  size_t *queue = NULL, *cnt = NULL, *mark = NULL, *first = NULL;
+  unsigned char *seen = NULL, *cc = NULL;
+  const char *p = NULL, *q = NULL;
+  queue = malloc_perror(n, sizeof(size_t));
+  first = malloc_perror(n, sizeof(size_t));
+  seen = malloc_perror(n, sizeof(unsigned char));
+  cc = calloc_perror(n, sizeof(unsigned char));
+  cnt = calloc_perror(num_bcc + 1, sizeof(size_t));
+  mark = malloc_perror(num_bcc + 1, sizeof(size_t));
+  for (i = 0; i <= num_bcc; i++){
+    mark[i] = n;
+  }
+  for (u = 0, i = 0; u < n; u++){
+    first[u] = i;
+    i += a->vt_wts[u]->num_elts;
+  }
+  for (u = 0; u < n; u++){
+    /* reference articulation point by removing u */
+    p = a->vt_wts[u]->elts;
+    for (k = 0, w = u; k < a->vt_wts[u]->num_elts && w == u; k++){
+      w = read_vt(p);
+      p += a->pair_size;
+    }
+    found = 0;
+    if (ref && w != u){
+      bicon_bfs(a, w, u, n, queue, seen, read_vt);
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        found += !seen[read_vt(p)];
+        p += a->pair_size;
+      }
+    }
+    if (ref) res *= (art[u] == (found > 0));
+    /* reference bridges by removing an edge, and components of pairs */
+    if (w != u && !cc[u]){
+      num_rch = bicon_bfs(a, u, n, n, queue, seen, read_vt);
+      for (l = 0; l < num_rch; l++){
+        cc[queue[l]] = 1;
+      }
+      num_cc++;
+    }
+    l = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(p);
+      p += a->pair_size;
+      i = first[u] + k;
+      if (u == v){
+        res *= (bridge[i] == 0 && bcc[i] == a->num_es);
+        continue;
+      }
+      if (bcc[i] >= num_bcc) return 0;
+      cnt[bcc[i]]++;
+      if (mark[bcc[i]] != u){
+        mark[bcc[i]] = u;
+        l++;
+      }
+      if (ref){
+        bicon_bfs(a, u, u, v, queue, seen, read_vt);
+        res *= (bridge[i] == !seen[v]);
+      }
+      found = 0;
+      q = a->vt_wts[v]->elts;
+      for (w = 0; w < a->vt_wts[v]->num_elts && !found; w++){
+        found = (read_vt(q) == u && bcc[first[v] + w] == bcc[i]);
+        q += a->pair_size;
+      }
+      res *= found;
+    }
+    res *= (art[u] == (l > 1));
+    if (l > 0) sum += l - 1;
+  }
+  for (u = 0, i = 0; u < n; u++){
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++, i++){
+      if (bcc[i] < num_bcc) res *= (bridge[i] == (cnt[bcc[i]] == 2));
+    }
+  }
+  res *= (num_bcc == num_cc + sum);
+  free(queue);
+  free(first);
+  free(seen);
+  free(cc);
+  free(cnt);
+  free(mark);
+  queue = NULL;
+  first = NULL;
+  seen = NULL;
+  cc = NULL;
+  cnt = NULL;
+  mark = NULL;
+  return res;
+}
+
 /**
    Computes a pointer to the ith element in the block of elements.
 */
@@ -807,7 +1113,7 @@ int main(int argc, char *argv[]){
   size_t *args = NULL;
   RGENS_SEED();
   if (argc > C_ARGC_ULIMIT){
-    printf("USAGE:\n%s", C_USAGE);
+    printf("USAGE:\n%s%s", C_USAGE[0], C_USAGE[1]);
     exit(EXIT_FAILURE);
   }
   args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
@@ -827,8 +1133,12 @@ int main(int argc, char *argv[]){
       args[6] > 1 ||
       args[7] > 1 ||
       args[8] > 1 ||
-      args[9] > 1){
-    printf("USAGE:\n%s", C_USAGE);
+      args[9] > 1 ||
+      args[10] > C_USHORT_BIT - 2 ||
+      args[11] > C_USHORT_BIT - 2 ||
+      args[11] < args[10] ||
+      args[12] > 1){
+    printf("USAGE:\n%s%s", C_USAGE[0], C_USAGE[1]);
     exit(EXIT_FAILURE);
   }
   if (args[6]){
@@ -838,6 +1148,10 @@ int main(int argc, char *argv[]){
   if (args[7]) run_max_edges_graph_test(args[0], args[1]);
   if (args[8]) run_no_edges_graph_test(args[2], args[3]);
   if (args[9]) run_random_dir_graph_test(args[4], args[5]);
+  if (args[12]){
+    run_bicon_rand_graph_test(args[10], args[11]);
+    run_bicon_path_graph_test(args[10], args[11]);
+  }
   free(args);
   args = NULL;
   return 0;
@@ -11,6 +11,11 @@
    the cache efficiency and reduce the space requirement*, depending on
    the system and the choice of the integer type for representing vertices.
 
+   dfs_bicon computes the articulation points, the bridges, and the
+   biconnected components of an undirected graph with low-link values, and
+   also emulates the recursion in DFS on a dynamically allocated stack, so
+   that graphs with long paths can be processed.
+
    The effective type of every element in the previsit and postvisit arrays
    is of the integer type used to represent vertices. The value of every
    element is set by the algorithm. If the block pointed to by pre or post
@@ -42,6 +47,12 @@
 
 static const size_t C_STACK_INIT_COUNT = 1;
 
+struct bicon_frame{
+  size_t u;
+  size_t k;  /* index of the next pair in the list of u */
+  int skip;  /* non-zero after a pair with the parent of u is skipped */
+};
+
 static void dfs_helper(const struct adj_lst *a,
                        size_t start,
                        size_t vt_alignment,
@@ -173,6 +184,155 @@ void dfs_align(const struct adj_lst *a,
              incr_vt);
 }
 
+/**
+   Computes the articulation points, the bridges, and the biconnected
+   components of an undirected graph with low-link values in a single
+   pass of DFS over all vertices, where the recursion is emulated on a
+   stack of (vertex, list position) frames. The low-link value of a
+   vertex v is the least previsit value reached from the subtree of v by
+   one back edge. A pair with the parent of v is skipped once in the
+   list of v, so that multiple edges between the same vertices form a
+   biconnected component. The vertices of an explored subtree are kept
+   on a second stack and are popped when the subtree is found to be a
+   biconnected component together with its parent. Runs in
+   O(num_vts + num_es) time and O(num_vts) space. Returns the number of
+   biconnected components with at least one edge that is not a loop.
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   art         : - NULL pointer, if articulation points are not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 elements, where the element at the index u is set to 1
+                 if u is an articulation point, and to 0 otherwise
+   bridge      : - NULL pointer, if bridges are not computed
+                 - otherwise pointer to a preallocated array of num_es
+                 elements, where the ith element corresponds to the ith
+                 pair in the order of the lists of the vertices 0, 1, ...,
+                 num_vts - 1, and is set to 1 if the edge of the pair is a
+                 bridge, and to 0 otherwise
+   bcc         : - NULL pointer, if biconnected components are not computed
+                 - otherwise pointer to a preallocated array of num_es
+                 size_t elements, where the ith element corresponds to the
+                 ith pair in the order of bridge, and is set to the index
+                 of the biconnected component of the edge of the pair in
+                 [0, number of biconnected components), or to num_es if
+                 the pair is a loop
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t dfs_bicon(const struct adj_lst *a,
+                 unsigned char *art,
+                 unsigned char *bridge,
+                 size_t *bcc,
+                 size_t (*read_vt)(const void *)){
+  size_t i, k, u, v = 0, x, y, n = a->num_vts;
+  size_t cnt = 0, top = 0, num_ch, ret = 0;
+  size_t *pre = NULL, *low = NULL, *parent = NULL, *comp = NULL;
+  size_t *vts = NULL;
+  const char *p = NULL;
+  struct bicon_frame f;
+  struct stack s;
+  if (n == 0) return 0;
+  /* arrays in single block; n is the special value in pre and parent */
+  pre = malloc_perror(mul_sz_perror(5, n), sizeof(size_t));
+  low = pre + n;
+  parent = low + n;
+  comp = parent + n;
+  vts = comp + n;
+  for (u = 0; u < n; u++){
+    pre[u] = n;
+  }
+  if (art != NULL) memset(art, 0, n);
+  stack_init(&s, sizeof(struct bicon_frame), NULL);
+  stack_bound(&s, C_STACK_INIT_COUNT, n);
+  for (i = 0; i < n; i++){
+    if (pre[i] != n) continue;
+    pre[i] = cnt;
+    low[i] = cnt++;
+    parent[i] = n;
+    num_ch = 0;
+    f.u = i;
+    f.k = 0;
+    f.skip = 0;
+    stack_push(&s, &f);
+    while (s.num_elts > 0){
+      stack_pop(&s, &f);
+      u = f.u;
+      p = ptr(a->vt_wts[u]->elts, f.k, a->pair_size);
+      /* iterate v across the u's list and update the low-link of u */
+      for (; f.k < a->vt_wts[u]->num_elts; f.k++, p += a->pair_size){
+        v = read_vt(p);
+        if (v == parent[u] && !f.skip){
+          f.skip = 1;
+        }else if (pre[v] == n){
+          break;
+        }else if (pre[v] < low[u]){
+          low[u] = pre[v];
+        }
+      }
+      if (f.k < a->vt_wts[u]->num_elts){
+        f.k++;
+        stack_push(&s, &f); /* push the unfinished vertex */
+        pre[v] = cnt;
+        low[v] = cnt++;
+        parent[v] = u;
+        vts[top++] = v;
+        f.u = v;
+        f.k = 0;
+        f.skip = 0;
+        stack_push(&s, &f); /* then push an unexplored vertex */
+      }else if (parent[u] != n){
+        x = parent[u];
+        if (low[u] < low[x]) low[x] = low[u];
+        if (low[u] >= pre[x]){
+          /* x separates the subtree of u, which is on top of vts */
+          if (x == i){
+            num_ch++;
+          }else if (art != NULL){
+            art[x] = 1;
+          }
+          do{
+            comp[vts[--top]] = ret;
+          }while (vts[top] != u);
+          ret++;
+        }
+      }
+    }
+    if (art != NULL && num_ch > 1) art[i] = 1;
+  }
+  /* a non-loop edge is in the component of the tree edge of its end
+     vertex with the greater previsit value */
+  if (bridge != NULL || bcc != NULL){
+    for (u = 0, i = 0; u < n; u++){
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++, i++){
+        v = read_vt(p);
+        p += a->pair_size;
+        if (pre[u] < pre[v]){
+          x = u;
+          y = v;
+        }else{
+          x = v;
+          y = u;
+        }
+        if (bridge != NULL){
+          bridge[i] = (u != v && parent[y] == x && low[y] > pre[x]);
+        }
+        if (bcc != NULL) bcc[i] = (u == v) ? a->num_es : comp[y];
+      }
+    }
+  }
+  stack_free(&s);
+  free(pre);
+  pre = NULL;
+  low = NULL;
+  parent = NULL;
+  comp = NULL;
+  vts = NULL;
+  return ret;
+}
+
 static void dfs_helper(const struct adj_lst *a,
                        size_t start,
                        size_t vt_alignment,
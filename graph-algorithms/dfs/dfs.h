@@ -12,6 +12,11 @@
    the cache efficiency and reduce the space requirement*, depending on
    the system and the choice of the integer type for representing vertices.
 
+   dfs_bicon computes the articulation points, the bridges, and the
+   biconnected components of an undirected graph with low-link values, and
+   also emulates the recursion in DFS on a dynamically allocated stack, so
+   that graphs with long paths can be processed.
+
    The effective type of every element in the previsit and postvisit arrays
    is of the integer type used to represent vertices. The value of every
    element is set by the algorithm. If the block pointed to by pre or post
@@ -121,4 +126,47 @@ void dfs_align(const struct adj_lst *a,
                int (*cmp_vt)(const void *, const void *),
                void (*incr_vt)(void *));
 
+/**
+   Computes the articulation points, the bridges, and the biconnected
+   components of an undirected graph with low-link values in a single
+   pass of DFS over all vertices, where the recursion is emulated on a
+   stack of (vertex, list position) frames. The low-link value of a
+   vertex v is the least previsit value reached from the subtree of v by
+   one back edge. A pair with the parent of v is skipped once in the
+   list of v, so that multiple edges between the same vertices form a
+   biconnected component. The vertices of an explored subtree are kept
+   on a second stack and are popped when the subtree is found to be a
+   biconnected component together with its parent. Runs in
+   O(num_vts + num_es) time and O(num_vts) space. Returns the number of
+   biconnected components with at least one edge that is not a loop.
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   art         : - NULL pointer, if articulation points are not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 elements, where the element at the index u is set to 1
+                 if u is an articulation point, and to 0 otherwise
+   bridge      : - NULL pointer, if bridges are not computed
+                 - otherwise pointer to a preallocated array of num_es
+                 elements, where the ith element corresponds to the ith
+                 pair in the order of the lists of the vertices 0, 1, ...,
+                 num_vts - 1, and is set to 1 if the edge of the pair is a
+                 bridge, and to 0 otherwise
+   bcc         : - NULL pointer, if biconnected components are not computed
+                 - otherwise pointer to a preallocated array of num_es
+                 size_t elements, where the ith element corresponds to the
+                 ith pair in the order of bridge, and is set to the index
+                 of the biconnected component of the edge of the pair in
+                 [0, number of biconnected components), or to num_es if
+                 the pair is a loop
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t dfs_bicon(const struct adj_lst *a,
+                 unsigned char *art,
+                 unsigned char *bridge,
+                 size_t *bcc,
+                 size_t (*read_vt)(const void *));
+
 #endif
@@ -8,10 +8,14 @@
    dfs-test-perf-ulong
      [0, ulong width - 1) : a
      [0, ulong width - 1) : b s.t. 2**a <= V <= 2**b or rand graph test
+     [0, 1] : on/off rand graph test
+     path : optional path of a .gr (DIMACS), .graph (METIS), or .mtx
+            (Matrix Market) file for a file graph test
 
    usage examples:
    ./dfs-test-perf-ulong
    ./dfs-test-perf-ulong 10 14
+   ./dfs-test-perf-ulong 0 0 0 USA-road-d.NY.gr
 
    dfs-test-perf-ulong can be run with any subset of command line arguments
    in the above-defined order. If the (i + 1)th argument is specified then
@@ -30,9 +34,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <math.h>
 #include <time.h>
 #include "dfs.h"
 #include "graph.h"
+#include "graph-io.h"
 #include "stack.h"
 #include "utilities-mem.h"
 #include "utilities-mod.h"
@@ -46,7 +52,6 @@
 */
 #define RGENS_SEED() do{srand(time(NULL));}while (0)
 #define RANDOM() (rand()) /* [0, RAND_MAX] */
-#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
 
 #define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
 
@@ -54,9 +59,12 @@
 const char *C_USAGE =
   "dfs-test-perf-ulong\n"
   "[0, ulong width - 1) : a\n"
-  "[0, ulong width - 1) : b s.t. 2**a <= V <= 2**b for rand graph test\n";
-const int C_ARGC_ULIMIT = 3;
-const size_t C_ARGS_DEF[2] = {14u, 14u};
+  "[0, ulong width - 1) : b s.t. 2**a <= V <= 2**b for rand graph test\n"
+  "[0, 1] : on/off rand graph test\n"
+  "path : optional path of a .gr, .graph, or .mtx file for file graph "
+  "test\n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[3] = {14u, 14u, 1u};
 const size_t C_ULONG_BIT = PRECISION_FROM_ULIMIT((unsigned long)-1);
 
 /* random graph tests */
@@ -99,19 +107,22 @@ const double C_PROB_ONE = 1.0;
 const double C_PROB_ZERO = 0.0;
 
 /**
-   Run a dfs test on random directed graphs.
+   Run a dfs test on random directed graphs generated by geometric
+   skipping.
 */
 
 struct bern_arg{
   double p;
 };
 
-int bern(void *arg){
+size_t geo(void *arg){
+  double k;
   struct bern_arg *b = arg;
-  if (b->p >= C_PROB_ONE) return 1;
-  if (b->p <= C_PROB_ZERO) return 0;
-  if (b->p > DRAND()) return 1;
-  return 0;
+  if (b->p >= C_PROB_ONE) return 0;
+  if (b->p <= C_PROB_ZERO) return (size_t)-1;
+  k = floor(log((RANDOM() + 1.0) / (RAND_MAX + 1.0)) / log(1.0 - b->p));
+  if (k >= (double)((size_t)-1)) return (size_t)-1;
+  return k;
 }
 
 void run_random_dir_graph_helper(size_t num_vts,
@@ -122,7 +133,7 @@ void run_random_dir_graph_helper(size_t num_vts,
                                  void *(*at_vt)(const void *, const void *),
                                  int (*cmp_vt)(const void *, const void *),
                                  void (*incr_vt)(void *),
-                                 int bern(void *),
+                                 size_t geo(void *),
                                  struct bern_arg *b);
 
 void run_random_dir_graph_test(size_t log_start, size_t log_end){
@@ -146,7 +157,7 @@ void run_random_dir_graph_test(size_t log_start, size_t log_end){
                                   C_AT[2],
                                   C_CMPEQ[2],
                                   C_INCR[2],
-                                  bern,
+                                  geo,
                                   &b);
     }
   }
@@ -160,7 +171,7 @@ void run_random_dir_graph_helper(size_t num_vts,
                                  void *(*at_vt)(const void *, const void *),
                                  int (*cmp_vt)(const void *, const void *),
                                  void (*incr_vt)(void *),
-                                 int bern(void *),
+                                 size_t geo(void *),
                                  struct bern_arg *b){
   size_t i;
   size_t *start = NULL;
@@ -174,7 +185,7 @@ void run_random_dir_graph_helper(size_t num_vts,
   post = malloc_perror(num_vts, vt_size);
   graph_base_init(&g, num_vts, vt_size, 0);
   adj_lst_base_init(&a, &g);
-  adj_lst_rand_dir(&a, write_vt, bern, b);
+  adj_lst_rand_dir_geo(&a, write_vt, geo, b);
   for (i = 0; i < C_ITER; i++){
     start[i] =  RANDOM() % num_vts;
   }
@@ -194,26 +205,78 @@ void run_random_dir_graph_helper(size_t num_vts,
   post = NULL;
 }
 
+/**
+   Run a dfs test on a graph read from a file.
+*/
+void run_file_graph_test(const char *path){
+  size_t i;
+  size_t *start = NULL;
+  void *pre = NULL, *post = NULL;
+  struct adj_lst a;
+  clock_t t;
+  printf("Run a dfs test on a graph from a file from %lu random "
+         "start vertices\n", TOLU(C_ITER));
+  printf("\t%s\n", path);
+  t = clock();
+  adj_lst_file_build(&a, path, C_VT_SIZES[2], 0, C_WRITE[2], NULL);
+  t = clock() - t;
+  printf("\t\tvertices: %lu, directed edges: %lu\n",
+         TOLU(a.num_vts), TOLU(a.num_es));
+  printf("\t\t\t%s build time:      %.6f seconds\n",
+         C_VT_TYPES[2], (double)t / CLOCKS_PER_SEC);
+  if (a.num_vts == 0 || a.num_vts - 1 > (unsigned long)-1){
+    printf("\t\t\tno vertices or vertices not representable\n");
+    adj_lst_free(&a);
+    return;
+  }
+  /* no declared type after malloc; effective type is set by dfs */
+  start = malloc_perror(C_ITER, sizeof(size_t));
+  pre = malloc_perror(a.num_vts, C_VT_SIZES[2]);
+  post = malloc_perror(a.num_vts, C_VT_SIZES[2]);
+  for (i = 0; i < C_ITER; i++){
+    start[i] = RANDOM() % a.num_vts;
+  }
+  t = clock();
+  for (i = 0; i < C_ITER; i++){
+    dfs(&a, start[i], pre, post,
+        C_READ[2], C_WRITE[2], C_AT[2], C_CMPEQ[2], C_INCR[2]);
+  }
+  t = clock() - t;
+  printf("\t\t\t%s ave runtime:     %.6f seconds\n",
+         C_VT_TYPES[2], (double)t / C_ITER / CLOCKS_PER_SEC);
+  adj_lst_free(&a);
+  free(start);
+  free(pre);
+  free(post);
+  start = NULL;
+  pre = NULL;
+  post = NULL;
+}
+
 int main(int argc, char *argv[]){
   int i;
   size_t *args = NULL;
+  const char *path = NULL;
   RGENS_SEED();
   if (argc > C_ARGC_ULIMIT){
     printf("USAGE:\n%s", C_USAGE);
     exit(EXIT_FAILURE);
   }
-  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
-  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
-  for (i = 1; i < argc; i++){
+  args = malloc_perror(C_ARGC_ULIMIT - 2, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 2) * sizeof(size_t));
+  for (i = 1; i < argc && i < C_ARGC_ULIMIT - 1; i++){
     args[i - 1] = atoi(argv[i]);
   }
+  if (argc == C_ARGC_ULIMIT) path = argv[C_ARGC_ULIMIT - 1];
   if (args[0] > C_ULONG_BIT - 1 ||
       args[1] > C_ULONG_BIT - 1 ||
-      args[1] < args[0]){
+      args[1] < args[0] ||
+      args[2] > 1){
     printf("USAGE:\n%s", C_USAGE);
     exit(EXIT_FAILURE);
   }
-  run_random_dir_graph_test(args[0], args[1]);
+  if (args[2]) run_random_dir_graph_test(args[0], args[1]);
+  if (path != NULL) run_file_graph_test(path);
   free(args);
   args = NULL;
   return 0;
@@ -1150,13 +1150,14 @@ void run_rand_test(size_t log_start, size_t log_end){
   void *dsum_def = NULL, *dsum_divchn = NULL, *dsum_muloa = NULL;
   void *dist_def = NULL, *dist_divchn = NULL, *dist_muloa = NULL;
   void *prev_def = NULL, *prev_divchn = NULL, *prev_muloa = NULL;
+  void *dist_dense = NULL, *prev_dense = NULL;
   struct graph g;
   struct adj_lst a;
   struct bern_arg b;
   struct ht_divchn ht_divchn;
   struct ht_muloa ht_muloa;
   struct dijkstra_ht daht_divchn, daht_muloa;
-  clock_t t_def, t_divchn, t_muloa;
+  clock_t t_def, t_divchn, t_muloa, t_dense;
   rand_start = malloc_perror(C_ITER, sizeof(size_t));
   daht_divchn.ht = &ht_divchn;
   daht_divchn.alpha_n = C_ALPHA_N_DIVCHN;
@@ -1215,9 +1216,11 @@ void run_rand_test(size_t log_start, size_t log_end){
           prev_def = realloc_perror(prev_def, num_vts, vt_size);
           prev_divchn = realloc_perror(prev_divchn, num_vts, vt_size);
           prev_muloa = realloc_perror(prev_muloa, num_vts, vt_size);
+          prev_dense = realloc_perror(prev_dense, num_vts, vt_size);
           dist_def = realloc_perror(dist_def, num_vts, wt_size);
           dist_divchn = realloc_perror(dist_divchn, num_vts, wt_size);
           dist_muloa = realloc_perror(dist_muloa, num_vts, wt_size);
+          dist_dense = realloc_perror(dist_dense, num_vts, wt_size);
           C_SET_ZERO[k](wt_l);
           C_SET_TEST_ULIMIT[k](wt_h, pow_two_perror(log_end));
           C_SET_ZERO[k](wt_zero);
@@ -1226,6 +1229,7 @@ void run_rand_test(size_t log_start, size_t log_end){
             C_SET_ZERO[k](ptr(dist_def, l, wt_size));
             C_SET_ZERO[k](ptr(dist_divchn, l, wt_size));
             C_SET_ZERO[k](ptr(dist_muloa, l, wt_size));
+            C_SET_ZERO[k](ptr(dist_dense, l, wt_size));
           }
           graph_base_init(&g, num_vts, vt_size, wt_size);
           adj_lst_rand_dir_wts(&g, &a, wt_l, wt_h,
@@ -1274,6 +1278,26 @@ void run_rand_test(size_t log_start, size_t log_end){
                      C_CMP_VT[j], C_CMP_WT[k], C_ADD_WT[k]);
           }
           t_muloa = clock() - t_muloa;
+          t_dense = clock();
+          for (l = 0; l < C_ITER; l++){
+            dijkstra_dense(&a, rand_start[l], dist_dense, prev_dense,
+                           wt_zero, C_READ_VT[j], C_WRITE_VT[j], C_AT_VT[j],
+                           C_CMP_WT[k], C_ADD_WT[k]);
+          }
+          t_dense = clock() - t_dense;
+          /* compared with a heap, since dijkstra with NULL may call
+             dijkstra_dense; ties may result in different previous
+             vertices */
+          for (l = 0; l < num_vts; l++){
+            res *= ((C_READ_VT[j](ptr(prev_divchn, l, vt_size)) ==
+                     num_vts) ==
+                    (C_READ_VT[j](ptr(prev_dense, l, vt_size)) == num_vts));
+            if (k < C_FN_INTEGRAL_WT_COUNT &&
+                C_READ_VT[j](ptr(prev_divchn, l, vt_size)) < num_vts){
+              res *= (C_CMP_WT[k](ptr(dist_divchn, l, wt_size),
+                                  ptr(dist_dense, l, wt_size)) == 0);
+            }
+          }
           C_SUM_DIST[k](dsum_muloa,
                         wsum_muloa,
                         &num_dwraps_muloa,
@@ -1299,13 +1323,16 @@ void run_rand_test(size_t log_start, size_t log_end){
           printf("\t\t\t# edges: %lu\n", TOLU(a.num_es));
           printf("\t\t\t\t%s %s dijkstra default ht:     %.8f seconds\n"
                  "\t\t\t\t%s %s dijkstra ht_divchn:      %.8f seconds\n"
-                 "\t\t\t\t%s %s dijkstra ht_muloa:       %.8f seconds\n",
+                 "\t\t\t\t%s %s dijkstra ht_muloa:       %.8f seconds\n"
+                 "\t\t\t\t%s %s dijkstra_dense:          %.8f seconds\n",
                  C_VT_TYPES[j], C_WT_TYPES[k],
                  (double)t_def / C_ITER / CLOCKS_PER_SEC,
                  C_VT_TYPES[j], C_WT_TYPES[k],
                  (double)t_divchn / C_ITER / CLOCKS_PER_SEC,
                  C_VT_TYPES[j], C_WT_TYPES[k],
-                 (double)t_muloa / C_ITER / CLOCKS_PER_SEC);
+                 (double)t_muloa / C_ITER / CLOCKS_PER_SEC,
+                 C_VT_TYPES[j], C_WT_TYPES[k],
+                 (double)t_dense / C_ITER / CLOCKS_PER_SEC);
           printf("\t\t\t\t%s %s correctness:             ",
                  C_VT_TYPES[j], C_WT_TYPES[k]);
           print_test_result(res);
@@ -1339,6 +1366,8 @@ void run_rand_test(size_t log_start, size_t log_end){
   free(prev_def);
   free(prev_divchn);
   free(prev_muloa);
+  free(dist_dense);
+  free(prev_dense);
   rand_start = NULL;
   wt_l = NULL;
   wt_h = NULL;
@@ -1355,6 +1384,8 @@ void run_rand_test(size_t log_start, size_t log_end){
   prev_def = NULL;
   prev_divchn = NULL;
   prev_muloa = NULL;
+  dist_dense = NULL;
+  prev_dense = NULL;
 }
 
 /**
@@ -16,6 +16,12 @@
    the computation of hash values. If V is large and the graph is sparse,
    a non-default hash table may provide space advantages.
 
+   If NULL is passed as a hash table parameter value and a graph is nearly
+   complete, dijkstra calls dijkstra_dense, where the vertex with the
+   lowest distance is found by an array scan instead of a heap. A non-NULL
+   hash table parameter value always results in a heap with the specified
+   hash table.
+
    The effective type of every element in the prev array is of the integer
    type used to represent vertices. The value of every element is set
    by the algorithm to the value of the previous vertex. If the block
@@ -56,6 +62,7 @@
 #include "utilities-mem.h"
 
 static const size_t C_HEAP_INIT_COUNT = 1;
+static const size_t C_DENSE_DIV = 4u; /* num_es >= 3/4 * num_vts**2 */
 
 struct ht_def{
   size_t absent;
@@ -71,6 +78,18 @@ static void *ht_def_search(const void *ht, const void *vt);
 static void ht_def_remove(void *ht, const void *vt, void *ix);
 static void ht_def_free(void *ht);
 
+static void dijkstra_heap(const struct adj_lst *a,
+                          size_t start,
+                          void *dist,
+                          void *prev,
+                          const void *wt_zero,
+                          const struct dijkstra_ht *daht,
+                          size_t (*read_vt)(const void *),
+                          void (*write_vt)(void *, size_t),
+                          void *(*at_vt)(const void *, const void *),
+                          int (*cmp_vt)(const void *, const void *),
+                          int (*cmp_wt)(const void *, const void *),
+                          void (*add_wt)(void *, const void *, const void *));
 static size_t compute_wt_offset_perror(const struct adj_lst *a);
 static void *ptr(const void *block, size_t i, size_t size);
 
@@ -105,7 +124,8 @@ static void *ptr(const void *block, size_t i, size_t size);
                  the type used to represent distances
    daht        : - NULL pointer, if a default hash table is used for
                  in-heap operations; a default hash table contains an index
-                 array with a count that is equal to the number of vertices
+                 array with a count that is equal to the number of vertices;
+                 on nearly complete graphs dijkstra_dense is called instead
                  - a pointer to a set of parameters specifying a hash table
                  used for in-heap operations
    read_vt     : reads the integer value of the type used to represent
@@ -150,6 +170,133 @@ void dijkstra(const struct adj_lst *a,
               int (*cmp_vt)(const void *, const void *),
               int (*cmp_wt)(const void *, const void *),
               void (*add_wt)(void *, const void *, const void *)){
+  if (daht == NULL &&
+      a->num_es / a->num_vts >= a->num_vts - a->num_vts / C_DENSE_DIV){
+    dijkstra_dense(a, start, dist, prev, wt_zero,
+                   read_vt, write_vt, at_vt, cmp_wt, add_wt);
+  }else{
+    dijkstra_heap(a, start, dist, prev, wt_zero, daht,
+                  read_vt, write_vt, at_vt, cmp_vt, cmp_wt, add_wt);
+  }
+}
+
+/**
+   Computes and copies the shortest distances from start to the array
+   pointed to by dist, and the previous vertices to the array pointed to by
+   prev, as dijkstra, where the vertex with the lowest distance is found by
+   a scan of a contiguous array of the distances that are not final,
+   instead of a heap. Runs in O(num_vts**2 + num_es) time regardless of
+   the number of distance updates, whereas a heap update takes
+   O(log num_vts) time. Called by dijkstra on nearly complete graphs with
+   num_es >= 3/4 * num_vts**2 (approximately) if the hash table parameter
+   is NULL. Please see the parameter specification in dijkstra.
+*/
+void dijkstra_dense(const struct adj_lst *a,
+                    size_t start,
+                    void *dist,
+                    void *prev,
+                    const void *wt_zero,
+                    size_t (*read_vt)(const void *),
+                    void (*write_vt)(void *, size_t),
+                    void *(*at_vt)(const void *, const void *),
+                    int (*cmp_wt)(const void *, const void *),
+                    void (*add_wt)(void *, const void *, const void *)){
+  size_t i, m, v;
+  size_t num_open = 1;
+  size_t *open = NULL, *pos = NULL;
+  void *keys = NULL;
+  void *p = NULL, *p_start = NULL, *p_end = NULL;
+  /* variables in single block for cache-efficiency */
+  void * const vars =
+    malloc_perror(1, add_sz_perror(compute_wt_offset_perror(a),
+                                   mul_sz_perror(2, a->wt_size)));
+  void * const u = vars;
+  void * const nr = (char *)u + a->vt_size;
+  void * const du = (char *)u + compute_wt_offset_perror(a);
+  void * const s = (char *)du + a->wt_size;
+  write_vt(u, start);
+  write_vt(nr, a->num_vts);
+  memcpy(du, wt_zero, a->wt_size);
+  memcpy(s, wt_zero, a->wt_size);
+  memcpy(ptr(dist, read_vt(u), a->wt_size), wt_zero, a->wt_size);
+  p_start = prev;
+  p_end = ptr(prev, a->num_vts, a->vt_size);
+  for (p = p_start; p != p_end; p = (char *)p + a->vt_size){
+    memcpy(p, nr, a->vt_size);
+  }
+  memcpy(at_vt(prev, u), u, a->vt_size);
+  /* reached vertices with distances that are not final, and their keys */
+  open = malloc_perror(a->num_vts, sizeof(size_t));
+  pos = malloc_perror(a->num_vts, sizeof(size_t));
+  keys = malloc_perror(a->num_vts, a->wt_size);
+  for (i = 0; i < a->num_vts; i++){
+    pos[i] = a->num_vts;
+  }
+  open[0] = start;
+  pos[start] = 0;
+  memcpy(keys, wt_zero, a->wt_size);
+  while (num_open > 0){
+    m = 0;
+    for (i = 1; i < num_open; i++){
+      if (cmp_wt(ptr(keys, i, a->wt_size),
+                 ptr(keys, m, a->wt_size)) < 0) m = i;
+    }
+    write_vt(u, open[m]);
+    memcpy(du, ptr(keys, m, a->wt_size), a->wt_size);
+    pos[open[m]] = a->num_vts + 1; /* final */
+    num_open--;
+    if (m < num_open){
+      open[m] = open[num_open];
+      pos[open[m]] = m;
+      memcpy(ptr(keys, m, a->wt_size),
+             ptr(keys, num_open, a->wt_size),
+             a->wt_size);
+    }
+    p_start = a->vt_wts[read_vt(u)]->elts;
+    p_end = ptr(p_start, a->vt_wts[read_vt(u)]->num_elts, a->pair_size);
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      v = read_vt(p);
+      if (pos[v] > a->num_vts) continue;
+      add_wt(s, du, (char *)p + a->wt_offset);
+      if (pos[v] == a->num_vts){
+        memcpy(ptr(dist, v, a->wt_size), s, a->wt_size);
+        memcpy(at_vt(prev, p), u, a->vt_size);
+        memcpy(ptr(keys, num_open, a->wt_size), s, a->wt_size);
+        open[num_open] = v;
+        pos[v] = num_open++;
+      }else if (cmp_wt(ptr(keys, pos[v], a->wt_size), s) > 0){
+        memcpy(ptr(dist, v, a->wt_size), s, a->wt_size);
+        memcpy(at_vt(prev, p), u, a->vt_size);
+        memcpy(ptr(keys, pos[v], a->wt_size), s, a->wt_size);
+      }
+    }
+  }
+  free(open);
+  free(pos);
+  free(keys);
+  free(vars);
+  open = NULL;
+  pos = NULL;
+  keys = NULL;
+  /* vars cannot be dereferenced after this line */
+}
+
+/**
+   Runs Dijkstra's algorithm with a heap and a hash table for in-heap
+   operations.
+*/
+static void dijkstra_heap(const struct adj_lst *a,
+                          size_t start,
+                          void *dist,
+                          void *prev,
+                          const void *wt_zero,
+                          const struct dijkstra_ht *daht,
+                          size_t (*read_vt)(const void *),
+                          void (*write_vt)(void *, size_t),
+                          void *(*at_vt)(const void *, const void *),
+                          int (*cmp_vt)(const void *, const void *),
+                          int (*cmp_wt)(const void *, const void *),
+                          void (*add_wt)(void *, const void *, const void *)){
   struct ht_def ht_def;
   struct heap_ht hht;
   struct heap h;
@@ -0,0 +1,319 @@
+/**
+   hopcroft-karp-test.c
+
+   Tests of maximum bipartite matching across graphs with different integer
+   types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   hopcroft-karp-test
+      [1, ushort width - 1] : n for 2**n vertices in smallest graph
+      [1, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : uniform random bipartite graph test on/off
+      [0, 1] : R-MAT bipartite graph test on/off
+
+   usage examples:
+   ./hopcroft-karp-test
+   ./hopcroft-karp-test 10 14
+   ./hopcroft-karp-test 14 15 0 1
+
+   hopcroft-karp-test can be run with any subset of command line arguments
+   in the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "hopcroft-karp.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "hopcroft-karp-test \n"
+  "[1, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[1, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : uniform random bipartite graph test on/off \n"
+  "[0, 1] : R-MAT bipartite graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {1u, 12u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+
+/* random graph parameters */
+const size_t C_EDGE_FACTORS[3] = {1u, 2u, 4u};
+const size_t C_EDGE_FACTOR_COUNT = 3u;
+
+size_t ref_match(const struct adj_lst *a,
+                 size_t num_l,
+                 size_t (*read_vt)(const void *));
+int is_match(const struct adj_lst *a,
+             size_t num_l,
+             const size_t *match,
+             size_t num_match,
+             size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Generates a bipartite graph with num_vts vertices and num_es edges
+   by generating the edges of a graph with rand_quad and graph_rmat, and
+   mapping the (u, v) edge to the edge between the left vertex u mod num_l
+   and the right vertex num_l + v mod (num_vts - num_l), where num_l is
+   num_vts / 2.
+*/
+void bip_graph(struct graph *g,
+               size_t num_es,
+               size_t j,
+               size_t (*rand_quad)(void *)){
+  size_t i;
+  size_t num_l = g->num_vts / 2, num_r = g->num_vts - num_l;
+  graph_rmat(g, num_es, C_WRITE[j], rand_quad, NULL, NULL);
+  for (i = 0; i < g->num_es; i++){
+    C_WRITE[j]((char *)g->u + i * g->vt_size,
+               C_READ[j]((char *)g->u + i * g->vt_size) % num_l);
+    C_WRITE[j]((char *)g->v + i * g->vt_size,
+               num_l + C_READ[j]((char *)g->v + i * g->vt_size) % num_r);
+  }
+}
+
+/**
+   Runs hopcroft_karp on bipartite graphs generated by bip_graph, with an
+   adjacency list built by adj_lst_dir_build if dir is non-zero, and by
+   adj_lst_undir_build otherwise. Tests that the computed matching is a
+   valid matching with the number of pairs computed by augmenting along
+   one path at a time.
+*/
+void run_bip_test(size_t log_start,
+                  size_t log_end,
+                  int dir,
+                  size_t (*rand_quad)(void *)){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_l, num_match = 0;
+  size_t *match = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_l = num_vts / 2;
+    match = malloc_perror(num_vts, sizeof(size_t));
+    for (k = 0; k < C_EDGE_FACTOR_COUNT; k++){
+      printf("\t\tleft vertices: %lu, right vertices: %lu, "
+             "# of edges: %lu\n", TOLU(num_l), TOLU(num_vts - num_l),
+             TOLU(C_EDGE_FACTORS[k] * num_l));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        bip_graph(&g, mul_sz_perror(C_EDGE_FACTORS[k], num_l), j,
+                  rand_quad);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        if (dir){
+          adj_lst_dir_build(&a, &g, C_READ[j]);
+        }else{
+          adj_lst_undir_build(&a, &g, C_READ[j]);
+        }
+        t = clock();
+        num_match = hopcroft_karp(&a, num_l, match, C_READ[j]);
+        t = clock() - t;
+        printf("\t\t\t%s hopcroft_karp time: %.6f seconds, "
+               "matched pairs: %lu\n", C_VT_TYPES[j],
+               (double)t / CLOCKS_PER_SEC, TOLU(num_match));
+        adj_lst_sort(&a, C_CMP[j]);
+        res *= is_match(&a, num_l, match, num_match, C_READ[j]);
+        res *= (num_match == ref_match(&a, num_l, C_READ[j]));
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+    free(match);
+    match = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+size_t rand_quad_unif(void *arg){
+  (void)arg;
+  return RANDOM() % 4;
+}
+
+void run_unif_test(size_t log_start, size_t log_end){
+  printf("Test hopcroft_karp on uniform random bipartite graphs\n");
+  run_bip_test(log_start, log_end, 1, rand_quad_unif);
+}
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  printf("Test hopcroft_karp on R-MAT bipartite graphs\n");
+  run_bip_test(log_start, log_end, 0, graph_rmat_quad);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Returns 1 if each matched left vertex is matched to a right vertex in
+   its list, the matching is symmetric, and the number of matched left
+   vertices is num_match, otherwise returns 0. The lists are sorted.
+*/
+int is_match(const struct adj_lst *a,
+             size_t num_l,
+             const size_t *match,
+             size_t num_match,
+             size_t (*read_vt)(const void *)){
+  size_t u, v, count = 0;
+  for (u = 0; u < a->num_vts; u++){
+    v = match[u];
+    if (v == a->num_vts) continue;
+    if (v >= a->num_vts || match[v] != u) return 0;
+    if ((u < num_l) == (v < num_l)) return 0;
+    if (u < num_l){
+      if (!adj_lst_has_edge(a, u, v, read_vt)) return 0;
+      count++;
+    }
+  }
+  return count == num_match;
+}
+
+/**
+   Computes the number of pairs in a maximum matching by searching an
+   augmenting path from each left vertex with a BFS along alternating
+   paths, in O(num_vts * (num_vts + num_es)) time.
+*/
+size_t ref_match(const struct adj_lst *a,
+                 size_t num_l,
+                 size_t (*read_vt)(const void *)){
+  size_t i, k, s, u, v, w, n = a->num_vts;
+  size_t num, ret = 0;
+  size_t *match = NULL, *prev = NULL, *queue = NULL;
+  const char *p = NULL;
+  match = malloc_perror(n, sizeof(size_t));
+  prev = malloc_perror(n, sizeof(size_t));
+  queue = malloc_perror(n, sizeof(size_t));
+  for (u = 0; u < n; u++){
+    match[u] = n;
+  }
+  for (s = 0; s < num_l; s++){
+    /* prev of a right vertex is the left vertex that reached it */
+    for (u = 0; u < n; u++){
+      prev[u] = n;
+    }
+    queue[0] = s;
+    num = 1;
+    w = n;
+    for (i = 0; i < num && w == n; i++){
+      u = queue[i];
+      p = a->vt_wts[u]->elts;
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        v = read_vt(p);
+        p += a->pair_size;
+        if (v < num_l || prev[v] != n) continue;
+        prev[v] = u;
+        if (match[v] == n){
+          w = v;
+          break;
+        }
+        queue[num++] = match[v];
+      }
+    }
+    if (w == n) continue;
+    while (w != n){
+      u = prev[w];
+      v = match[u];
+      match[u] = w;
+      match[w] = u;
+      w = v;
+    }
+    ret++;
+  }
+  free(match);
+  free(prev);
+  free(queue);
+  match = NULL;
+  prev = NULL;
+  queue = NULL;
+  return ret;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] < 1 ||
+      args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_unif_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+   hopcroft-karp.c
+
+   Functions for computing a maximum matching of a bipartite graph with
+   generic integer vertices indexed from 0 according to the Hopcroft-Karp
+   algorithm. A graph may be unweighted or weighted. In the latter case
+   the weights of the graph are ignored.
+
+   The vertices in [0, num_l) are the left vertices and the vertices in
+   [num_l, num_vts) are the right vertices of a bipartite graph. Only the
+   lists of the left vertices are scanned, and the pairs with left vertices
+   in the list of a left vertex are ignored, so that an adjacency list may
+   be built with adj_lst_dir_build from the edges directed from left to
+   right vertices, or with adj_lst_undir_build from undirected edges.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "hopcroft-karp.h"
+#include "graph.h"
+#include "utilities-mem.h"
+
+/**
+   Computes a maximum matching of a bipartite graph and returns the number
+   of matched pairs. After a greedy initial matching, each phase runs a
+   BFS from the unmatched left vertices along alternating paths that
+   stops at the first layer with an unmatched right vertex, and then
+   finds a maximal set of vertex-disjoint shortest augmenting paths in
+   the layered graph by an iterative DFS with an explicit stack. The
+   position in the list of each left vertex is kept across the DFS runs
+   of a phase, and a left vertex without an augmenting path is removed
+   from the layered graph, so that a phase runs in O(num_vts + num_es)
+   time. Runs in O(sqrt(num_vts) * (num_vts + num_es)) time.
+   a           : pointer to an adjacency list of a bipartite graph, where
+                 each edge between a left vertex u and a right vertex v
+                 is represented by v in the list of u
+   num_l       : number of left vertices, which are the vertices in
+                 [0, num_l) and is not greater than num_vts
+   match       : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index of a matched vertex is
+                 set to the vertex matched to it, and the element at the
+                 index of an unmatched vertex is set to num_vts
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t hopcroft_karp(const struct adj_lst *a,
+                     size_t num_l,
+                     size_t *match,
+                     size_t (*read_vt)(const void *)){
+  size_t i, u, v, w, x;
+  size_t n = a->num_vts, lim, num, top, ret = 0;
+  size_t *dist = NULL, *cur = NULL, *queue = NULL, *stack = NULL;
+  const char *p = NULL, *p_start = NULL, *p_end = NULL;
+  for (u = 0; u < n; u++){
+    match[u] = n;
+  }
+  if (num_l == 0) return 0;
+  /* arrays in single block; n is the infinite distance */
+  dist = malloc_perror(mul_sz_perror(4, num_l), sizeof(size_t));
+  cur = dist + num_l;
+  queue = cur + num_l;
+  stack = queue + num_l;
+  for (u = 0; u < num_l; u++){
+    p_start = a->vt_wts[u]->elts;
+    p_end = p_start + a->vt_wts[u]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p += a->pair_size){
+      v = read_vt(p);
+      if (v >= num_l && match[v] == n){
+        match[u] = v;
+        match[v] = u;
+        ret++;
+        break;
+      }
+    }
+  }
+  while (1){
+    /* BFS layering up to the first layer with an unmatched right vertex */
+    num = 0;
+    for (u = 0; u < num_l; u++){
+      if (match[u] == n){
+        dist[u] = 0;
+        queue[num++] = u;
+      }else{
+        dist[u] = n;
+      }
+      cur[u] = 0;
+    }
+    lim = n;
+    for (i = 0; i < num && dist[queue[i]] < lim; i++){
+      u = queue[i];
+      p_start = a->vt_wts[u]->elts;
+      p_end = p_start + a->vt_wts[u]->num_elts * a->pair_size;
+      for (p = p_start; p != p_end; p += a->pair_size){
+        v = read_vt(p);
+        if (v < num_l) continue;
+        w = match[v];
+        if (w == n){
+          lim = dist[u];
+        }else if (dist[w] == n){
+          dist[w] = dist[u] + 1;
+          queue[num++] = w;
+        }
+      }
+    }
+    if (lim == n) break;
+    /* iterative DFS from each unmatched left vertex in the first layer */
+    for (i = 0; i < num && dist[queue[i]] == 0; i++){
+      top = 0;
+      stack[top++] = queue[i];
+      while (top > 0){
+        x = stack[top - 1];
+        p_start = a->vt_wts[x]->elts;
+        p_end = p_start + a->vt_wts[x]->num_elts * a->pair_size;
+        w = n;
+        for (p = p_start + cur[x] * a->pair_size;
+             p != p_end;
+             p += a->pair_size){
+          v = read_vt(p);
+          if (v >= num_l){
+            w = match[v];
+            if (dist[x] == lim && w == n) break;
+            if (dist[x] < lim && w != n && dist[w] == dist[x] + 1) break;
+          }
+          cur[x]++;
+        }
+        if (p == p_end){
+          /* no augmenting path through x in the layered graph */
+          dist[x] = n;
+          top--;
+          if (top > 0) cur[stack[top - 1]]++;
+        }else if (w != n){
+          stack[top++] = w;
+        }else{
+          /* augment along the path of the stack and remove its vertices */
+          while (top > 0){
+            x = stack[--top];
+            v = read_vt((const char *)a->vt_wts[x]->elts +
+                        cur[x] * a->pair_size);
+            match[x] = v;
+            match[v] = x;
+            dist[x] = n;
+          }
+          ret++;
+        }
+      }
+    }
+  }
+  free(dist);
+  dist = NULL;
+  cur = NULL;
+  queue = NULL;
+  stack = NULL;
+  return ret;
+}
@@ -0,0 +1,62 @@
+/**
+   hopcroft-karp.h
+
+   Declarations of accessible functions for computing a maximum matching
+   of a bipartite graph with generic integer vertices indexed from 0
+   according to the Hopcroft-Karp algorithm. A graph may be unweighted or
+   weighted. In the latter case the weights of the graph are ignored.
+
+   The vertices in [0, num_l) are the left vertices and the vertices in
+   [num_l, num_vts) are the right vertices of a bipartite graph. Only the
+   lists of the left vertices are scanned, and the pairs with left vertices
+   in the list of a left vertex are ignored, so that an adjacency list may
+   be built with adj_lst_dir_build from the edges directed from left to
+   right vertices, or with adj_lst_undir_build from undirected edges.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef HOPCROFT_KARP_H
+#define HOPCROFT_KARP_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a maximum matching of a bipartite graph and returns the number
+   of matched pairs. After a greedy initial matching, each phase runs a
+   BFS from the unmatched left vertices along alternating paths that
+   stops at the first layer with an unmatched right vertex, and then
+   finds a maximal set of vertex-disjoint shortest augmenting paths in
+   the layered graph by an iterative DFS with an explicit stack. The
+   position in the list of each left vertex is kept across the DFS runs
+   of a phase, and a left vertex without an augmenting path is removed
+   from the layered graph, so that a phase runs in O(num_vts + num_es)
+   time. Runs in O(sqrt(num_vts) * (num_vts + num_es)) time.
+   a           : pointer to an adjacency list of a bipartite graph, where
+                 each edge between a left vertex u and a right vertex v
+                 is represented by v in the list of u
+   num_l       : number of left vertices, which are the vertices in
+                 [0, num_l) and is not greater than num_vts
+   match       : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index of a matched vertex is
+                 set to the vertex matched to it, and the element at the
+                 index of an unmatched vertex is set to num_vts
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t hopcroft_karp(const struct adj_lst *a,
+                     size_t num_l,
+                     size_t *match,
+                     size_t (*read_vt)(const void *));
+
+#endif
@@ -0,0 +1,352 @@
+/**
+   kcore-test.c
+
+   Tests of core decomposition across graphs with different integer types
+   of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   kcore-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./kcore-test
+   ./kcore-test 10 14
+   ./kcore-test 14 18 0 1
+
+   kcore-test can be run with any subset of command line arguments in the
+   above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "kcore.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "kcore-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 11u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+int (* const C_CMP[4])(const void *, const void *) ={
+  graph_cmp_ushort,
+  graph_cmp_uint,
+  graph_cmp_ulong,
+  graph_cmp_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 16u};
+
+size_t ref_kcore(const struct adj_lst *a,
+                 size_t *core,
+                 size_t (*read_vt)(const void *));
+int is_degen_ord(const struct adj_lst *a,
+                 const size_t *core,
+                 const size_t *ord,
+                 size_t max_core,
+                 size_t (*read_vt)(const void *));
+int cmp_arr(const size_t *a, const size_t *b, size_t n);
+void print_test_result(int res);
+
+/**
+   Computes the core numbers with kcore, with and without the order of
+   removal, and compares the result with the result of repeatedly
+   removing a vertex of minimum degree by a linear scan.
+*/
+void kcore_helper(const struct adj_lst *a,
+                  size_t j,
+                  const char *s,
+                  int *res){
+  size_t n = a->num_vts;
+  size_t max_core, max_ref;
+  size_t *core = NULL, *core_ord = NULL, *ord = NULL, *ref = NULL;
+  clock_t t;
+  core = malloc_perror(n, sizeof(size_t));
+  core_ord = malloc_perror(n, sizeof(size_t));
+  ord = malloc_perror(n, sizeof(size_t));
+  ref = malloc_perror(n, sizeof(size_t));
+  t = clock();
+  max_core = kcore(a, core, NULL, C_READ[j]);
+  t = clock() - t;
+  printf("\t\t\t%s %skcore time: %.6f seconds, max core: %lu\n",
+         C_VT_TYPES[j], s, (double)t / CLOCKS_PER_SEC, TOLU(max_core));
+  *res *= (kcore(a, core_ord, ord, C_READ[j]) == max_core);
+  max_ref = ref_kcore(a, ref, C_READ[j]);
+  *res *= (max_core == max_ref);
+  *res *= cmp_arr(core, ref, n);
+  *res *= cmp_arr(core_ord, ref, n);
+  *res *= is_degen_ord(a, core, ord, max_core, C_READ[j]);
+  free(core);
+  free(core_ord);
+  free(ord);
+  free(ref);
+  core = NULL;
+  core_ord = NULL;
+  ord = NULL;
+  ref = NULL;
+}
+
+/**
+   Run tests on 2D grid graphs, where each vertex has core number 2 if
+   there are at least two vertices along each axis.
+*/
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, u;
+  size_t num_vts, num_x, num_y;
+  size_t *core = NULL;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test kcore on 2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    core = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      kcore_helper(&a, j, "", &res);
+      if (num_x > 1 && num_y > 1){
+        res *= (kcore(&a, core, NULL, C_READ[j]) == 2);
+        for (u = 0; u < num_vts; u++){
+          res *= (core[u] == 2);
+        }
+      }
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+    free(core);
+    core = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on undirected R-MAT graphs, which may have multiple edges
+   between the same vertices and loops, before and after the lists are
+   sorted and deduplicated.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test kcore on undirected R-MAT graphs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n edges\n", TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, NULL, NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_undir_build(&a, &g, C_READ[j]);
+        kcore_helper(&a, j, "multigraph ", &res);
+        adj_lst_sort(&a, C_CMP[j]);
+        adj_lst_dedup(&a, C_CMP[j]);
+        kcore_helper(&a, j, "simple     ", &res);
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Computes the core numbers by repeatedly removing a vertex of minimum
+   degree, which is found by a linear scan, and returns the maximum core
+   number.
+*/
+size_t ref_kcore(const struct adj_lst *a,
+                 size_t *core,
+                 size_t (*read_vt)(const void *)){
+  size_t i, k, u, v, w;
+  size_t ret = 0;
+  size_t *deg = NULL;
+  unsigned char *rem = NULL;
+  const char *p = NULL;
+  if (a->num_vts == 0) return 0;
+  deg = malloc_perror(a->num_vts, sizeof(size_t));
+  rem = malloc_perror(a->num_vts, sizeof(unsigned char));
+  for (u = 0; u < a->num_vts; u++){
+    deg[u] = 0;
+    rem[u] = 0;
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      deg[u] += (read_vt(p) != u);
+      p += a->pair_size;
+    }
+  }
+  for (i = 0; i < a->num_vts; i++){
+    v = a->num_vts;
+    for (u = 0; u < a->num_vts; u++){
+      if (!rem[u] && (v == a->num_vts || deg[u] < deg[v])) v = u;
+    }
+    rem[v] = 1;
+    if (deg[v] > ret) ret = deg[v];
+    core[v] = ret;
+    p = a->vt_wts[v]->elts;
+    for (k = 0; k < a->vt_wts[v]->num_elts; k++){
+      w = read_vt(p);
+      if (!rem[w]) deg[w]--;
+      p += a->pair_size;
+    }
+  }
+  free(deg);
+  free(rem);
+  deg = NULL;
+  rem = NULL;
+  return ret;
+}
+
+/**
+   Returns 1 if ord is a permutation of the vertices, in which the core
+   numbers are non-decreasing and each vertex has at most max_core pairs
+   with the vertices that follow it, otherwise returns 0.
+*/
+int is_degen_ord(const struct adj_lst *a,
+                 const size_t *core,
+                 const size_t *ord,
+                 size_t max_core,
+                 size_t (*read_vt)(const void *)){
+  int ret = 1;
+  size_t i, k, v, num;
+  size_t *ix = NULL;
+  const char *p = NULL;
+  if (a->num_vts == 0) return 1;
+  ix = malloc_perror(a->num_vts, sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    ix[i] = a->num_vts;
+  }
+  for (i = 0; i < a->num_vts; i++){
+    if (ord[i] >= a->num_vts || ix[ord[i]] < a->num_vts) ret = 0;
+    if (i > 0 && core[ord[i]] < core[ord[i - 1]]) ret = 0;
+    if (ret) ix[ord[i]] = i;
+  }
+  for (i = 0; ret && i < a->num_vts; i++){
+    num = 0;
+    p = a->vt_wts[i]->elts;
+    for (k = 0; k < a->vt_wts[i]->num_elts; k++){
+      v = read_vt(p);
+      num += (ix[v] > ix[i]);
+      p += a->pair_size;
+    }
+    if (num > max_core) ret = 0;
+  }
+  free(ix);
+  ix = NULL;
+  return ret;
+}
+
+/**
+   Returns 1 if two arrays of size_t elements are equal, otherwise
+   returns 0.
+*/
+int cmp_arr(const size_t *a, const size_t *b, size_t n){
+  size_t i;
+  for (i = 0; i < n; i++){
+    if (a[i] != b[i]) return 0;
+  }
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
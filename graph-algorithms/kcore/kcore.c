@@ -0,0 +1,128 @@
+/**
+   kcore.c
+
+   Functions for computing the core decomposition of an undirected graph
+   with generic integer vertices indexed from 0. A graph may be unweighted
+   or weighted. In the latter case the weights of the graph are ignored.
+
+   The k-core of a graph is the maximal subgraph in which each vertex has
+   at least k neighbors, and the core number of a vertex is the largest k
+   such that the vertex is in the k-core. The degree of a vertex is the
+   number of pairs in its list that are not loops, so that multiple edges
+   between the same vertices are counted with multiplicity; the lists can
+   be sorted and deduplicated with adj_lst_sort and adj_lst_dedup in
+   graph.h to compute the core numbers of the underlying simple graph.
+   The core numbers are equal to the core numbers computed by
+   kcore_pthread in kcore-pthread.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "kcore.h"
+#include "graph.h"
+#include "utilities-mem.h"
+
+/**
+   Computes the core numbers of the vertices of an undirected graph by
+   repeatedly removing a vertex of minimum degree according to the
+   Batagelj-Zaversnik algorithm. The vertices are kept in an array sorted
+   by degree with a bucket of each degree, and a decrement of the degree
+   of a vertex moves the vertex to the start of its bucket and shifts the
+   bucket boundary, in O(num_vts + num_es) time. Returns the maximum core
+   number, i.e. the degeneracy of the graph, which is 0 if the graph has
+   no vertices.
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   core        : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the core
+                 number of u
+   ord         : - NULL pointer, if the order of removal is not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 size_t elements, where the vertices are set in the order
+                 of their removal, i.e. a degeneracy ordering, in which
+                 each vertex has at most the degeneracy of the graph
+                 neighbors that follow it
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t kcore(const struct adj_lst *a,
+             size_t *core,
+             size_t *ord,
+             size_t (*read_vt)(const void *)){
+  size_t i, u, v, w, pu, pw, d;
+  size_t max_deg = 0;
+  size_t *vert = NULL, *pos = NULL, *bin = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  if (a->num_vts == 0) return 0;
+  vert = (ord == NULL) ? malloc_perror(a->num_vts, sizeof(size_t)) : ord;
+  pos = malloc_perror(a->num_vts, sizeof(size_t));
+  /* core[u] is the degree of u until u is removed */
+  for (u = 0; u < a->num_vts; u++){
+    core[u] = 0;
+    p_start = a->vt_wts[u]->elts;
+    p_end = (char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      core[u] += (read_vt(p) != u);
+    }
+    if (core[u] > max_deg) max_deg = core[u];
+  }
+  /* bin[d] is the start of the bucket of degree d in vert */
+  bin = calloc_perror(add_sz_perror(max_deg, 1), sizeof(size_t));
+  for (u = 0; u < a->num_vts; u++){
+    bin[core[u]]++;
+  }
+  for (d = 0, i = 0; d <= max_deg; d++){
+    u = bin[d];
+    bin[d] = i;
+    i += u;
+  }
+  for (u = 0; u < a->num_vts; u++){
+    pos[u] = bin[core[u]]++;
+    vert[pos[u]] = u;
+  }
+  for (d = max_deg; d > 0; d--){
+    bin[d] = bin[d - 1];
+  }
+  bin[0] = 0;
+  for (i = 0; i < a->num_vts; i++){
+    v = vert[i];
+    p_start = a->vt_wts[v]->elts;
+    p_end = (char *)p_start + a->vt_wts[v]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      w = read_vt(p);
+      if (core[w] <= core[v]) continue;
+      /* move w to the start of its bucket and shift the bucket */
+      pw = pos[w];
+      pu = bin[core[w]];
+      u = vert[pu];
+      if (u != w){
+        pos[w] = pu;
+        vert[pu] = w;
+        pos[u] = pw;
+        vert[pw] = u;
+      }
+      bin[core[w]]++;
+      core[w]--;
+    }
+  }
+  d = core[vert[a->num_vts - 1]];
+  if (ord == NULL) free(vert);
+  free(pos);
+  free(bin);
+  vert = NULL;
+  pos = NULL;
+  bin = NULL;
+  return d;
+}
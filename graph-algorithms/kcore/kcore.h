@@ -0,0 +1,66 @@
+/**
+   kcore.h
+
+   Declarations of accessible functions for computing the core
+   decomposition of an undirected graph with generic integer vertices
+   indexed from 0. A graph may be unweighted or weighted. In the latter
+   case the weights of the graph are ignored.
+
+   The k-core of a graph is the maximal subgraph in which each vertex has
+   at least k neighbors, and the core number of a vertex is the largest k
+   such that the vertex is in the k-core. The degree of a vertex is the
+   number of pairs in its list that are not loops, so that multiple edges
+   between the same vertices are counted with multiplicity; the lists can
+   be sorted and deduplicated with adj_lst_sort and adj_lst_dedup in
+   graph.h to compute the core numbers of the underlying simple graph.
+   The core numbers are equal to the core numbers computed by
+   kcore_pthread in kcore-pthread.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef KCORE_H
+#define KCORE_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes the core numbers of the vertices of an undirected graph by
+   repeatedly removing a vertex of minimum degree according to the
+   Batagelj-Zaversnik algorithm. The vertices are kept in an array sorted
+   by degree with a bucket of each degree, and a decrement of the degree
+   of a vertex moves the vertex to the start of its bucket and shifts the
+   bucket boundary, in O(num_vts + num_es) time. Returns the maximum core
+   number, i.e. the degeneracy of the graph, which is 0 if the graph has
+   no vertices.
+   a           : pointer to an adjacency list of an undirected graph, where
+                 the vertex v is in the list of u if and only if u is in
+                 the list of v, e.g. built by adj_lst_undir_build
+   core        : pointer to a preallocated array of num_vts size_t
+                 elements; the element at the index u is set to the core
+                 number of u
+   ord         : - NULL pointer, if the order of removal is not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 size_t elements, where the vertices are set in the order
+                 of their removal, i.e. a degeneracy ordering, in which
+                 each vertex has at most the degeneracy of the graph
+                 neighbors that follow it
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+size_t kcore(const struct adj_lst *a,
+             size_t *core,
+             size_t *ord,
+             size_t (*read_vt)(const void *));
+
+#endif
@@ -0,0 +1,437 @@
+/**
+   max-flow-test.c
+
+   Tests of maximum flow and minimum cut across graphs with different
+   integer types of vertices and capacities within the same translation
+   unit.
+
+   The following command line arguments can be used to customize tests:
+   max-flow-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./max-flow-test
+   ./max-flow-test 10 14
+   ./max-flow-test 14 16 0 1
+
+   max-flow-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then
+   the ith argument must be specified for i >= 0. Default values are used
+   for the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "max-flow.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "max-flow-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {1u, 11u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+
+const size_t C_WT_FN_COUNT = 2u;
+const size_t C_WT_SIZES[2] = {sizeof(unsigned long), sizeof(long)};
+const char *C_WT_TYPES[2] = {"ulong", "long "};
+const unsigned long C_ULONG_ZERO = 0;
+const long C_LONG_ZERO = 0;
+const void *C_WT_ZEROS[2] = {&C_ULONG_ZERO, &C_LONG_ZERO};
+const size_t C_WT_RANGE = 8u; /* capacities in [0, 7] */
+const size_t C_RMAT_EDGE_FACTOR = 4u;
+
+void sub_ulong(void *s, const void *a, const void *b);
+void sub_long(void *s, const void *a, const void *b);
+int (* const C_CMP_WT[2])(const void *, const void *) ={
+  graph_cmp_ulong,
+  graph_cmp_long};
+void (* const C_ADD_WT[2])(void *, const void *, const void *) ={
+  graph_add_ulong,
+  graph_add_long};
+void (* const C_SUB_WT[2])(void *, const void *, const void *) ={
+  sub_ulong,
+  sub_long};
+
+long read_wt(const void *w, size_t l);
+size_t max_in_vt(const struct adj_lst *a,
+                 size_t s,
+                 size_t (*read_vt)(const void *));
+long ref_max_flow(const struct adj_lst *a,
+                  size_t s,
+                  size_t t,
+                  size_t l,
+                  size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Computes a maximum flow and a minimum cut with max_flow, and compares
+   the value with the value computed by augmenting along shortest paths.
+   Tests that the flow satisfies the capacity and conservation
+   constraints, and that the capacity of the cut equals the value.
+*/
+void max_flow_helper(const struct adj_lst *a,
+                     size_t s,
+                     size_t t,
+                     size_t j,
+                     size_t l,
+                     int *res){
+  size_t i, k, u, v;
+  long val_l, f, cap, cut_cap = 0;
+  long *bal = NULL;
+  void *val = NULL, *flow = NULL;
+  unsigned char *cut = NULL;
+  const char *p = NULL;
+  clock_t time;
+  val = malloc_perror(1, a->wt_size);
+  flow = malloc_perror((a->num_es > 0) ? a->num_es : 1, a->wt_size);
+  cut = malloc_perror(a->num_vts, sizeof(unsigned char));
+  bal = calloc_perror(a->num_vts, sizeof(long));
+  time = clock();
+  max_flow(a, s, t, val, flow, cut, C_WT_ZEROS[l], C_READ[j],
+           C_CMP_WT[l], C_ADD_WT[l], C_SUB_WT[l]);
+  time = clock() - time;
+  val_l = read_wt(val, l);
+  printf("\t\t\t%s %s max_flow time: %.6f seconds, value: %ld\n",
+         C_VT_TYPES[j], C_WT_TYPES[l],
+         (double)time / CLOCKS_PER_SEC, val_l);
+  *res *= (val_l == ref_max_flow(a, s, t, l, C_READ[j]));
+  *res *= (cut[s] == 1 && cut[t] == 0);
+  for (u = 0, i = 0; u < a->num_vts; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = C_READ[j](p);
+      cap = read_wt(p + a->wt_offset, l);
+      f = read_wt((char *)flow + i * a->wt_size, l);
+      *res *= (f >= 0 && f <= cap);
+      bal[u] -= f;
+      bal[v] += f;
+      if (cut[u] && !cut[v]) cut_cap += cap;
+      if (!cut[u] && cut[v]) *res *= (f == 0);
+      p += a->pair_size;
+      i++;
+    }
+  }
+  for (u = 0; u < a->num_vts; u++){
+    if (u == s){
+      *res *= (bal[u] == -val_l);
+    }else if (u == t){
+      *res *= (bal[u] == val_l);
+    }else{
+      *res *= (bal[u] == 0);
+    }
+  }
+  *res *= (cut_cap == val_l);
+  free(val);
+  free(flow);
+  free(cut);
+  free(bal);
+  val = NULL;
+  flow = NULL;
+  cut = NULL;
+  bal = NULL;
+}
+
+/**
+   Run tests on 2D grid graphs with random capacities, where each edge of
+   a grid is in both directions, from the vertex 0 to the last vertex.
+*/
+
+void gen_ulong(void *wt, void *arg){
+  (void)arg;
+  *(unsigned long *)wt = RANDOM() % C_WT_RANGE;
+}
+
+void gen_long(void *wt, void *arg){
+  (void)arg;
+  *(long *)wt = RANDOM() % C_WT_RANGE;
+}
+
+void (* const C_GEN_WT[2])(void *, void *) ={gen_ulong, gen_long};
+
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, l;
+  size_t num_vts, num_x, num_y;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test max_flow on 2D grid graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    if (num_vts < 2) continue;
+    for (j = 0; j < C_FN_COUNT; j++){
+      for (l = 0; l < C_WT_FN_COUNT; l++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], C_WT_SIZES[l]);
+        graph_grid(&g, num_x, num_y, 1, C_WRITE[j], C_GEN_WT[l], NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_undir_build(&a, &g, C_READ[j]);
+        max_flow_helper(&a, 0, num_vts - 1, j, l, &res);
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on directed R-MAT graphs with random capacities, which may
+   have multiple edges between the same vertices and loops, from the
+   vertex 0, which tends to have the highest degree, and from a random
+   vertex with outgoing edges, to a vertex with the most incoming edges.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, l;
+  size_t num_vts, s, t;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test max_flow on directed R-MAT graphs\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu, E[# of edges]: %lu\n",
+           TOLU(num_vts), TOLU(C_RMAT_EDGE_FACTOR * num_vts));
+    if (num_vts < 2) continue;
+    for (j = 0; j < C_FN_COUNT; j++){
+      for (l = 0; l < C_WT_FN_COUNT; l++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], C_WT_SIZES[l]);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                   C_WRITE[j], graph_rmat_quad, C_GEN_WT[l], NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        t = max_in_vt(&a, 0, C_READ[j]);
+        max_flow_helper(&a, 0, t, j, l, &res);
+        s = RANDOM() % num_vts;
+        while (a.vt_wts[s]->num_elts == 0) s = RANDOM() % num_vts;
+        t = max_in_vt(&a, s, C_READ[j]);
+        max_flow_helper(&a, s, t, j, l, &res);
+        adj_lst_free(&a);
+        graph_free(&g);
+      }
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+void sub_ulong(void *s, const void *a, const void *b){
+  *(unsigned long *)s = *(const unsigned long *)a - *(const unsigned long *)b;
+}
+
+void sub_long(void *s, const void *a, const void *b){
+  *(long *)s = *(const long *)a - *(const long *)b;
+}
+
+/**
+   Reads a capacity of the unsigned long type if l is 0, and of the long
+   type otherwise, as a long value.
+*/
+long read_wt(const void *w, size_t l){
+  if (l == 0) return (long)*(const unsigned long *)w;
+  return *(const long *)w;
+}
+
+/**
+   Returns a vertex other than s with the most incoming edges, where a
+   graph has at least two vertices.
+*/
+size_t max_in_vt(const struct adj_lst *a,
+                 size_t s,
+                 size_t (*read_vt)(const void *)){
+  size_t k, u, ret = (s == 0);
+  size_t *deg = NULL;
+  const char *p = NULL;
+  deg = calloc_perror(a->num_vts, sizeof(size_t));
+  for (u = 0; u < a->num_vts; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      deg[read_vt(p)]++;
+      p += a->pair_size;
+    }
+  }
+  for (u = 0; u < a->num_vts; u++){
+    if (u != s && deg[u] > deg[ret]) ret = u;
+  }
+  free(deg);
+  deg = NULL;
+  return ret;
+}
+
+/**
+   Computes the value of a maximum flow by augmenting along shortest paths
+   in a residual graph, where the arcs 2 * i and 2 * i + 1 are the forward
+   and reverse arcs of the ith edge, and the arcs of each vertex are in a
+   singly linked list.
+*/
+long ref_max_flow(const struct adj_lst *a,
+                  size_t s,
+                  size_t t,
+                  size_t l,
+                  size_t (*read_vt)(const void *)){
+  size_t i, k, u, v, n = a->num_vts, m = 2 * a->num_es + 1;
+  size_t num;
+  size_t *first = NULL, *next = NULL, *head = NULL;
+  size_t *prev = NULL, *queue = NULL;
+  long ret = 0, d;
+  long *cap = NULL;
+  const char *p = NULL;
+  first = malloc_perror(n, sizeof(size_t));
+  prev = malloc_perror(n, sizeof(size_t));
+  queue = malloc_perror(n, sizeof(size_t));
+  next = malloc_perror(m, sizeof(size_t));
+  head = malloc_perror(m, sizeof(size_t));
+  cap = malloc_perror(m, sizeof(long));
+  for (u = 0; u < n; u++){
+    first[u] = m;
+  }
+  for (u = 0, i = 0; u < n; u++){
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(p);
+      head[i] = v;
+      cap[i] = read_wt(p + a->wt_offset, l);
+      next[i] = first[u];
+      first[u] = i++;
+      head[i] = u;
+      cap[i] = 0;
+      next[i] = first[v];
+      first[v] = i++;
+      p += a->pair_size;
+    }
+  }
+  while (1){
+    for (u = 0; u < n; u++){
+      prev[u] = m;
+    }
+    prev[s] = m - 1;
+    queue[0] = s;
+    num = 1;
+    for (i = 0; i < num && prev[t] == m; i++){
+      u = queue[i];
+      for (k = first[u]; k < m; k = next[k]){
+        if (prev[head[k]] == m && cap[k] > 0){
+          prev[head[k]] = k;
+          queue[num++] = head[k];
+        }
+      }
+    }
+    if (prev[t] == m) break;
+    d = LONG_MAX;
+    for (v = t; v != s; v = head[prev[v] ^ 1]){
+      if (cap[prev[v]] < d) d = cap[prev[v]];
+    }
+    for (v = t; v != s; v = head[prev[v] ^ 1]){
+      cap[prev[v]] -= d;
+      cap[prev[v] ^ 1] += d;
+    }
+    ret += d;
+  }
+  free(first);
+  free(prev);
+  free(queue);
+  free(next);
+  free(head);
+  free(cap);
+  first = NULL;
+  prev = NULL;
+  queue = NULL;
+  next = NULL;
+  head = NULL;
+  cap = NULL;
+  return ret;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
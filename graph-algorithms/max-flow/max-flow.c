@@ -0,0 +1,485 @@
+/**
+   max-flow.c
+
+   Functions for computing a maximum flow and a minimum cut in graphs with
+   generic integer vertices indexed from 0 and generic non-negative
+   capacities according to the highest-label push-relabel algorithm.
+
+   The capacities are the weights of an adjacency list of a directed
+   graph. A residual graph is built with an arc for each pair and a paired
+   reverse arc with zero residual capacity in the list of the end vertex,
+   so that a push along an arc is reflected in its paired arc in O(1)
+   time, and the flow on an edge is the residual capacity of the reverse
+   arc. Multiple edges between the same vertices and edges in opposite
+   directions are kept as separate pairs of arcs.
+
+   Active vertices, i.e. vertices with a positive excess other than the
+   source and the sink, are kept in buckets by their labels and a vertex
+   with the highest label is discharged. The labels are periodically
+   recomputed as exact residual distances to the sink, or if the sink is
+   not reachable, as the number of vertices plus the residual distances to
+   the source, by a backward breadth-first search (global relabeling). If
+   no vertex has a label i < num_vts after a relabel, then the vertices
+   with a label in (i, num_vts) are lifted above num_vts, because they
+   cannot reach the sink (gap heuristic), and their excesses are returned
+   to the source. The vertices with labels below num_vts are kept in
+   doubly linked lists by their labels to detect and process gaps.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "max-flow.h"
+#include "graph.h"
+#include "utilities-mem.h"
+
+struct pr{
+  size_t n;                  /* number of vertices, also the nil value */
+  size_t s;
+  size_t t;
+  size_t wt_size;
+  size_t *off;               /* arcs of u at off[u], ..., off[u + 1] - 1 */
+  size_t *head;
+  size_t *rev;               /* paired arcs */
+  void *res;                 /* residual capacities of arcs */
+  void *ex;                  /* excesses of vertices */
+  void *delta;
+  size_t *lbl;
+  size_t *cur;               /* current arcs */
+  size_t *bkt;               /* 2 * n buckets of active vertices */
+  size_t *bnext;
+  size_t hi;                 /* no active vertex in buckets above hi */
+  size_t *lhead;             /* n lists of vertices by labels below n */
+  size_t *lnext;
+  size_t *lprev;
+  size_t lmax;               /* no vertex in lists above lmax */
+  size_t *queue;
+  size_t num_rlbl;           /* relabels since the last global relabel */
+  const void *wt_zero;
+  int (*cmp_wt)(const void *, const void *);
+  void (*add_wt)(void *, const void *, const void *);
+  void (*sub_wt)(void *, const void *, const void *);
+};
+
+static void pr_init(struct pr *p,
+                    const struct adj_lst *a,
+                    size_t s,
+                    size_t t,
+                    size_t (*read_vt)(const void *));
+static void pr_free(struct pr *p);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Returns 1 if the weight value pointed to by w is positive, otherwise
+   returns 0.
+*/
+static int is_pos(const struct pr *p, const void *w){
+  return (p->cmp_wt(w, p->wt_zero) > 0);
+}
+
+static void bkt_add(struct pr *p, size_t u){
+  p->bnext[u] = p->bkt[p->lbl[u]];
+  p->bkt[p->lbl[u]] = u;
+  if (p->lbl[u] > p->hi) p->hi = p->lbl[u];
+}
+
+static void lst_add(struct pr *p, size_t u){
+  size_t d = p->lbl[u];
+  if (d >= p->n) return;
+  p->lnext[u] = p->lhead[d];
+  p->lprev[u] = p->n;
+  if (p->lhead[d] != p->n) p->lprev[p->lhead[d]] = u;
+  p->lhead[d] = u;
+  if (d > p->lmax) p->lmax = d;
+}
+
+static void lst_del(struct pr *p, size_t u){
+  size_t d = p->lbl[u];
+  if (d >= p->n) return;
+  if (p->lprev[u] != p->n){
+    p->lnext[p->lprev[u]] = p->lnext[u];
+  }else{
+    p->lhead[d] = p->lnext[u];
+  }
+  if (p->lnext[u] != p->n) p->lprev[p->lnext[u]] = p->lprev[u];
+}
+
+/**
+   Sets the labels to the residual distances to t, or for the vertices
+   that cannot reach t, to n plus the residual distances to s, and
+   rebuilds the buckets and the lists. The vertices that can reach neither
+   t nor s have no excess and are labeled 2 * n.
+*/
+static void global_relabel(struct pr *p){
+  size_t i, j, k, u, v;
+  size_t num = 0;
+  size_t inf = 2 * p->n;
+  for (u = 0; u < p->n; u++){
+    p->lbl[u] = inf;
+    p->cur[u] = p->off[u];
+    p->lhead[u] = p->n;
+    p->bkt[u] = p->n;
+    p->bkt[p->n + u] = p->n;
+  }
+  p->hi = 0;
+  p->lmax = 0;
+  p->lbl[p->t] = 0;
+  p->lbl[p->s] = p->n;
+  for (k = 0; k < 2; k++){
+    i = num;
+    p->queue[num++] = (k == 0) ? p->t : p->s;
+    for (; i < num; i++){
+      u = p->queue[i];
+      for (j = p->off[u]; j < p->off[u + 1]; j++){
+        v = p->head[j];
+        if (p->lbl[v] == inf &&
+            is_pos(p, ptr(p->res, p->rev[j], p->wt_size))){
+          p->lbl[v] = p->lbl[u] + 1;
+          p->queue[num++] = v;
+        }
+      }
+    }
+  }
+  for (u = 0; u < p->n; u++){
+    lst_add(p, u);
+    if (u != p->s && u != p->t && p->lbl[u] < inf &&
+        is_pos(p, ptr(p->ex, u, p->wt_size))){
+      bkt_add(p, u);
+    }
+  }
+  p->num_rlbl = 0;
+}
+
+/**
+   Relabels u to the lowest label that creates an admissible arc, and
+   lifts the vertices above a gap, if any, above n.
+*/
+static void relabel(struct pr *p, size_t u){
+  size_t j, v, d;
+  size_t old = p->lbl[u];
+  size_t min = 2 * p->n;
+  for (j = p->off[u]; j < p->off[u + 1]; j++){
+    if (is_pos(p, ptr(p->res, j, p->wt_size)) &&
+        p->lbl[p->head[j]] + 1 < min){
+      min = p->lbl[p->head[j]] + 1;
+    }
+  }
+  lst_del(p, u);
+  p->cur[u] = p->off[u];
+  p->num_rlbl++;
+  if (old < p->n && p->lhead[old] == p->n){
+    /* gap; the lifted active vertices are rebucketed when popped */
+    for (d = old + 1; d <= p->lmax; d++){
+      for (v = p->lhead[d]; v != p->n; v = p->lnext[v]){
+        p->lbl[v] = p->n + 1;
+        p->cur[v] = p->off[v];
+      }
+      p->lhead[d] = p->n;
+    }
+    p->lmax = (old > 0) ? old - 1 : 0;
+    if (min < p->n + 1) min = p->n + 1;
+  }
+  p->lbl[u] = min;
+  lst_add(p, u);
+}
+
+/**
+   Pushes the minimum of the excess of u and the residual capacity of the
+   arc j along j.
+*/
+static void push(struct pr *p, size_t u, size_t j){
+  size_t v = p->head[j];
+  void *ex_u = ptr(p->ex, u, p->wt_size);
+  void *ex_v = ptr(p->ex, v, p->wt_size);
+  void *res_j = ptr(p->res, j, p->wt_size);
+  void *res_r = ptr(p->res, p->rev[j], p->wt_size);
+  int is_act = is_pos(p, ex_v);
+  if (p->cmp_wt(ex_u, res_j) < 0){
+    memcpy(p->delta, ex_u, p->wt_size);
+  }else{
+    memcpy(p->delta, res_j, p->wt_size);
+  }
+  p->sub_wt(res_j, res_j, p->delta);
+  p->add_wt(res_r, res_r, p->delta);
+  p->sub_wt(ex_u, ex_u, p->delta);
+  p->add_wt(ex_v, ex_v, p->delta);
+  if (!is_act && v != p->s && v != p->t) bkt_add(p, v);
+}
+
+/**
+   Pushes the excess of u along admissible arcs and relabels u until the
+   excess is zero.
+*/
+static void discharge(struct pr *p, size_t u){
+  size_t j;
+  while (is_pos(p, ptr(p->ex, u, p->wt_size))){
+    if (p->cur[u] == p->off[u + 1]){
+      relabel(p, u);
+      continue;
+    }
+    j = p->cur[u];
+    if (p->lbl[u] == p->lbl[p->head[j]] + 1 &&
+        is_pos(p, ptr(p->res, j, p->wt_size))){
+      push(p, u, j);
+    }else{
+      p->cur[u]++;
+    }
+  }
+}
+
+/**
+   Returns an active vertex with the highest label, or n if there is no
+   active vertex. A vertex with a label lifted by a gap is moved to its
+   bucket.
+*/
+static size_t pop_active(struct pr *p){
+  size_t u;
+  while (1){
+    if (p->bkt[p->hi] != p->n){
+      u = p->bkt[p->hi];
+      p->bkt[p->hi] = p->bnext[u];
+      if (p->lbl[u] == p->hi) return u;
+      bkt_add(p, u);
+    }else if (p->hi == 0){
+      return p->n;
+    }else{
+      p->hi--;
+    }
+  }
+}
+
+/**
+   Computes a maximum flow from s to t and a minimum cut. Runs in
+   O(num_vts**2 * sqrt(num_es)) time in the worst case.
+   a           : pointer to an adjacency list of a weighted directed graph,
+                 where the weight of a pair is the non-negative capacity of
+                 the edge, with at least two vertices
+   s           : source vertex
+   t           : sink vertex, not equal to s
+   val         : pointer to a preallocated wt_size block, where the value of
+                 a maximum flow is copied
+   flow        : - NULL pointer, if the flow on each edge is not copied
+                 - otherwise pointer to a preallocated array of num_es
+                 wt_size blocks, where the flow on the edge of the kth pair
+                 in the list of u is copied at the index equal to the sum of
+                 k and the number of pairs in the lists of the vertices
+                 below u
+   cut         : - NULL pointer, if a minimum cut is not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 unsigned char elements, where the element at the index v
+                 is set to 1 if v is reachable from s in the residual graph
+                 of the flow, i.e. on the source side of a minimum cut, and
+                 to 0 otherwise
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent capacities
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument,
+                 which may be the block pointed to by the second argument;
+                 if the sum of capacities can result in an overflow, the
+                 user may include an overflow test in the function or use a
+                 provided _perror-suffixed function
+   sub_wt      : subtraction function which copies the weight value pointed
+                 to by the second argument minus the weight value pointed
+                 to by the third argument, which is not greater than the
+                 former, to the preallocated wt_size block pointed to by the
+                 first argument, which may be the block pointed to by the
+                 second argument
+*/
+void max_flow(const struct adj_lst *a,
+              size_t s,
+              size_t t,
+              void *val,
+              void *flow,
+              unsigned char *cut,
+              const void *wt_zero,
+              size_t (*read_vt)(const void *),
+              int (*cmp_wt)(const void *, const void *),
+              void (*add_wt)(void *, const void *, const void *),
+              void (*sub_wt)(void *, const void *, const void *)){
+  size_t i, j, k, u, v;
+  size_t num;
+  struct pr p;
+  p.wt_zero = wt_zero;
+  p.cmp_wt = cmp_wt;
+  p.add_wt = add_wt;
+  p.sub_wt = sub_wt;
+  pr_init(&p, a, s, t, read_vt);
+  /* saturate the arcs from s */
+  p.lbl[s] = p.n;
+  for (j = p.off[s]; j < p.off[s + 1]; j++){
+    if (p.head[j] != s && is_pos(&p, ptr(p.res, j, p.wt_size))){
+      memcpy(ptr(p.ex, s, p.wt_size), ptr(p.res, j, p.wt_size), p.wt_size);
+      push(&p, s, j);
+    }
+  }
+  global_relabel(&p);
+  while ((u = pop_active(&p)) != p.n){
+    discharge(&p, u);
+    if (p.num_rlbl >= p.n) global_relabel(&p);
+  }
+  memcpy(val, ptr(p.ex, t, p.wt_size), p.wt_size);
+  if (flow != NULL){
+    for (u = 0, i = 0; u < p.n; u++){
+      for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+        memcpy(ptr(flow, i, p.wt_size),
+               ptr(p.res, p.rev[p.off[u] + k], p.wt_size),
+               p.wt_size);
+        i++;
+      }
+    }
+  }
+  if (cut != NULL){
+    memset(cut, 0, p.n);
+    cut[s] = 1;
+    p.queue[0] = s;
+    num = 1;
+    for (i = 0; i < num; i++){
+      u = p.queue[i];
+      for (j = p.off[u]; j < p.off[u + 1]; j++){
+        v = p.head[j];
+        if (!cut[v] && is_pos(&p, ptr(p.res, j, p.wt_size))){
+          cut[v] = 1;
+          p.queue[num++] = v;
+        }
+      }
+    }
+  }
+  pr_free(&p);
+}
+
+/**
+   Builds the residual graph, where the arcs of the pairs in the list of
+   u are followed by the reverse arcs of the pairs with u in the lists of
+   other vertices, and allocates the arrays of the algorithm.
+*/
+static void pr_init(struct pr *p,
+                    const struct adj_lst *a,
+                    size_t s,
+                    size_t t,
+                    size_t (*read_vt)(const void *)){
+  size_t i, j, k, u, v;
+  size_t n = a->num_vts;
+  size_t num_arcs = mul_sz_perror(2, a->num_es);
+  size_t *fill = NULL;
+  const char *q = NULL;
+  p->n = n;
+  p->s = s;
+  p->t = t;
+  p->wt_size = a->wt_size;
+  p->off = calloc_perror(add_sz_perror(n, 1), sizeof(size_t));
+  for (u = 0; u < n; u++){
+    p->off[u + 1] += a->vt_wts[u]->num_elts;
+    q = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(q);
+      p->off[v + 1]++;
+      q += a->pair_size;
+    }
+  }
+  for (u = 0; u < n; u++){
+    p->off[u + 1] += p->off[u];
+  }
+  p->head = malloc_perror((num_arcs > 0) ? num_arcs : 1, sizeof(size_t));
+  p->rev = malloc_perror((num_arcs > 0) ? num_arcs : 1, sizeof(size_t));
+  p->res = malloc_perror((num_arcs > 0) ? num_arcs : 1, p->wt_size);
+  fill = malloc_perror(n, sizeof(size_t));
+  for (u = 0; u < n; u++){
+    fill[u] = p->off[u] + a->vt_wts[u]->num_elts;
+  }
+  for (u = 0; u < n; u++){
+    q = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(q);
+      i = p->off[u] + k;
+      j = fill[v]++;
+      p->head[i] = v;
+      p->head[j] = u;
+      p->rev[i] = j;
+      p->rev[j] = i;
+      memcpy(ptr(p->res, i, p->wt_size), q + a->wt_offset, p->wt_size);
+      memcpy(ptr(p->res, j, p->wt_size), p->wt_zero, p->wt_size);
+      q += a->pair_size;
+    }
+  }
+  p->ex = malloc_perror(n, p->wt_size);
+  for (u = 0; u < n; u++){
+    memcpy(ptr(p->ex, u, p->wt_size), p->wt_zero, p->wt_size);
+  }
+  p->delta = malloc_perror(1, p->wt_size);
+  p->lbl = malloc_perror(n, sizeof(size_t));
+  p->cur = malloc_perror(n, sizeof(size_t));
+  p->bkt = malloc_perror(mul_sz_perror(2, n), sizeof(size_t));
+  p->bnext = malloc_perror(n, sizeof(size_t));
+  p->lhead = malloc_perror(n, sizeof(size_t));
+  p->lnext = malloc_perror(n, sizeof(size_t));
+  p->lprev = malloc_perror(n, sizeof(size_t));
+  p->queue = malloc_perror(n, sizeof(size_t));
+  p->hi = 0;
+  p->lmax = 0;
+  p->num_rlbl = 0;
+  for (u = 0; u < n; u++){
+    p->lbl[u] = 0;
+    p->cur[u] = p->off[u];
+  }
+  free(fill);
+  fill = NULL;
+}
+
+static void pr_free(struct pr *p){
+  free(p->off);
+  free(p->head);
+  free(p->rev);
+  free(p->res);
+  free(p->ex);
+  free(p->delta);
+  free(p->lbl);
+  free(p->cur);
+  free(p->bkt);
+  free(p->bnext);
+  free(p->lhead);
+  free(p->lnext);
+  free(p->lprev);
+  free(p->queue);
+  p->off = NULL;
+  p->head = NULL;
+  p->rev = NULL;
+  p->res = NULL;
+  p->ex = NULL;
+  p->delta = NULL;
+  p->lbl = NULL;
+  p->cur = NULL;
+  p->bkt = NULL;
+  p->bnext = NULL;
+  p->lhead = NULL;
+  p->lnext = NULL;
+  p->lprev = NULL;
+  p->queue = NULL;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -0,0 +1,106 @@
+/**
+   max-flow.h
+
+   Declarations of accessible functions for computing a maximum flow and a
+   minimum cut in graphs with generic integer vertices indexed from 0 and
+   generic non-negative capacities according to the highest-label
+   push-relabel algorithm.
+
+   The capacities are the weights of an adjacency list of a directed
+   graph. A residual graph is built with an arc for each pair and a paired
+   reverse arc with zero residual capacity in the list of the end vertex,
+   so that a push along an arc is reflected in its paired arc in O(1)
+   time, and the flow on an edge is the residual capacity of the reverse
+   arc. Multiple edges between the same vertices and edges in opposite
+   directions are kept as separate pairs of arcs.
+
+   Active vertices, i.e. vertices with a positive excess other than the
+   source and the sink, are kept in buckets by their labels and a vertex
+   with the highest label is discharged. The labels are periodically
+   recomputed as exact residual distances to the sink, or if the sink is
+   not reachable, as the number of vertices plus the residual distances to
+   the source, by a backward breadth-first search (global relabeling). If
+   no vertex has a label i < num_vts after a relabel, then the vertices
+   with a label in (i, num_vts) are lifted above num_vts, because they
+   cannot reach the sink (gap heuristic), and their excesses are returned
+   to the source. The vertices with labels below num_vts are kept in
+   doubly linked lists by their labels to detect and process gaps.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under C89/C90
+   and C99.
+*/
+
+#ifndef MAX_FLOW_H
+#define MAX_FLOW_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a maximum flow from s to t and a minimum cut. Runs in
+   O(num_vts**2 * sqrt(num_es)) time in the worst case.
+   a           : pointer to an adjacency list of a weighted directed graph,
+                 where the weight of a pair is the non-negative capacity of
+                 the edge, with at least two vertices
+   s           : source vertex
+   t           : sink vertex, not equal to s
+   val         : pointer to a preallocated wt_size block, where the value of
+                 a maximum flow is copied
+   flow        : - NULL pointer, if the flow on each edge is not copied
+                 - otherwise pointer to a preallocated array of num_es
+                 wt_size blocks, where the flow on the edge of the kth pair
+                 in the list of u is copied at the index equal to the sum of
+                 k and the number of pairs in the lists of the vertices
+                 below u
+   cut         : - NULL pointer, if a minimum cut is not computed
+                 - otherwise pointer to a preallocated array of num_vts
+                 unsigned char elements, where the element at the index v
+                 is set to 1 if v is reachable from s in the residual graph
+                 of the flow, i.e. on the source side of a minimum cut, and
+                 to 0 otherwise
+   wt_zero     : pointer to a block of size wt_size with a zero value of
+                 the type used to represent capacities
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   cmp_wt      : comparison function which returns a negative integer value
+                 if the weight value pointed to by the first argument is
+                 less than the weight value pointed to by the second, a
+                 positive integer value if the weight value pointed to by
+                 the first argument is greater than the weight value
+                 pointed to by the second, and zero integer value if the two
+                 weight values are equal
+   add_wt      : addition function which copies the sum of the weight values
+                 pointed to by the second and third arguments to the
+                 preallocated wt_size block pointed to by the first argument,
+                 which may be the block pointed to by the second argument;
+                 if the sum of capacities can result in an overflow, the
+                 user may include an overflow test in the function or use a
+                 provided _perror-suffixed function
+   sub_wt      : subtraction function which copies the weight value pointed
+                 to by the second argument minus the weight value pointed
+                 to by the third argument, which is not greater than the
+                 former, to the preallocated wt_size block pointed to by the
+                 first argument, which may be the block pointed to by the
+                 second argument
+*/
+void max_flow(const struct adj_lst *a,
+              size_t s,
+              size_t t,
+              void *val,
+              void *flow,
+              unsigned char *cut,
+              const void *wt_zero,
+              size_t (*read_vt)(const void *),
+              int (*cmp_wt)(const void *, const void *),
+              void (*add_wt)(void *, const void *, const void *),
+              void (*sub_wt)(void *, const void *, const void *));
+
+#endif
@@ -898,19 +898,23 @@ void run_rand_test(size_t log_start, size_t log_end){
   size_t wt_size;
   size_t num_dwraps_def, num_dwraps_divchn, num_dwraps_muloa;
   size_t num_paths_def, num_paths_divchn, num_paths_muloa;
+  size_t num_dwraps_heap, num_paths_heap;
+  size_t num_dwraps_dense, num_paths_dense;
   size_t *rand_start = NULL;
   void *wt_l = NULL, *wt_h = NULL;
   void *wt_zero = NULL;
   void *dsum_def = NULL, *dsum_divchn = NULL, *dsum_muloa = NULL;
+  void *dsum_heap = NULL, *dsum_dense = NULL;
   void *dist_def = NULL, *dist_divchn = NULL, *dist_muloa = NULL;
   void *prev_def = NULL, *prev_divchn = NULL, *prev_muloa = NULL;
+  void *dist_dense = NULL, *prev_dense = NULL;
   struct graph g;
   struct adj_lst a;
   struct bern_arg b;
   struct ht_divchn ht_divchn;
   struct ht_muloa ht_muloa;
   struct prim_ht pmht_divchn, pmht_muloa;
-  clock_t t_def, t_divchn, t_muloa;
+  clock_t t_def, t_divchn, t_muloa, t_dense;
   rand_start = malloc_perror(C_ITER, sizeof(size_t));
   pmht_divchn.ht = &ht_divchn;
   pmht_divchn.alpha_n = C_ALPHA_N_DIVCHN;
@@ -963,12 +967,16 @@ void run_rand_test(size_t log_start, size_t log_end){
           dsum_def = realloc_perror(dsum_def, 1, wt_size);
           dsum_divchn = realloc_perror(dsum_divchn, 1, wt_size);
           dsum_muloa = realloc_perror(dsum_muloa, 1, wt_size);
+          dsum_heap = realloc_perror(dsum_heap, 1, wt_size);
+          dsum_dense = realloc_perror(dsum_dense, 1, wt_size);
           prev_def = realloc_perror(prev_def, num_vts, vt_size);
           prev_divchn = realloc_perror(prev_divchn, num_vts, vt_size);
           prev_muloa = realloc_perror(prev_muloa, num_vts, vt_size);
+          prev_dense = realloc_perror(prev_dense, num_vts, vt_size);
           dist_def = realloc_perror(dist_def, num_vts, wt_size);
           dist_divchn = realloc_perror(dist_divchn, num_vts, wt_size);
           dist_muloa = realloc_perror(dist_muloa, num_vts, wt_size);
+          dist_dense = realloc_perror(dist_dense, num_vts, wt_size);
           C_SET_ZERO[k](wt_l);
           C_SET_TEST_ULIMIT[k](wt_h, pow_two_perror(log_end));
           C_SET_ZERO[k](wt_zero);
@@ -977,6 +985,7 @@ void run_rand_test(size_t log_start, size_t log_end){
             C_SET_ZERO[k](ptr(dist_def, l, wt_size));
             C_SET_ZERO[k](ptr(dist_divchn, l, wt_size));
             C_SET_ZERO[k](ptr(dist_muloa, l, wt_size));
+            C_SET_ZERO[k](ptr(dist_dense, l, wt_size));
           }
           graph_base_init(&g, num_vts, vt_size, wt_size);
           adj_lst_rand_undir_wts(&g, &a, wt_l, wt_h, C_WRITE_VT[j],
@@ -1021,6 +1030,36 @@ void run_rand_test(size_t log_start, size_t log_end){
                  C_CMP_VT[j], C_CMP_WT[k]);
           }
           t_muloa = clock() - t_muloa;
+          t_dense = clock();
+          for (l = 0; l < C_ITER; l++){
+            prim_dense(&a, rand_start[l], dist_dense, prev_dense, wt_zero,
+                       C_READ_VT[j], C_WRITE_VT[j], C_AT_VT[j], C_CMP_WT[k]);
+          }
+          t_dense = clock() - t_dense;
+          /* compared with a heap, since prim with NULL may call
+             prim_dense; ties may result in a different mst with the same
+             weight */
+          C_SUM_DIST[k](dsum_heap,
+                        &num_dwraps_heap,
+                        &num_paths_heap,
+                        num_vts,
+                        vt_size,
+                        dist_divchn,
+                        prev_divchn,
+                        C_READ_VT[j]);
+          C_SUM_DIST[k](dsum_dense,
+                        &num_dwraps_dense,
+                        &num_paths_dense,
+                        num_vts,
+                        vt_size,
+                        dist_dense,
+                        prev_dense,
+                        C_READ_VT[j]);
+          if (k < C_FN_INTEGRAL_WT_COUNT){
+            res *= (C_CMP_WT[k](dsum_heap, dsum_dense) == 0);
+          }
+          res *= (num_dwraps_heap == num_dwraps_dense &&
+                  num_paths_heap == num_paths_dense);
           C_SUM_DIST[k](dsum_muloa,
                         &num_dwraps_muloa,
                         &num_paths_muloa,
@@ -1040,13 +1079,16 @@ void run_rand_test(size_t log_start, size_t log_end){
           printf("\t\t\t# edges: %lu\n", TOLU(a.num_es));
           printf("\t\t\t\t%s %s prim default ht:         %.8f seconds\n"
                  "\t\t\t\t%s %s prim ht_divchn:          %.8f seconds\n"
-                 "\t\t\t\t%s %s prim ht_muloa:           %.8f seconds\n",
+                 "\t\t\t\t%s %s prim ht_muloa:           %.8f seconds\n"
+                 "\t\t\t\t%s %s prim_dense:              %.8f seconds\n",
                  C_VT_TYPES[j], C_WT_TYPES[k],
                  (double)t_def / C_ITER / CLOCKS_PER_SEC,
                  C_VT_TYPES[j], C_WT_TYPES[k],
                  (double)t_divchn / C_ITER / CLOCKS_PER_SEC,
                  C_VT_TYPES[j], C_WT_TYPES[k],
-                 (double)t_muloa / C_ITER / CLOCKS_PER_SEC);
+                 (double)t_muloa / C_ITER / CLOCKS_PER_SEC,
+                 C_VT_TYPES[j], C_WT_TYPES[k],
+                 (double)t_dense / C_ITER / CLOCKS_PER_SEC);
           printf("\t\t\t\t%s %s correctness:             ",
                  C_VT_TYPES[j], C_WT_TYPES[k]);
           print_test_result(res);
@@ -1067,23 +1109,31 @@ void run_rand_test(size_t log_start, size_t log_end){
   free(dsum_def);
   free(dsum_divchn);
   free(dsum_muloa);
+  free(dsum_heap);
+  free(dsum_dense);
   free(dist_def);
   free(dist_divchn);
   free(dist_muloa);
   free(prev_def);
   free(prev_divchn);
   free(prev_muloa);
+  free(dist_dense);
+  free(prev_dense);
   rand_start = NULL;
   wt_l = NULL;
   dsum_def = NULL;
   dsum_divchn = NULL;
   dsum_muloa = NULL;
+  dsum_heap = NULL;
+  dsum_dense = NULL;
   dist_def = NULL;
   dist_divchn = NULL;
   dist_muloa = NULL;
   prev_def = NULL;
   prev_divchn = NULL;
   prev_muloa = NULL;
+  dist_dense = NULL;
+  prev_dense = NULL;
 }
 
 /**
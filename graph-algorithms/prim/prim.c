@@ -16,6 +16,12 @@
    the computation of hash values. If V is large and the graph is sparse,
    a non-default hash table may provide space advantages.
 
+   If NULL is passed as a hash table parameter value and a graph is nearly
+   complete, prim calls prim_dense, where the vertex with the lowest edge
+   weight is found by an array scan instead of a heap. A non-NULL hash
+   table parameter value always results in a heap with the specified hash
+   table.
+
    The effective type of every element in the prev array is of the integer
    type used to represent vertices. The value of every element is set
    by the algorithm to the value of the previous vertex. If the block
@@ -56,6 +62,7 @@
 #include "utilities-mem.h"
 
 static const size_t C_HEAP_INIT_COUNT = 1;
+static const size_t C_DENSE_DIV = 4u; /* num_es >= 3/4 * num_vts**2 */
 
 struct ht_def{
   size_t absent;
@@ -71,6 +78,17 @@ static void *ht_def_search(const void *ht, const void *vt);
 static void ht_def_remove(void *ht, const void *vt, void *ix);
 static void ht_def_free(void *ht);
 
+static void prim_heap(const struct adj_lst *a,
+                      size_t start,
+                      void *dist,
+                      void *prev,
+                      const void *wt_zero,
+                      const struct prim_ht *pmht,
+                      size_t (*read_vt)(const void *),
+                      void (*write_vt)(void *, size_t),
+                      void *(*at_vt)(const void *, const void *),
+                      int (*cmp_vt)(const void *, const void *),
+                      int (*cmp_wt)(const void *, const void *));
 static size_t compute_wt_offset_perror(const struct adj_lst *a);
 static void *ptr(const void *block, size_t i, size_t size);
 
@@ -106,7 +124,8 @@ static void *ptr(const void *block, size_t i, size_t size);
                  to the element in dist corresponding to the start vertex
    pmht        : - NULL pointer, if a default hash table is used for
                  in-heap operations; a default hash table contains an index
-                 array with a count that is equal to the number of vertices
+                 array with a count that is equal to the number of vertices;
+                 on nearly complete graphs prim_dense is called instead
                  - a pointer to a set of parameters specifying a hash table
                  used for in-heap operations
    read_vt     : reads the integer value of the type used to represent
@@ -144,6 +163,130 @@ void prim(const struct adj_lst *a,
           void *(*at_vt)(const void *, const void *),
           int (*cmp_vt)(const void *, const void *),
           int (*cmp_wt)(const void *, const void *)){
+  /* num_es counts each undirected edge in both directions */
+  if (pmht == NULL &&
+      a->num_es / a->num_vts >= a->num_vts - a->num_vts / C_DENSE_DIV){
+    prim_dense(a, start, dist, prev, wt_zero,
+               read_vt, write_vt, at_vt, cmp_wt);
+  }else{
+    prim_heap(a, start, dist, prev, wt_zero, pmht,
+              read_vt, write_vt, at_vt, cmp_vt, cmp_wt);
+  }
+}
+
+/**
+   Computes and copies the edge weights of an mst of the connected component
+   of a start vertex to the array pointed to by dist, and the previous
+   vertices to the array pointed to by prev, as prim, where the vertex with
+   the lowest edge weight is found by a scan of a contiguous array of the
+   edge weights of the vertices that are not in the tree, instead of a
+   heap. Runs in O(num_vts**2 + num_es) time regardless of the number of
+   edge weight updates, whereas a heap update takes O(log num_vts) time.
+   Called by prim on nearly complete graphs with
+   num_es >= 3/4 * num_vts**2 (approximately), where num_es counts each
+   edge in both directions, if the hash table parameter is NULL. Please see
+   the parameter specification in prim.
+*/
+void prim_dense(const struct adj_lst *a,
+                size_t start,
+                void *dist,
+                void *prev,
+                const void *wt_zero,
+                size_t (*read_vt)(const void *),
+                void (*write_vt)(void *, size_t),
+                void *(*at_vt)(const void *, const void *),
+                int (*cmp_wt)(const void *, const void *)){
+  size_t i, m, v;
+  size_t num_open = 1;
+  size_t *open = NULL, *pos = NULL;
+  void *keys = NULL;
+  void *p = NULL, *p_start = NULL, *p_end = NULL;
+  void *dp_new = NULL;
+  /* variables in single block for cache-efficiency */
+  void * const vars =
+    malloc_perror(1, add_sz_perror(compute_wt_offset_perror(a),
+                                   a->wt_size));
+  void * const u = vars;
+  void * const nr = (char *)u + a->vt_size;
+  write_vt(u, start);
+  write_vt(nr, a->num_vts);
+  memcpy(ptr(dist, read_vt(u), a->wt_size), wt_zero, a->wt_size);
+  p_start = prev;
+  p_end = ptr(prev, a->num_vts, a->vt_size);
+  for (p = p_start; p != p_end; p = (char *)p + a->vt_size){
+    memcpy(p, nr, a->vt_size);
+  }
+  memcpy(at_vt(prev, u), u, a->vt_size);
+  /* reached vertices that are not in the tree, and their keys */
+  open = malloc_perror(a->num_vts, sizeof(size_t));
+  pos = malloc_perror(a->num_vts, sizeof(size_t));
+  keys = malloc_perror(a->num_vts, a->wt_size);
+  for (i = 0; i < a->num_vts; i++){
+    pos[i] = a->num_vts;
+  }
+  open[0] = start;
+  pos[start] = 0;
+  memcpy(keys, wt_zero, a->wt_size);
+  while (num_open > 0){
+    m = 0;
+    for (i = 1; i < num_open; i++){
+      if (cmp_wt(ptr(keys, i, a->wt_size),
+                 ptr(keys, m, a->wt_size)) < 0) m = i;
+    }
+    write_vt(u, open[m]);
+    pos[open[m]] = a->num_vts + 1; /* in the tree */
+    num_open--;
+    if (m < num_open){
+      open[m] = open[num_open];
+      pos[open[m]] = m;
+      memcpy(ptr(keys, m, a->wt_size),
+             ptr(keys, num_open, a->wt_size),
+             a->wt_size);
+    }
+    p_start = a->vt_wts[read_vt(u)]->elts;
+    p_end = ptr(p_start, a->vt_wts[read_vt(u)]->num_elts, a->pair_size);
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      v = read_vt(p);
+      if (pos[v] > a->num_vts) continue;
+      dp_new = (char *)p + a->wt_offset;
+      if (pos[v] == a->num_vts){
+        memcpy(ptr(dist, v, a->wt_size), dp_new, a->wt_size);
+        memcpy(at_vt(prev, p), u, a->vt_size);
+        memcpy(ptr(keys, num_open, a->wt_size), dp_new, a->wt_size);
+        open[num_open] = v;
+        pos[v] = num_open++;
+      }else if (cmp_wt(ptr(keys, pos[v], a->wt_size), dp_new) > 0){
+        memcpy(ptr(dist, v, a->wt_size), dp_new, a->wt_size);
+        memcpy(at_vt(prev, p), u, a->vt_size);
+        memcpy(ptr(keys, pos[v], a->wt_size), dp_new, a->wt_size);
+      }
+    }
+  }
+  free(open);
+  free(pos);
+  free(keys);
+  free(vars);
+  open = NULL;
+  pos = NULL;
+  keys = NULL;
+  /* vars cannot be dereferenced after this line */
+}
+
+/**
+   Runs Prim's algorithm with a heap and a hash table for in-heap
+   operations.
+*/
+static void prim_heap(const struct adj_lst *a,
+                      size_t start,
+                      void *dist,
+                      void *prev,
+                      const void *wt_zero,
+                      const struct prim_ht *pmht,
+                      size_t (*read_vt)(const void *),
+                      void (*write_vt)(void *, size_t),
+                      void *(*at_vt)(const void *, const void *),
+                      int (*cmp_vt)(const void *, const void *),
+                      int (*cmp_wt)(const void *, const void *)){
   struct ht_def ht_def;
   struct heap_ht hht;
   struct heap h;
@@ -17,6 +17,12 @@
    the computation of hash values. If V is large and the graph is sparse,
    a non-default hash table may provide space advantages.
 
+   If NULL is passed as a hash table parameter value and a graph is nearly
+   complete, prim calls prim_dense, where the vertex with the lowest edge
+   weight is found by an array scan instead of a heap. A non-NULL hash
+   table parameter value always results in a heap with the specified hash
+   table.
+
    The effective type of every element in the prev array is of the integer
    type used to represent vertices. The value of every element is set
    by the algorithm to the value of the previous vertex. If the block
@@ -110,7 +116,8 @@ struct prim_ht{
                  to the element in dist corresponding to the start vertex
    pmht        : - NULL pointer, if a default hash table is used for
                  in-heap operations; a default hash table contains an index
-                 array with a count that is equal to the number of vertices
+                 array with a count that is equal to the number of vertices;
+                 on nearly complete graphs prim_dense is called instead
                  - a pointer to a set of parameters specifying a hash table
                  used for in-heap operations
    read_vt     : reads the integer value of the type used to represent
@@ -148,4 +155,28 @@ void prim(const struct adj_lst *a,
           void *(*at_vt)(const void *, const void *),
           int (*cmp_vt)(const void *, const void *),
           int (*cmp_wt)(const void *, const void *));
+
+/**
+   Computes and copies the edge weights of an mst of the connected component
+   of a start vertex to the array pointed to by dist, and the previous
+   vertices to the array pointed to by prev, as prim, where the vertex with
+   the lowest edge weight is found by a scan of a contiguous array of the
+   edge weights of the vertices that are not in the tree, instead of a
+   heap. Runs in O(num_vts**2 + num_es) time regardless of the number of
+   edge weight updates, whereas a heap update takes O(log num_vts) time.
+   Called by prim on nearly complete graphs with
+   num_es >= 3/4 * num_vts**2 (approximately), where num_es counts each
+   edge in both directions, if the hash table parameter is NULL. Please see
+   the parameter specification in prim.
+*/
+void prim_dense(const struct adj_lst *a,
+                size_t start,
+                void *dist,
+                void *prev,
+                const void *wt_zero,
+                size_t (*read_vt)(const void *),
+                void (*write_vt)(void *, size_t),
+                void *(*at_vt)(const void *, const void *),
+                int (*cmp_wt)(const void *, const void *));
+
 #endif
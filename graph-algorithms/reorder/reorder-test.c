@@ -0,0 +1,414 @@
+/**
+   reorder-test.c
+
+   Tests of vertex reordering across graphs with different integer types
+   of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   reorder-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : grid graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./reorder-test
+   ./reorder-test 10 14
+   ./reorder-test 14 18 0 1
+
+   reorder-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "reorder.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "reorder-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : grid graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 12u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTOR = 16u;
+
+void rand_perm(size_t *perm, size_t n);
+int is_perm(const size_t *perm, size_t n);
+int is_id(const size_t *perm, size_t n);
+size_t bandwidth(const struct adj_lst *a, size_t (*read_vt)(const void *));
+int cmp_adj_lst(const struct adj_lst *a, const struct adj_lst *b);
+void print_test_result(int res);
+
+/**
+   Test helpers shared by grid and R-MAT graph tests. A graph with random
+   vertex ids is reordered, and a BFS or DFS permutation of the relabeled
+   graph from the relabeled start vertex is tested to be the identity,
+   because adj_lst_relabel preserves the order of each list. Relabeling
+   by the inverse permutation is tested to recover the graph.
+*/
+
+void reorder_helper(const struct adj_lst *a,
+                    size_t start,
+                    size_t j,
+                    int is_undir,
+                    int *res){
+  size_t i;
+  size_t num_vts = a->num_vts;
+  size_t *perm = NULL, *inv = NULL, *perm_b = NULL;
+  size_t *dist = NULL, *dist_b = NULL, *dist_m = NULL;
+  void *prev = NULL, *prev_b = NULL, *prev_m = NULL;
+  struct graph g;
+  struct adj_lst b, c;
+  clock_t t;
+  perm = malloc_perror(num_vts, sizeof(size_t));
+  inv = malloc_perror(num_vts, sizeof(size_t));
+  perm_b = malloc_perror(num_vts, sizeof(size_t));
+  graph_base_init(&g, num_vts, a->vt_size, a->wt_size);
+  /* degree */
+  t = clock();
+  reorder_degree(perm, a);
+  t = clock() - t;
+  *res *= is_perm(perm, num_vts);
+  reorder_inverse(inv, perm, num_vts);
+  for (i = 1; i < num_vts; i++){
+    *res *= (a->vt_wts[inv[i - 1]]->num_elts >=
+             a->vt_wts[inv[i]]->num_elts);
+  }
+  printf("\t\t\t%s degree time:     %.6f seconds\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  /* bfs and relabeling */
+  t = clock();
+  reorder_bfs(perm, a, start, C_READ[j]);
+  t = clock() - t;
+  *res *= is_perm(perm, num_vts);
+  printf("\t\t\t%s bfs time:        %.6f seconds\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  adj_lst_base_init(&b, &g);
+  adj_lst_unbound(&b);
+  t = clock();
+  adj_lst_relabel(&b, a, perm, C_READ[j], C_WRITE[j]);
+  t = clock() - t;
+  printf("\t\t\t%s relabel time:    %.6f seconds\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  reorder_bfs(perm_b, &b, perm[start], C_READ[j]);
+  *res *= is_id(perm_b, num_vts);
+  reorder_inverse(inv, perm, num_vts);
+  adj_lst_base_init(&c, &g);
+  adj_lst_unbound(&c);
+  adj_lst_relabel(&c, &b, inv, C_READ[j], C_WRITE[j]);
+  *res *= cmp_adj_lst(a, &c);
+  adj_lst_free(&c);
+  /* mapping of dist and prev arrays back to original ids */
+  dist = malloc_perror(num_vts, sizeof(size_t));
+  dist_b = malloc_perror(num_vts, sizeof(size_t));
+  dist_m = malloc_perror(num_vts, sizeof(size_t));
+  prev = malloc_perror(num_vts, a->vt_size);
+  prev_b = malloc_perror(num_vts, a->vt_size);
+  prev_m = malloc_perror(num_vts, a->vt_size);
+  for (i = 0; i < num_vts; i++){
+    dist[i] = RANDOM();
+    dist_b[perm[i]] = dist[i];
+    if (i % 2){
+      C_WRITE[j]((char *)prev + i * a->vt_size, num_vts);
+      C_WRITE[j]((char *)prev_b + perm[i] * a->vt_size, num_vts);
+    }else{
+      C_WRITE[j]((char *)prev + i * a->vt_size, num_vts - 1 - i);
+      C_WRITE[j]((char *)prev_b + perm[i] * a->vt_size,
+                 perm[num_vts - 1 - i]);
+    }
+  }
+  reorder_map(dist_m, dist_b, perm, num_vts, sizeof(size_t));
+  reorder_map_vts(prev_m, prev_b, perm, num_vts, a->vt_size,
+                  C_READ[j], C_WRITE[j]);
+  *res *= (memcmp(dist, dist_m, num_vts * sizeof(size_t)) == 0);
+  *res *= (memcmp(prev, prev_m, num_vts * a->vt_size) == 0);
+  adj_lst_free(&b);
+  /* dfs */
+  t = clock();
+  reorder_dfs(perm, a, start, C_READ[j]);
+  t = clock() - t;
+  *res *= is_perm(perm, num_vts);
+  printf("\t\t\t%s dfs time:        %.6f seconds\n",
+         C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+  adj_lst_base_init(&b, &g);
+  adj_lst_unbound(&b);
+  adj_lst_relabel(&b, a, perm, C_READ[j], C_WRITE[j]);
+  reorder_dfs(perm_b, &b, perm[start], C_READ[j]);
+  *res *= is_id(perm_b, num_vts);
+  adj_lst_free(&b);
+  /* rcm */
+  if (is_undir){
+    t = clock();
+    reorder_rcm(perm, a, C_READ[j]);
+    t = clock() - t;
+    *res *= is_perm(perm, num_vts);
+    adj_lst_base_init(&b, &g);
+    adj_lst_unbound(&b);
+    adj_lst_relabel(&b, a, perm, C_READ[j], C_WRITE[j]);
+    printf("\t\t\t%s rcm time:        %.6f seconds\n",
+           C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+    printf("\t\t\t%s bandwidth:       %lu random, %lu rcm\n",
+           C_VT_TYPES[j], TOLU(bandwidth(a, C_READ[j])),
+           TOLU(bandwidth(&b, C_READ[j])));
+    adj_lst_free(&b);
+  }
+  free(perm);
+  free(inv);
+  free(perm_b);
+  free(dist);
+  free(dist_b);
+  free(dist_m);
+  free(prev);
+  free(prev_b);
+  free(prev_m);
+}
+
+/**
+   Run tests on 2D grid graphs with random vertex ids. The bandwidth of a
+   grid with an RCM order is at most twice the smaller dimension.
+*/
+
+void run_grid_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts, num_x, num_y;
+  size_t *perm = NULL;
+  struct graph g;
+  struct adj_lst a, b;
+  printf("Test reorder_ operations on 2D grid graphs with random "
+         "vertex ids\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    num_x = pow_two_perror(i / 2);
+    num_y = pow_two_perror(i - i / 2);
+    printf("\t\tgrid %lu x %lu\n", TOLU(num_x), TOLU(num_y));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_grid(&g, num_x, num_y, 1, C_WRITE[j], NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_undir_build(&a, &g, C_READ[j]);
+      rand_perm(perm, num_vts);
+      adj_lst_base_init(&b, &g);
+      adj_lst_relabel(&b, &a, perm, C_READ[j], C_WRITE[j]);
+      adj_lst_free(&a);
+      reorder_helper(&b, RANDOM() % num_vts, j, 1, &res);
+      reorder_rcm(perm, &b, C_READ[j]);
+      adj_lst_base_init(&a, &g);
+      adj_lst_relabel(&a, &b, perm, C_READ[j], C_WRITE[j]);
+      res *= (bandwidth(&a, C_READ[j]) <= 2 * num_x);
+      adj_lst_free(&a);
+      adj_lst_free(&b);
+      graph_free(&g);
+    }
+    free(perm);
+    perm = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on directed R-MAT graphs with random vertex ids.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  struct graph g;
+  struct adj_lst a;
+  printf("Test reorder_ operations on R-MAT graphs\n");
+  printf("\tn vertices, %lu * n directed edges\n",
+         TOLU(C_RMAT_EDGE_FACTOR));
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTOR, num_vts),
+                 C_WRITE[j], graph_rmat_quad, NULL, NULL);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      reorder_helper(&a, RANDOM() % num_vts, j, 0, &res);
+      adj_lst_free(&a);
+      graph_free(&g);
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+/**
+   Returns 1 if each value in [0, n) appears once in an array, otherwise
+   returns 0.
+*/
+int is_perm(const size_t *perm, size_t n){
+  int res = 1;
+  size_t i;
+  char *seen = NULL;
+  seen = calloc_perror(n, 1);
+  for (i = 0; i < n; i++){
+    if (perm[i] >= n || seen[perm[i]]){
+      res = 0;
+      break;
+    }
+    seen[perm[i]] = 1;
+  }
+  free(seen);
+  seen = NULL;
+  return res;
+}
+
+/**
+   Returns 1 if a permutation is the identity, otherwise returns 0.
+*/
+int is_id(const size_t *perm, size_t n){
+  size_t i;
+  for (i = 0; i < n; i++){
+    if (perm[i] != i) return 0;
+  }
+  return 1;
+}
+
+/**
+   Returns the maximum |u - v| across the (u, v) edges of a graph.
+*/
+size_t bandwidth(const struct adj_lst *a, size_t (*read_vt)(const void *)){
+  size_t i, v;
+  size_t ret = 0;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  for (i = 0; i < a->num_vts; i++){
+    p_start = a->vt_wts[i]->elts;
+    p_end = (char *)p_start + a->vt_wts[i]->num_elts * a->pair_size;
+    for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+      v = read_vt(p);
+      if (v > i && v - i > ret) ret = v - i;
+      if (i > v && i - v > ret) ret = i - v;
+    }
+  }
+  return ret;
+}
+
+/**
+   Compares two unweighted adjacency lists with the same vt_size and
+   pair_size, with the same order of vertices in each list. Returns 1 if
+   the lists are equal, otherwise returns 0.
+*/
+int cmp_adj_lst(const struct adj_lst *a, const struct adj_lst *b){
+  size_t i;
+  if (a->num_vts != b->num_vts || a->num_es != b->num_es) return 0;
+  for (i = 0; i < a->num_vts; i++){
+    if (a->vt_wts[i]->num_elts != b->vt_wts[i]->num_elts ||
+        memcmp(a->vt_wts[i]->elts,
+               b->vt_wts[i]->elts,
+               a->vt_wts[i]->num_elts * a->pair_size)) return 0;
+  }
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_grid_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
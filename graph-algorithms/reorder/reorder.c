@@ -0,0 +1,372 @@
+/**
+   reorder.c
+
+   Functions for computing vertex permutations
+   that improve the locality of vertex ids in graphs with generic integer
+   vertices indexed from 0, and for mapping the results of algorithms on
+   relabeled graphs back to the original vertex ids. A graph may be
+   unweighted or weighted. In the latter case the weights of the graph are
+   ignored.
+
+   Vertex ids index the lists of an adjacency list and the arrays of graph
+   algorithms (e.g. dist and prev), and the default hash tables of heaps.
+   A permutation computed by a reorder_ operation is applied to an
+   adjacency list with adj_lst_relabel in graph.h, or with
+   adj_lst_relabel_pthread in graph-pthread.h, and places vertices that are
+   accessed together at nearby ids.
+
+   A permutation is represented by an array perm of num_vts size_t
+   elements, where perm[u] is the new id of the vertex u. The inverse
+   permutation inv, where inv[perm[u]] = u, lists the vertices in the
+   computed order.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reorder.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+struct deg_vt{
+  size_t deg;
+  size_t vt;
+};
+
+static void order_to_perm(size_t *perm, const size_t *order, size_t n);
+static int cmp_deg_vt(const void *a, const void *b);
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes a permutation that orders the vertices in the non-increasing
+   order of the number of pairs in their lists, with ties ordered by the
+   original ids, in O(num_vts + max degree) time. High-degree vertices,
+   which are accessed most often, are placed at the lowest ids.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list
+*/
+void reorder_degree(size_t *perm, const struct adj_lst *a){
+  size_t i;
+  size_t max_deg = 0;
+  size_t *offsets = NULL;
+  size_t offset = 0;
+  for (i = 0; i < a->num_vts; i++){
+    if (a->vt_wts[i]->num_elts > max_deg) max_deg = a->vt_wts[i]->num_elts;
+  }
+  offsets = calloc_perror(add_sz_perror(max_deg, 1), sizeof(size_t));
+  for (i = 0; i < a->num_vts; i++){
+    offsets[a->vt_wts[i]->num_elts]++;
+  }
+  /* non-increasing order of degree */
+  for (i = max_deg + 1; i > 0; i--){
+    offset += offsets[i - 1];
+    offsets[i - 1] = offset - offsets[i - 1];
+  }
+  for (i = 0; i < a->num_vts; i++){
+    perm[i] = offsets[a->vt_wts[i]->num_elts]++;
+  }
+  free(offsets);
+  offsets = NULL;
+}
+
+/**
+   Computes a permutation that orders the vertices in the BFS order from
+   start, where the vertices not reachable from start are ordered by
+   subsequent BFS from the unvisited vertex with the lowest original id.
+   The vertices at the same distance from a BFS root are placed at
+   consecutive ids.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list with at least one vertex
+   start       : start vertex of the first BFS
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void reorder_bfs(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t start,
+                 size_t (*read_vt)(const void *)){
+  size_t i = 0, v;
+  size_t head = 0, tail = 0;
+  size_t *order = NULL;
+  char *visited = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  order = malloc_perror(a->num_vts, sizeof(size_t));
+  visited = calloc_perror(a->num_vts, 1);
+  visited[start] = 1;
+  order[tail++] = start;
+  while (1){
+    /* the order array is the queue of the BFS */
+    while (head < tail){
+      p_start = a->vt_wts[order[head]]->elts;
+      p_end = (char *)p_start +
+        a->vt_wts[order[head]]->num_elts * a->pair_size;
+      for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+        v = read_vt(p);
+        if (!visited[v]){
+          visited[v] = 1;
+          order[tail++] = v;
+        }
+      }
+      head++;
+    }
+    while (i < a->num_vts && visited[i]) i++;
+    if (i == a->num_vts) break;
+    visited[i] = 1;
+    order[tail++] = i;
+  }
+  order_to_perm(perm, order, a->num_vts);
+  free(order);
+  free(visited);
+  order = NULL;
+  visited = NULL;
+}
+
+/**
+   Computes a permutation that orders the vertices in the DFS preorder
+   from start, where the vertices not reachable from start are ordered by
+   subsequent DFS from the unvisited vertex with the lowest original id.
+   The DFS visits the vertices in each list in the order of the list.
+   Please see the parameter specification in reorder_bfs.
+*/
+void reorder_dfs(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t start,
+                 size_t (*read_vt)(const void *)){
+  size_t i = 0, u, v;
+  size_t tail = 0, top = 0;
+  size_t *order = NULL, *vts = NULL, *ixs = NULL;
+  char *visited = NULL;
+  order = malloc_perror(a->num_vts, sizeof(size_t));
+  vts = malloc_perror(a->num_vts, sizeof(size_t));
+  ixs = malloc_perror(a->num_vts, sizeof(size_t));
+  visited = calloc_perror(a->num_vts, 1);
+  u = start;
+  while (1){
+    /* each vertex is pushed once onto the stack of vertices and indices */
+    visited[u] = 1;
+    order[tail++] = u;
+    vts[top] = u;
+    ixs[top] = 0;
+    top++;
+    while (top > 0){
+      u = vts[top - 1];
+      if (ixs[top - 1] < a->vt_wts[u]->num_elts){
+        v = read_vt(ptr(a->vt_wts[u]->elts, ixs[top - 1], a->pair_size));
+        ixs[top - 1]++;
+        if (!visited[v]){
+          visited[v] = 1;
+          order[tail++] = v;
+          vts[top] = v;
+          ixs[top] = 0;
+          top++;
+        }
+      }else{
+        top--;
+      }
+    }
+    while (i < a->num_vts && visited[i]) i++;
+    if (i == a->num_vts) break;
+    u = i;
+  }
+  order_to_perm(perm, order, a->num_vts);
+  free(order);
+  free(vts);
+  free(ixs);
+  free(visited);
+  order = NULL;
+  vts = NULL;
+  ixs = NULL;
+  visited = NULL;
+}
+
+/**
+   Computes a permutation according to the Reverse Cuthill-McKee (RCM)
+   algorithm, which reduces the bandwidth of the adjacency matrix of an
+   undirected graph. Each connected component is visited in the BFS order
+   from its unvisited vertex of the lowest degree, where the unvisited
+   vertices in a list are visited in the non-decreasing order of degree,
+   with ties ordered by the original ids, and the resulting order is
+   reversed. The graph is assumed to be undirected.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list of an undirected graph
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void reorder_rcm(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t (*read_vt)(const void *)){
+  size_t i = 0, j, u, v;
+  size_t head = 0, tail = 0, num_nbrs;
+  size_t max_deg = 0;
+  size_t *order = NULL, *roots = NULL;
+  char *visited = NULL;
+  const void *p = NULL, *p_start = NULL, *p_end = NULL;
+  struct deg_vt *nbrs = NULL;
+  if (a->num_vts == 0) return;
+  order = malloc_perror(a->num_vts, sizeof(size_t));
+  roots = malloc_perror(a->num_vts, sizeof(size_t));
+  visited = calloc_perror(a->num_vts, 1);
+  /* roots in the non-decreasing order of degree */
+  reorder_degree(roots, a);
+  for (u = 0; u < a->num_vts; u++){
+    order[a->num_vts - 1 - roots[u]] = u;
+    if (a->vt_wts[u]->num_elts > max_deg) max_deg = a->vt_wts[u]->num_elts;
+  }
+  memcpy(roots, order, a->num_vts * sizeof(size_t));
+  nbrs = malloc_perror(add_sz_perror(max_deg, 1), sizeof(struct deg_vt));
+  while (1){
+    while (i < a->num_vts && visited[roots[i]]) i++;
+    if (i == a->num_vts) break;
+    visited[roots[i]] = 1;
+    order[tail++] = roots[i];
+    while (head < tail){
+      u = order[head++];
+      p_start = a->vt_wts[u]->elts;
+      p_end = (char *)p_start + a->vt_wts[u]->num_elts * a->pair_size;
+      num_nbrs = 0;
+      for (p = p_start; p != p_end; p = (char *)p + a->pair_size){
+        v = read_vt(p);
+        if (!visited[v]){
+          visited[v] = 1;
+          nbrs[num_nbrs].deg = a->vt_wts[v]->num_elts;
+          nbrs[num_nbrs].vt = v;
+          num_nbrs++;
+        }
+      }
+      qsort(nbrs, num_nbrs, sizeof(struct deg_vt), cmp_deg_vt);
+      for (j = 0; j < num_nbrs; j++){
+        order[tail++] = nbrs[j].vt;
+      }
+    }
+  }
+  /* reverse the Cuthill-McKee order */
+  for (j = 0; j < a->num_vts; j++){
+    perm[order[j]] = a->num_vts - 1 - j;
+  }
+  free(order);
+  free(roots);
+  free(visited);
+  free(nbrs);
+  order = NULL;
+  roots = NULL;
+  visited = NULL;
+  nbrs = NULL;
+}
+
+/**
+   Computes the inverse of a permutation, where inv[perm[u]] = u.
+   inv         : pointer to a preallocated array of num_vts size_t elements
+   perm        : pointer to an array of num_vts size_t elements, where each
+                 value in [0, num_vts) appears once
+   num_vts     : number of vertices
+*/
+void reorder_inverse(size_t *inv, const size_t *perm, size_t num_vts){
+  size_t i;
+  for (i = 0; i < num_vts; i++){
+    inv[perm[i]] = i;
+  }
+}
+
+/**
+   Maps an array of elements indexed by new vertex ids, e.g. the dist
+   array computed on a relabeled graph, to an array of elements indexed by
+   original vertex ids, where dst[u] is a copy of src[perm[u]].
+   dst         : pointer to a preallocated array of num_vts elements of
+                 size elt_size, which does not overlap src
+   src         : pointer to an array of num_vts elements of size elt_size
+   perm        : pointer to an array of num_vts size_t elements, where
+                 perm[u] is the new id of the vertex u
+   num_vts     : number of vertices
+   elt_size    : non-zero size of an element
+*/
+void reorder_map(void *dst,
+                 const void *src,
+                 const size_t *perm,
+                 size_t num_vts,
+                 size_t elt_size){
+  size_t i;
+  for (i = 0; i < num_vts; i++){
+    memcpy(ptr(dst, i, elt_size), ptr(src, perm[i], elt_size), elt_size);
+  }
+}
+
+/**
+   Maps an array of vertices indexed by new vertex ids, e.g. the prev
+   array computed on a relabeled graph, to an array of original vertex
+   ids indexed by original vertex ids, where dst[u] is the original id of
+   the vertex src[perm[u]]. A value greater or equal to num_vts, e.g. the
+   special value for unreached vertices, is copied without mapping.
+   dst         : pointer to a preallocated array of num_vts vt_size blocks,
+                 which does not overlap src
+   src         : pointer to an array of num_vts vt_size blocks
+   perm        : pointer to an array of num_vts size_t elements, where
+                 perm[u] is the new id of the vertex u
+   num_vts     : number of vertices
+   vt_size     : non-zero size of the integer type used to represent a
+                 vertex according to sizeof
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+void reorder_map_vts(void *dst,
+                     const void *src,
+                     const size_t *perm,
+                     size_t num_vts,
+                     size_t vt_size,
+                     size_t (*read_vt)(const void *),
+                     void (*write_vt)(void *, size_t)){
+  size_t i, v;
+  size_t *inv = NULL;
+  inv = malloc_perror(num_vts, sizeof(size_t));
+  reorder_inverse(inv, perm, num_vts);
+  for (i = 0; i < num_vts; i++){
+    v = read_vt(ptr(src, perm[i], vt_size));
+    write_vt(ptr(dst, i, vt_size), v < num_vts ? inv[v] : v);
+  }
+  free(inv);
+  inv = NULL;
+}
+
+/**
+   Computes a permutation from an order of vertices, where the ith vertex
+   in the order receives the new id i.
+*/
+static void order_to_perm(size_t *perm, const size_t *order, size_t n){
+  size_t i;
+  for (i = 0; i < n; i++){
+    perm[order[i]] = i;
+  }
+}
+
+/**
+   Compares two (degree, vertex) pairs by degree and then by vertex.
+*/
+static int cmp_deg_vt(const void *a, const void *b){
+  const struct deg_vt *x = a;
+  const struct deg_vt *y = b;
+  if (x->deg != y->deg) return (x->deg > y->deg) - (x->deg < y->deg);
+  return (x->vt > y->vt) - (x->vt < y->vt);
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
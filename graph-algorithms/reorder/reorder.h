@@ -0,0 +1,154 @@
+/**
+   reorder.h
+
+   Declarations of accessible functions for computing vertex permutations
+   that improve the locality of vertex ids in graphs with generic integer
+   vertices indexed from 0, and for mapping the results of algorithms on
+   relabeled graphs back to the original vertex ids. A graph may be
+   unweighted or weighted. In the latter case the weights of the graph are
+   ignored.
+
+   Vertex ids index the lists of an adjacency list and the arrays of graph
+   algorithms (e.g. dist and prev), and the default hash tables of heaps.
+   A permutation computed by a reorder_ operation is applied to an
+   adjacency list with adj_lst_relabel in graph.h, or with
+   adj_lst_relabel_pthread in graph-pthread.h, and places vertices that are
+   accessed together at nearby ids.
+
+   A permutation is represented by an array perm of num_vts size_t
+   elements, where perm[u] is the new id of the vertex u. The inverse
+   permutation inv, where inv[perm[u]] = u, lists the vertices in the
+   computed order.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <stddef.h>
+#include "graph.h"
+
+/**
+   Computes a permutation that orders the vertices in the non-increasing
+   order of the number of pairs in their lists, with ties ordered by the
+   original ids, in O(num_vts + max degree) time. High-degree vertices,
+   which are accessed most often, are placed at the lowest ids.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list
+*/
+void reorder_degree(size_t *perm, const struct adj_lst *a);
+
+/**
+   Computes a permutation that orders the vertices in the BFS order from
+   start, where the vertices not reachable from start are ordered by
+   subsequent BFS from the unvisited vertex with the lowest original id.
+   The vertices at the same distance from a BFS root are placed at
+   consecutive ids.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list with at least one vertex
+   start       : start vertex of the first BFS
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void reorder_bfs(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t start,
+                 size_t (*read_vt)(const void *));
+
+/**
+   Computes a permutation that orders the vertices in the DFS preorder
+   from start, where the vertices not reachable from start are ordered by
+   subsequent DFS from the unvisited vertex with the lowest original id.
+   The DFS visits the vertices in each list in the order of the list.
+   Please see the parameter specification in reorder_bfs.
+*/
+void reorder_dfs(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t start,
+                 size_t (*read_vt)(const void *));
+
+/**
+   Computes a permutation according to the Reverse Cuthill-McKee (RCM)
+   algorithm, which reduces the bandwidth of the adjacency matrix of an
+   undirected graph. Each connected component is visited in the BFS order
+   from its unvisited vertex of the lowest degree, where the unvisited
+   vertices in a list are visited in the non-decreasing order of degree,
+   with ties ordered by the original ids, and the resulting order is
+   reversed. The graph is assumed to be undirected.
+   perm        : pointer to a preallocated array of num_vts size_t elements
+   a           : pointer to an adjacency list of an undirected graph
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+*/
+void reorder_rcm(size_t *perm,
+                 const struct adj_lst *a,
+                 size_t (*read_vt)(const void *));
+
+/**
+   Computes the inverse of a permutation, where inv[perm[u]] = u.
+   inv         : pointer to a preallocated array of num_vts size_t elements
+   perm        : pointer to an array of num_vts size_t elements, where each
+                 value in [0, num_vts) appears once
+   num_vts     : number of vertices
+*/
+void reorder_inverse(size_t *inv, const size_t *perm, size_t num_vts);
+
+/**
+   Maps an array of elements indexed by new vertex ids, e.g. the dist
+   array computed on a relabeled graph, to an array of elements indexed by
+   original vertex ids, where dst[u] is a copy of src[perm[u]].
+   dst         : pointer to a preallocated array of num_vts elements of
+                 size elt_size, which does not overlap src
+   src         : pointer to an array of num_vts elements of size elt_size
+   perm        : pointer to an array of num_vts size_t elements, where
+                 perm[u] is the new id of the vertex u
+   num_vts     : number of vertices
+   elt_size    : non-zero size of an element
+*/
+void reorder_map(void *dst,
+                 const void *src,
+                 const size_t *perm,
+                 size_t num_vts,
+                 size_t elt_size);
+
+/**
+   Maps an array of vertices indexed by new vertex ids, e.g. the prev
+   array computed on a relabeled graph, to an array of original vertex
+   ids indexed by original vertex ids, where dst[u] is the original id of
+   the vertex src[perm[u]]. A value greater or equal to num_vts, e.g. the
+   special value for unreached vertices, is copied without mapping.
+   dst         : pointer to a preallocated array of num_vts vt_size blocks,
+                 which does not overlap src
+   src         : pointer to an array of num_vts vt_size blocks
+   perm        : pointer to an array of num_vts size_t elements, where
+                 perm[u] is the new id of the vertex u
+   num_vts     : number of vertices
+   vt_size     : non-zero size of the integer type used to represent a
+                 vertex according to sizeof
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+void reorder_map_vts(void *dst,
+                     const void *src,
+                     const size_t *perm,
+                     size_t num_vts,
+                     size_t vt_size,
+                     size_t (*read_vt)(const void *),
+                     void (*write_vt)(void *, size_t));
+
+#endif
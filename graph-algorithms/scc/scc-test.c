@@ -0,0 +1,364 @@
+/**
+   scc-test.c
+
+   Tests of strongly connected components across graphs with different
+   integer types of vertices within the same translation unit.
+
+   The following command line arguments can be used to customize tests:
+   scc-test
+      [0, ushort width - 1] : n for 2**n vertices in smallest graph
+      [0, ushort width - 1] : n for 2**n vertices in largest graph
+      [0, 1] : cycle and path graph test on/off
+      [0, 1] : R-MAT graph test on/off
+
+   usage examples:
+   ./scc-test
+   ./scc-test 10 14
+   ./scc-test 14 16 0 1
+
+   scc-test can be run with any subset of command line arguments in the
+   above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The requirements are: i) the widths of the unsigned
+   integral types are less than 2040 and even, and ii) size_t and clock_t
+   are convertible to double.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "scc.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "scc-test \n"
+  "[0, ushort width - 1] : n for 2**n vertices in smallest graph \n"
+  "[0, ushort width - 1] : n for 2**n vertices in largest graph \n"
+  "[0, 1] : cycle and path graph test on/off \n"
+  "[0, 1] : R-MAT graph test on/off \n";
+const int C_ARGC_ULIMIT = 5;
+const size_t C_ARGS_DEF[4] = {0u, 10u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+const size_t C_FN_COUNT = 4u;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_RMAT_EDGE_FACTORS[2] = {1u, 4u};
+
+size_t ref_scc(const struct adj_lst *a,
+               size_t *lbl,
+               size_t (*read_vt)(const void *),
+               void (*write_vt)(void *, size_t));
+int cmp_lbls(const void *lbl,
+             const size_t *ref,
+             size_t num_vts,
+             size_t vt_size,
+             size_t (*read_vt)(const void *));
+void print_test_result(int res);
+
+/**
+   Run tests on a directed cycle and a directed path with vertices in a
+   random order, where the DFS depth equals the number of vertices. The
+   cycle is a single component and each vertex of the path is a
+   component.
+*/
+
+void rand_perm(size_t *perm, size_t n);
+
+void run_cycle_path_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_scc;
+  size_t *perm = NULL;
+  void *lbl = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test scc on directed cycles and paths\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    perm = malloc_perror(num_vts, sizeof(size_t));
+    for (j = 0; j < C_FN_COUNT; j++){
+      rand_perm(perm, num_vts);
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      g.num_es = num_vts;
+      g.u = malloc_perror(num_vts, C_VT_SIZES[j]);
+      g.v = malloc_perror(num_vts, C_VT_SIZES[j]);
+      for (k = 0; k < num_vts; k++){
+        C_WRITE[j]((char *)g.u + k * g.vt_size, perm[k]);
+        C_WRITE[j]((char *)g.v + k * g.vt_size, perm[(k + 1) % num_vts]);
+      }
+      lbl = malloc_perror(num_vts, C_VT_SIZES[j]);
+      adj_lst_base_init(&a, &g);
+      adj_lst_unbound(&a);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      t = clock();
+      num_scc = scc(&a, lbl, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s cycle scc time: %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (num_scc == 1);
+      for (k = 0; k < num_vts; k++){
+        res *= (C_READ[j]((char *)lbl + k * g.vt_size) == 0);
+      }
+      adj_lst_free(&a);
+      g.num_es = num_vts - 1;
+      adj_lst_base_init(&a, &g);
+      adj_lst_dir_build(&a, &g, C_READ[j]);
+      t = clock();
+      num_scc = scc(&a, lbl, C_READ[j], C_WRITE[j]);
+      t = clock() - t;
+      printf("\t\t\t%s path scc time:  %.6f seconds\n",
+             C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC);
+      res *= (num_scc == num_vts);
+      for (k = 0; k < num_vts; k++){
+        res *= (C_READ[j]((char *)lbl + k * g.vt_size) == k);
+      }
+      adj_lst_free(&a);
+      graph_free(&g);
+      free(lbl);
+      lbl = NULL;
+    }
+    free(perm);
+    perm = NULL;
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Run tests on R-MAT graphs. The labels and the number of components
+   computed by scc are compared with the result of a forward and a
+   backward search from the lowest unlabeled vertex.
+*/
+
+void run_rmat_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k;
+  size_t num_vts, num_scc, num_ref;
+  size_t *ref = NULL;
+  void *lbl = NULL;
+  struct graph g;
+  struct adj_lst a;
+  clock_t t;
+  printf("Test scc on R-MAT graphs\n");
+  for (k = 0; k < 2; k++){
+    printf("\tn vertices, %lu * n directed edges\n",
+           TOLU(C_RMAT_EDGE_FACTORS[k]));
+    for (i = log_start; i <= log_end; i++){
+      num_vts = pow_two_perror(i);
+      printf("\t\tvertices: %lu\n", TOLU(num_vts));
+      ref = malloc_perror(num_vts, sizeof(size_t));
+      for (j = 0; j < C_FN_COUNT; j++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+        graph_rmat(&g, mul_sz_perror(C_RMAT_EDGE_FACTORS[k], num_vts),
+                   C_WRITE[j], graph_rmat_quad, NULL, NULL);
+        adj_lst_base_init(&a, &g);
+        adj_lst_unbound(&a);
+        adj_lst_dir_build(&a, &g, C_READ[j]);
+        lbl = malloc_perror(num_vts, C_VT_SIZES[j]);
+        t = clock();
+        num_scc = scc(&a, lbl, C_READ[j], C_WRITE[j]);
+        t = clock() - t;
+        printf("\t\t\t%s scc time: %.6f seconds, components: %lu\n",
+               C_VT_TYPES[j], (double)t / CLOCKS_PER_SEC, TOLU(num_scc));
+        num_ref = ref_scc(&a, ref, C_READ[j], C_WRITE[j]);
+        res *= (num_scc == num_ref);
+        res *= cmp_lbls(lbl, ref, num_vts, C_VT_SIZES[j], C_READ[j]);
+        adj_lst_free(&a);
+        graph_free(&g);
+        free(lbl);
+        lbl = NULL;
+      }
+      free(ref);
+      ref = NULL;
+    }
+  }
+  printf("\t\tcorrectness across all builds --> ");
+  print_test_result(res);
+}
+
+/**
+   Auxiliary functions.
+*/
+
+/**
+   Marks with mark the unlabeled vertices reachable from u in an
+   adjacency list, where seen is an array of num_vts size_t elements and
+   top is an array of num_vts size_t elements.
+*/
+void reach(const struct adj_lst *a,
+           size_t u,
+           size_t mark,
+           const size_t *lbl,
+           size_t *seen,
+           size_t *top,
+           size_t (*read_vt)(const void *)){
+  size_t k, v;
+  size_t num_top = 1;
+  const char *p = NULL;
+  seen[u] = mark;
+  top[0] = u;
+  while (num_top > 0){
+    u = top[--num_top];
+    p = a->vt_wts[u]->elts;
+    for (k = 0; k < a->vt_wts[u]->num_elts; k++){
+      v = read_vt(p);
+      if (lbl[v] == a->num_vts && seen[v] != mark){
+        seen[v] = mark;
+        top[num_top++] = v;
+      }
+      p += a->pair_size;
+    }
+  }
+}
+
+/**
+   Labels each vertex with the lowest vertex in its strongly connected
+   component by intersecting the sets of vertices reachable from and to
+   the lowest unlabeled vertex, and returns the number of components.
+*/
+size_t ref_scc(const struct adj_lst *a,
+               size_t *lbl,
+               size_t (*read_vt)(const void *),
+               void (*write_vt)(void *, size_t)){
+  size_t i, k;
+  size_t n = a->num_vts, ret = 0;
+  size_t *fw = NULL, *bw = NULL, *top = NULL;
+  struct graph g;
+  struct adj_lst b;
+  graph_base_init(&g, n, a->vt_size, a->wt_size);
+  adj_lst_base_init(&b, &g);
+  adj_lst_unbound(&b);
+  adj_lst_transpose(&b, a, read_vt, write_vt);
+  fw = malloc_perror(n, sizeof(size_t));
+  bw = malloc_perror(n, sizeof(size_t));
+  top = malloc_perror(n, sizeof(size_t));
+  for (i = 0; i < n; i++){
+    lbl[i] = n;
+    fw[i] = n;
+    bw[i] = n;
+  }
+  for (i = 0; i < n; i++){
+    if (lbl[i] < n) continue;
+    reach(a, i, i, lbl, fw, top, read_vt);
+    reach(&b, i, i, lbl, bw, top, read_vt);
+    for (k = i; k < n; k++){
+      if (lbl[k] == n && fw[k] == i && bw[k] == i) lbl[k] = i;
+    }
+    ret++;
+  }
+  adj_lst_free(&b);
+  free(fw);
+  free(bw);
+  free(top);
+  fw = NULL;
+  bw = NULL;
+  top = NULL;
+  return ret;
+}
+
+/**
+   Computes a random permutation by the Fisher-Yates shuffle.
+*/
+void rand_perm(size_t *perm, size_t n){
+  size_t i, k, tmp;
+  for (i = 0; i < n; i++){
+    perm[i] = i;
+  }
+  for (i = n; i > 1; i--){
+    k = RANDOM() % i;
+    tmp = perm[i - 1];
+    perm[i - 1] = perm[k];
+    perm[k] = tmp;
+  }
+}
+
+/**
+   Compares an array of labels in vt_size blocks with an array of size_t
+   labels. Returns 1 if the labels are equal, otherwise returns 0.
+*/
+int cmp_lbls(const void *lbl,
+             const size_t *ref,
+             size_t num_vts,
+             size_t vt_size,
+             size_t (*read_vt)(const void *)){
+  size_t i;
+  for (i = 0; i < num_vts; i++){
+    if (read_vt((const char *)lbl + i * vt_size) != ref[i]) return 0;
+  }
+  return 1;
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[2] > 1 ||
+      args[3] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[2]) run_cycle_path_test(args[0], args[1]);
+  if (args[3]) run_rmat_test(args[0], args[1]);
+  free(args);
+  args = NULL;
+  return 0;
+}
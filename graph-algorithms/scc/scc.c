@@ -0,0 +1,151 @@
+/**
+   scc.c
+
+   Functions for computing the strongly connected components of a directed
+   graph with generic integer vertices indexed from 0. A graph may be
+   unweighted or weighted. In the latter case the weights of the graph are
+   ignored.
+
+   The recursion of the DFS in Tarjan's algorithm is emulated on a
+   dynamically allocated stack data structure, as in dfs in dfs.h, to
+   avoid an overflow of the memory stack on graphs with long paths.
+
+   Each vertex is labeled with the lowest vertex in its component, which
+   provides a unique representative of each component that does not
+   depend on the order of edges and lists. The labels are written in the
+   integer type used to represent vertices, and a label array can be
+   compared across implementations, e.g. with the labels computed by
+   scc_pthread in scc-pthread.h.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "scc.h"
+#include "graph.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static const size_t C_STACK_INIT_COUNT = 1;
+static const size_t C_STACK_MAX_COUNT = 0; /* < init count, unbounded */
+
+/* frame of the emulated recursion */
+struct scc_frame{
+  size_t u;
+  size_t k;       /* index of the next pair in the list of u */
+};
+
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Computes the strongly connected components of a directed graph with
+   Tarjan's algorithm in O(num_vts + num_es) time. The DFS is run from
+   each unvisited vertex in the increasing order of vertices, and visits
+   the vertices in each list in the order of the list. The components are
+   found in a reverse topological order of the condensation of the graph.
+   Returns the number of components.
+   a           : pointer to an adjacency list
+   lbl         : pointer to a preallocated array of num_vts vt_size blocks;
+                 the block of the vertex u is set to the lowest vertex in
+                 the component of u
+   read_vt     : reads the integer value of the type used to represent
+                 vertices from the vt_size block pointed to by the argument
+                 and returns a size_t value
+   write_vt    : writes the integer value of the second argument to
+                 the vt_size block pointed to by the first argument
+                 as a value of the integer type used to represent vertices
+*/
+size_t scc(const struct adj_lst *a,
+           void *lbl,
+           size_t (*read_vt)(const void *),
+           void (*write_vt)(void *, size_t)){
+  size_t i, j, min;
+  size_t v = 0;
+  size_t n = a->num_vts;
+  size_t c = 0, top = 0, ret = 0;
+  size_t *ix = NULL, *low = NULL, *comp = NULL, *vs = NULL;
+  struct scc_frame f;
+  struct stack s;
+  if (n == 0) return 0;
+  ix = malloc_perror(n, sizeof(size_t));
+  low = malloc_perror(n, sizeof(size_t));
+  comp = malloc_perror(n, sizeof(size_t));
+  vs = malloc_perror(n, sizeof(size_t)); /* stack of Tarjan's algorithm */
+  for (i = 0; i < n; i++){
+    ix[i] = n;
+    comp[i] = n;
+  }
+  stack_init(&s, sizeof(struct scc_frame), NULL);
+  stack_bound(&s, C_STACK_INIT_COUNT, C_STACK_MAX_COUNT);
+  for (i = 0; i < n; i++){
+    if (ix[i] < n) continue;
+    ix[i] = c;
+    low[i] = c;
+    c++;
+    vs[top++] = i;
+    f.u = i;
+    f.k = 0;
+    stack_push(&s, &f);
+    while (s.num_elts > 0){
+      stack_pop(&s, &f);
+      /* a pair is examined again after the return from its vertex */
+      while (f.k < a->vt_wts[f.u]->num_elts){
+        v = read_vt(ptr(a->vt_wts[f.u]->elts, f.k, a->pair_size));
+        if (ix[v] == n) break;
+        if (comp[v] == n && low[v] < low[f.u]) low[f.u] = low[v];
+        f.k++;
+      }
+      if (f.k < a->vt_wts[f.u]->num_elts){
+        stack_push(&s, &f); /* push the unfinished vertex */
+        ix[v] = c;
+        low[v] = c;
+        c++;
+        vs[top++] = v;
+        f.u = v;
+        f.k = 0;
+        stack_push(&s, &f); /* then push an unexplored vertex */
+      }else if (low[f.u] == ix[f.u]){
+        /* f.u is the root of a component at the top of vs */
+        j = top;
+        min = f.u;
+        do{
+          j--;
+          if (vs[j] < min) min = vs[j];
+        }while (vs[j] != f.u);
+        while (top > j){
+          comp[vs[--top]] = min;
+        }
+        ret++;
+      }
+    }
+  }
+  for (i = 0; i < n; i++){
+    write_vt(ptr(lbl, i, a->vt_size), comp[i]);
+  }
+  stack_free(&s);
+  free(ix);
+  free(low);
+  free(comp);
+  free(vs);
+  ix = NULL;
+  low = NULL;
+  comp = NULL;
+  vs = NULL;
+  return ret;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
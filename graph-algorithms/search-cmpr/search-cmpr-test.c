@@ -0,0 +1,340 @@
+/**
+   search-cmpr-test.c
+
+   Tests of the BFS and DFS algorithms on compressed adjacency lists
+   across graphs with different integer types of vertices within the same
+   translation unit.
+
+   The following command line arguments can be used to customize tests:
+   search-cmpr-test
+     [0, ushort width - 1] : a
+     [0, ushort width - 1] : b s.t. 2**a <= V <= 2**b for no edges test
+     [0, ushort width - 1] : c
+     [0, ushort width - 1] : d s.t. 2**c <= V <= 2**d for rand graph test
+     [0, 1] : on/off for no edges test
+     [0, 1] : on/off for rand graph test
+
+   usage examples:
+   ./search-cmpr-test
+   ./search-cmpr-test 10 14 10 12
+   ./search-cmpr-test 10 14 10 12 0 1
+
+   search-cmpr-test can be run with any subset of command line arguments in
+   the above-defined order. If the (i + 1)th argument is specified then the
+   ith argument must be specified for i >= 0. Default values are used for
+   the unspecified arguments according to the C_ARGS_DEF array.
+
+   The implementation of tests does not use stdint.h and is portable under
+   C89/C90 and C99. The tests require that:
+   - size_t and clock_t are convertible to double,
+   - size_t can represent values upto 65535 for default values, and
+     upto USHRT_MAX (>= 65535) otherwise,
+   - the widths of the unsigned integral types are less than 2040 and even.
+
+   TODO: add portable size_t printing
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "search-cmpr.h"
+#include "bfs.h"
+#include "dfs.h"
+#include "graph.h"
+#include "graph-cmpr.h"
+#include "stack.h"
+#include "utilities-mem.h"
+#include "utilities-mod.h"
+#include "utilities-lim.h"
+
+/**
+   Generate random numbers in a portable way for test purposes only; rand()
+   in the Linux C Library uses the same generator as random(), which may not
+   be the case on older rand() implementations, and on current
+   implementations on different systems.
+*/
+#define RGENS_SEED() do{srand(time(NULL));}while (0)
+#define RANDOM() (rand()) /* [0, RAND_MAX] */
+#define DRAND() ((double)rand() / RAND_MAX) /* [0.0, 1.0] */
+
+#define TOLU(i) ((unsigned long int)(i)) /* printing size_t under C89/C90 */
+
+/* input handling */
+const char *C_USAGE =
+  "search-cmpr-test\n"
+  "[0, ushort width - 1] : a\n"
+  "[0, ushort width - 1] : b s.t. 2**a <= V <= 2**b for no edges test\n"
+  "[0, ushort width - 1] : c\n"
+  "[0, ushort width - 1] : d s.t. 2**c <= V <= 2**d for rand graph test\n"
+  "[0, 1] : on/off for no edges test\n"
+  "[0, 1] : on/off for rand graph test\n";
+const int C_ARGC_ULIMIT = 7;
+const size_t C_ARGS_DEF[6] = {0u, 10u, 0u, 11u, 1u, 1u};
+const size_t C_USHORT_BIT = PRECISION_FROM_ULIMIT((unsigned short)-1);
+
+/* tests */
+const size_t C_FN_COUNT = 4;
+size_t (* const C_READ[4])(const void *) ={
+  graph_read_ushort,
+  graph_read_uint,
+  graph_read_ulong,
+  graph_read_sz};
+void (* const C_WRITE[4])(void *, size_t) ={
+  graph_write_ushort,
+  graph_write_uint,
+  graph_write_ulong,
+  graph_write_sz};
+void *(* const C_AT[4])(const void *, const void *) ={
+  graph_at_ushort,
+  graph_at_uint,
+  graph_at_ulong,
+  graph_at_sz};
+int (* const C_CMPEQ[4])(const void *, const void *) ={
+  graph_cmpeq_ushort,
+  graph_cmpeq_uint,
+  graph_cmpeq_ulong,
+  graph_cmpeq_sz};
+void (* const C_INCR[4])(void *) ={
+  graph_incr_ushort,
+  graph_incr_uint,
+  graph_incr_ulong,
+  graph_incr_sz};
+const size_t C_VT_SIZES[4] = {
+  sizeof(unsigned short),
+  sizeof(unsigned int),
+  sizeof(unsigned long),
+  sizeof(size_t)};
+const char *C_VT_TYPES[4] = {"ushort", "uint  ", "ulong ", "sz    "};
+const size_t C_ITER = 10u;
+const size_t C_PROBS_COUNT = 5u;
+const double C_PROBS[5] = {1.00, 0.75, 0.50, 0.25, 0.00};
+const double C_PROB_ONE = 1.0;
+const double C_PROB_ZERO = 0.0;
+
+/* additional operations */
+void *ptr(const void *block, size_t i, size_t size);
+void print_test_result(int res);
+
+struct bern_arg{
+  double p;
+};
+
+int bern(void *arg){
+  struct bern_arg *b = arg;
+  if (b->p >= C_PROB_ONE) return 1;
+  if (b->p <= C_PROB_ZERO) return 0;
+  if (b->p > DRAND()) return 1;
+  return 0;
+}
+
+/**
+   Compares bfs_cmpr with bfs and dfs_cmpr with dfs on an adjacency list
+   with lists in the increasing order of vertices, and prints the runtimes
+   of the compressed searches.
+*/
+int search_cmpr_helper(const struct adj_lst *a,
+                       const size_t *start,
+                       size_t num_start,
+                       const char *type_string,
+                       size_t (*read_vt)(const void *),
+                       void (*write_vt)(void *, size_t),
+                       void *(*at_vt)(const void *, const void *),
+                       int (*cmp_vt)(const void *, const void *),
+                       void (*incr_vt)(void *)){
+  int res = 1;
+  size_t i;
+  size_t vt_size = a->vt_size;
+  void *dist = NULL, *prev = NULL, *pre = NULL, *post = NULL;
+  void *dist_c = NULL, *prev_c = NULL, *pre_c = NULL, *post_c = NULL;
+  struct adj_cmpr c;
+  clock_t t_bfs = 0, t_dfs = 0, t;
+  /* no declared type after malloc; effective type is set by searches */
+  dist = malloc_perror(a->num_vts, vt_size);
+  prev = malloc_perror(a->num_vts, vt_size);
+  pre = malloc_perror(a->num_vts, vt_size);
+  post = malloc_perror(a->num_vts, vt_size);
+  dist_c = malloc_perror(a->num_vts, vt_size);
+  prev_c = malloc_perror(a->num_vts, vt_size);
+  pre_c = malloc_perror(a->num_vts, vt_size);
+  post_c = malloc_perror(a->num_vts, vt_size);
+  for (i = 0; i < a->num_vts; i++){
+    /* avoid trap representations in tests */
+    write_vt(ptr(dist, i, vt_size), 0);
+    write_vt(ptr(dist_c, i, vt_size), 0);
+  }
+  adj_cmpr_init(&c, a, read_vt);
+  for (i = 0; i < num_start; i++){
+    bfs(a, start[i], dist, prev, read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    t = clock();
+    bfs_cmpr(&c, start[i], dist_c, prev_c,
+             read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    t_bfs += clock() - t;
+    res *= (memcmp(dist, dist_c, a->num_vts * vt_size) == 0);
+    res *= (memcmp(prev, prev_c, a->num_vts * vt_size) == 0);
+    dfs(a, start[i], pre, post, read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    t = clock();
+    dfs_cmpr(&c, start[i], pre_c, post_c,
+             read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    t_dfs += clock() - t;
+    res *= (memcmp(pre, pre_c, a->num_vts * vt_size) == 0);
+    res *= (memcmp(post, post_c, a->num_vts * vt_size) == 0);
+  }
+  printf("\t\t\t%s bfs_cmpr ave runtime: %.6f seconds\n",
+         type_string, (double)t_bfs / num_start / CLOCKS_PER_SEC);
+  printf("\t\t\t%s dfs_cmpr ave runtime: %.6f seconds\n",
+         type_string, (double)t_dfs / num_start / CLOCKS_PER_SEC);
+  adj_cmpr_free(&c);
+  free(dist);
+  free(prev);
+  free(pre);
+  free(post);
+  free(dist_c);
+  free(prev_c);
+  free(pre_c);
+  free(post_c);
+  dist = NULL;
+  prev = NULL;
+  pre = NULL;
+  post = NULL;
+  dist_c = NULL;
+  prev_c = NULL;
+  pre_c = NULL;
+  post_c = NULL;
+  return res;
+}
+
+/**
+   Runs a test of bfs_cmpr and dfs_cmpr on graphs with no edges, where the
+   compressed adjacency list has no encoded bytes.
+*/
+void run_no_edges_graph_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j;
+  size_t num_vts;
+  size_t start;
+  struct graph g;
+  struct adj_lst a;
+  struct bern_arg b;
+  b.p = C_PROB_ZERO;
+  printf("Run a bfs_cmpr and dfs_cmpr test on graphs with no edges\n");
+  for (i = log_start; i <= log_end; i++){
+    num_vts = pow_two_perror(i);
+    printf("\t\tvertices: %lu\n", TOLU(num_vts));
+    for (j = 0; j < C_FN_COUNT; j++){
+      graph_base_init(&g, num_vts, C_VT_SIZES[j], 0);
+      adj_lst_base_init(&a, &g);
+      adj_lst_rand_dir(&a, C_WRITE[j], bern, &b);
+      start = RANDOM() % num_vts;
+      res *= search_cmpr_helper(&a,
+                                &start,
+                                1,
+                                C_VT_TYPES[j],
+                                C_READ[j],
+                                C_WRITE[j],
+                                C_AT[j],
+                                C_CMPEQ[j],
+                                C_INCR[j]);
+      printf("\t\t\t%s correctness:          ", C_VT_TYPES[j]);
+      print_test_result(res);
+      res = 1;
+      adj_lst_free(&a); /* deallocates blocks with effective vertex type */
+    }
+  }
+}
+
+/**
+   Runs a test of bfs_cmpr and dfs_cmpr on random directed graphs.
+*/
+void run_random_dir_graph_test(size_t log_start, size_t log_end){
+  int res = 1;
+  size_t i, j, k, l;
+  size_t num_vts;
+  size_t *start = NULL;
+  struct graph g;
+  struct adj_lst a;
+  struct bern_arg b;
+  start = malloc_perror(C_ITER, sizeof(size_t));
+  printf("Run a bfs_cmpr and dfs_cmpr test on random directed graphs "
+         "from %lu random start vertices in each graph\n",  TOLU(C_ITER));
+  for (i = 0; i < C_PROBS_COUNT; i++){
+    b.p = C_PROBS[i];
+    printf("\tP[an edge is in a graph] = %.2f\n", b.p);
+    for (j = log_start; j <= log_end; j++){
+      num_vts = pow_two_perror(j);
+      printf("\t\tvertices: %lu, E[# of directed edges]: %.1f\n",
+             TOLU(num_vts), b.p * num_vts * (num_vts - 1));
+      for (k = 0; k < C_FN_COUNT; k++){
+        graph_base_init(&g, num_vts, C_VT_SIZES[k], 0);
+        adj_lst_base_init(&a, &g);
+        /* lists are built in the increasing order of vertices */
+        adj_lst_rand_dir(&a, C_WRITE[k], bern, &b);
+        for (l = 0; l < C_ITER; l++){
+          start[l] = RANDOM() % num_vts;
+        }
+        res *= search_cmpr_helper(&a,
+                                  start,
+                                  C_ITER,
+                                  C_VT_TYPES[k],
+                                  C_READ[k],
+                                  C_WRITE[k],
+                                  C_AT[k],
+                                  C_CMPEQ[k],
+                                  C_INCR[k]);
+        printf("\t\t\t%s correctness:          ", C_VT_TYPES[k]);
+        print_test_result(res);
+        res = 1;
+        adj_lst_free(&a); /* deallocates blocks with effective vertex type */
+      }
+    }
+  }
+  free(start);
+  start = NULL;
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+*/
+void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
+
+void print_test_result(int res){
+  if (res){
+    printf("SUCCESS\n");
+  }else{
+    printf("FAILURE\n");
+  }
+}
+
+int main(int argc, char *argv[]){
+  int i;
+  size_t *args = NULL;
+  RGENS_SEED();
+  if (argc > C_ARGC_ULIMIT){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  args = malloc_perror(C_ARGC_ULIMIT - 1, sizeof(size_t));
+  memcpy(args, C_ARGS_DEF, (C_ARGC_ULIMIT - 1) * sizeof(size_t));
+  for (i = 1; i < argc; i++){
+    args[i - 1] = atoi(argv[i]);
+  }
+  if (args[0] > C_USHORT_BIT - 1 ||
+      args[1] > C_USHORT_BIT - 1 ||
+      args[2] > C_USHORT_BIT - 1 ||
+      args[3] > C_USHORT_BIT - 1 ||
+      args[1] < args[0] ||
+      args[3] < args[2] ||
+      args[4] > 1 ||
+      args[5] > 1){
+    printf("USAGE:\n%s", C_USAGE);
+    exit(EXIT_FAILURE);
+  }
+  if (args[4]) run_no_edges_graph_test(args[0], args[1]);
+  if (args[5]) run_random_dir_graph_test(args[2], args[3]);
+  free(args);
+  args = NULL;
+  return 0;
+}
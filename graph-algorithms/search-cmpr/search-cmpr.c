@@ -0,0 +1,264 @@
+/**
+   search-cmpr.c
+
+   Functions for running the BFS and DFS algorithms on compressed adjacency
+   lists of graphs with generic integer vertices indexed from 0.
+
+   The vertices of a list are decoded one at a time from the variable-length
+   gaps of a compressed adjacency list and are visited in the
+   non-decreasing order. The results equal the results of bfs and dfs on an
+   adjacency list with sorted lists, and the same distances are computed by
+   bfs_cmpr for any order of vertices in lists. The recursion in DFS is
+   emulated on a dynamically allocated stack of list iterators to avoid an
+   overflow of the memory stack.
+
+   The effective type of every element in the dist, prev, pre, and post
+   arrays is of the integer type used to represent vertices, according to
+   the specifications of bfs and dfs.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "search-cmpr.h"
+#include "graph-cmpr.h"
+#include "queue.h"
+#include "stack.h"
+#include "utilities-mem.h"
+
+static const size_t C_QUEUE_INIT_COUNT = 1;
+static const size_t C_STACK_INIT_COUNT = 1;
+
+struct cmpr_frame{
+  struct adj_cmpr_iter it;
+  size_t u;
+};
+
+static void search_cmpr(const struct adj_cmpr *c,
+                        struct stack *s,
+                        void *cnt,
+                        const void *nr,
+                        const void *ix,
+                        void *p,
+                        void *pre,
+                        void *post,
+                        size_t (*read_vt)(const void *),
+                        void (*write_vt)(void *, size_t),
+                        void *(*at_vt)(const void *, const void *),
+                        int (*cmp_vt)(const void *, const void *),
+                        void (*incr_vt)(void *));
+static void *ptr(const void *block, size_t i, size_t size);
+
+/**
+   Runs bfs on a compressed adjacency list according to the specification
+   of bfs, where the vertices in each list are visited in the non-decreasing
+   order. The results equal the results of bfs on an adjacency list with
+   sorted lists, and the same distances are computed for any order of
+   vertices in lists. The vertices of a list are decoded one at a time
+   into a vt_size block and are not stored in an adjacency list.
+   c           : pointer to a compressed adjacency list with at least one
+                 vertex
+   Please see the specification of the other parameters in bfs.
+*/
+void bfs_cmpr(const struct adj_cmpr *c,
+              size_t start,
+              void *dist,
+              void *prev,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t),
+              void *(*at_vt)(const void *, const void *),
+              int (*cmp_vt)(const void *, const void *),
+              void (*incr_vt)(void *)){
+  size_t v;
+  struct adj_cmpr_iter it;
+  struct queue q;
+  /* variables in single block for cache-efficiency */
+  void * const vars = malloc_perror(6, c->vt_size);
+  void * const u = vars;
+  void * const nr = ptr(vars, 1, c->vt_size);
+  void * const zero = ptr(vars, 2, c->vt_size);
+  void * const ix = ptr(vars, 3, c->vt_size);
+  void * const d = ptr(vars, 4, c->vt_size);
+  void * const p = ptr(vars, 5, c->vt_size);
+  write_vt(u, start);
+  write_vt(nr, c->num_vts);
+  write_vt(zero, 0);
+  write_vt(ix, 0);
+  write_vt(d, 0);
+  write_vt(at_vt(dist, u), 0);
+  while (cmp_vt(ix, nr) != 0){
+    memcpy(at_vt(prev, ix), nr, c->vt_size);
+    incr_vt(ix);
+  }
+  memcpy(at_vt(prev, u), u, c->vt_size);
+  queue_init(&q, c->vt_size, NULL);
+  queue_bound(&q, C_QUEUE_INIT_COUNT, c->num_vts);
+  queue_push(&q, u);
+  while (q.num_elts > 0){
+    queue_pop(&q, u);
+    memcpy(d, at_vt(dist, u), c->vt_size);
+    incr_vt(d);
+    adj_cmpr_iter_init(&it, c, read_vt(u));
+    while (adj_cmpr_iter_next(&it, &v)){
+      write_vt(p, v);
+      if (cmp_vt(at_vt(prev, p), nr) == 0){
+        memcpy(at_vt(dist, p), d, c->vt_size);
+        memcpy(at_vt(prev, p), u, c->vt_size);
+        queue_push(&q, p);
+      }
+    }
+  }
+  queue_free(&q);
+  free(vars);
+  /* after this line vars cannot be dereferenced */
+}
+
+/**
+   Computes and copies to the arrays pointed to by pre and post the previsit
+   and postvisit values of a DFS search from a start vertex on a compressed
+   adjacency list according to the specification of dfs, where the
+   vertices in each list are visited in the non-decreasing order. The
+   results equal the results of dfs on an adjacency list with sorted lists.
+   The recursion is emulated on a stack of list iterators, and the vertices
+   of a list are decoded one at a time.
+   c           : pointer to a compressed adjacency list with at least one
+                 and at most 2**(P - 1) - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   Please see the specification of the other parameters in dfs.
+*/
+void dfs_cmpr(const struct adj_cmpr *c,
+              size_t start,
+              void *pre,
+              void *post,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t),
+              void *(*at_vt)(const void *, const void *),
+              int (*cmp_vt)(const void *, const void *),
+              void (*incr_vt)(void *)){
+  struct stack s;
+  /* variables in single block for cache-efficiency */
+  void * const vars = malloc_perror(7, c->vt_size);
+  void * const su = vars;
+  void * const cnt = ptr(vars, 1, c->vt_size);
+  void * const nr = ptr(vars, 2, c->vt_size);
+  void * const zero = ptr(vars, 3, c->vt_size);
+  void * const ix = ptr(vars, 4, c->vt_size);
+  void * const end = ptr(vars, 5, c->vt_size);
+  void * const p = ptr(vars, 6, c->vt_size);
+  write_vt(su, start);
+  write_vt(cnt, 0);
+  write_vt(nr, mul_sz_perror(2, c->num_vts));
+  write_vt(zero, 0);
+  write_vt(ix, 0);
+  write_vt(end, c->num_vts);
+  while (cmp_vt(ix, end) != 0){
+    memcpy(at_vt(pre, ix), nr, c->vt_size);
+    incr_vt(ix);
+  }
+  /* run search with recursion emulation on a stack ds */
+  stack_init(&s, sizeof(struct cmpr_frame), NULL);
+  stack_bound(&s, C_STACK_INIT_COUNT, c->num_vts);
+  memcpy(ix, su, c->vt_size);
+  while (cmp_vt(ix, end) != 0){
+    if (cmp_vt(at_vt(pre, ix), nr) == 0){
+      search_cmpr(c, &s, cnt, nr, ix, p, pre, post,
+                  read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    }
+    incr_vt(ix);
+  }
+  memcpy(end, su, c->vt_size);
+  memcpy(ix, zero, c->vt_size);
+  while (cmp_vt(ix, end) != 0){
+    if (cmp_vt(at_vt(pre, ix), nr) == 0){
+      search_cmpr(c, &s, cnt, nr, ix, p, pre, post,
+                  read_vt, write_vt, at_vt, cmp_vt, incr_vt);
+    }
+    incr_vt(ix);
+  }
+  stack_free(&s);
+  free(vars);
+  /* after this line vars cannot be dereferenced */
+}
+
+/**
+   Performs a DFS search of a graph component reachable from an unexplored
+   vertex pointed to by the ix parameter on a compressed adjacency list by
+   emulating the recursion in DFS on a stack of list iterators. The vertex
+   pointed to by p is used for decoded vertices.
+*/
+static void search_cmpr(const struct adj_cmpr *c,
+                        struct stack *s,
+                        void *cnt,
+                        const void *nr,
+                        const void *ix,
+                        void *p,
+                        void *pre,
+                        void *post,
+                        size_t (*read_vt)(const void *),
+                        void (*write_vt)(void *, size_t),
+                        void *(*at_vt)(const void *, const void *),
+                        int (*cmp_vt)(const void *, const void *),
+                        void (*incr_vt)(void *)){
+  int found;
+  size_t v;
+  struct cmpr_frame f;
+  f.u = read_vt(ix);
+  adj_cmpr_iter_init(&f.it, c, f.u);
+  memcpy(at_vt(pre, ix), cnt, c->vt_size);
+  incr_vt(cnt);
+  stack_push(s, &f);
+  while (s->num_elts > 0){
+    stack_pop(s, &f);
+    /* iterate v across the u's list */
+    found = 0;
+    while (!found && adj_cmpr_iter_next(&f.it, &v)){
+      write_vt(p, v);
+      found = (cmp_vt(at_vt(pre, p), nr) == 0);
+    }
+    if (!found){
+      write_vt(p, f.u);
+      memcpy(at_vt(post, p), cnt, c->vt_size);
+      incr_vt(cnt);
+    }else{
+      stack_push(s, &f); /* push the unfinished vertex */
+      f.u = v;
+      adj_cmpr_iter_init(&f.it, c, f.u);
+      memcpy(at_vt(pre, p), cnt, c->vt_size);
+      incr_vt(cnt);
+      stack_push(s, &f); /* then push an unexplored vertex */
+    }
+  }
+}
+
+/**
+   Computes a pointer to the ith element in the block of elements.
+
+   According to C89 (draft):
+
+   "It is guaranteed, however, that a pointer to an object of a given
+   alignment may be converted to a pointer to an object of the same
+   alignment or a less strict alignment and back again; the result shall
+   compare equal to the original pointer. (An object that has character
+   type has the least strict alignment.)"
+
+   "A pointer to void may be converted to or from a pointer to any
+   incomplete or object type. A pointer to any incomplete or object type
+   may be converted to a pointer to void and back again; the result shall
+   compare equal to the original pointer."
+
+   "A pointer to void shall have the same representation and alignment
+   requirements as a pointer to a character type."
+*/
+static void *ptr(const void *block, size_t i, size_t size){
+  return (void *)((char *)block + i * size);
+}
@@ -0,0 +1,79 @@
+/**
+   search-cmpr.h
+
+   Declarations of accessible functions for running the BFS and DFS
+   algorithms on compressed adjacency lists of graphs with generic integer
+   vertices indexed from 0.
+
+   The vertices of a list are decoded one at a time from the variable-length
+   gaps of a compressed adjacency list and are visited in the
+   non-decreasing order. The results equal the results of bfs and dfs on an
+   adjacency list with sorted lists, and the same distances are computed by
+   bfs_cmpr for any order of vertices in lists.
+
+   The effective type of every element in the dist, prev, pre, and post
+   arrays is of the integer type used to represent vertices, according to
+   the specifications of bfs and dfs.
+
+   The implementation only uses integer and pointer operations. Given
+   parameter values within the specified ranges, the implementation
+   provides an error message and an exit is executed if an integer
+   overflow is attempted or an allocation is not completed due to
+   insufficient resources. The behavior outside the specified parameter
+   ranges is undefined.
+
+   The implementation does not use stdint.h and is portable under
+   C89/C90 and C99.
+*/
+
+#ifndef SEARCH_CMPR_H
+#define SEARCH_CMPR_H
+
+#include <stddef.h>
+#include "graph-cmpr.h"
+
+/**
+   Runs bfs on a compressed adjacency list according to the specification
+   of bfs, where the vertices in each list are visited in the non-decreasing
+   order. The results equal the results of bfs on an adjacency list with
+   sorted lists, and the same distances are computed for any order of
+   vertices in lists. The vertices of a list are decoded one at a time
+   into a vt_size block and are not stored in an adjacency list.
+   c           : pointer to a compressed adjacency list with at least one
+                 vertex
+   Please see the specification of the other parameters in bfs.
+*/
+void bfs_cmpr(const struct adj_cmpr *c,
+              size_t start,
+              void *dist,
+              void *prev,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t),
+              void *(*at_vt)(const void *, const void *),
+              int (*cmp_vt)(const void *, const void *),
+              void (*incr_vt)(void *));
+
+/**
+   Computes and copies to the arrays pointed to by pre and post the previsit
+   and postvisit values of a DFS search from a start vertex on a compressed
+   adjacency list according to the specification of dfs, where the
+   vertices in each list are visited in the non-decreasing order. The
+   results equal the results of dfs on an adjacency list with sorted lists.
+   The recursion is emulated on a stack of list iterators, and the vertices
+   of a list are decoded one at a time.
+   c           : pointer to a compressed adjacency list with at least one
+                 and at most 2**(P - 1) - 1 vertices, where P is the
+                 precision of the integer type used to represent vertices
+   Please see the specification of the other parameters in dfs.
+*/
+void dfs_cmpr(const struct adj_cmpr *c,
+              size_t start,
+              void *pre,
+              void *post,
+              size_t (*read_vt)(const void *),
+              void (*write_vt)(void *, size_t),
+              void *(*at_vt)(const void *, const void *),
+              int (*cmp_vt)(const void *, const void *),
+              void (*incr_vt)(void *));
+
+#endif